@@ -45,6 +45,12 @@ meta constant cc_state.proof_for        : cc_state → expr → tactic expr
 meta constant cc_state.refutation_for   : cc_state → expr → tactic expr
 /- If the given state is inconsistent, return a proof for false. Otherwise fail. -/
 meta constant cc_state.proof_for_false  : cc_state → tactic expr
+/- (fast_cc_is_eqv e₁ e₂) returns tt if e₁ and e₂ are equal modulo the hypotheses in the local context
+   using congruence closure, or if the hypotheses are inconsistent. It does not produce a proof, and it is
+   cheaper than cc_state.is_eqv, but there is no propositional, AC, constructor or beta propagation.
+   So, tt means that e₁ and e₂ are equal (heterogeneously equal if their types are different),
+   and ff means that nothing is known. -/
+meta constant tactic.fast_cc_is_eqv     : expr → expr → tactic bool
 namespace cc_state
 
 meta def mk : cc_state :=
@@ -49,6 +49,38 @@ lean_bool lean_type_checker_whnf(lean_type_checker t, lean_expr e, lean_expr * r
     \remark exceptions: LEAN_KERNEL_EXCEPTION */
 lean_bool lean_type_checker_is_def_eq(lean_type_checker t, lean_expr e1, lean_expr e2, lean_bool * r, lean_exception * ex);
 
+LEAN_DEFINE_TYPE(lean_batch_check);
+
+/** \brief Type check the \c n declarations \c decls, and add them (in order) to \c e.
+    \c deps is either NULL or an array of \c n lists, where <tt>deps[i]</tt> contains the names of the
+    declarations of the batch used by <tt>decls[i]</tt> (when the list is empty, they are computed from the declaration).
+    The values of the declarations are checked in parallel when the process has a task queue, and the
+    type checkers share their caches.
+    Store in \c r the environment containing the declarations preceding the first one that failed to
+    type check, and in \c b the result of each declaration.
+    \remark exceptions: LEAN_INTERRUPTED */
+lean_bool lean_env_check_batch(lean_env e, unsigned n, lean_decl const * decls, lean_list_name const * deps,
+                               lean_env * r, lean_batch_check * b, lean_exception * ex);
+
+/** \brief Dispose/delete the given batch check results */
+void lean_batch_check_del(lean_batch_check b);
+
+/** \brief Return the number of declarations in \c b. */
+unsigned lean_batch_check_size(lean_batch_check b);
+
+/** \brief Store in \c r the name of the i-th declaration of \c b. */
+lean_bool lean_batch_check_get_name(lean_batch_check b, unsigned i, lean_name * r, lean_exception * ex);
+
+/** \brief Store true in \c r iff the i-th declaration of \c b is type correct. */
+lean_bool lean_batch_check_get_ok(lean_batch_check b, unsigned i, lean_bool * r, lean_exception * ex);
+
+/** \brief Store in \c r the error message of the i-th declaration of \c b (the empty string if it is type correct).
+    \remark The caller must invoke lean_string_del. */
+lean_bool lean_batch_check_get_error(lean_batch_check b, unsigned i, char const ** r, lean_exception * ex);
+
+/** \brief Store in \c r the time (in seconds) spent type checking the i-th declaration of \c b. */
+lean_bool lean_batch_check_get_time(lean_batch_check b, unsigned i, double * r, lean_exception * ex);
+
 /*@}*/
 /*@}*/
 
@@ -27,7 +27,7 @@ lean_bool lean_env_import(lean_env env, lean_ios ios, lean_list_name modules, le
         module_name m(n);
         imports.push_back(m);
     }
-    new_env = import_modules(new_env, "", imports, mk_olean_loader(standard_search_path().get_path()));
+    new_env = import_modules(new_env, "", imports, mk_parallel_olean_loader(standard_search_path().get_path()));
     *r = of_env(new environment(new_env));
     LEAN_CATCH;
 }
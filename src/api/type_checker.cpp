@@ -4,6 +4,8 @@ Released under Apache 2.0 license as described in the file LICENSE.
 
 Author: Leonardo de Moura
 */
+#include <vector>
+#include "library/module.h"
 #include "api/string.h"
 #include "api/exception.h"
 #include "api/type_checker.h"
@@ -52,3 +54,67 @@ lean_bool lean_type_checker_is_def_eq(lean_type_checker t, lean_expr e1, lean_ex
     *r = to_type_checker_ref(t).is_def_eq(to_expr_ref(e1), to_expr_ref(e2));
     LEAN_CATCH;
 }
+
+lean_bool lean_env_check_batch(lean_env e, unsigned n, lean_decl const * decls, lean_list_name const * deps,
+                               lean_env * r, lean_batch_check * b, lean_exception * ex) {
+    LEAN_TRY;
+    check_nonnull(e);
+    if (n > 0) check_nonnull(decls);
+    std::vector<batch_declaration> ds;
+    for (unsigned i = 0; i < n; i++) {
+        check_nonnull(decls[i]);
+        ds.emplace_back(to_decl_ref(decls[i]));
+        if (deps) {
+            check_nonnull(deps[i]);
+            for (name const & d : to_list_name_ref(deps[i]))
+                ds.back().m_deps.push_back(d);
+        }
+    }
+    std::unique_ptr<batch_check_results> results(new batch_check_results());
+    environment new_env = check_batch(to_env_ref(e), ds, *results,
+                                      [](environment const & env, certified_declaration const & d) {
+                                          return module::add(env, d);
+                                      });
+    *r = of_env(new environment(new_env));
+    *b = of_batch_check(results.release());
+    LEAN_CATCH;
+}
+
+void lean_batch_check_del(lean_batch_check b) {
+    delete to_batch_check(b);
+}
+
+unsigned lean_batch_check_size(lean_batch_check b) {
+    return b ? static_cast<unsigned>(to_batch_check_ref(b).size()) : 0;
+}
+
+static batch_check_result const & get_batch_check_result(lean_batch_check b, unsigned i) {
+    check_nonnull(b);
+    if (i >= to_batch_check_ref(b).size())
+        throw exception("invalid batch check result index");
+    return to_batch_check_ref(b)[i];
+}
+
+lean_bool lean_batch_check_get_name(lean_batch_check b, unsigned i, lean_name * r, lean_exception * ex) {
+    LEAN_TRY;
+    *r = of_name(new name(get_batch_check_result(b, i).m_name));
+    LEAN_CATCH;
+}
+
+lean_bool lean_batch_check_get_ok(lean_batch_check b, unsigned i, lean_bool * r, lean_exception * ex) {
+    LEAN_TRY;
+    *r = get_batch_check_result(b, i).m_ok;
+    LEAN_CATCH;
+}
+
+lean_bool lean_batch_check_get_error(lean_batch_check b, unsigned i, char const ** r, lean_exception * ex) {
+    LEAN_TRY;
+    *r = mk_string(get_batch_check_result(b, i).m_error);
+    LEAN_CATCH;
+}
+
+lean_bool lean_batch_check_get_time(lean_batch_check b, unsigned i, double * r, lean_exception * ex) {
+    LEAN_TRY;
+    *r = get_batch_check_result(b, i).m_time.count();
+    LEAN_CATCH;
+}
@@ -5,8 +5,10 @@ Released under Apache 2.0 license as described in the file LICENSE.
 Author: Leonardo de Moura
 */
 #pragma once
+#include <vector>
 #include "kernel/declaration.h"
 #include "kernel/type_checker.h"
+#include "kernel/batch_check.h"
 #include "api/expr.h"
 #include "api/decl.h"
 #include "api/lean_type_checker.h"
@@ -14,4 +16,9 @@ namespace lean {
 inline type_checker * to_type_checker(lean_type_checker n) { return reinterpret_cast<type_checker *>(n); }
 inline type_checker & to_type_checker_ref(lean_type_checker n) { return *reinterpret_cast<type_checker *>(n); }
 inline lean_type_checker of_type_checker(type_checker * n) { return reinterpret_cast<lean_type_checker>(n); }
+
+typedef std::vector<batch_check_result> batch_check_results;
+inline batch_check_results * to_batch_check(lean_batch_check n) { return reinterpret_cast<batch_check_results *>(n); }
+inline batch_check_results const & to_batch_check_ref(lean_batch_check n) { return *reinterpret_cast<batch_check_results *>(n); }
+inline lean_batch_check of_batch_check(batch_check_results * n) { return reinterpret_cast<lean_batch_check>(n); }
 }
@@ -5,6 +5,7 @@ Released under Apache 2.0 license as described in the file LICENSE.
 Author: Gabriel Ebner
 */
 #include <fstream>
+#include <string>
 #include "kernel/init_module.h"
 #include "util/init_module.h"
 #include "util/test.h"
@@ -87,8 +88,21 @@ int main(int argc, char ** argv) {
         });
 #endif
 
-    if (argc < 2) {
-        std::cout << "usage: leanchecker export.out lemma_to_print" << std::endl;
+    unsigned num_threads = 0;
+    buffer<char const *> args;
+    for (int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+        if (arg == "-j" && i + 1 < argc) {
+            num_threads = static_cast<unsigned>(atoi(argv[++i]));
+        } else if (arg.compare(0, 2, "-j") == 0 && arg.size() > 2) {
+            num_threads = static_cast<unsigned>(atoi(arg.c_str() + 2));
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+
+    if (args.empty()) {
+        std::cout << "usage: leanchecker [-j num_threads] export.out lemma_to_print" << std::endl;
         return 1;
     }
 
@@ -111,17 +125,17 @@ int main(int argc, char ** argv) {
     } initer;
 
     try {
-        std::ifstream in(argv[1]);
-        if (!in) throw exception(sstream() << "file not found: " << argv[1]);
+        std::ifstream in(args[0]);
+        if (!in) throw exception(sstream() << "file not found: " << args[0]);
 
         unsigned trust_lvl = 0;
         auto env = mk_environment(trust_lvl);
         lowlevel_notations notations;
-        import_from_text(in, env, notations);
+        import_from_text(in, env, notations, num_threads);
 
         buffer<name> to_print;
-        for (int i = 2; i < argc; i++)
-            to_print.push_back(string_to_name(argv[i]));
+        for (unsigned i = 1; i < args.size(); i++)
+            to_print.push_back(string_to_name(args[i]));
 
         checker_print_fn(std::cout, env, notations).handle_cmdline_args(to_print);
 
@@ -0,0 +1,153 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "util/exception.h"
+#include "util/sstream.h"
+#include "checker/parallel_checker.h"
+
+namespace lean {
+
+parallel_checker::parallel_checker(unsigned num_threads) {
+    for (unsigned i = 0; i < num_threads; i++)
+        m_workers.push_back(std::unique_ptr<lthread>(new lthread([this] { worker_loop(); })));
+}
+
+parallel_checker::~parallel_checker() {
+    {
+        unique_lock<mutex> lock(m_mutex);
+        m_cancelled = true;
+        m_ready.clear();
+        m_wake_up.notify_all();
+    }
+    for (auto & w : m_workers) w->join();
+}
+
+void parallel_checker::add(name const & n, unsigned line, std::function<void()> const & check,
+                           buffer<name> const & deps) {
+    unique_lock<mutex> lock(m_mutex);
+    unsigned idx = m_nodes.size();
+    m_nodes.emplace_back();
+    node & nd = m_nodes.back();
+    nd.m_name  = n;
+    nd.m_line  = line;
+    nd.m_check = check;
+    m_node_of[n] = idx;
+
+    optional<name> failed_dep;
+    for (name const & d : deps) {
+        auto it = m_node_of.find(d);
+        if (it == m_node_of.end() || it->second == idx) continue;
+        node & dep = m_nodes[it->second];
+        if (dep.m_failed) {
+            failed_dep = dep.m_name;
+        } else if (!dep.m_done) {
+            dep.m_dependents.push_back(idx);
+            nd.m_pending++;
+        }
+    }
+
+    if (failed_dep) {
+        lock.unlock();
+        finish(idx, optional<std::string>((sstream() << "depends on declaration that failed to type check: "
+                                           << *failed_dep).str()));
+    } else if (nd.m_pending == 0) {
+        m_ready.push_back(idx);
+        m_wake_up.notify_one();
+    }
+}
+
+void parallel_checker::finish(unsigned idx, optional<std::string> const & error) {
+    unique_lock<mutex> lock(m_mutex);
+    /* Failures propagate along arbitrarily long dependency chains, so we use
+       an explicit worklist instead of recursing on each failed dependent. */
+    std::vector<std::pair<unsigned, optional<std::string>>> todo;
+    todo.emplace_back(idx, error);
+    while (!todo.empty()) {
+        unsigned i = todo.back().first;
+        optional<std::string> err = todo.back().second;
+        todo.pop_back();
+        node & nd = m_nodes[i];
+        if (nd.m_done) continue;
+        nd.m_done  = true;
+        nd.m_check = nullptr;
+        m_num_done++;
+        if (err) {
+            nd.m_failed = true;
+            nd.m_error  = *err;
+        }
+        std::vector<unsigned> dependents;
+        std::swap(dependents, nd.m_dependents);
+        for (unsigned d : dependents) {
+            node & dep = m_nodes[d];
+            if (dep.m_done) continue;
+            lean_assert(dep.m_pending > 0);
+            dep.m_pending--;
+            if (nd.m_failed) {
+                todo.emplace_back(d, optional<std::string>((sstream() << "depends on declaration that failed to type check: "
+                                                            << nd.m_name).str()));
+            } else if (dep.m_pending == 0) {
+                m_ready.push_back(d);
+            }
+        }
+    }
+    m_wake_up.notify_all();
+}
+
+void parallel_checker::worker_loop() {
+    while (true) {
+        unsigned idx;
+        std::function<void()> check;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            while (!m_cancelled && m_ready.empty() && !(m_no_more_input && m_num_done == m_nodes.size()))
+                m_wake_up.wait(lock);
+            if (m_cancelled || m_ready.empty()) return;
+            idx = m_ready.front();
+            m_ready.pop_front();
+            check = m_nodes[idx].m_check;
+        }
+
+        optional<std::string> error;
+        try {
+            if (check) check();
+        } catch (throwable & ex) {
+            error = std::string(ex.what());
+        } catch (std::exception & ex) {
+            error = std::string(ex.what());
+        }
+        finish(idx, error);
+    }
+}
+
+void parallel_checker::join() {
+    {
+        unique_lock<mutex> lock(m_mutex);
+        m_no_more_input = true;
+        m_wake_up.notify_all();
+        while (m_num_done < m_nodes.size())
+            m_wake_up.wait(lock);
+    }
+    for (auto & w : m_workers) w->join();
+    m_workers.clear();
+
+    unsigned num_failed = 0;
+    node const * first_failed = nullptr;
+    for (node const & nd : m_nodes) {
+        if (nd.m_failed) {
+            num_failed++;
+            if (!first_failed) first_failed = &nd;
+        }
+    }
+    if (first_failed)
+        throw exception(sstream() << "line " << first_failed->m_line << ": " << first_failed->m_error
+                        << " (" << num_failed << " declaration(s) failed to type check)");
+}
+
+}
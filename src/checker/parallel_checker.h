@@ -0,0 +1,63 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#pragma once
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "util/thread.h"
+#include "util/buffer.h"
+#include "util/name.h"
+
+namespace lean {
+
+/** \brief Executes the deferred value checks of declarations (see \c check_deferred) in parallel.
+
+    The declarations form a dependency graph: the value of a declaration is only checked after
+    the values of all declarations it refers to have been successfully checked. If a check fails,
+    then the declarations depending on it are not checked at all, and the failure is reported
+    for the first declaration in export order. */
+class parallel_checker {
+    struct node {
+        name                  m_name;
+        unsigned              m_line;
+        std::function<void()> m_check;
+        unsigned              m_pending = 0;
+        std::vector<unsigned> m_dependents;
+        bool                  m_done    = false;
+        bool                  m_failed  = false;
+        std::string           m_error;
+    };
+
+    mutex                                          m_mutex;
+    condition_variable                             m_wake_up;
+    std::deque<node>                               m_nodes;
+    std::unordered_map<name, unsigned, name_hash>  m_node_of;
+    std::deque<unsigned>                           m_ready;
+    unsigned                                       m_num_done = 0;
+    bool                                           m_no_more_input = false;
+    bool                                           m_cancelled     = false;
+    std::vector<std::unique_ptr<lthread>>          m_workers;
+
+    void worker_loop();
+    void finish(unsigned idx, optional<std::string> const & error);
+
+public:
+    parallel_checker(unsigned num_threads);
+    ~parallel_checker();
+
+    /** \brief Schedule \c check for the declaration \c n (defined at line \c line of the export).
+        \c deps contains the names of the constants occurring in the declaration. */
+    void add(name const & n, unsigned line, std::function<void()> const & check, buffer<name> const & deps);
+
+    /** \brief Wait until all checks have been executed, throw an exception if one of them failed. */
+    void join();
+};
+
+}
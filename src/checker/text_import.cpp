@@ -8,94 +8,240 @@ Author: Gabriel Ebner
 #include "kernel/environment.h"
 #include "kernel/inductive/inductive.h"
 #include "kernel/type_checker.h"
+#include "kernel/for_each_fn.h"
 #include "util/sstream.h"
+#include "util/name_set.h"
+#include <cctype>
 #include <string>
+#include <vector>
 #include <iostream>
-#include <unordered_map>
 #include "kernel/quotient/quotient.h"
+#include "checker/parallel_checker.h"
 
 namespace lean {
 
+/** \brief Streaming tokenizer for the export format.
+
+    The input is read in large blocks, and each line is split into whitespace-separated tokens
+    without copying it into an intermediate string stream. */
+class export_reader {
+    std::istream &    m_in;
+    std::vector<char> m_buffer;
+    size_t            m_pos = 0;
+    size_t            m_end = 0;
+    unsigned          m_line = 0;
+    std::string       m_token;
+
+    bool fill() {
+        if (m_pos < m_end) return true;
+        if (!m_in) return false;
+        m_in.read(m_buffer.data(), m_buffer.size());
+        m_pos = 0;
+        m_end = static_cast<size_t>(m_in.gcount());
+        return m_end > 0;
+    }
+
+    int peek() { return fill() ? m_buffer[m_pos] : EOF; }
+
+    void skip_spaces() {
+        int c;
+        while ((c = peek()) == ' ' || c == '\t' || c == '\r') m_pos++;
+    }
+
+public:
+    export_reader(std::istream & in, size_t buffer_size = 1 << 20) : m_in(in), m_buffer(buffer_size) {}
+
+    unsigned get_line() const { return m_line; }
+
+    /** \brief Skip the rest of the current line, return false if there are no more lines. */
+    bool next_line() {
+        if (m_line > 0) {
+            int c;
+            while ((c = peek()) != EOF) {
+                m_pos++;
+                if (c == '\n') break;
+            }
+        }
+        if (peek() == EOF) return false;
+        m_line++;
+        return true;
+    }
+
+    /** \brief Return true iff there are no more tokens on the current line. */
+    bool at_eol() {
+        skip_spaces();
+        int c = peek();
+        return c == '\n' || c == EOF;
+    }
+
+    std::string const & read_token() {
+        skip_spaces();
+        m_token.clear();
+        int c;
+        while ((c = peek()) != EOF && !isspace(c)) {
+            m_token.push_back(static_cast<char>(c));
+            m_pos++;
+        }
+        return m_token;
+    }
+
+    bool is_unsigned_next() {
+        skip_spaces();
+        return isdigit(peek());
+    }
+
+    unsigned read_unsigned() {
+        skip_spaces();
+        int c = peek();
+        if (!isdigit(c))
+            throw exception("number expected");
+        unsigned r = 0;
+        while (isdigit(c = peek())) {
+            r = 10*r + static_cast<unsigned>(c - '0');
+            m_pos++;
+        }
+        return r;
+    }
+
+    /** \brief Read the remaining characters of the current line, without the leading space. */
+    std::string read_rest_of_line() {
+        if (peek() == ' ') m_pos++;
+        std::string r;
+        int c;
+        while ((c = peek()) != EOF && c != '\n') {
+            r.push_back(static_cast<char>(c));
+            m_pos++;
+        }
+        if (!r.empty() && r.back() == '\r')
+            r.pop_back();
+        return r;
+    }
+};
+
+template <class T>
+static T const & get_entry(std::vector<optional<T>> const & table, unsigned idx, char const * kind) {
+    if (idx >= table.size() || !table[idx])
+        throw exception(sstream() << "unknown " << kind << " index: " << idx);
+    return *table[idx];
+}
+
+template <class T>
+static void set_entry(std::vector<optional<T>> & table, unsigned idx, T const & v) {
+    if (idx >= table.size()) table.resize(idx + 1);
+    table[idx] = v;
+}
+
 struct text_importer {
-    std::unordered_map<unsigned, expr> m_expr;
-    std::unordered_map<unsigned, name> m_name;
-    std::unordered_map<unsigned, level> m_level;
+    std::vector<optional<expr>>  m_expr;
+    std::vector<optional<name>>  m_name;
+    std::vector<optional<level>> m_level;
 
     lowlevel_notations m_notations;
 
     environment m_env;
 
-    text_importer(environment const & env) : m_env(env) {
-        m_level[0] = {};
-        m_name[0] = {};
+    std::unique_ptr<parallel_checker> m_checker;
+
+    text_importer(environment const & env, unsigned num_threads) : m_env(env) {
+        set_entry(m_level, 0, level());
+        set_entry(m_name, 0, name());
+#if defined(LEAN_MULTI_THREAD)
+        if (num_threads > 0)
+            m_checker.reset(new parallel_checker(num_threads));
+#else
+        (void)num_threads;
+#endif
     }
 
-    levels read_levels(std::istream & in) {
-        unsigned idx;
+    expr const & get_expr(unsigned idx) const { return get_entry(m_expr, idx, "expression"); }
+    name const & get_name(unsigned idx) const { return get_entry(m_name, idx, "name"); }
+    level const & get_level(unsigned idx) const { return get_entry(m_level, idx, "universe level"); }
+
+    levels read_levels(export_reader & in) {
         buffer<level> ls;
-        while (in >> idx) {
-            ls.push_back(m_level.at(idx));
+        while (!in.at_eol()) {
+            ls.push_back(get_level(in.read_unsigned()));
         }
         return to_list(ls);
     }
 
-    level_param_names read_level_params(std::istream & in) {
-        unsigned idx;
+    level_param_names read_level_params(export_reader & in) {
         buffer<name> ls;
-        while (in >> idx) {
-            ls.push_back(m_name.at(idx));
+        while (!in.at_eol()) {
+            ls.push_back(get_name(in.read_unsigned()));
         }
         return to_list(ls);
     }
 
-    void handle_ind(std::istream & in) {
-        unsigned num_params, name_idx, type_idx, num_intros;
-        in >> num_params >> name_idx >> type_idx >> num_intros;
+    void handle_ind(export_reader & in) {
+        unsigned num_params = in.read_unsigned();
+        unsigned name_idx   = in.read_unsigned();
+        unsigned type_idx   = in.read_unsigned();
+        unsigned num_intros = in.read_unsigned();
 
         buffer<inductive::intro_rule> intros;
         for (unsigned i = 0; i < num_intros; i++) {
-            unsigned name_idx, type_idx; in >> name_idx >> type_idx;
-            intros.push_back(inductive::mk_intro_rule(m_name.at(name_idx), m_expr.at(type_idx)));
+            unsigned name_idx = in.read_unsigned();
+            unsigned type_idx = in.read_unsigned();
+            intros.push_back(inductive::mk_intro_rule(get_name(name_idx), get_expr(type_idx)));
         }
 
         auto ls = read_level_params(in);
 
-        inductive::inductive_decl decl(m_name.at(name_idx), ls, num_params, m_expr.at(type_idx), to_list(intros));
+        inductive::inductive_decl decl(get_name(name_idx), ls, num_params, get_expr(type_idx), to_list(intros));
         m_env = inductive::add_inductive(m_env, decl, true).first;
     }
 
-    void handle_def(std::istream & in) {
-        unsigned name_idx, type_idx, val_idx;
-        in >> name_idx >> type_idx >> val_idx;
+    void add(declaration const & decl, unsigned line) {
+        if (!m_checker) {
+            m_env = m_env.add(check(m_env, decl, true));
+            return;
+        }
+        std::function<void()> check_value;
+        m_env = m_env.add(check_deferred(m_env, decl, check_value));
+        if (!check_value) return;
+        buffer<name> deps;
+        name_set visited;
+        auto collect = [&] (expr const & e) {
+            for_each(e, [&] (expr const & c, unsigned) {
+                if (is_constant(c) && !visited.contains(const_name(c))) {
+                    visited.insert(const_name(c));
+                    deps.push_back(const_name(c));
+                }
+                return true;
+            });
+        };
+        collect(decl.get_type());
+        collect(decl.get_value());
+        m_checker->add(decl.get_name(), line, check_value, deps);
+    }
+
+    void handle_def(export_reader & in) {
+        unsigned name_idx = in.read_unsigned();
+        unsigned type_idx = in.read_unsigned();
+        unsigned val_idx  = in.read_unsigned();
         auto ls = read_level_params(in);
 
         auto decl =
-            type_checker(m_env).is_prop(m_expr.at(type_idx)) ?
-                mk_theorem(m_name.at(name_idx), ls, m_expr.at(type_idx), m_expr.at(val_idx)) :
-                mk_definition(m_env, m_name.at(name_idx), ls, m_expr.at(type_idx), m_expr.at(val_idx), true, true);
+            type_checker(m_env).is_prop(get_expr(type_idx)) ?
+                mk_theorem(get_name(name_idx), ls, get_expr(type_idx), get_expr(val_idx)) :
+                mk_definition(m_env, get_name(name_idx), ls, get_expr(type_idx), get_expr(val_idx), true, true);
 
-        m_env = m_env.add(check(m_env, decl, true));
+        add(decl, in.get_line());
     }
 
-    void handle_ax(std::istream & in) {
-        unsigned name_idx, type_idx;
-        in >> name_idx >> type_idx;
+    void handle_ax(export_reader & in) {
+        unsigned name_idx = in.read_unsigned();
+        unsigned type_idx = in.read_unsigned();
         auto ls = read_level_params(in);
-        m_env = m_env.add(check(m_env, mk_axiom(m_name.at(name_idx), ls, m_expr.at(type_idx))));
+        add(mk_axiom(get_name(name_idx), ls, get_expr(type_idx)), in.get_line());
     }
 
-    void handle_notation(std::istream & in, lowlevel_notation_kind kind) {
-        unsigned name_idx, prec;
-        in >> name_idx >> prec;
-
-        std::string token;
-        std::getline(in, token);
-        if (!token.empty() && token.front())
-            token.erase(token.begin());
-        if (!token.empty() && token.back() == '\n')
-            token.erase(token.end() - 1);
-
-        m_notations[m_name.at(name_idx)] = { kind, token, prec };
+    void handle_notation(export_reader & in, lowlevel_notation_kind kind) {
+        unsigned name_idx = in.read_unsigned();
+        unsigned prec     = in.read_unsigned();
+        std::string token = in.read_rest_of_line();
+        m_notations[get_name(name_idx)] = { kind, token, prec };
     }
 
     binder_info read_binder_info(std::string const & tok) {
@@ -112,95 +258,98 @@ struct text_importer {
         }
     }
 
-    void handle_line(std::string const & line) {
-        std::istringstream in(line);
-
-        unsigned idx;
-        std::string cmd;
-        in >> cmd;
-        if (cmd == "#IND") {
-            handle_ind(in);
-        } else if (cmd == "#DEF") {
-            handle_def(in);
-        } else if (cmd == "#AX") {
-            handle_ax(in);
-        } else if (cmd == "#QUOT") {
-            m_env = declare_quotient(m_env);
-        } else if (cmd == "#PREFIX") {
-            handle_notation(in, lowlevel_notation_kind::Prefix);
-        } else if (cmd == "#POSTFIX") {
-            handle_notation(in, lowlevel_notation_kind::Postfix);
-        } else if (cmd == "#INFIX") {
-            handle_notation(in, lowlevel_notation_kind::Infix);
-        } else if (std::istringstream(cmd) >> idx) {
-            std::string kind;
-            in >> kind;
+    void handle_line(export_reader & in) {
+        if (in.at_eol()) return;
+        if (in.is_unsigned_next()) {
+            unsigned idx = in.read_unsigned();
+            std::string const & kind = in.read_token();
 
             if (kind == "#NS") {
-                unsigned p; std::string limb; in >> p >> std::skipws >> limb;
-                m_name[idx] = name(m_name.at(p), limb.c_str());
+                unsigned p = in.read_unsigned();
+                std::string const & limb = in.read_token();
+                set_entry(m_name, idx, name(get_name(p), limb.c_str()));
             } else if (kind == "#NI") {
-                unsigned p, limb; in >> p >> limb;
-                m_name[idx] = name(m_name.at(p), limb);
+                unsigned p = in.read_unsigned(); unsigned limb = in.read_unsigned();
+                set_entry(m_name, idx, name(get_name(p), limb));
             } else if (kind == "#US") {
-                unsigned l1; in >> l1;
-                m_level[idx] = mk_succ(m_level.at(l1));
+                unsigned l1 = in.read_unsigned();
+                set_entry(m_level, idx, mk_succ(get_level(l1)));
             } else if (kind == "#UM") {
-                unsigned l1, l2; in >> l1 >> l2;
-                m_level[idx] = mk_max(m_level.at(l1), m_level.at(l2));
+                unsigned l1 = in.read_unsigned(); unsigned l2 = in.read_unsigned();
+                set_entry(m_level, idx, mk_max(get_level(l1), get_level(l2)));
             } else if (kind == "#UIM") {
-                unsigned l1, l2; in >> l1 >> l2;
-                m_level[idx] = mk_imax(m_level.at(l1), m_level.at(l2));
+                unsigned l1 = in.read_unsigned(); unsigned l2 = in.read_unsigned();
+                set_entry(m_level, idx, mk_imax(get_level(l1), get_level(l2)));
             } else if (kind == "#UP") {
-                unsigned i1; in >> i1;
-                m_level[idx] = mk_param_univ(m_name.at(i1));
+                unsigned i1 = in.read_unsigned();
+                set_entry(m_level, idx, mk_param_univ(get_name(i1)));
             } else if (kind == "#EV") {
-                unsigned v; in >> v;
-                m_expr[idx] = mk_var(v);
+                unsigned v = in.read_unsigned();
+                set_entry(m_expr, idx, mk_var(v));
             } else if (kind == "#ES") {
-                unsigned l; in >> l;
-                m_expr[idx] = mk_sort(m_level.at(l));
+                unsigned l = in.read_unsigned();
+                set_entry(m_expr, idx, mk_sort(get_level(l)));
             } else if (kind == "#EC") {
-                unsigned n; in >> n;
+                unsigned n = in.read_unsigned();
                 auto ls = read_levels(in);
-                m_expr[idx] = mk_constant(m_name.at(n), ls);
+                set_entry(m_expr, idx, mk_constant(get_name(n), ls));
             } else if (kind == "#EA") {
-                unsigned e1, e2; in >> e1 >> e2;
-                m_expr[idx] = mk_app(m_expr.at(e1), m_expr.at(e2));
+                unsigned e1 = in.read_unsigned(); unsigned e2 = in.read_unsigned();
+                set_entry(m_expr, idx, mk_app(get_expr(e1), get_expr(e2)));
             } else if (kind == "#EZ") {
-                unsigned n, t, v, b; in >> n >> t >> v >> b;
-                m_expr[idx] = mk_let(m_name.at(n), m_expr.at(t), m_expr.at(v), m_expr.at(b));
-            } else if (kind == "#EL") {
-                unsigned n, t, e; std::string b; in >> b >> n >> t >> e;
-                m_expr[idx] = mk_lambda(m_name.at(n), m_expr.at(t), m_expr.at(e), read_binder_info(b));
-            } else if (kind == "#EP") {
-                unsigned n, t, e; std::string b; in >> b >> n >> t >> e;
-                m_expr[idx] = mk_pi(m_name.at(n), m_expr.at(t), m_expr.at(e), read_binder_info(b));
+                unsigned n = in.read_unsigned(); unsigned t = in.read_unsigned();
+                unsigned v = in.read_unsigned(); unsigned b = in.read_unsigned();
+                set_entry(m_expr, idx, mk_let(get_name(n), get_expr(t), get_expr(v), get_expr(b)));
+            } else if (kind == "#EL" || kind == "#EP") {
+                bool is_lambda = kind == "#EL";
+                binder_info bi = read_binder_info(in.read_token());
+                unsigned n = in.read_unsigned(); unsigned t = in.read_unsigned(); unsigned e = in.read_unsigned();
+                set_entry(m_expr, idx, is_lambda ? mk_lambda(get_name(n), get_expr(t), get_expr(e), bi)
+                                                 : mk_pi(get_name(n), get_expr(t), get_expr(e), bi));
             } else {
                 throw exception(sstream() << "unknown term definition kind: " << kind);
             }
+            return;
+        }
+
+        std::string const & cmd = in.read_token();
+        if (cmd == "#IND") {
+            handle_ind(in);
+        } else if (cmd == "#DEF") {
+            handle_def(in);
+        } else if (cmd == "#AX") {
+            handle_ax(in);
+        } else if (cmd == "#QUOT") {
+            m_env = declare_quotient(m_env);
+        } else if (cmd == "#PREFIX") {
+            handle_notation(in, lowlevel_notation_kind::Prefix);
+        } else if (cmd == "#POSTFIX") {
+            handle_notation(in, lowlevel_notation_kind::Postfix);
+        } else if (cmd == "#INFIX") {
+            handle_notation(in, lowlevel_notation_kind::Infix);
         } else {
             throw exception(sstream() << "unknown command: " << cmd);
         }
     }
 };
 
-void import_from_text(std::istream & in, environment & env, lowlevel_notations & notations) {
-    text_importer importer(env);
+void import_from_text(std::istream & in, environment & env, lowlevel_notations & notations, unsigned num_threads) {
+    text_importer importer(env, num_threads);
 
-    std::string line;
-    unsigned line_num = 0;
-    while (std::getline(in, line)) {
-        line_num++;
+    export_reader reader(in);
+    while (reader.next_line()) {
         try {
-            importer.handle_line(line);
+            importer.handle_line(reader);
         } catch (throwable & t) {
-            throw exception(sstream() << "line " << line_num << ": " << t.what());
+            throw exception(sstream() << "line " << reader.get_line() << ": " << t.what());
         } catch (std::exception & e) {
-            throw exception(sstream() << "line " << line_num << ": " << e.what());
+            throw exception(sstream() << "line " << reader.get_line() << ": " << e.what());
         }
     }
 
+    if (importer.m_checker)
+        importer.m_checker->join();
+
     env = importer.m_env;
     notations = std::move(importer.m_notations);
 }
@@ -23,6 +23,10 @@ struct lowlevel_notation_info {
 
 using lowlevel_notations = std::unordered_map<name, lowlevel_notation_info, name_hash>;
 
-void import_from_text(std::istream & in, environment & env, lowlevel_notations & notations);
+/** \brief Import and type check the declarations in the low-level export format.
+    If \c num_threads is positive, then the values of definitions and theorems are checked in parallel
+    by \c num_threads worker threads. */
+void import_from_text(std::istream & in, environment & env, lowlevel_notations & notations,
+                      unsigned num_threads = 0);
 
 }
@@ -11,3 +11,4 @@ cd "$LEAN_PATH"
 # We pass "$LEAN_PATH" as a last argument here, because we don't have lrealpath on emscripten
 $emulator "$lean_bin" --recursive --export="$export_file" "$LEAN_PATH"
 $emulator "$leanchecker_bin" "$export_file" nat.add_assoc
+$emulator "$leanchecker_bin" -j 4 "$export_file" nat.add_assoc
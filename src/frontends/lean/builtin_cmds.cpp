@@ -214,7 +214,10 @@ environment reduce_cmd(parser & p) {
     } else {
         type_checker tc(p.env(), true, false);
         bool eta = false;
-        r = normalize(tc, e, eta);
+        if (auto n = tc.machine_normalize(e))
+            r = *n;
+        else
+            r = normalize(tc, e, eta);
     }
     auto out = p.mk_message(p.cmd_pos(), INFORMATION);
     out.set_caption("reduce result") << r;
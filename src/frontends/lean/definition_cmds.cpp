@@ -680,6 +680,7 @@ static expr elaborate_proof(
         metavar_context const & mctx, local_context const & lctx,
         parser_pos_provider pos_provider, bool use_info_manager, std::string const & file_name) {
     scoped_expr_caching disable(false);  // FIXME: otherwise sigma.eq fails to elaborate
+    scoped_expr_interning disable_interning(false);
     auto tc = std::make_shared<type_context>(decl_env, opts, mctx, lctx);
     scope_trace_env scope2(decl_env, opts, *tc);
     scope_traces_as_messages scope2a(file_name, header_pos);
@@ -725,6 +726,7 @@ static void check_example(environment const & decl_env, options const & opts,
                           metavar_context const & mctx, local_context const & lctx,
                           parser_pos_provider pos_provider, bool use_info_manager, std::string const & file_name) {
     scoped_expr_caching disable(false);  // FIXME: otherwise sigma.eq fails to elaborate
+    scoped_expr_interning disable_interning(false);
     auto tc = std::make_shared<type_context>(decl_env, opts, mctx, lctx);
     scope_trace_env scope2(decl_env, opts, *tc);
     scope_pos_info_provider scope3(pos_provider);
@@ -8,6 +8,7 @@ Author: Leonardo de Moura
 #include <utility>
 #include "util/flet.h"
 #include "util/thread.h"
+#include "util/sampling_profiler.h"
 #include "util/sexpr/option_declarations.h"
 #include "kernel/find_fn.h"
 #include "kernel/error_msgs.h"
@@ -3316,6 +3317,7 @@ tactic_state elaborator::mk_tactic_state_for(expr const & mvar) {
 }
 
 void elaborator::invoke_tactic(expr const & mvar, expr const & tactic) {
+    scoped_profiler_phase phase("tactic execution");
     expr const & ref     = mvar;
     expr type            = m_ctx.mctx().get_metavar_decl(mvar).get_type();
     tactic_state s       = mk_tactic_state_for(mvar);
@@ -3585,6 +3587,7 @@ static expr replace_with_simple_metavars(metavar_context mctx, name_map<expr> &
 }
 
 expr elaborator::elaborate(expr const & e) {
+    scoped_profiler_phase phase("elaboration");
     scoped_info_manager scope_infom(&m_info);
     expr r = visit(e,  none_expr());
     trace_elab_detail(tout() << "result before final checkpoint\n" << r << "\n";);
@@ -3593,6 +3596,7 @@ expr elaborator::elaborate(expr const & e) {
 }
 
 expr elaborator::elaborate_type(expr const & e) {
+    scoped_profiler_phase phase("elaboration");
     scoped_info_manager scope_infom(&m_info);
     expr const & ref = e;
     expr new_e = ensure_type(visit(e, none_expr()), ref);
@@ -3601,6 +3605,7 @@ expr elaborator::elaborate_type(expr const & e) {
 }
 
 expr_pair elaborator::elaborate_with_type(expr const & e, expr const & e_type) {
+    scoped_profiler_phase phase("elaboration");
     scoped_info_manager scope_infom(&m_info);
     expr const & ref = e;
     expr new_e, new_e_type;
@@ -2483,6 +2483,7 @@ bool parser::parse_command_like() {
 
     // We disable hash-consing while parsing to make sure the pos-info are correct.
     scoped_expr_caching disable(false);
+    scoped_expr_interning disable_interning(false);
     scope_pos_info_provider scope1(*this);
 
     check_interrupted();
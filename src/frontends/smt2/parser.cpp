@@ -699,7 +699,7 @@ public:
     bool operator()() {
         scoped_expr_caching disable(false);
 
-        auto mod_ldr = mk_olean_loader(m_path);
+        auto mod_ldr = mk_parallel_olean_loader(m_path);
         m_env = import_modules(m_env, get_stream_name(), {module_name("init"), module_name("smt")},
                                mod_ldr);
 
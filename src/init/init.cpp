@@ -12,6 +12,7 @@ Author: Leonardo de Moura
 #include "kernel/init_module.h"
 #include "kernel/inductive/inductive.h"
 #include "kernel/quotient/quotient.h"
+#include "kernel/nat/nat.h"
 #include "library/init_module.h"
 #include "library/tactic/init_module.h"
 #include "library/constructions/init_module.h"
@@ -34,6 +35,7 @@ void initialize() {
     initialize_kernel_module();
     initialize_inductive_module();
     initialize_quotient_module();
+    initialize_nat_module();
     init_default_print_fn();
     initialize_library_core_module();
     initialize_vm_core_module();
@@ -69,6 +71,7 @@ void finalize() {
     finalize_library_module();
     finalize_vm_core_module();
     finalize_library_core_module();
+    finalize_nat_module();
     finalize_quotient_module();
     finalize_inductive_module();
     finalize_kernel_module();
@@ -0,0 +1,145 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "util/interrupt.h"
+#include "util/name_set.h"
+#include "util/sstream.h"
+#include "util/task_builder.h"
+#include "kernel/for_each_fn.h"
+#include "kernel/type_checker.h"
+#include "kernel/batch_check.h"
+
+namespace lean {
+typedef std::unordered_map<name, unsigned, name_hash> batch_index;
+
+static std::vector<unsigned> get_batch_deps(batch_declaration const & d, batch_index const & idx_of) {
+    std::vector<unsigned> deps;
+    name_set visited;
+    auto add_dep = [&](name const & n) {
+        if (visited.contains(n))
+            return;
+        visited.insert(n);
+        auto it = idx_of.find(n);
+        if (it != idx_of.end())
+            deps.push_back(it->second);
+    };
+    if (!d.m_deps.empty()) {
+        for (name const & n : d.m_deps)
+            add_dep(n);
+        return deps;
+    }
+    auto collect = [&](expr const & e) {
+        for_each(e, [&](expr const & c, unsigned) {
+                if (is_constant(c))
+                    add_dep(const_name(c));
+                return true;
+            });
+    };
+    collect(d.m_decl.get_type());
+    if (d.m_decl.is_definition())
+        collect(d.m_decl.get_value());
+    return deps;
+}
+
+typedef std::shared_ptr<std::vector<batch_check_result>> batch_results;
+
+/* Check the value of the i-th declaration, the checks of its dependencies must have been executed. */
+static bool check_batch_value(batch_results const & results, unsigned i, std::vector<unsigned> const & deps,
+                              std::function<void()> const & check_value) {
+    batch_check_result & r = (*results)[i];
+    for (unsigned d : deps) {
+        if (!(*results)[d].m_ok) {
+            r.m_error = (sstream() << "depends on declaration that failed to type check: " << (*results)[d].m_name).str();
+            return false;
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    try {
+        check_value();
+        r.m_ok = true;
+    } catch (interrupted &) {
+        throw;
+    } catch (throwable & ex) {
+        r.m_error = ex.what();
+    } catch (std::exception & ex) {
+        r.m_error = ex.what();
+    }
+    r.m_time += second_duration(std::chrono::steady_clock::now() - start);
+    return r.m_ok;
+}
+
+environment check_batch(environment const & env, std::vector<batch_declaration> const & decls,
+                        std::vector<batch_check_result> & out, batch_add_fn const & add) {
+    batch_results results = std::make_shared<std::vector<batch_check_result>>(decls.size());
+    bool parallel = has_task_queue();
+    batch_index idx_of;
+    std::vector<task<bool>> tasks(decls.size());
+    /* envs[i] is the environment containing the first i declarations of the batch */
+    std::vector<environment> envs;
+    envs.push_back(env);
+    for (unsigned i = 0; i < decls.size(); i++) {
+        declaration const & d = decls[i].m_decl;
+        batch_check_result & r = (*results)[i];
+        r.m_name = d.get_name();
+        environment new_env = envs.back();
+        std::function<void()> check_value;
+        auto start = std::chrono::steady_clock::now();
+        try {
+            new_env = add(new_env, check_deferred(new_env, d, check_value));
+            r.m_ok  = !check_value;
+        } catch (interrupted &) {
+            throw;
+        } catch (throwable & ex) {
+            r.m_error = ex.what();
+        } catch (std::exception & ex) {
+            r.m_error = ex.what();
+        }
+        r.m_time = second_duration(std::chrono::steady_clock::now() - start);
+        envs.push_back(new_env);
+        if (!r.m_ok && !check_value)
+            continue;
+        idx_of[d.get_name()] = i;
+        if (!check_value)
+            continue;
+        std::vector<unsigned> deps = get_batch_deps(decls[i], idx_of);
+        if (parallel) {
+            std::vector<gtask> dep_tasks;
+            for (unsigned j : deps)
+                if (tasks[j]) dep_tasks.push_back(tasks[j]);
+            tasks[i] = task_builder<bool>([results, i, deps, check_value] {
+                    return check_batch_value(results, i, deps, check_value);
+                }).depends_on(dep_tasks).build();
+            taskq().submit(tasks[i]);
+        } else {
+            check_batch_value(results, i, deps, check_value);
+        }
+    }
+    for (unsigned i = 0; i < tasks.size(); i++) {
+        if (!tasks[i])
+            continue;
+        taskq().wait_for_finish(tasks[i]);
+        if (tasks[i]->peek_exception() && (*results)[i].m_error.empty())
+            (*results)[i].m_error = "interrupted";
+    }
+    check_interrupted();
+    out = *results;
+    for (unsigned i = 0; i < out.size(); i++) {
+        if (!out[i].m_ok)
+            return envs[i];
+    }
+    return envs.back();
+}
+
+environment check_batch(environment const & env, std::vector<batch_declaration> const & decls,
+                        std::vector<batch_check_result> & results) {
+    return check_batch(env, decls, results,
+                       [](environment const & env, certified_declaration const & d) { return env.add(d); });
+}
+}
@@ -0,0 +1,50 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+#include "util/timeit.h"
+#include "kernel/environment.h"
+
+namespace lean {
+/** \brief Declaration given to \c check_batch. */
+struct batch_declaration {
+    declaration       m_decl;
+    /* Names of the declarations of the batch used by \c m_decl. When it is empty, the constants
+       occurring in the type and value of \c m_decl are used. */
+    std::vector<name> m_deps;
+    batch_declaration(declaration const & d):m_decl(d) {}
+    batch_declaration(declaration const & d, std::vector<name> const & deps):m_decl(d), m_deps(deps) {}
+};
+
+struct batch_check_result {
+    name            m_name;
+    bool            m_ok = false;
+    /* error message when \c m_ok is false */
+    std::string     m_error;
+    /* time spent type checking the declaration */
+    second_duration m_time = second_duration(0);
+};
+
+typedef std::function<environment(environment const &, certified_declaration const &)> batch_add_fn;
+
+/** \brief Type check the declarations \c decls, and add them (in order) to \c env using \c add.
+
+    The types are checked sequentially, but the values are checked in parallel on the task queue
+    (when one has been set), as soon as the values of their dependencies have been checked.
+    The type checkers share the kernel cache of inferred types and weak head normal forms.
+    A declaration fails if it is type incorrect or if one of its dependencies failed,
+    and the other declarations are still checked.
+
+    \c results is set to the results of the declarations (in the same order), and the function
+    returns the environment containing the declarations preceding the first failure. */
+environment check_batch(environment const & env, std::vector<batch_declaration> const & decls,
+                        std::vector<batch_check_result> & results, batch_add_fn const & add);
+environment check_batch(environment const & env, std::vector<batch_declaration> const & decls,
+                        std::vector<batch_check_result> & results);
+}
@@ -0,0 +1,173 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include "util/thread.h"
+#include "util/name_map.h"
+#include "kernel/delta_hints.h"
+
+#ifndef LEAN_DELTA_HINT_MIN_FAILURES
+#define LEAN_DELTA_HINT_MIN_FAILURES 16
+#endif
+
+namespace lean {
+/* statistics of the type checkers created for the environments that share this object, see reset_delta_stats */
+struct module_delta_stats {
+    mutex       m_mutex;
+    delta_stats m_stats;
+};
+
+struct delta_hints_ext : public environment_extension {
+    name_map<delta_hint>                m_hints;
+    std::shared_ptr<module_delta_stats> m_stats;
+};
+
+struct delta_hints_ext_reg {
+    unsigned m_ext_id;
+    delta_hints_ext_reg() { m_ext_id = environment::register_extension(std::make_shared<delta_hints_ext>()); }
+};
+
+static delta_hints_ext_reg * g_ext = nullptr;
+
+static delta_hints_ext const & get_extension(environment const & env) {
+    return static_cast<delta_hints_ext const &>(env.get_extension(g_ext->m_ext_id));
+}
+
+static environment update(environment const & env, delta_hints_ext const & ext) {
+    return env.update(g_ext->m_ext_id, std::make_shared<delta_hints_ext>(ext));
+}
+
+delta_hint get_delta_hint(environment const & env, name const & n) {
+    if (auto h = get_extension(env).m_hints.find(n))
+        return *h;
+    return delta_hint();
+}
+
+environment add_delta_hint(environment const & env, name const & n, delta_hint const & h) {
+    delta_hints_ext ext = get_extension(env);
+    delta_hint new_h = h;
+    if (auto old_h = ext.m_hints.find(n)) {
+        new_h.m_priority    += old_h->m_priority;
+        new_h.m_no_self_opt  = new_h.m_no_self_opt || old_h->m_no_self_opt;
+    }
+    ext.m_hints.insert(n, new_h);
+    return update(env, ext);
+}
+
+int compare_delta_hints(environment const & env, name const & n1, name const & n2) {
+    name_map<delta_hint> const & hints = get_extension(env).m_hints;
+    if (hints.empty())
+        return 0;
+    unsigned p1 = 0, p2 = 0;
+    if (auto h = hints.find(n1)) p1 = h->m_priority;
+    if (auto h = hints.find(n2)) p2 = h->m_priority;
+    if (p1 > p2)
+        return -1;
+    else if (p1 < p2)
+        return 1;
+    else
+        return 0;
+}
+
+void delta_stats_entry::merge(delta_stats_entry const & e) {
+    m_unfolds     += e.m_unfolds;
+    m_successes   += e.m_successes;
+    m_failures    += e.m_failures;
+    m_failed_cost += e.m_failed_cost;
+}
+
+delta_hint delta_stats_entry::to_hint() const {
+    /* Comparing the arguments is not worth it if it almost always fails. */
+    bool no_self_opt = m_failures >= LEAN_DELTA_HINT_MIN_FAILURES && 4 * m_successes < m_failures;
+    return delta_hint(m_unfolds, no_self_opt);
+}
+
+static bool          g_delta_stats_enabled = false;
+static mutex *       g_delta_stats_mutex   = nullptr;
+static delta_stats * g_delta_stats         = nullptr;
+
+void enable_delta_stats(bool flag) { g_delta_stats_enabled = flag; }
+bool delta_stats_enabled() { return g_delta_stats_enabled; }
+
+environment reset_delta_stats(environment const & env) {
+    delta_hints_ext ext = get_extension(env);
+    ext.m_stats = std::make_shared<module_delta_stats>();
+    return update(env, ext);
+}
+
+static void merge(delta_stats & s1, delta_stats const & s2) {
+    for (auto const & p : s2)
+        s1[p.first].merge(p.second);
+}
+
+void merge_delta_stats(environment const & env, delta_stats const & s) {
+    if (s.empty())
+        return;
+    if (auto const & m = get_extension(env).m_stats) {
+        lock_guard<mutex> lock(m->m_mutex);
+        merge(m->m_stats, s);
+    }
+    lock_guard<mutex> lock(*g_delta_stats_mutex);
+    merge(*g_delta_stats, s);
+}
+
+static std::vector<std::pair<name, delta_stats_entry>> to_sorted_vector(delta_stats const & s) {
+    std::vector<std::pair<name, delta_stats_entry>> r(s.begin(), s.end());
+    std::sort(r.begin(), r.end(), [](std::pair<name, delta_stats_entry> const & p1,
+                                     std::pair<name, delta_stats_entry> const & p2) {
+                  if (p1.second.m_unfolds != p2.second.m_unfolds)
+                      return p1.second.m_unfolds > p2.second.m_unfolds;
+                  return quick_cmp(p1.first, p2.first) < 0;
+              });
+    return r;
+}
+
+std::vector<std::pair<name, delta_stats_entry>> get_delta_stats() {
+    delta_stats s;
+    {
+        lock_guard<mutex> lock(*g_delta_stats_mutex);
+        s = *g_delta_stats;
+    }
+    return to_sorted_vector(s);
+}
+
+std::vector<std::pair<name, delta_stats_entry>> get_module_delta_stats(environment const & env) {
+    delta_stats s;
+    if (auto const & m = get_extension(env).m_stats) {
+        lock_guard<mutex> lock(m->m_mutex);
+        s = m->m_stats;
+    }
+    return to_sorted_vector(s);
+}
+
+void display_delta_stats(std::ostream & out, unsigned max_entries) {
+    auto stats = get_delta_stats();
+    if (stats.empty())
+        return;
+    out << "lazy delta reduction (unfoldings, self-opt successes/failures, cost of failures):\n";
+    for (unsigned i = 0; i < stats.size() && i < max_entries; i++) {
+        delta_stats_entry const & e = stats[i].second;
+        out << "  " << stats[i].first << " " << e.m_unfolds << " "
+            << e.m_successes << "/" << e.m_failures << " " << e.m_failed_cost << "\n";
+    }
+}
+
+void initialize_delta_hints() {
+    g_ext               = new delta_hints_ext_reg();
+    g_delta_stats_mutex = new mutex();
+    g_delta_stats       = new delta_stats();
+}
+
+void finalize_delta_hints() {
+    delete g_delta_stats;
+    delete g_delta_stats_mutex;
+    delete g_ext;
+}
+}
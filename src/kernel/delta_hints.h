@@ -0,0 +1,68 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#pragma once
+#include <utility>
+#include <vector>
+#include <unordered_map>
+#include "util/name.h"
+#include "util/int64.h"
+#include "kernel/environment.h"
+
+namespace lean {
+/** \brief Unfolding hint for a constant, it is used by the lazy delta reduction of the kernel and
+    \c type_context when the definitional heights of the two sides do not decide which one should be unfolded. */
+struct delta_hint {
+    /* Constants with a higher priority are unfolded first. */
+    unsigned m_priority    = 0;
+    /* When true, the arguments of (f a =?= f b) are not compared before unfolding f
+       (the comparison usually fails for f). */
+    bool     m_no_self_opt = false;
+    delta_hint() {}
+    delta_hint(unsigned p, bool no_self_opt):m_priority(p), m_no_self_opt(no_self_opt) {}
+};
+
+/** \brief Return the hint for \c n, or the default one. */
+delta_hint get_delta_hint(environment const & env, name const & n);
+/** \brief Merge \c h with the hint for \c n stored in \c env (the priorities are added). */
+environment add_delta_hint(environment const & env, name const & n, delta_hint const & h);
+/** \brief Return -1 if the hints say that \c n1 should be unfolded before \c n2, 1 for the converse, and 0 if they do not say anything. */
+int compare_delta_hints(environment const & env, name const & n1, name const & n2);
+
+/** \brief Statistics collected by the lazy delta reduction of the kernel when \c enable_delta_stats is set. */
+struct delta_stats_entry {
+    /* number of times the constant was unfolded */
+    unsigned m_unfolds     = 0;
+    /* number of times the arguments of (f a =?= f b) were definitionally equal */
+    unsigned m_successes   = 0;
+    /* number of times they were not, and the number of unfoldings performed while comparing them */
+    unsigned m_failures    = 0;
+    uint64   m_failed_cost = 0;
+    void merge(delta_stats_entry const & e);
+    delta_hint to_hint() const;
+};
+
+typedef std::unordered_map<name, delta_stats_entry, name_hash> delta_stats;
+
+void enable_delta_stats(bool flag);
+bool delta_stats_enabled();
+/** \brief Return an environment where the statistics collected by the type checkers for it (and for the environments
+    derived from it) are also accumulated in a new table, see \c get_module_delta_stats.
+    It is used to separate the statistics of modules that are compiled in parallel. */
+environment reset_delta_stats(environment const & env);
+/** \brief Add the statistics collected by a type checker for \c env to the global ones,
+    and to the table of \c env (see \c reset_delta_stats). */
+void merge_delta_stats(environment const & env, delta_stats const & s);
+/** \brief Return the global statistics, sorted by decreasing number of unfoldings. */
+std::vector<std::pair<name, delta_stats_entry>> get_delta_stats();
+/** \brief Return the statistics accumulated in the table of \c env (sorted as above),
+    they are used to create the hint table of the module being compiled. */
+std::vector<std::pair<name, delta_stats_entry>> get_module_delta_stats(environment const & env);
+void display_delta_stats(std::ostream & out, unsigned max_entries);
+
+void initialize_delta_hints();
+void finalize_delta_hints();
+}
@@ -205,6 +205,8 @@ class name_generator;
 class certified_declaration {
     friend class certify_unchecked;
     friend certified_declaration check(environment const & env, declaration const & d, bool immediately);
+    friend certified_declaration check_deferred(environment const & env, declaration const & d,
+                                                std::function<void()> & check_value);
     environment_id m_id;
     declaration    m_declaration;
     certified_declaration(environment_id const & id, declaration const & d):m_id(id), m_declaration(d) {}
@@ -16,7 +16,9 @@ Author: Leonardo de Moura
 #include "util/object_serializer.h"
 #include "util/lru_cache.h"
 #include "util/memory_pool.h"
+#include "util/weak_intern_table.h"
 #include "kernel/expr.h"
+#include "kernel/expr_arena.h"
 #include "kernel/expr_eq_fn.h"
 #include "kernel/expr_sets.h"
 #include "kernel/free_vars.h"
@@ -53,7 +55,107 @@ unsigned hash_levels(levels const & ls) {
     return r;
 }
 
+#ifdef LEAN_COMPACT_EXPR
+/* Tags of the cells of the compact representation, a cell has an entry iff bit 4 of its m_flags is set.
+
+   About half of the live composite cells have a tag when the standard library is compiled, so each shard is
+   an open addressing hash table (linear probing) of 16-byte entries. A node based table (e.g., std::unordered_map)
+   needs more memory for each entry than the compact layout saves per cell. */
+class expr_tag_table {
+    struct entry {
+        expr_cell const * m_cell; /* nullptr for empty slots */
+        tag               m_tag;
+    };
+    struct shard {
+        mutex              m_mutex;
+        /* the capacity is zero or a power of two */
+        std::vector<entry> m_entries;
+        unsigned           m_size{0};
+    };
+    shard m_shards[LEAN_NUM_INTERN_TABLE_SHARDS];
+
+    static unsigned hash_cell(expr_cell const * c) { return hash_ptr(c); }
+    shard & get_shard(expr_cell const * c) { return m_shards[hash_cell(c) % LEAN_NUM_INTERN_TABLE_SHARDS]; }
+    /* Slot where the search for \c c starts, the bits used to select the shard are ignored. */
+    static unsigned get_home(shard const & s, expr_cell const * c) {
+        return (hash_cell(c) / LEAN_NUM_INTERN_TABLE_SHARDS) & (s.m_entries.size() - 1);
+    }
+
+    /* Return the slot containing \c c or the empty slot where it should be inserted. \pre capacity > 0 */
+    static unsigned find_slot(shard const & s, expr_cell const * c) {
+        unsigned mask = s.m_entries.size() - 1;
+        unsigned i    = get_home(s, c);
+        while (s.m_entries[i].m_cell && s.m_entries[i].m_cell != c)
+            i = (i + 1) & mask;
+        return i;
+    }
+
+    static void grow(shard & s) {
+        std::vector<entry> old_entries(std::max<size_t>(64, 2 * s.m_entries.size()), entry{nullptr, nulltag});
+        old_entries.swap(s.m_entries);
+        for (entry const & e : old_entries) {
+            if (e.m_cell)
+                s.m_entries[find_slot(s, e.m_cell)] = e;
+        }
+    }
+
+public:
+    tag find(expr_cell const * c) {
+        shard & s = get_shard(c);
+        lock_guard<mutex> lock(s.m_mutex);
+        if (s.m_entries.empty())
+            return nulltag;
+        entry const & e = s.m_entries[find_slot(s, c)];
+        return e.m_cell ? e.m_tag : nulltag;
+    }
+
+    void insert(expr_cell const * c, tag t) {
+        shard & s = get_shard(c);
+        lock_guard<mutex> lock(s.m_mutex);
+        /* maximum load factor is 3/4 */
+        if (4 * (s.m_size + 1) > 3 * s.m_entries.size())
+            grow(s);
+        entry & e = s.m_entries[find_slot(s, c)];
+        if (!e.m_cell) {
+            e.m_cell = c;
+            s.m_size++;
+        }
+        e.m_tag = t;
+    }
+
+    void erase(expr_cell const * c) {
+        shard & s = get_shard(c);
+        lock_guard<mutex> lock(s.m_mutex);
+        if (s.m_entries.empty())
+            return;
+        unsigned mask = s.m_entries.size() - 1;
+        unsigned i    = find_slot(s, c);
+        if (!s.m_entries[i].m_cell)
+            return;
+        /* Backward shift deletion: move back the entries of the cluster that would not be found after
+           the slot i becomes empty. */
+        unsigned j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (!s.m_entries[j].m_cell)
+                break;
+            unsigned k = get_home(s, s.m_entries[j].m_cell);
+            /* the entry at j can be moved to i iff its home slot is not in the cyclic interval (i, j] */
+            bool in_between = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+            if (!in_between) {
+                s.m_entries[i] = s.m_entries[j];
+                i = j;
+            }
+        }
+        s.m_entries[i].m_cell = nullptr;
+        s.m_size--;
+    }
+};
+static expr_tag_table * g_expr_tag_table = nullptr;
+static_assert(sizeof(void *) != 8 || sizeof(expr_app) == 32, "unexpected size of compact application cells"); // NOLINT
+#else
 LEAN_THREAD_VALUE(unsigned, g_hash_alloc_counter, 0);
+#endif
 
 #ifdef LEAN_TRACK_LIVE_EXPRS
 static atomic<unsigned> g_num_live_exprs(0);
@@ -70,6 +172,13 @@ expr_cell::expr_cell(expr_kind k, unsigned h, bool has_expr_mv, bool has_univ_mv
     m_has_univ_mv(has_univ_mv),
     m_has_local(has_local),
     m_has_param_univ(has_param_univ),
+#ifdef LEAN_COMPACT_EXPR
+    m_free_var_range(0),
+    m_hash(h),
+    m_rc(0) {
+    if (g != nulltag)
+        set_tag(g);
+#else
     m_hash(h),
     m_tag(g),
     m_rc(0) {
@@ -81,6 +190,7 @@ expr_cell::expr_cell(expr_kind k, unsigned h, bool has_expr_mv, bool has_univ_mv
     //    - the hash is not diverse enough
     m_hash_alloc = g_hash_alloc_counter;
     g_hash_alloc_counter++;
+#endif
     #ifdef LEAN_TRACK_LIVE_EXPRS
     atomic_fetch_add_explicit(&g_num_live_exprs, 1u, memory_order_release);
     #endif
@@ -114,14 +224,37 @@ void expr_cell::set_is_arrow(bool flag) {
     lean_assert(is_arrow() && *is_arrow() == flag);
 }
 
+#ifdef LEAN_COMPACT_EXPR
+void expr_cell::set_tag(tag t) {
+    if (t == nulltag && (m_flags & 16) == 0)
+        return;
+    g_expr_tag_table->insert(this, t);
+    m_flags |= 16;
+}
+
+tag expr_cell::get_tag() const {
+    if ((m_flags & 16) == 0)
+        return nulltag;
+    return g_expr_tag_table->find(this);
+}
+#else
 void expr_cell::set_tag(tag t) {
     m_tag = t;
 }
+#endif
 
 bool is_meta(expr const & e) {
     return is_metavar(get_app_fn(e));
 }
 
+/* Return the memory of a destroyed cell to the arena or memory pool it was allocated from. */
+static inline void recycle_cell(memory_pool & pool, void * mem, bool arena) {
+    if (LEAN_UNLIKELY(arena))
+        expr_arena_recycle(mem);
+    else
+        pool.recycle(mem);
+}
+
 // Expr variables
 DEF_THREAD_MEMORY_POOL(get_var_allocator, sizeof(expr_var));
 expr_var::expr_var(unsigned idx, tag g):
@@ -131,8 +264,9 @@ expr_var::expr_var(unsigned idx, tag g):
         throw exception("invalid free variable index, de Bruijn index is too big");
 }
 void expr_var::dealloc() {
+    bool arena = is_arena_cell();
     this->~expr_var();
-    get_var_allocator().recycle(this);
+    recycle_cell(get_var_allocator(), this, arena);
 }
 
 // Expr constants
@@ -144,8 +278,9 @@ expr_const::expr_const(name const & n, levels const & ls, tag g):
     m_levels(ls) {
 }
 void expr_const::dealloc() {
+    bool arena = is_arena_cell();
     this->~expr_const();
-    get_const_allocator().recycle(this);
+    recycle_cell(get_const_allocator(), this, arena);
 }
 
 unsigned binder_info::hash() const {
@@ -162,8 +297,9 @@ expr_mlocal::expr_mlocal(bool is_meta, name const & n, expr const & t, tag g):
     m_type(t) {}
 void expr_mlocal::dealloc(buffer<expr_cell*> & todelete) {
     dec_ref(m_type, todelete);
+    bool arena = is_arena_cell();
     this->~expr_mlocal();
-    get_mlocal_allocator().recycle(this);
+    recycle_cell(get_mlocal_allocator(), this, arena);
 }
 
 DEF_THREAD_MEMORY_POOL(get_local_allocator, sizeof(expr_local));
@@ -173,17 +309,24 @@ expr_local::expr_local(name const & n, name const & pp_name, expr const & t, bin
     m_bi(bi) {}
 void expr_local::dealloc(buffer<expr_cell*> & todelete) {
     dec_ref(m_type, todelete);
+    bool arena = is_arena_cell();
     this->~expr_local();
-    get_local_allocator().recycle(this);
+    recycle_cell(get_local_allocator(), this, arena);
 }
 
 // Composite expressions
 expr_composite::expr_composite(expr_kind k, unsigned h, bool has_expr_mv, bool has_univ_mv,
                                bool has_local, bool has_param_univ, unsigned w, unsigned fv_range, tag g):
     expr_cell(k, h, has_expr_mv, has_univ_mv, has_local, has_param_univ, g),
+#ifdef LEAN_COMPACT_EXPR
+    m_weight(w) {
+    m_free_var_range = std::min(fv_range, LEAN_MAX_COMPACT_FREE_VAR_RANGE);
+}
+#else
     m_weight(w),
     m_depth(0),
     m_free_var_range(fv_range) {}
+#endif
 
 // Expr applications
 DEF_THREAD_MEMORY_POOL(get_app_allocator, sizeof(expr_app));
@@ -197,18 +340,26 @@ expr_app::expr_app(expr const & fn, expr const & arg, tag g):
                    std::max(get_free_var_range(fn), get_free_var_range(arg)),
                    g),
     m_fn(fn), m_arg(arg) {
-    m_depth = std::max(get_depth(fn), get_depth(arg)) + 1;
     m_hash  = ::lean::hash(m_hash, m_weight);
+#ifndef LEAN_COMPACT_EXPR
+    m_depth = std::max(get_depth(fn), get_depth(arg)) + 1;
     m_hash  = ::lean::hash(m_hash, m_depth);
+#endif
 }
 void expr_app::dealloc(buffer<expr_cell*> & todelete) {
     dec_ref(m_fn, todelete);
     dec_ref(m_arg, todelete);
+    bool arena = is_arena_cell();
     this->~expr_app();
-    get_app_allocator().recycle(this);
+    recycle_cell(get_app_allocator(), this, arena);
 }
 
+#ifdef LEAN_COMPACT_EXPR
+/* A saturated free variable range is only an upper bound, it must not be decremented. */
+static unsigned dec(unsigned k) { return k == 0 || k >= LEAN_MAX_COMPACT_FREE_VAR_RANGE ? k : k - 1; }
+#else
 static unsigned dec(unsigned k) { return k == 0 ? 0 : k - 1; }
+#endif
 
 bool operator==(binder_info const & i1, binder_info const & i2) {
     return
@@ -231,16 +382,19 @@ expr_binding::expr_binding(expr_kind k, name const & n, expr const & t, expr con
                    g),
     m_binder(n, t, i),
     m_body(b) {
-    m_depth = std::max(get_depth(t), get_depth(b)) + 1;
     m_hash  = ::lean::hash(m_hash, m_weight);
+#ifndef LEAN_COMPACT_EXPR
+    m_depth = std::max(get_depth(t), get_depth(b)) + 1;
     m_hash  = ::lean::hash(m_hash, m_depth);
+#endif
     lean_assert(k == expr_kind::Lambda || k == expr_kind::Pi);
 }
 void expr_binding::dealloc(buffer<expr_cell*> & todelete) {
     dec_ref(m_body, todelete);
     dec_ref(m_binder.m_type, todelete);
+    bool arena = is_arena_cell();
     this->~expr_binding();
-    get_binding_allocator().recycle(this);
+    recycle_cell(get_binding_allocator(), this, arena);
 }
 
 // Expr Sort
@@ -251,8 +405,9 @@ expr_sort::expr_sort(level const & l, tag g):
 }
 expr_sort::~expr_sort() {}
 void expr_sort::dealloc() {
+    bool arena = is_arena_cell();
     this->~expr_sort();
-    get_sort_allocator().recycle(this);
+    recycle_cell(get_sort_allocator(), this, arena);
 }
 
 // Let expressions
@@ -268,16 +423,19 @@ expr_let::expr_let(name const & n, expr const & t, expr const & v, expr const &
                    std::max(std::max(get_free_var_range(t), get_free_var_range(v)), dec(get_free_var_range(b))),
                    g),
     m_name(n), m_type(t), m_value(v), m_body(b) {
-    m_depth = std::max(get_depth(t), std::max(get_depth(v), get_depth(b))) + 1;
     m_hash  = ::lean::hash(m_hash, m_weight);
+#ifndef LEAN_COMPACT_EXPR
+    m_depth = std::max(get_depth(t), std::max(get_depth(v), get_depth(b))) + 1;
     m_hash  = ::lean::hash(m_hash, m_depth);
+#endif
 }
 void expr_let::dealloc(buffer<expr_cell*> & todelete) {
     dec_ref(m_body,  todelete);
     dec_ref(m_value, todelete);
     dec_ref(m_type,  todelete);
+    bool arena = is_arena_cell();
     this->~expr_let();
-    get_let_allocator().recycle(this);
+    recycle_cell(get_let_allocator(), this, arena);
 }
 
 // Macro definition
@@ -331,6 +489,7 @@ expr_macro::expr_macro(macro_definition const & m, unsigned num, expr const * ar
     m_definition(m),
     m_num_args(num) {
     expr * data = get_args_ptr();
+#ifndef LEAN_COMPACT_EXPR
     m_depth = 0;
     for (unsigned i = 0; i < num; i++) {
         unsigned d = get_depth(args[i]);
@@ -338,6 +497,7 @@ expr_macro::expr_macro(macro_definition const & m, unsigned num, expr const * ar
             m_depth = d;
     }
     m_depth++;
+#endif
     std::uninitialized_copy(args, args + num, data);
 }
 void expr_macro::dealloc(buffer<expr_cell*> & todelete) {
@@ -382,6 +542,96 @@ bool enable_expr_caching(bool f) {
 bool is_cached(expr const & e) {
     return get_expr_cache().find(e) != get_expr_cache().end();
 }
+
+/* Equality used by the global hash-consing table. The children of the expressions in the table are
+   usually in the table too, so we compare them using pointer equality. Moreover, binder names are
+   taken into account, otherwise expressions would be pretty printed using the binder names of another one. */
+struct is_shallow_equal_proc {
+    bool operator()(expr const & a, expr const & b) const {
+        if (is_eqp(a, b))                 return true;
+        if (a.kind() != b.kind())         return false;
+        switch (a.kind()) {
+        case expr_kind::Var:
+            return var_idx(a) == var_idx(b);
+        case expr_kind::Sort:
+            return sort_level(a) == sort_level(b);
+        case expr_kind::Constant:
+            return const_name(a) == const_name(b) && const_levels(a) == const_levels(b);
+        case expr_kind::Meta: case expr_kind::Local:
+            return false;
+        case expr_kind::App:
+            return is_eqp(app_fn(a), app_fn(b)) && is_eqp(app_arg(a), app_arg(b));
+        case expr_kind::Lambda: case expr_kind::Pi:
+            return
+                is_eqp(binding_domain(a), binding_domain(b)) && is_eqp(binding_body(a), binding_body(b)) &&
+                binding_name(a) == binding_name(b) && binding_info(a) == binding_info(b);
+        case expr_kind::Let:
+            return
+                is_eqp(let_type(a), let_type(b)) && is_eqp(let_value(a), let_value(b)) &&
+                is_eqp(let_body(a), let_body(b)) && let_name(a) == let_name(b);
+        case expr_kind::Macro:
+            if (macro_def(a) != macro_def(b) || macro_num_args(a) != macro_num_args(b))
+                return false;
+            for (unsigned i = 0; i < macro_num_args(a); i++) {
+                if (!is_eqp(macro_arg(a, i), macro_arg(b, i)))
+                    return false;
+            }
+            return true;
+        }
+        lean_unreachable();
+    }
+};
+
+typedef weak_intern_table<expr, expr_cell, is_shallow_equal_proc> expr_intern_table;
+static expr_intern_table * g_expr_intern_table = nullptr;
+
+void enable_expr_interning() {
+    enable_level_interning();
+    if (!g_expr_intern_table)
+        g_expr_intern_table = new expr_intern_table();
+}
+
+bool is_expr_interning_enabled() {
+    return g_expr_intern_table != nullptr;
+}
+
+LEAN_THREAD_VALUE(bool, g_expr_interning_in_thread, true);
+
+bool enable_expr_interning_in_thread(bool f) {
+    bool r = g_expr_interning_in_thread;
+    g_expr_interning_in_thread = f;
+    return r;
+}
+
+intern_table_stats get_expr_interning_stats() {
+    return g_expr_intern_table ? g_expr_intern_table->get_stats() : intern_table_stats();
+}
+
+/* Allocate a cell of type \c T in the current arena (see expr_arena_scope), or using \c pool otherwise. */
+template<typename T, typename... Args>
+inline T * new_cell(memory_pool & pool, Args &&... args) {
+    if (LEAN_UNLIKELY(in_expr_arena())) {
+        T * r = new (expr_arena_allocate(sizeof(T))) T(std::forward<Args>(args)...);
+        r->set_arena_cell();
+        return r;
+    }
+    return new (pool.allocate()) T(std::forward<Args>(args)...);
+}
+
+/* Arena cells are short-lived, they are not hash-consed. */
+inline expr cache_pool_cell(expr const & e) {
+    return e.raw()->is_arena_cell() ? e : cache(e);
+}
+
+/* Use the global hash-consing table if it is enabled, and the thread local cache otherwise.
+   \c sz is the size of the cell of \c e. */
+inline expr intern(expr const & e, unsigned sz) {
+    if (e.raw()->is_arena_cell())
+        return e;
+    if (LEAN_UNLIKELY(g_expr_intern_table != nullptr) && g_expr_interning_in_thread && e.get_tag() == nulltag)
+        return g_expr_intern_table->intern(e, e.raw(), e.hash(), sz, [](expr_cell * c) { c->set_interned(); });
+    return cache(e);
+}
 void flush_expr_cache() {
     flush_level_cache();
     expr_cache new_cache;
@@ -390,32 +640,33 @@ void flush_expr_cache() {
     clear_instantiate_cache();
 }
 expr mk_var(unsigned idx, tag g) {
-    return cache(expr(new (get_var_allocator().allocate()) expr_var(idx, g)));
+    return intern(expr(new_cell<expr_var>(get_var_allocator(), idx, g)), sizeof(expr_var));
 }
 expr mk_constant(name const & n, levels const & ls, tag g) {
-    return cache(expr(new (get_const_allocator().allocate()) expr_const(n, ls, g)));
+    return intern(expr(new_cell<expr_const>(get_const_allocator(), n, ls, g)), sizeof(expr_const));
 }
 expr mk_macro(macro_definition const & m, unsigned num, expr const * args, tag g) {
-    char * mem = new char[sizeof(expr_macro) + num*sizeof(expr const *)];
-    return cache(expr(new (mem) expr_macro(m, num, args, g)));
+    unsigned sz = sizeof(expr_macro) + num*sizeof(expr const *);
+    char * mem = new char[sz];
+    return intern(expr(new (mem) expr_macro(m, num, args, g)), sz);
 }
 expr mk_metavar(name const & n, expr const & t, tag g) {
-    return cache(expr(new (get_mlocal_allocator().allocate()) expr_mlocal(true, n, t, g)));
+    return cache_pool_cell(expr(new_cell<expr_mlocal>(get_mlocal_allocator(), true, n, t, g)));
 }
 expr mk_local(name const & n, name const & pp_n, expr const & t, binder_info const & bi, tag g) {
-    return cache(expr(new (get_local_allocator().allocate()) expr_local(n, pp_n, t, bi, g)));
+    return cache_pool_cell(expr(new_cell<expr_local>(get_local_allocator(), n, pp_n, t, bi, g)));
 }
 expr mk_app(expr const & f, expr const & a, tag g) {
-    return cache(expr(new (get_app_allocator().allocate()) expr_app(f, a, g)));
+    return intern(expr(new_cell<expr_app>(get_app_allocator(), f, a, g)), sizeof(expr_app));
 }
 expr mk_binding(expr_kind k, name const & n, expr const & t, expr const & e, binder_info const & i, tag g) {
-    return cache(expr(new (get_binding_allocator().allocate()) expr_binding(k, n, t, e, i, g)));
+    return intern(expr(new_cell<expr_binding>(get_binding_allocator(), k, n, t, e, i, g)), sizeof(expr_binding));
 }
 expr mk_let(name const & n, expr const & t, expr const & v, expr const & b, tag g) {
-    return cache(expr(new (get_let_allocator().allocate()) expr_let(n, t, v, b, g)));
+    return intern(expr(new_cell<expr_let>(get_let_allocator(), n, t, v, b, g)), sizeof(expr_let));
 }
 expr mk_sort(level const & l, tag g) {
-    return cache(expr(new (get_sort_allocator().allocate()) expr_sort(l, g)));
+    return intern(expr(new_cell<expr_sort>(get_sort_allocator(), l, g)), sizeof(expr_sort));
 }
 // =======================================
 
@@ -431,6 +682,12 @@ void expr_cell::dealloc() {
             atomic_fetch_sub_explicit(&g_num_live_exprs, 1u, memory_order_release);
             #endif
             lean_assert(it->get_rc() == 0);
+            if (it->is_interned() && g_expr_intern_table)
+                g_expr_intern_table->erase(it, it->hash());
+#ifdef LEAN_COMPACT_EXPR
+            if ((it->m_flags & 16) && g_expr_tag_table)
+                g_expr_tag_table->erase(it);
+#endif
             switch (it->kind()) {
             case expr_kind::Var:        static_cast<expr_var*>(it)->dealloc(); break;
             case expr_kind::Macro:      static_cast<expr_macro*>(it)->dealloc(todo); break;
@@ -573,6 +830,7 @@ unsigned get_weight(expr const & e) {
     lean_unreachable(); // LCOV_EXCL_LINE
 }
 
+#ifndef LEAN_COMPACT_EXPR
 unsigned get_depth(expr const & e) {
     switch (e.kind()) {
     case expr_kind::Var:  case expr_kind::Constant: case expr_kind::Sort:
@@ -584,6 +842,33 @@ unsigned get_depth(expr const & e) {
     }
     lean_unreachable(); // LCOV_EXCL_LINE
 }
+#endif
+
+/* Return a fresh cell with tag \c t that is structurally equal to \c e. */
+static expr mk_tagged_copy(expr const & e, tag t) {
+    scoped_expr_caching scope(false);
+    switch (e.kind()) {
+    case expr_kind::Var:      return mk_var(var_idx(e), t);
+    case expr_kind::Constant: return mk_constant(const_name(e), const_levels(e), t);
+    case expr_kind::Sort:     return mk_sort(sort_level(e), t);
+    case expr_kind::Macro:    return mk_macro(macro_def(e), macro_num_args(e), macro_args(e), t);
+    case expr_kind::App:      return mk_app(app_fn(e), app_arg(e), t);
+    case expr_kind::Lambda:   case expr_kind::Pi:
+        return mk_binding(e.kind(), binding_name(e), binding_domain(e), binding_body(e), binding_info(e), t);
+    case expr_kind::Meta:     return mk_metavar(mlocal_name(e), mlocal_type(e), t);
+    case expr_kind::Local:    return mk_local(mlocal_name(e), local_pp_name(e), mlocal_type(e), local_info(e), t);
+    case expr_kind::Let:      return mk_let(let_name(e), let_type(e), let_value(e), let_body(e), t);
+    }
+    lean_unreachable(); // LCOV_EXCL_LINE
+}
+
+expr expr::set_tag(tag t) {
+    if (LEAN_UNLIKELY(m_ptr->is_interned()))
+        *this = mk_tagged_copy(*this, t);
+    else
+        m_ptr->set_tag(t);
+    return *this;
+}
 
 expr copy_tag(expr const & e, expr && new_e) {
     tag t = e.get_tag();
@@ -773,6 +1058,9 @@ std::ostream & operator<<(std::ostream & out, expr_kind const & k) {
 }
 
 void initialize_expr() {
+#ifdef LEAN_COMPACT_EXPR
+    g_expr_tag_table = new expr_tag_table();
+#endif
     g_dummy        = new expr(mk_constant("__expr_for_default_constructor__"));
     g_default_name = new name("a");
     g_Type1        = new expr(mk_sort(mk_level_one()));
@@ -784,5 +1072,12 @@ void finalize_expr() {
     delete g_Type1;
     delete g_dummy;
     delete g_default_name;
+    /* The remaining interned expressions are not removed from the table anymore when they are deallocated. */
+    delete g_expr_intern_table;
+    g_expr_intern_table = nullptr;
+#ifdef LEAN_COMPACT_EXPR
+    delete g_expr_tag_table;
+    g_expr_tag_table = nullptr;
+#endif
 }
 }
@@ -32,6 +32,10 @@ class abstract_type_context;
 typedef unsigned tag;
 constexpr tag nulltag = std::numeric_limits<unsigned>::max();
 class expr;
+
+#ifdef LEAN_COMPACT_EXPR
+#define LEAN_MAX_COMPACT_FREE_VAR_RANGE 0xFFFFu
+#endif
 /* =======================================
    Expressions
    expr ::=   Var           idx
@@ -50,16 +54,32 @@ class expr_cell {
 protected:
     // The bits of the following field mean:
     //    0-1  - term is an arrow (0 - not initialized, 1 - is arrow, 2 - is not arrow)
+    //    2    - term is in the global hash-consing table (see enable_expr_interning)
+    //    3    - cell was allocated in an arena (see expr_arena_scope)
+    //    4    - cell has an entry in the tag table (LEAN_COMPACT_EXPR only)
     // Remark: we use atomic_uchar because these flags are computed lazily (i.e., after the expression is created)
     atomic_uchar       m_flags;
+#ifdef LEAN_COMPACT_EXPR
+    // In the compact representation, the kind, the flags below and the free variable range share
+    // the word of m_flags, the allocation hash is derived from the address of the cell, and the tags
+    // (which are nulltag for most cells) are stored in a side table.
+    // Then, the header of composite cells takes 16 bytes (e.g., sizeof(expr_app) == 32 on 64-bit platforms).
+    unsigned           m_kind:4;
+#else
     unsigned           m_kind:8;
+#endif
     unsigned           m_has_expr_mv:1;    // term contains expression metavariables
     unsigned           m_has_univ_mv:1;    // term contains universe metavariables
     unsigned           m_has_local:1;      // term contains local constants
     unsigned           m_has_param_univ:1; // term constains parametric universe levels
+#ifdef LEAN_COMPACT_EXPR
+    unsigned           m_free_var_range:16; // see expr_composite, saturated at LEAN_MAX_COMPACT_FREE_VAR_RANGE
+#endif
     unsigned           m_hash;             // hash based on the structure of the expression (this is a good hash for structural equality)
+#ifndef LEAN_COMPACT_EXPR
     unsigned           m_hash_alloc;       // hash based on 'time' of allocation (this is a good hash for pointer-based equality)
     atomic_uint        m_tag;
+#endif
     MK_LEAN_RC(); // Declare m_rc counter
     void dealloc();
 
@@ -72,19 +92,32 @@ public:
     expr_cell(expr_kind k, unsigned h, bool has_expr_mv, bool has_univ_mv, bool has_local, bool has_param_univ, tag g);
     expr_kind kind() const { return static_cast<expr_kind>(m_kind); }
     unsigned  hash() const { return m_hash; }
+#ifdef LEAN_COMPACT_EXPR
+    unsigned  hash_alloc() const { return hash_ptr(this); }
+#else
     unsigned  hash_alloc() const { return m_hash_alloc; }
+#endif
     bool has_expr_metavar() const { return m_has_expr_mv; }
     bool has_univ_metavar() const { return m_has_univ_mv; }
     bool has_local() const { return m_has_local; }
     bool has_param_univ() const { return m_has_param_univ; }
     void set_tag(tag t);
+#ifdef LEAN_COMPACT_EXPR
+    tag get_tag() const;
+#else
     tag get_tag() const { return m_tag; }
+#endif
+    bool is_interned() const { return (m_flags & 4) != 0; }
+    void set_interned() { m_flags |= 4; }
+    bool is_arena_cell() const { return (m_flags & 8) != 0; }
+    void set_arena_cell() { m_flags |= 8; }
 };
 
 typedef expr_cell * expr_ptr;
 
 class macro_definition;
 class binder_info;
+template<typename Ref, typename Cell, typename Eq> class weak_intern_table;
 
 /**
    \brief Exprs for encoding formulas/expressions, types and proofs.
@@ -94,6 +127,7 @@ private:
     expr_cell * m_ptr;
     explicit expr(expr_cell * ptr):m_ptr(ptr) { if (m_ptr) m_ptr->inc_ref(); }
     friend class expr_cell;
+    template<typename Ref, typename Cell, typename Eq> friend class weak_intern_table;
     expr_cell * steal_ptr() { expr_cell * r = m_ptr; m_ptr = nullptr; return r; }
     friend class optional<expr>;
 public:
@@ -124,7 +158,9 @@ public:
     bool has_local() const { return m_ptr->has_local(); }
     bool has_param_univ() const { return m_ptr->has_param_univ(); }
 
-    expr set_tag(tag t) { m_ptr->set_tag(t); return *this; }
+    /** \brief Set the tag of this expression. If the cell is in the global hash-consing table, then
+        this reference is replaced with a fresh copy, since the cell may be shared by unrelated terms. */
+    expr set_tag(tag t);
     tag get_tag() const { return m_ptr->get_tag(); }
 
     operator expr_ptr() const { return m_ptr; }
@@ -182,10 +218,12 @@ public:
 class expr_composite : public expr_cell {
 protected:
     unsigned m_weight;
+#ifndef LEAN_COMPACT_EXPR
     unsigned m_depth;
     unsigned m_free_var_range;
-    friend unsigned get_weight(expr const & e);
     friend unsigned get_depth(expr const & e);
+#endif
+    friend unsigned get_weight(expr const & e);
     friend unsigned get_free_var_range(expr const & e);
 public:
     expr_composite(expr_kind k, unsigned h, bool has_expr_mv, bool has_univ_mv, bool has_local,
@@ -512,6 +550,24 @@ struct scoped_expr_caching {
 /** \brief Return true iff \c e is in the cache */
 bool is_cached(expr const & e);
 void flush_expr_cache();
+
+/** \brief Enable the hash-consing table shared by all threads for expressions (and universe levels).
+    Afterwards, structurally equal expressions without position information are represented by the same cell,
+    independently of the thread (and module) that created them. Local constants and metavariables are not shared.
+    The table does not keep expressions alive.
+    \remark This function must be invoked before other threads are created, and interning cannot be disabled. */
+void enable_expr_interning();
+bool is_expr_interning_enabled();
+/** \brief Enable/disable the hash-consing table in the current thread. It is enabled by default.
+    The parser disables it, because it tags the cells it creates with position information. */
+bool enable_expr_interning_in_thread(bool f);
+/** \brief Helper class for temporarily enabling/disabling the hash-consing table in the current thread */
+struct scoped_expr_interning {
+    bool m_old;
+    scoped_expr_interning(bool f) { m_old = enable_expr_interning_in_thread(f); }
+    ~scoped_expr_interning() { enable_expr_interning_in_thread(m_old); }
+};
+intern_table_stats get_expr_interning_stats();
 // =======================================
 
 // =======================================
@@ -570,10 +626,15 @@ optional<expr> has_expr_metavar_strict(expr const & e);
 inline bool has_local(expr const & e) { return e.has_local(); }
 inline bool has_param_univ(expr const & e) { return e.has_param_univ(); }
 unsigned get_weight(expr const & e);
+#ifndef LEAN_COMPACT_EXPR
 unsigned get_depth(expr const & e);
+#endif
 /**
    \brief Return \c R s.t. the de Bruijn index of all free variables
    occurring in \c e is in the interval <tt>[0, R)</tt>.
+
+   \remark In the compact representation, the result is only an upper bound when it is
+   greater than or equal to LEAN_MAX_COMPACT_FREE_VAR_RANGE.
 */
 inline unsigned get_free_var_range(expr const & e) {
     switch (e.kind()) {
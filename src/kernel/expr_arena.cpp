@@ -0,0 +1,203 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+#include <unordered_map>
+#include "util/thread.h"
+#include "util/flet.h"
+#include "util/buffer.h"
+#include "kernel/expr_arena.h"
+
+#ifndef LEAN_EXPR_ARENA_CHUNK_SIZE
+#define LEAN_EXPR_ARENA_CHUNK_SIZE (64*1024)
+#endif
+
+namespace lean {
+static bool g_expr_arenas = false;
+
+void enable_expr_arenas(bool flag) { g_expr_arenas = flag; }
+bool expr_arenas_enabled() { return g_expr_arenas; }
+
+/* Chunks are aligned to their size, the chunk of a cell is obtained by masking its address.
+
+   m_count starts at CHUNK_BIAS, and it is decremented whenever a cell is deallocated (by any thread).
+   When the owner thread stops allocating from the chunk, it retires it by subtracting
+   <tt>CHUNK_BIAS - m_num_allocated</tt>. Then, m_count is the number of live cells,
+   and the chunk is released by whoever brings m_count to zero. */
+static constexpr unsigned CHUNK_BIAS = 1u << 30;
+
+struct expr_arena_chunk {
+    atomic<unsigned> m_count;
+    unsigned         m_num_allocated; /* only accessed by the owner thread */
+    char *           m_next;
+    char * begin() { return reinterpret_cast<char *>(this) + ((sizeof(expr_arena_chunk) + 7) & ~7u); }
+    char * end() { return reinterpret_cast<char *>(this) + LEAN_EXPR_ARENA_CHUNK_SIZE; }
+};
+
+static expr_arena_chunk * get_chunk(void * p) {
+    return reinterpret_cast<expr_arena_chunk *>(reinterpret_cast<std::uintptr_t>(p) &
+                                                ~static_cast<std::uintptr_t>(LEAN_EXPR_ARENA_CHUNK_SIZE - 1));
+}
+
+static expr_arena_chunk * alloc_chunk() {
+    void * mem;
+#if defined(LEAN_WINDOWS)
+    mem = _aligned_malloc(LEAN_EXPR_ARENA_CHUNK_SIZE, LEAN_EXPR_ARENA_CHUNK_SIZE);
+    if (!mem) throw std::bad_alloc();
+#else
+    if (posix_memalign(&mem, LEAN_EXPR_ARENA_CHUNK_SIZE, LEAN_EXPR_ARENA_CHUNK_SIZE) != 0)
+        throw std::bad_alloc();
+#endif
+    expr_arena_chunk * c = new (mem) expr_arena_chunk();
+    c->m_count.store(CHUNK_BIAS);
+    c->m_num_allocated = 0;
+    c->m_next          = c->begin();
+    return c;
+}
+
+static void free_chunk(expr_arena_chunk * c) {
+    c->~expr_arena_chunk();
+#if defined(LEAN_WINDOWS)
+    _aligned_free(c);
+#else
+    free(c);
+#endif
+}
+
+static void retire_chunk(expr_arena_chunk * c) {
+    unsigned d = CHUNK_BIAS - c->m_num_allocated;
+    if (atomic_fetch_sub_explicit(&c->m_count, d, memory_order_seq_cst) == d)
+        free_chunk(c);
+}
+
+LEAN_THREAD_VALUE(unsigned, g_arena_depth, 0);
+LEAN_THREAD_PTR(expr_arena_chunk, g_arena_chunk);
+
+static void finalize_arena_chunk(void *) { // NOLINT
+    if (g_arena_chunk) {
+        retire_chunk(g_arena_chunk);
+        g_arena_chunk = nullptr;
+    }
+}
+
+bool in_expr_arena() {
+    return g_arena_depth > 0;
+}
+
+void * expr_arena_allocate(unsigned sz) {
+    sz = (sz + 7) & ~7u;
+    expr_arena_chunk * c = g_arena_chunk;
+    if (!c || c->m_next + sz > c->end()) {
+        if (c)
+            retire_chunk(c);
+        else
+            register_thread_finalizer(finalize_arena_chunk, nullptr);
+        c = alloc_chunk();
+        g_arena_chunk = c;
+    }
+    void * r = c->m_next;
+    c->m_next += sz;
+    c->m_num_allocated++;
+    return r;
+}
+
+void expr_arena_recycle(void * p) {
+    expr_arena_chunk * c = get_chunk(p);
+    if (atomic_fetch_sub_explicit(&c->m_count, 1u, memory_order_seq_cst) == 1)
+        free_chunk(c);
+}
+
+expr_arena_scope::expr_arena_scope():m_active(g_expr_arenas) {
+    if (m_active)
+        g_arena_depth++;
+}
+
+expr_arena_scope::~expr_arena_scope() {
+    if (!m_active)
+        return;
+    g_arena_depth--;
+    if (g_arena_depth > 0 || !g_arena_chunk)
+        return;
+    expr_arena_chunk * c = g_arena_chunk;
+    if (atomic_load(&c->m_count) == CHUNK_BIAS - c->m_num_allocated) {
+        /* all cells are dead, the chunk can be reused */
+        c->m_count.store(CHUNK_BIAS);
+        c->m_num_allocated = 0;
+        c->m_next          = c->begin();
+    } else {
+        retire_chunk(c);
+        g_arena_chunk = nullptr;
+    }
+}
+
+class copy_out_of_arena_fn {
+    std::unordered_map<expr_cell *, expr> m_cache;
+
+    expr copy(expr const & e) {
+        /* macros are never allocated in arenas, but their arguments may be */
+        if (!e.raw()->is_arena_cell() && !is_macro(e))
+            return e;
+        auto it = m_cache.find(e.raw());
+        if (it != m_cache.end())
+            return it->second;
+        expr r;
+        switch (e.kind()) {
+        case expr_kind::Var:
+            r = mk_var(var_idx(e), e.get_tag());
+            break;
+        case expr_kind::Sort:
+            r = mk_sort(sort_level(e), e.get_tag());
+            break;
+        case expr_kind::Constant:
+            r = mk_constant(const_name(e), const_levels(e), e.get_tag());
+            break;
+        case expr_kind::Meta:
+            r = mk_metavar(mlocal_name(e), copy(mlocal_type(e)), e.get_tag());
+            break;
+        case expr_kind::Local:
+            r = mk_local(mlocal_name(e), local_pp_name(e), copy(mlocal_type(e)), local_info(e), e.get_tag());
+            break;
+        case expr_kind::App: {
+            expr f = copy(app_fn(e));
+            r = mk_app(f, copy(app_arg(e)), e.get_tag());
+            break;
+        }
+        case expr_kind::Lambda: case expr_kind::Pi: {
+            expr d = copy(binding_domain(e));
+            r = mk_binding(e.kind(), binding_name(e), d, copy(binding_body(e)), binding_info(e), e.get_tag());
+            break;
+        }
+        case expr_kind::Let: {
+            expr t = copy(let_type(e));
+            expr v = copy(let_value(e));
+            r = mk_let(let_name(e), t, v, copy(let_body(e)), e.get_tag());
+            break;
+        }
+        case expr_kind::Macro: {
+            buffer<expr> args;
+            for (unsigned i = 0; i < macro_num_args(e); i++)
+                args.push_back(copy(macro_arg(e, i)));
+            r = update_macro(e, args.size(), args.data());
+            break;
+        }
+        }
+        m_cache.insert(std::make_pair(e.raw(), r));
+        return r;
+    }
+
+public:
+    expr operator()(expr const & e) {
+        flet<unsigned> suspend(g_arena_depth, 0);
+        return copy(e);
+    }
+};
+
+expr copy_out_of_arena(expr const & e) {
+    return copy_out_of_arena_fn()(e);
+}
+}
@@ -0,0 +1,45 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#pragma once
+#include "kernel/expr.h"
+
+namespace lean {
+/** \brief Region allocation for short-lived expressions.
+
+    While an \c expr_arena_scope object is alive, the expression cells created by the current thread
+    (except macros) are bump-allocated from chunks owned by the thread instead of the per-kind memory pools,
+    and they are not hash-consed.
+    The cells are still reference counted: a chunk is released when the scope that allocated it is closed
+    and all its cells have been deallocated, i.e., a cell that survives the scope (e.g., stored in a cache)
+    keeps its chunk alive, it never dangles. When all cells die before the end of the scope, the chunk is
+    reused by the next scope.
+
+    Scopes can be nested, only the outermost one has an effect. They are ignored unless
+    the arenas are enabled using \c enable_expr_arenas. */
+class expr_arena_scope {
+    bool m_active;
+public:
+    expr_arena_scope();
+    ~expr_arena_scope();
+};
+
+/** \brief Return a copy of \c e where the cells that were allocated in an arena are replaced with
+    cells allocated in the memory pools, i.e., the result does not keep arena chunks alive.
+    Shared subterms remain shared, and only arena cells and macros are traversed (a pool cell
+    created outside of an arena scope may still reference arena cells, it keeps their chunks alive).
+    It can be invoked inside of an \c expr_arena_scope. */
+expr copy_out_of_arena(expr const & e);
+
+void enable_expr_arenas(bool flag);
+bool expr_arenas_enabled();
+
+/* The following functions are used to implement the expression constructors. */
+/** \brief Return true if the expression cells must be allocated using \c expr_arena_allocate. */
+bool in_expr_arena();
+void * expr_arena_allocate(unsigned sz);
+void expr_arena_recycle(void * p);
+}
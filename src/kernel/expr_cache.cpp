@@ -7,27 +7,19 @@ Author: Leonardo de Moura
 #include "kernel/expr_cache.h"
 
 namespace lean {
+static cache_stats g_expr_cache_stats("expr");
+
+expr_cache::expr_cache(unsigned c):m_cache(g_expr_cache_stats, c) {}
+
 expr * expr_cache::find(expr const & e) {
-    unsigned i = e.hash() % m_capacity;
-    if (m_cache[i].m_expr && is_bi_equal(*m_cache[i].m_expr, e))
-        return &m_cache[i].m_result;
-    else
-        return nullptr;
+    return m_cache.find(e.hash(), e);
 }
 
 void expr_cache::insert(expr const & e, expr const & v) {
-    unsigned i = e.hash() % m_capacity;
-    if (!m_cache[i].m_expr)
-        m_used.push_back(i);
-    m_cache[i].m_expr   = e;
-    m_cache[i].m_result = v;
+    m_cache.insert(e.hash(), e, v);
 }
 
 void expr_cache::clear() {
-    for (unsigned i : m_used) {
-        m_cache[i].m_expr   = none_expr();
-        m_cache[i].m_result = expr();
-    }
-    m_used.clear();
+    m_cache.clear();
 }
 }
@@ -5,25 +5,18 @@ Released under Apache 2.0 license as described in the file LICENSE.
 Author: Leonardo de Moura
 */
 #pragma once
-#include <vector>
+#include "util/set_assoc_cache.h"
 #include "kernel/expr.h"
 
 namespace lean {
 /** \brief Cache for storing mappings from expressions to expressions.
 
-    \warning The insert(k, v) method overwrites andy entry (k1, v1) when
-    hash(k) == hash(k1)
-*/
+    \warning Entries may be evicted by the insertion of entries with colliding hash codes
+    (see \c set_assoc_cache). */
 class expr_cache {
-    struct entry {
-        optional<expr> m_expr;
-        expr           m_result;
-    };
-    unsigned              m_capacity;
-    std::vector<entry>    m_cache;
-    std::vector<unsigned> m_used;
+    set_assoc_cache<expr, expr, is_bi_equal_proc> m_cache;
 public:
-    expr_cache(unsigned c):m_capacity(c), m_cache(c) {}
+    expr_cache(unsigned c);
     void insert(expr const & e, expr const & v);
     expr * find(expr const & e);
     void clear();
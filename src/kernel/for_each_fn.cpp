@@ -9,6 +9,7 @@ Author: Leonardo de Moura
 #include "util/flet.h"
 #include "util/memory.h"
 #include "util/interrupt.h"
+#include "util/set_assoc_cache.h"
 #include "kernel/for_each_fn.h"
 #include "kernel/cache_stack.h"
 
@@ -17,35 +18,25 @@ Author: Leonardo de Moura
 #endif
 
 namespace lean {
+static cache_stats g_for_each_cache_stats("for_each");
+
 struct for_each_cache {
-    struct entry {
-        expr_cell const * m_cell;
-        unsigned          m_offset;
-        entry():m_cell(nullptr) {}
-    };
-    unsigned              m_capacity;
-    std::vector<entry>    m_cache;
-    std::vector<unsigned> m_used;
-    for_each_cache(unsigned c):m_capacity(c), m_cache(c) {}
+    typedef std::pair<expr_cell const *, unsigned> key;
+    set_assoc_cache<key, bool> m_cache;
+    for_each_cache(unsigned c):m_cache(g_for_each_cache_stats, c) {}
 
     bool visited(expr const & e, unsigned offset) {
-        unsigned i = hash(e.hash_alloc(), offset) % m_capacity;
-        if (m_cache[i].m_cell == e.raw() && m_cache[i].m_offset == offset) {
+        unsigned h = hash(e.hash_alloc(), offset);
+        key k(e.raw(), offset);
+        if (m_cache.find(h, k)) {
             return true;
         } else {
-            if (m_cache[i].m_cell == nullptr)
-                m_used.push_back(i);
-            m_cache[i].m_cell   = e.raw();
-            m_cache[i].m_offset = offset;
+            m_cache.insert(h, k, true);
             return false;
         }
     }
 
-    void clear() {
-        for (unsigned i : m_used)
-            m_cache[i].m_cell = nullptr;
-        m_used.clear();
-    }
+    void clear() { m_cache.clear(); }
 };
 
 MK_CACHE_STACK(for_each_cache, LEAN_DEFAULT_FOR_EACH_CACHE_CAPACITY)
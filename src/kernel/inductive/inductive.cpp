@@ -873,6 +873,14 @@ bool inductive_normalizer_extension::is_builtin(environment const & env, name co
     return is_inductive_decl(env, n) || is_elim_rule(env, n) || is_intro_rule(env, n);
 }
 
+bool inductive_normalizer_extension::may_reduce(environment const & env, name const & n) const {
+    return static_cast<bool>(is_elim_rule(env, n));
+}
+
+optional<unsigned> inductive_normalizer_extension::get_major_idx(environment const & env, name const & n) const {
+    return get_elim_major_idx(env, n);
+}
+
 template<typename Ctx>
 optional<expr> is_elim_meta_app_core(Ctx & ctx, expr const & e) {
     inductive_env_ext const & ext = get_extension(ctx.env());
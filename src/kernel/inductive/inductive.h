@@ -22,6 +22,8 @@ public:
     virtual bool supports(name const & feature) const;
     virtual bool is_recursor(environment const & env, name const & n) const;
     virtual bool is_builtin(environment const & env, name const & n) const;
+    virtual bool may_reduce(environment const & env, name const & n) const;
+    virtual optional<unsigned> get_major_idx(environment const & env, name const & n) const;
 };
 
 /** \brief Introduction rule */
@@ -11,6 +11,7 @@ Author: Leonardo de Moura
 #include "kernel/level.h"
 #include "kernel/declaration.h"
 #include "kernel/error_msgs.h"
+#include "kernel/delta_hints.h"
 
 namespace lean {
 void initialize_kernel_module() {
@@ -20,10 +21,12 @@ void initialize_kernel_module() {
     initialize_declaration();
     initialize_type_checker();
     initialize_environment();
+    initialize_delta_hints();
     initialize_formatter();
 }
 void finalize_kernel_module() {
     finalize_formatter();
+    finalize_delta_hints();
     finalize_environment();
     finalize_type_checker();
     finalize_declaration();
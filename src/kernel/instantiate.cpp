@@ -7,6 +7,8 @@ Author: Leonardo de Moura
 #include <algorithm>
 #include <limits>
 #include <vector>
+#include <utility>
+#include "util/set_assoc_cache.h"
 #include "kernel/free_vars.h"
 #include "kernel/replace_fn.h"
 #include "kernel/declaration.h"
@@ -17,46 +19,37 @@ Author: Leonardo de Moura
 #endif
 
 namespace lean {
+static cache_stats g_instantiate_univ_cache_stats("instantiate_univ_params");
+
 class instantiate_univ_cache {
-    typedef std::tuple<declaration, levels, expr> entry;
-    unsigned                     m_capacity;
-    std::vector<optional<entry>> m_cache;
-public:
-    instantiate_univ_cache(unsigned capacity):m_capacity(capacity) {
-        if (m_capacity == 0)
-            m_capacity++;
+    typedef std::pair<declaration, levels> key;
+    struct key_eq {
+        bool operator()(key const & k1, key const & k2) const {
+            return is_eqp(k1.first, k2.first) && k1.second == k2.second;
+        }
+    };
+    set_assoc_cache<key, expr, key_eq> m_cache;
+
+    static unsigned hash_key(declaration const & d, levels const & ls) {
+        unsigned h = d.get_name().hash();
+        for (level const & l : ls)
+            h = hash(h, l.hash());
+        return h;
     }
+public:
+    instantiate_univ_cache(unsigned capacity):m_cache(g_instantiate_univ_cache_stats, capacity) {}
 
     optional<expr> is_cached(declaration const & d, levels const & ls) {
-        if (m_cache.empty())
-            return none_expr();
-        lean_assert(m_cache.size() == m_capacity);
-        unsigned idx = d.get_name().hash() % m_capacity;
-        if (auto it = m_cache[idx]) {
-            declaration d_c; levels ls_c; expr r_c;
-            std::tie(d_c, ls_c, r_c) = *it;
-            if (!is_eqp(d_c, d))
-                return none_expr();
-            if (ls == ls_c)
-                return some_expr(r_c);
-            else
-                return none_expr();
-        }
+        if (expr * r = m_cache.find(hash_key(d, ls), key(d, ls)))
+            return some_expr(*r);
         return none_expr();
     }
 
     void save(declaration const & d, levels const & ls, expr const & r) {
-        if (m_cache.empty())
-            m_cache.resize(m_capacity);
-        lean_assert(m_cache.size() == m_capacity);
-        unsigned idx = d.get_name().hash() % m_cache.size();
-        m_cache[idx] = entry(d, ls, r);
+        m_cache.insert(hash_key(d, ls), key(d, ls), r);
     }
 
-    void clear() {
-        m_cache.clear();
-        lean_assert(m_cache.empty());
-    }
+    void clear() { m_cache.clear(); }
 };
 
 template<bool rev>
@@ -0,0 +1,278 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include "util/interrupt.h"
+#include "util/flet.h"
+#include "util/fresh_name.h"
+#include "kernel/krivine_machine.h"
+#include "kernel/type_checker.h"
+#include "kernel/instantiate.h"
+#include "kernel/abstract.h"
+
+namespace lean {
+struct krivine_machine::closure_cell {
+    expr           m_expr;
+    env            m_env;
+    /* m_expr instantiated with the terms of m_env, when it is set, m_expr is replaced with it and m_env is released. */
+    bool           m_read_back = false;
+    /* weak head normal form of this closure */
+    optional<expr> m_value;
+    closure_cell(expr const & e, env const & s):m_expr(e), m_env(s) {}
+};
+
+auto krivine_machine::mk_closure(expr const & e, env const & s) -> closure {
+    if (is_var(e)) {
+        /* Avoid chains of closures for arguments that are variables. */
+        unsigned idx = var_idx(e);
+        for (closure const & c : s) {
+            if (idx == 0) return c;
+            idx--;
+        }
+    }
+    if (is_nil(s) || !has_free_vars(e))
+        return std::make_shared<closure_cell>(e, env());
+    return std::make_shared<closure_cell>(e, s);
+}
+
+expr krivine_machine::read_back(expr const & e, env const & s) {
+    unsigned n = get_free_var_range(e);
+    if (n == 0 || is_nil(s))
+        return e;
+    buffer<expr> subst;
+    for (closure const & c : s) {
+        if (subst.size() == n) break;
+        subst.push_back(read_back(c));
+    }
+    return instantiate(e, subst.size(), subst.data());
+}
+
+expr krivine_machine::read_back(closure const & c) {
+    if (!c->m_read_back) {
+        c->m_expr      = read_back(c->m_expr, c->m_env);
+        c->m_env       = env();
+        c->m_read_back = true;
+    }
+    return c->m_expr;
+}
+
+expr krivine_machine::read_back(state const & s) {
+    expr f = read_back(s.m_expr, s.m_env);
+    if (s.m_stack.empty())
+        return f;
+    buffer<expr> args;
+    unsigned i = s.m_stack.size();
+    while (i > 0) {
+        --i;
+        args.push_back(read_back(s.m_stack[i]));
+    }
+    return mk_app(f, args);
+}
+
+expr krivine_machine::force(closure const & c) {
+    if (!c->m_value) {
+        state s;
+        s.m_expr = c->m_expr;
+        s.m_env  = c->m_env;
+        eval(s);
+        c->m_value = read_back(s);
+    }
+    return *c->m_value;
+}
+
+optional<expr> krivine_machine::unfold(expr const & c) {
+    if (auto d = m_tc.env().find(const_name(c))) {
+        if (d->is_definition() && length(const_levels(c)) == d->get_num_univ_params())
+            return some_expr(instantiate_value_univ_params(*d, const_levels(c)));
+    }
+    return none_expr();
+}
+
+/** \brief Reduce the application of the constant in head position using the normalizer extensions
+    (mainly iota-reduction, it also applies HIT and quotient reduction rules). Return true if it was reduced.
+
+    When the extension only inspects the major premise, the other arguments are not read back: they are replaced
+    with fresh local constants, which are then bound to the original closures in the resulting state. */
+bool krivine_machine::reduce_ext(state & s) {
+    environment const & e = m_tc.env();
+    name const & n = const_name(s.m_expr);
+    if (s.m_stack.empty() || !e.norm_ext().may_reduce(e, n))
+        return false;
+    optional<unsigned> major_idx = e.norm_ext().get_major_idx(e, n);
+    if (!major_idx) {
+        if (auto r = e.norm_ext()(read_back(s), m_tc)) {
+            s.m_expr = *r;
+            s.m_env  = env();
+            s.m_stack.clear();
+            return true;
+        }
+        return false;
+    }
+    unsigned num_args = *major_idx + 1;
+    if (s.m_stack.size() < num_args)
+        return false;
+    buffer<expr> args;
+    buffer<expr> locals;
+    env new_env;
+    for (unsigned i = 0; i < num_args; i++) {
+        closure const & c = s.m_stack[s.m_stack.size() - i - 1];
+        if (i == *major_idx) {
+            args.push_back(force(c));
+        } else {
+            /* The type is irrelevant, the extension does not inspect this argument. */
+            expr l = mk_local(mk_fresh_name(), mk_Prop());
+            args.push_back(l);
+            locals.push_back(l);
+            new_env = cons(c, new_env);
+        }
+    }
+    optional<expr> r = e.norm_ext()(mk_app(s.m_expr, args), m_tc);
+    if (!r)
+        return false;
+    s.m_expr = abstract_locals(*r, locals.size(), locals.data());
+    s.m_env  = new_env;
+    s.m_stack.shrink(s.m_stack.size() - num_args);
+    return true;
+}
+
+/** \brief Run the machine until it reaches a weak head normal form. Return true if at least one reduction step was performed. */
+bool krivine_machine::eval(state & s) {
+    check_system("krivine machine");
+    bool progress = false;
+    while (true) {
+        switch (s.m_expr.kind()) {
+        case expr_kind::Var: {
+            unsigned idx = var_idx(s.m_expr);
+            optional<closure> c;
+            for (closure const & c1 : s.m_env) {
+                if (idx == 0) { c = c1; break; }
+                idx--;
+            }
+            if (c) {
+                s.m_expr = force(*c);
+                s.m_env  = env();
+                continue;
+            } else {
+                /* free variable of the input term */
+                s.m_expr = mk_var(idx);
+                s.m_env  = env();
+                return progress;
+            }
+        }
+        case expr_kind::App: {
+            expr e = s.m_expr;
+            while (is_app(e)) {
+                s.m_stack.push_back(mk_closure(app_arg(e), s.m_env));
+                e = app_fn(e);
+            }
+            s.m_expr = e;
+            continue;
+        }
+        case expr_kind::Lambda:
+            if (s.m_stack.empty())
+                return progress;
+            s.m_env  = cons(s.m_stack.back(), s.m_env);
+            s.m_stack.pop_back();
+            s.m_expr = binding_body(s.m_expr);
+            progress = true;
+            continue;
+        case expr_kind::Let:
+            s.m_env  = cons(mk_closure(let_value(s.m_expr), s.m_env), s.m_env);
+            s.m_expr = let_body(s.m_expr);
+            progress = true;
+            continue;
+        case expr_kind::Constant:
+            /* The extensions are tried before delta, e.g., the nat extension reduces nat.add on numerals. */
+            if (reduce_ext(s)) {
+                progress = true;
+                continue;
+            }
+            if (m_delta) {
+                if (auto v = unfold(s.m_expr)) {
+                    s.m_expr = *v;
+                    s.m_env  = env();
+                    progress = true;
+                    continue;
+                }
+            }
+            return progress;
+        case expr_kind::Macro:
+            if (auto m = m_tc.expand_macro(read_back(s.m_expr, s.m_env))) {
+                s.m_expr = *m;
+                s.m_env  = env();
+                progress = true;
+                continue;
+            }
+            return progress;
+        case expr_kind::Sort: case expr_kind::Pi:
+        case expr_kind::Local: case expr_kind::Meta:
+            return progress;
+        }
+    }
+}
+
+expr krivine_machine::whnf_core(expr const & e) {
+    flet<bool> no_delta(m_delta, false);
+    state s;
+    s.m_expr = e;
+    return eval(s) ? read_back(s) : e;
+}
+
+expr krivine_machine::whnf(expr const & e) {
+    flet<bool> delta(m_delta, true);
+    state s;
+    s.m_expr = e;
+    return eval(s) ? read_back(s) : e;
+}
+
+expr krivine_machine::normalize(closure const & c) {
+    if (c->m_value)
+        return normalize(*c->m_value, env());
+    return normalize(c->m_expr, c->m_env);
+}
+
+expr krivine_machine::normalize(expr const & e, env const & s0) {
+    state s;
+    s.m_expr = e;
+    s.m_env  = s0;
+    eval(s);
+    expr const & f = s.m_expr;
+    expr r;
+    switch (f.kind()) {
+    case expr_kind::Lambda: case expr_kind::Pi: {
+        lean_assert(s.m_stack.empty());
+        expr d = normalize(binding_domain(f), s.m_env);
+        expr l = mk_local(mk_fresh_name(), binding_name(f), d, binding_info(f));
+        expr b = normalize(binding_body(f), cons(mk_closure(l, env()), s.m_env));
+        r = update_binding(f, d, abstract_local(b, l));
+        break;
+    }
+    case expr_kind::Macro: {
+        buffer<expr> args;
+        for (unsigned i = 0; i < macro_num_args(f); i++)
+            args.push_back(normalize(macro_arg(f, i), s.m_env));
+        r = update_macro(f, args.size(), args.data());
+        break;
+    }
+    default:
+        r = read_back(f, s.m_env);
+        break;
+    }
+    if (s.m_stack.empty())
+        return r;
+    buffer<expr> args;
+    unsigned i = s.m_stack.size();
+    while (i > 0) {
+        --i;
+        args.push_back(normalize(s.m_stack[i]));
+    }
+    return mk_app(r, args);
+}
+
+expr krivine_machine::normalize(expr const & e) {
+    flet<bool> delta(m_delta, true);
+    return normalize(e, env());
+}
+}
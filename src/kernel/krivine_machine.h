@@ -0,0 +1,61 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#pragma once
+#include <memory>
+#include "util/list.h"
+#include "util/buffer.h"
+#include "kernel/expr.h"
+
+namespace lean {
+class type_checker;
+
+/** \brief Reduction engine based on a lazy Krivine machine.
+
+    Instead of substituting the arguments of a beta-redex (or the value of a let-expression) in its body,
+    the machine evaluates the body in an environment that maps the de Bruijn indices to closures.
+    A closure is evaluated at most once, when a variable bound to it is in head position (call-by-need),
+    and terms are only rebuilt when the machine stops (read back).
+    Normalization under binders (see \c normalize) instantiates the bound variables with fresh local constants
+    in the environment, i.e., it is normalization by evaluation.
+
+    Recursors, quotients and macros are reduced using the normalizer extensions of the environment
+    and \c type_checker::expand_macro. */
+class krivine_machine {
+    struct closure_cell;
+    typedef std::shared_ptr<closure_cell> closure;
+    typedef list<closure>                 env;
+    struct state {
+        expr            m_expr;
+        env             m_env;
+        buffer<closure> m_stack; /* arguments, the first one is at the top */
+    };
+
+    type_checker & m_tc;
+    bool           m_delta;
+
+    static closure mk_closure(expr const & e, env const & s);
+    expr read_back(expr const & e, env const & s);
+    expr read_back(closure const & c);
+    expr read_back(state const & s);
+    expr force(closure const & c);
+    optional<expr> unfold(expr const & c);
+    bool reduce_ext(state & s);
+    bool eval(state & s);
+    expr normalize(expr const & e, env const & s);
+    expr normalize(closure const & c);
+
+public:
+    krivine_machine(type_checker & tc):m_tc(tc), m_delta(false) {}
+
+    /** \brief Weak head normal form using beta, zeta, iota and macro expansion (but not delta) reduction. */
+    expr whnf_core(expr const & e);
+    /** \brief Weak head normal form, definitions are unfolded. */
+    expr whnf(expr const & e);
+    /** \brief Return the normal form of \c e (not eta-reduced). */
+    expr normalize(expr const & e);
+};
+}
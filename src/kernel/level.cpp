@@ -8,6 +8,7 @@ Author: Leonardo de Moura
 #include <algorithm>
 #include <vector>
 #include <unordered_set>
+#include <functional>
 #include "util/safe_arith.h"
 #include "util/buffer.h"
 #include "util/rc.h"
@@ -15,11 +16,18 @@ Author: Leonardo de Moura
 #include "util/debug.h"
 #include "util/hash.h"
 #include "util/interrupt.h"
+#include "util/thread.h"
+#include "util/set_assoc_cache.h"
 #include "kernel/level.h"
 #include "kernel/environment.h"
 
+#ifndef LEAN_LEVEL_RELATION_CACHE_CAPACITY
+#define LEAN_LEVEL_RELATION_CACHE_CAPACITY 1024
+#endif
+
 namespace lean {
 level cache(level const & e);
+static cache_stats g_level_relation_stats("level is_equivalent/is_geq");
 
 level_cell const & to_cell(level const & l) {
     return *l.m_ptr;
@@ -31,15 +39,24 @@ struct level_cell {
     MK_LEAN_RC()
     level_kind m_kind;
     unsigned   m_hash;
-    level_cell(level_kind k, unsigned h):m_rc(0), m_kind(k), m_hash(h) {}
+    bool       m_interned; /* true iff the cell is in the global hash-consing table */
+    level_cell(level_kind k, unsigned h):m_rc(0), m_kind(k), m_hash(h), m_interned(false) {}
 };
 
 struct level_composite : public level_cell {
     unsigned   m_depth;
     unsigned   m_has_param:1;
     unsigned   m_has_meta:1;
+    /* Memoized normal form (see normalize): nullptr if it has not been computed yet, the cell itself if
+       it is already in normal form, and a (counted) reference to the normal form otherwise. */
+    mutable atomic<level_cell *> m_normal;
     level_composite(level_kind k, unsigned h, unsigned d, bool has_param, bool has_meta):
-        level_cell(k, h), m_depth(d), m_has_param(has_param), m_has_meta(has_meta) {}
+        level_cell(k, h), m_depth(d), m_has_param(has_param), m_has_meta(has_meta), m_normal(nullptr) {}
+    ~level_composite() {
+        level_cell * n = m_normal.load();
+        if (n && n != this)
+            n->dec_ref();
+    }
 };
 
 bool is_composite(level const & l) {
@@ -116,7 +133,11 @@ name const & level_id(level const & l) {
     return to_param_core(l).m_id;
 }
 
+static void erase_interned(level_cell * c);
+
 void level_cell::dealloc() {
+    if (m_interned)
+        erase_interned(this);
     switch (m_kind) {
     case level_kind::Succ:
         delete static_cast<level_succ*>(this);
@@ -259,7 +280,38 @@ void flush_level_cache() {
     level_cache new_cache;
     get_level_cache().swap(new_cache);
 }
+typedef weak_intern_table<level, level_cell, std::equal_to<level>> level_intern_table;
+static level_intern_table * g_level_intern_table = nullptr;
+
+void enable_level_interning() {
+    if (!g_level_intern_table)
+        g_level_intern_table = new level_intern_table();
+}
+
+intern_table_stats get_level_interning_stats() {
+    return g_level_intern_table ? g_level_intern_table->get_stats() : intern_table_stats();
+}
+
+static void erase_interned(level_cell * c) {
+    if (g_level_intern_table)
+        g_level_intern_table->erase(c, c->m_hash);
+}
+
+static unsigned get_cell_size(level const & l) {
+    switch (kind(l)) {
+    case level_kind::Succ:                         return sizeof(level_succ);
+    case level_kind::Max: case level_kind::IMax:   return sizeof(level_max_core);
+    case level_kind::Param: case level_kind::Meta: return sizeof(level_param_core);
+    case level_kind::Zero:                         return sizeof(level_cell);
+    }
+    lean_unreachable();
+}
+
 level cache(level const & e) {
+    if (LEAN_UNLIKELY(g_level_intern_table != nullptr)) {
+        return g_level_intern_table->intern(e, const_cast<level_cell *>(&to_cell(e)), hash(e), get_cell_size(e),
+                                            [](level_cell * c) { c->m_interned = true; });
+    }
     if (g_level_cache_enabled) {
         level_cache & cache = get_level_cache();
         auto it = cache.find(e);
@@ -635,7 +687,7 @@ level mk_succ(level l, unsigned k) {
     return l;
 }
 
-level normalize(level const & l) {
+static level normalize_core(level const & l) {
     auto p = to_offset(l);
     level const & r = p.first;
     switch (kind(r)) {
@@ -702,9 +754,65 @@ level normalize(level const & l) {
     lean_unreachable(); // LCOV_EXCL_LINE
 }
 
+level normalize(level const & l) {
+    if (!is_composite(l))
+        return l;
+    level_composite const & c = to_composite(l);
+    if (level_cell * n = c.m_normal.load())
+        return n == &c ? l : level(n);
+    level r = normalize_core(l);
+    level_cell * n = const_cast<level_cell *>(&to_cell(r));
+    if (n != &c)
+        n->inc_ref();
+    level_cell * expected = nullptr;
+    if (!c.m_normal.compare_exchange_strong(expected, n) && n != &c) {
+        /* another thread has memoized the normal form */
+        n->dec_ref();
+    }
+    return r;
+}
+
+/* Cache for the results of is_equivalent and is_geq on composite levels, there is one per thread. */
+class level_relation_cache {
+    struct key {
+        level m_lhs;
+        level m_rhs;
+        bool  m_geq = false; /* is_geq if true, is_equivalent otherwise */
+        key() {}
+        key(level const & l1, level const & l2, bool geq):m_lhs(l1), m_rhs(l2), m_geq(geq) {}
+        unsigned hash() const { return ::lean::hash(::lean::hash(m_lhs), ::lean::hash(m_rhs)) + m_geq; }
+    };
+    struct key_eq {
+        bool operator()(key const & k1, key const & k2) const {
+            return k1.m_geq == k2.m_geq && k1.m_lhs == k2.m_lhs && k1.m_rhs == k2.m_rhs;
+        }
+    };
+    set_assoc_cache<key, bool, key_eq> m_cache;
+
+public:
+    level_relation_cache(unsigned capacity):m_cache(g_level_relation_stats, capacity) {}
+
+    template<typename F>
+    bool get(level const & l1, level const & l2, bool geq, F && f) {
+        key k(l1, l2, geq);
+        unsigned h = k.hash();
+        if (bool const * r = m_cache.find(h, k))
+            return *r;
+        bool r = f();
+        m_cache.insert(h, k, r);
+        return r;
+    }
+};
+
+MK_THREAD_LOCAL_GET(level_relation_cache, get_level_relation_cache, LEAN_LEVEL_RELATION_CACHE_CAPACITY);
+
 bool is_equivalent(level const & lhs, level const & rhs) {
     check_system("level constraints");
-    return lhs == rhs || normalize(lhs) == normalize(rhs);
+    if (lhs == rhs)
+        return true;
+    if (!is_composite(lhs) && !is_composite(rhs))
+        return false;
+    return get_level_relation_cache().get(lhs, rhs, false, [&]() { return normalize(lhs) == normalize(rhs); });
 }
 
 bool is_geq_core(level l1, level l2) {
@@ -727,7 +835,9 @@ bool is_geq_core(level l1, level l2) {
     return false;
 }
 bool is_geq(level const & l1, level const & l2) {
-    return is_geq_core(normalize(l1), normalize(l2));
+    if (!is_composite(l1) && !is_composite(l2))
+        return is_geq_core(l1, l2);
+    return get_level_relation_cache().get(l1, l2, true, [&]() { return is_geq_core(normalize(l1), normalize(l2)); });
 }
 levels param_names_to_levels(level_param_names const & ps) {
     return map2<level>(ps, [](name const & p) { return mk_param_univ(p); });
@@ -741,6 +851,8 @@ void initialize_level() {
 void finalize_level() {
     delete g_level_one;
     delete g_level_zero;
+    delete g_level_intern_table;
+    g_level_intern_table = nullptr;
 }
 }
 void print(lean::level const & l) { std::cout << l << std::endl; }
@@ -13,6 +13,7 @@ Author: Leonardo de Moura
 #include "util/list.h"
 #include "util/sexpr/format.h"
 #include "util/sexpr/options.h"
+#include "util/weak_intern_table.h"
 
 namespace lean {
 class environment;
@@ -82,6 +83,9 @@ bool enable_level_caching(bool f);
 level cache(level const & l);
 bool is_cached(level const & l);
 void flush_level_cache();
+/** \brief Enable the hash-consing table shared by all threads for universe levels (see \c enable_expr_interning) */
+void enable_level_interning();
+intern_table_stats get_level_interning_stats();
 
 level const & mk_level_zero();
 level const & mk_level_one();
@@ -0,0 +1,303 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+
+Evaluation of closed natural number arithmetic in the kernel.
+*/
+#include "util/numerics/mpz.h"
+#include "kernel/nat/nat.h"
+#include "kernel/abstract_type_context.h"
+
+namespace lean {
+static name * g_nat_extension    = nullptr;
+static name * g_nat              = nullptr;
+static name * g_nat_zero         = nullptr;
+static name * g_nat_succ         = nullptr;
+static name * g_nat_add          = nullptr;
+static name * g_nat_mul          = nullptr;
+static name * g_nat_sub          = nullptr;
+static name * g_nat_div          = nullptr;
+static name * g_nat_mod          = nullptr;
+static name * g_nat_has_zero     = nullptr;
+static name * g_nat_has_one      = nullptr;
+static name * g_nat_has_add      = nullptr;
+static name * g_nat_has_mul      = nullptr;
+static name * g_nat_has_sub      = nullptr;
+static name * g_nat_has_div      = nullptr;
+static name * g_nat_has_mod      = nullptr;
+static name * g_nat_decidable_eq = nullptr;
+static name * g_nat_decidable_le = nullptr;
+static name * g_nat_decidable_lt = nullptr;
+static name * g_has_zero_zero    = nullptr;
+static name * g_has_one_one      = nullptr;
+static name * g_has_add_add      = nullptr;
+static name * g_has_mul_mul      = nullptr;
+static name * g_has_sub_sub      = nullptr;
+static name * g_has_div_div      = nullptr;
+static name * g_has_mod_mod      = nullptr;
+static name * g_bit0             = nullptr;
+static name * g_bit1             = nullptr;
+static expr * g_nat_zero_num     = nullptr; /* @has_zero.zero nat nat.has_zero */
+static expr * g_nat_one_num      = nullptr; /* @has_one.one nat nat.has_one */
+static expr * g_nat_bit0_fn      = nullptr;
+static expr * g_nat_bit1_fn      = nullptr;
+static expr * g_nat_zero_fn      = nullptr;
+static expr * g_nat_succ_fn      = nullptr;
+
+enum class nat_op { Add, Mul, Sub, Div, Mod };
+
+static mpz apply(nat_op op, mpz const & a, mpz const & b) {
+    switch (op) {
+    case nat_op::Add: return a + b;
+    case nat_op::Mul: return a * b;
+    case nat_op::Sub: return a < b ? mpz(0) : a - b;
+    case nat_op::Div: return b.is_zero() ? mpz(0) : a / b;
+    case nat_op::Mod: return b.is_zero() ? a : rem(a, b);
+    }
+    lean_unreachable();
+}
+
+/* Return the operation and the number of instance arguments of an arithmetic function application. */
+static optional<nat_op> is_nat_op(expr const & fn, buffer<expr> const & args, unsigned & num_inst) {
+    name const & n = const_name(fn);
+    num_inst = 0;
+    if (n == *g_nat_add) return optional<nat_op>(nat_op::Add);
+    if (n == *g_nat_mul) return optional<nat_op>(nat_op::Mul);
+    if (n == *g_nat_sub) return optional<nat_op>(nat_op::Sub);
+    if (n == *g_nat_div) return optional<nat_op>(nat_op::Div);
+    if (n == *g_nat_mod) return optional<nat_op>(nat_op::Mod);
+    if (args.size() != 4 || !is_constant(args[0], *g_nat) || !is_constant(args[1]))
+        return optional<nat_op>();
+    num_inst = 2;
+    name const & inst = const_name(args[1]);
+    if (n == *g_has_add_add && inst == *g_nat_has_add) return optional<nat_op>(nat_op::Add);
+    if (n == *g_has_mul_mul && inst == *g_nat_has_mul) return optional<nat_op>(nat_op::Mul);
+    if (n == *g_has_sub_sub && inst == *g_nat_has_sub) return optional<nat_op>(nat_op::Sub);
+    if (n == *g_has_div_div && inst == *g_nat_has_div) return optional<nat_op>(nat_op::Div);
+    if (n == *g_has_mod_mod && inst == *g_nat_has_mod) return optional<nat_op>(nat_op::Mod);
+    return optional<nat_op>();
+}
+
+/* Return the value of \c e if it is a numeral. */
+static optional<mpz> to_numeral(expr const & e) {
+    if (is_constant(e, *g_nat_zero))
+        return optional<mpz>(0);
+    buffer<expr> args;
+    expr const & fn = get_app_args(e, args);
+    if (!is_constant(fn))
+        return optional<mpz>();
+    name const & n = const_name(fn);
+    if (n == *g_has_zero_zero && args.size() == 2 && is_constant(args[0], *g_nat) && is_constant(args[1], *g_nat_has_zero)) {
+        return optional<mpz>(0);
+    } else if (n == *g_has_one_one && args.size() == 2 && is_constant(args[0], *g_nat) && is_constant(args[1], *g_nat_has_one)) {
+        return optional<mpz>(1);
+    } else if (n == *g_bit0 && args.size() == 3 && is_constant(args[0], *g_nat) && is_constant(args[1], *g_nat_has_add)) {
+        if (auto v = to_numeral(args[2]))
+            return optional<mpz>(2 * *v);
+    } else if (n == *g_bit1 && args.size() == 4 && is_constant(args[0], *g_nat) && is_constant(args[1], *g_nat_has_one) &&
+               is_constant(args[2], *g_nat_has_add)) {
+        if (auto v = to_numeral(args[3]))
+            return optional<mpz>(2 * *v + 1);
+    }
+    return optional<mpz>();
+}
+
+/* Return the value of \c e if it is built using numerals, \c nat.succ and arithmetic operations. */
+static optional<mpz> eval(expr const & e) {
+    if (auto v = to_numeral(e))
+        return v;
+    if (!is_app(e))
+        return optional<mpz>();
+    buffer<expr> args;
+    expr const & fn = get_app_args(e, args);
+    if (!is_constant(fn))
+        return optional<mpz>();
+    if (const_name(fn) == *g_nat_succ && args.size() == 1) {
+        if (auto v = eval(args[0]))
+            return optional<mpz>(*v + 1);
+        return optional<mpz>();
+    }
+    unsigned num_inst;
+    if (auto op = is_nat_op(fn, args, num_inst)) {
+        if (args.size() != num_inst + 2)
+            return optional<mpz>();
+        if (auto v1 = eval(args[num_inst])) {
+            if (auto v2 = eval(args[num_inst + 1]))
+                return optional<mpz>(apply(*op, *v1, *v2));
+        }
+    }
+    return optional<mpz>();
+}
+
+static expr mk_numeral(mpz const & v) {
+    if (v.is_zero())
+        return *g_nat_zero_num;
+    if (v == 1)
+        return *g_nat_one_num;
+    expr r = mk_numeral(v / 2u);
+    return v.test_bit(0) ? mk_app(*g_nat_bit1_fn, r) : mk_app(*g_nat_bit0_fn, r);
+}
+
+/* Return a proof of \c p (if \c b is true) or <tt>not p</tt> (if \c b is false), given an instance \c d of
+   <tt>decidable p</tt> that reduces to \c is_true (if \c b is true) or \c is_false.
+
+   It is the term <tt>@decidable.rec p (λ d, as_bool d → q) f t d true.intro</tt> where
+   <tt>as_bool d := @decidable.rec p (λ _, Prop) (λ _, ¬b) (λ _, b) d</tt>, i.e.,
+   it is \c true for the expected constructor, and \c f and \c t are trivial proofs of
+   <tt>¬b → q</tt> and <tt>b → q</tt> on the corresponding constructors. */
+static expr mk_decision_proof(expr const & p, expr const & d, bool b) {
+    expr true_prop   = mk_constant("true");
+    expr false_prop  = mk_constant("false");
+    expr not_p       = mk_app(mk_constant("not"), p);
+    expr q           = b ? p : not_p;
+    expr dec_p       = mk_app(mk_constant("decidable"), p);
+    expr as_bool_fn  = mk_app(mk_constant(name{"decidable", "rec"}, {mk_succ(mk_level_zero())}), p,
+                              mk_lambda("d", dec_p, mk_Prop()));
+    expr as_bool_d   = mk_app(as_bool_fn,
+                              mk_lambda("h", not_p, b ? false_prop : true_prop),
+                              mk_lambda("h", p,     b ? true_prop : false_prop),
+                              mk_var(0));
+    expr motive      = mk_lambda("d", dec_p, mk_arrow(as_bool_d, q));
+    /* λ (h : A) (x : false), false.rec q x */
+    auto absurd_case = [&](expr const & A) {
+        return mk_lambda("h", A, mk_lambda("x", false_prop,
+                                           mk_app(mk_constant(name{"false", "rec"}, {mk_level_zero()}), q, mk_var(0))));
+    };
+    /* λ (h : A) (x : true), h */
+    auto h_case = [&](expr const & A) {
+        return mk_lambda("h", A, mk_lambda("x", true_prop, mk_var(1)));
+    };
+    expr false_case  = b ? absurd_case(not_p) : h_case(not_p);
+    expr true_case   = b ? h_case(p) : absurd_case(p);
+    return mk_app({mk_constant(name{"decidable", "rec"}, {mk_level_zero()}), p, motive, false_case, true_case, d,
+                   mk_constant(name{"true", "intro"})});
+}
+
+optional<expr> nat_normalizer_extension::operator()(expr const & e, abstract_type_context & ctx) const {
+    expr const & fn = get_app_fn(e);
+    if (!is_constant(fn) || !is_app(e))
+        return none_expr();
+    name const & n = const_name(fn);
+    if (n == *g_nat_decidable_eq || n == *g_nat_decidable_le || n == *g_nat_decidable_lt) {
+        buffer<expr> args;
+        get_app_args(e, args);
+        if (args.size() != 2)
+            return none_expr();
+        auto v1 = eval(args[0]);
+        if (!v1) return none_expr();
+        auto v2 = eval(args[1]);
+        if (!v2) return none_expr();
+        bool b;
+        if (n == *g_nat_decidable_eq)
+            b = *v1 == *v2;
+        else if (n == *g_nat_decidable_le)
+            b = *v1 <= *v2;
+        else
+            b = *v1 < *v2;
+        /* e : decidable p */
+        expr type = ctx.whnf(ctx.infer(e));
+        if (!is_app(type) || !is_constant(app_fn(type), "decidable"))
+            return none_expr();
+        expr const & p = app_arg(type);
+        expr proof     = mk_decision_proof(p, e, b);
+        return some_expr(mk_app(mk_constant(b ? name{"decidable", "is_true"} : name{"decidable", "is_false"}), p, proof));
+    } else if (n == *g_has_zero_zero || n == *g_has_one_one || n == *g_bit0 || n == *g_bit1) {
+        if (auto v = to_numeral(e)) {
+            if (v->is_zero())
+                return some_expr(*g_nat_zero_fn);
+            return some_expr(mk_app(*g_nat_succ_fn, mk_numeral(*v - 1)));
+        }
+        return none_expr();
+    } else if (n == *g_nat_succ) {
+        return none_expr();
+    } else if (auto v = eval(e)) {
+        return some_expr(mk_numeral(*v));
+    }
+    return none_expr();
+}
+
+optional<expr> nat_normalizer_extension::is_stuck(expr const &, abstract_type_context &) const {
+    return none_expr();
+}
+
+bool nat_normalizer_extension::supports(name const & feature) const {
+    return feature == *g_nat_extension;
+}
+
+bool nat_normalizer_extension::is_recursor(environment const &, name const &) const {
+    return false;
+}
+
+bool nat_normalizer_extension::is_builtin(environment const &, name const &) const {
+    return false;
+}
+
+bool nat_normalizer_extension::may_reduce(environment const &, name const & n) const {
+    return
+        n == *g_nat_add || n == *g_nat_mul || n == *g_nat_sub || n == *g_nat_div || n == *g_nat_mod ||
+        n == *g_has_add_add || n == *g_has_mul_mul || n == *g_has_sub_sub || n == *g_has_div_div ||
+        n == *g_has_mod_mod || n == *g_has_zero_zero || n == *g_has_one_one || n == *g_bit0 || n == *g_bit1 ||
+        n == *g_nat_decidable_eq || n == *g_nat_decidable_le || n == *g_nat_decidable_lt;
+}
+
+optional<unsigned> nat_normalizer_extension::get_major_idx(environment const &, name const &) const {
+    return optional<unsigned>();
+}
+
+void initialize_nat_module() {
+    g_nat_extension    = new name("nat_extension");
+    g_nat              = new name{"nat"};
+    g_nat_zero         = new name{"nat", "zero"};
+    g_nat_succ         = new name{"nat", "succ"};
+    g_nat_add          = new name{"nat", "add"};
+    g_nat_mul          = new name{"nat", "mul"};
+    g_nat_sub          = new name{"nat", "sub"};
+    g_nat_div          = new name{"nat", "div"};
+    g_nat_mod          = new name{"nat", "mod"};
+    g_nat_has_zero     = new name{"nat", "has_zero"};
+    g_nat_has_one      = new name{"nat", "has_one"};
+    g_nat_has_add      = new name{"nat", "has_add"};
+    g_nat_has_mul      = new name{"nat", "has_mul"};
+    g_nat_has_sub      = new name{"nat", "has_sub"};
+    g_nat_has_div      = new name{"nat", "has_div"};
+    g_nat_has_mod      = new name{"nat", "has_mod"};
+    g_nat_decidable_eq = new name{"nat", "decidable_eq"};
+    g_nat_decidable_le = new name{"nat", "decidable_le"};
+    g_nat_decidable_lt = new name{"nat", "decidable_lt"};
+    g_has_zero_zero    = new name{"has_zero", "zero"};
+    g_has_one_one      = new name{"has_one", "one"};
+    g_has_add_add      = new name{"has_add", "add"};
+    g_has_mul_mul      = new name{"has_mul", "mul"};
+    g_has_sub_sub      = new name{"has_sub", "sub"};
+    g_has_div_div      = new name{"has_div", "div"};
+    g_has_mod_mod      = new name{"has_mod", "mod"};
+    g_bit0             = new name{"bit0"};
+    g_bit1             = new name{"bit1"};
+    expr nat           = mk_constant(*g_nat);
+    levels lvls        = levels(mk_level_zero());
+    g_nat_zero_num     = new expr(mk_app(mk_constant(*g_has_zero_zero, lvls), nat, mk_constant(*g_nat_has_zero)));
+    g_nat_one_num      = new expr(mk_app(mk_constant(*g_has_one_one, lvls), nat, mk_constant(*g_nat_has_one)));
+    g_nat_bit0_fn      = new expr(mk_app(mk_constant(*g_bit0, lvls), nat, mk_constant(*g_nat_has_add)));
+    g_nat_bit1_fn      = new expr(mk_app(mk_constant(*g_bit1, lvls), nat, mk_constant(*g_nat_has_one),
+                                         mk_constant(*g_nat_has_add)));
+    g_nat_zero_fn      = new expr(mk_constant(*g_nat_zero));
+    g_nat_succ_fn      = new expr(mk_constant(*g_nat_succ));
+}
+
+void finalize_nat_module() {
+    delete g_nat_succ_fn;
+    delete g_nat_zero_fn;
+    delete g_nat_bit1_fn;
+    delete g_nat_bit0_fn;
+    delete g_nat_one_num;
+    delete g_nat_zero_num;
+    for (name * n : {g_nat_extension, g_nat, g_nat_zero, g_nat_succ, g_nat_add, g_nat_mul, g_nat_sub, g_nat_div,
+                     g_nat_mod, g_nat_has_zero, g_nat_has_one, g_nat_has_add, g_nat_has_mul, g_nat_has_sub,
+                     g_nat_has_div, g_nat_has_mod, g_nat_decidable_eq, g_nat_decidable_le, g_nat_decidable_lt,
+                     g_has_zero_zero, g_has_one_one, g_has_add_add, g_has_mul_mul, g_has_sub_sub, g_has_div_div,
+                     g_has_mod_mod, g_bit0, g_bit1})
+        delete n;
+}
+}
@@ -0,0 +1,40 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+
+Evaluation of closed natural number arithmetic in the kernel.
+*/
+#pragma once
+#include <memory>
+#include "kernel/normalizer_extension.h"
+
+namespace lean {
+/** \brief Normalizer extension that evaluates closed arithmetic on binary numerals of type \c nat using
+    arbitrary precision integers.
+
+    - <tt>nat.add a b</tt>, <tt>nat.mul a b</tt>, <tt>nat.sub a b</tt>, <tt>nat.div a b</tt>, <tt>nat.mod a b</tt>
+      (and the corresponding \c has_add.add, ... applications using the \c nat instances) are reduced to numerals
+      when \c a and \c b are numerals or closed arithmetic terms.
+    - Numerals (\c bit0, \c bit1, \c one, \c zero) are reduced to \c nat.zero or <tt>nat.succ n</tt> where \c n is a numeral.
+    - <tt>nat.decidable_eq a b</tt>, <tt>nat.decidable_le a b</tt> and <tt>nat.decidable_lt a b</tt> are reduced to
+      \c decidable.is_true or \c decidable.is_false. The proofs are built using \c decidable.rec on the instance itself,
+      and they are valid without this extension.
+
+    \remark This extension assumes that these constants have the definitions in the standard library,
+    so it is not part of the standard kernel (see \c mk_environment). */
+class nat_normalizer_extension : public normalizer_extension {
+public:
+    virtual optional<expr> operator()(expr const & e, abstract_type_context & ctx) const;
+    virtual optional<expr> is_stuck(expr const & e, abstract_type_context & ctx) const;
+    virtual bool supports(name const & feature) const;
+    virtual bool is_recursor(environment const & env, name const & n) const;
+    virtual bool is_builtin(environment const & env, name const & n) const;
+    virtual bool may_reduce(environment const & env, name const & n) const;
+    virtual optional<unsigned> get_major_idx(environment const & env, name const & n) const;
+};
+
+void initialize_nat_module();
+void finalize_nat_module();
+}
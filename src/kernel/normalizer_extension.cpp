@@ -14,6 +14,8 @@ public:
     virtual bool supports(name const &) const { return false; }
     virtual bool is_recursor(environment const &, name const &) const { return false; }
     virtual bool is_builtin(environment const &, name const &) const { return false; }
+    virtual bool may_reduce(environment const &, name const &) const { return false; }
+    virtual optional<unsigned> get_major_idx(environment const &, name const &) const { return optional<unsigned>(); }
 };
 
 std::unique_ptr<normalizer_extension> mk_id_normalizer_extension() {
@@ -52,6 +54,21 @@ public:
     virtual bool is_builtin(environment const & env, name const & n) const {
         return m_ext1->is_builtin(env, n) || m_ext2->is_builtin(env, n);
     }
+
+    virtual bool may_reduce(environment const & env, name const & n) const {
+        return m_ext1->may_reduce(env, n) || m_ext2->may_reduce(env, n);
+    }
+
+    virtual optional<unsigned> get_major_idx(environment const & env, name const & n) const {
+        bool r1 = m_ext1->may_reduce(env, n);
+        bool r2 = m_ext2->may_reduce(env, n);
+        if (r1 && r2)
+            return optional<unsigned>(); /* both extensions may inspect different arguments */
+        else if (r1)
+            return m_ext1->get_major_idx(env, n);
+        else
+            return m_ext2->get_major_idx(env, n);
+    }
 };
 
 std::unique_ptr<normalizer_extension> compose(std::unique_ptr<normalizer_extension> && ext1, std::unique_ptr<normalizer_extension> && ext2) {
@@ -29,6 +29,12 @@ public:
     virtual bool supports(name const & feature) const = 0;
     virtual bool is_recursor(environment const & env, name const & n) const = 0;
     virtual bool is_builtin(environment const & env, name const & n) const = 0;
+    /** \brief Return true iff the extension may reduce applications of the constant \c n.
+        Applications of other constants are never reduced by the extension. */
+    virtual bool may_reduce(environment const & env, name const & n) const = 0;
+    /** \brief Return the position of the major premise of \c n, if the extension only inspects this argument
+        when reducing applications of \c n, and the other arguments are just copied to the result. */
+    virtual optional<unsigned> get_major_idx(environment const & env, name const & n) const = 0;
 };
 
 /** \brief Create the do-nothing normalizer extension */
@@ -198,6 +198,19 @@ bool quotient_normalizer_extension::is_builtin(environment const & env, name con
     return is_quotient_decl(env, n);
 }
 
+bool quotient_normalizer_extension::may_reduce(environment const &, name const & n) const {
+    return n == *g_quotient_lift || n == *g_quotient_ind;
+}
+
+optional<unsigned> quotient_normalizer_extension::get_major_idx(environment const &, name const & n) const {
+    if (n == *g_quotient_lift)
+        return optional<unsigned>(5);
+    else if (n == *g_quotient_ind)
+        return optional<unsigned>(4);
+    else
+        return optional<unsigned>();
+}
+
 bool is_quotient_decl(environment const & env, name const & n) {
     if (!get_extension(env).m_initialized)
         return false;
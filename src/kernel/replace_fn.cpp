@@ -4,8 +4,10 @@ Released under Apache 2.0 license as described in the file LICENSE.
 
 Author: Leonardo de Moura
 */
+#include <utility>
 #include <vector>
 #include <memory>
+#include "util/set_assoc_cache.h"
 #include "kernel/replace_fn.h"
 #include "kernel/cache_stack.h"
 
@@ -14,42 +16,22 @@ Author: Leonardo de Moura
 #endif
 
 namespace lean {
+static cache_stats g_replace_cache_stats("replace");
+
 struct replace_cache {
-    struct entry {
-        expr_cell * m_cell;
-        unsigned    m_offset;
-        expr        m_result;
-        entry():m_cell(nullptr) {}
-    };
-    unsigned              m_capacity;
-    std::vector<entry>    m_cache;
-    std::vector<unsigned> m_used;
-    replace_cache(unsigned c):m_capacity(c), m_cache(c) {}
+    typedef std::pair<expr_cell *, unsigned> key;
+    set_assoc_cache<key, expr> m_cache;
+    replace_cache(unsigned c):m_cache(g_replace_cache_stats, c) {}
 
     expr * find(expr const & e, unsigned offset) {
-        unsigned i = hash(e.hash_alloc(), offset) % m_capacity;
-        if (m_cache[i].m_cell == e.raw() && m_cache[i].m_offset == offset)
-            return &m_cache[i].m_result;
-        else
-            return nullptr;
+        return m_cache.find(hash(e.hash_alloc(), offset), key(e.raw(), offset));
     }
 
     void insert(expr const & e, unsigned offset, expr const & v) {
-        unsigned i = hash(e.hash_alloc(), offset) % m_capacity;
-        if (m_cache[i].m_cell == nullptr)
-            m_used.push_back(i);
-        m_cache[i].m_cell   = e.raw();
-        m_cache[i].m_offset = offset;
-        m_cache[i].m_result = v;
+        m_cache.insert(hash(e.hash_alloc(), offset), key(e.raw(), offset), v);
     }
 
-    void clear() {
-        for (unsigned i : m_used) {
-            m_cache[i].m_cell   = nullptr;
-            m_cache[i].m_result = expr();
-        }
-        m_used.clear();
-    }
+    void clear() { m_cache.clear(); }
 };
 
 MK_CACHE_STACK(replace_cache, LEAN_DEFAULT_REPLACE_CACHE_CAPACITY)
@@ -17,4 +17,11 @@ environment mk_environment(unsigned trust_lvl) {
                        compose(std::unique_ptr<normalizer_extension>(new inductive_normalizer_extension()),
                                std::unique_ptr<normalizer_extension>(new quotient_normalizer_extension())));
 }
+
+environment mk_environment(unsigned trust_lvl, std::unique_ptr<normalizer_extension> && ext) {
+    return environment(trust_lvl,
+                       compose(compose(std::unique_ptr<normalizer_extension>(new inductive_normalizer_extension()),
+                                       std::unique_ptr<normalizer_extension>(new quotient_normalizer_extension())),
+                               std::move(ext)));
+}
 }
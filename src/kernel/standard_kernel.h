@@ -10,4 +10,6 @@ Author: Leonardo de Moura
 namespace lean {
 /** \brief Create standard Lean environment */
 environment mk_environment(unsigned trust_lvl = 0);
+/** \brief Create standard Lean environment, \c ext is used in addition to the standard normalizer extensions. */
+environment mk_environment(unsigned trust_lvl, std::unique_ptr<normalizer_extension> && ext);
 }
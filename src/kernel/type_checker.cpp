@@ -6,6 +6,7 @@ Author: Leonardo de Moura
 */
 #include <utility>
 #include <vector>
+#include <functional>
 #include "util/task.h"
 #include "util/interrupt.h"
 #include "util/lbool.h"
@@ -13,6 +14,10 @@ Author: Leonardo de Moura
 #include "util/sstream.h"
 #include "util/scoped_map.h"
 #include "util/fresh_name.h"
+#include "util/sampling_profiler.h"
+#include "util/lru_cache.h"
+#include "util/cache_stats.h"
+#include "util/name_set.h"
 #include "kernel/type_checker.h"
 #include "kernel/expr_maps.h"
 #include "kernel/instantiate.h"
@@ -21,11 +26,180 @@ Author: Leonardo de Moura
 #include "kernel/kernel_exception.h"
 #include "kernel/abstract.h"
 #include "kernel/replace_fn.h"
+#include "kernel/for_each_fn.h"
+#include "kernel/krivine_machine.h"
 #include "util/task_builder.h"
 
+#ifndef LEAN_KERNEL_SHARED_CACHE_CAPACITY
+#define LEAN_KERNEL_SHARED_CACHE_CAPACITY 1024*64
+#endif
+
+#ifndef LEAN_KERNEL_SHARED_CACHE_SHARDS
+#define LEAN_KERNEL_SHARED_CACHE_SHARDS 16
+#endif
+
 namespace lean {
 static expr * g_dont_care = nullptr;
 
+static cache_stats g_shared_cache_stats("kernel shared");
+static cache_stats g_shared_cache_deps_stats("kernel shared (other environments)");
+
+/** \brief Store in \c deps the declarations of the constants occurring in \c e, and return false
+    if \c e contains macros. Macros may depend on constants that do not occur in \c e. */
+static bool get_dependencies(environment const & env, expr const & e, list<declaration> & deps) {
+    bool ok = true;
+    name_set visited;
+    for_each(e, [&](expr const & s, unsigned) {
+            if (!ok) return false;
+            if (is_macro(s)) {
+                ok = false;
+            } else if (is_constant(s) && !visited.contains(const_name(s))) {
+                visited.insert(const_name(s));
+                if (optional<declaration> d = env.find(const_name(s)))
+                    deps = cons(*d, deps);
+                else
+                    ok = false;
+            }
+            return ok && !is_atomic(s);
+        });
+    return ok;
+}
+
+/** \brief Return true iff the given declarations are also the declarations of \c env.
+
+    Then, the kernel results computed for a term whose constants have these declarations are also valid
+    in \c env, since declarations only refer to constants declared before them. We use this test to reuse
+    results across sibling environments, e.g., modules importing the same modules. */
+static bool same_dependencies(environment const & env, list<declaration> const & deps) {
+    for (declaration const & d : deps) {
+        optional<declaration> d2 = env.find(d.get_name());
+        if (!d2 || !is_eqp(d, *d2))
+            return false;
+    }
+    return true;
+}
+
+static bool     g_use_shared_cache      = true;
+static unsigned g_shared_cache_capacity = LEAN_KERNEL_SHARED_CACHE_CAPACITY;
+
+/** \brief Cache of kernel results for closed terms (i.e., without local constants and metavariables)
+    shared by all type checkers. Type checkers are created for each declaration, and this cache allows them
+    to reuse the work of previous ones, including the ones of other modules.
+
+    A result computed in an environment is used in descendants of this environment, and in any environment
+    where the constants occurring in the term have the same declarations (see \c same_dependencies).
+    Entries do not keep the environment alive: they only store its identifier and the declarations
+    of the constants occurring in the term. Each shard is a LRU cache protected by its own mutex. */
+template<typename Eq>
+class kernel_shared_cache {
+    struct entry {
+        expr                       m_expr;
+        mutable environment_id     m_env_id;
+        /* Declarations of the constants occurring in \c m_expr, only valid if \c m_has_deps is true. */
+        mutable list<declaration>  m_deps;
+        mutable bool               m_has_deps;
+        mutable expr               m_result;
+        entry(expr const & e, environment_id const & id, list<declaration> const & deps, bool has_deps,
+              expr const & r):
+            m_expr(e), m_env_id(id), m_deps(deps), m_has_deps(has_deps), m_result(r) {}
+    };
+    struct entry_hash { unsigned operator()(entry const & e) const { return e.m_expr.hash(); } };
+    struct entry_eq {
+        bool operator()(entry const & e1, entry const & e2) const { return Eq()(e1.m_expr, e2.m_expr); }
+    };
+    struct shard {
+        mutex                                       m_mutex;
+        lru_cache<entry, entry_hash, entry_eq>      m_cache;
+        shard():m_cache(g_shared_cache_capacity / LEAN_KERNEL_SHARED_CACHE_SHARDS) {}
+    };
+    shard m_shards[LEAN_KERNEL_SHARED_CACHE_SHARDS];
+
+    shard & get_shard(expr const & e) { return m_shards[e.hash() % LEAN_KERNEL_SHARED_CACHE_SHARDS]; }
+
+public:
+    optional<expr> find(environment const & env, expr const & e) {
+        list<declaration> deps;
+        expr              result;
+        {
+            shard & s = get_shard(e);
+            lock_guard<mutex> lock(s.m_mutex);
+            entry const * it = s.m_cache.find(entry(e, env.get_id(), deps, false, e));
+            if (!it) {
+                g_shared_cache_stats.m_misses++;
+                return none_expr();
+            }
+            if (env.get_id().is_descendant(it->m_env_id)) {
+                g_shared_cache_stats.m_hits++;
+                return some_expr(it->m_result);
+            }
+            if (!it->m_has_deps) {
+                g_shared_cache_stats.m_misses++;
+                return none_expr();
+            }
+            deps   = it->m_deps;
+            result = it->m_result;
+        }
+        /* We check the dependencies without holding the lock. */
+        if (same_dependencies(env, deps)) {
+            g_shared_cache_stats.m_hits++;
+            g_shared_cache_deps_stats.m_hits++;
+            return some_expr(result);
+        }
+        g_shared_cache_stats.m_misses++;
+        g_shared_cache_deps_stats.m_misses++;
+        return none_expr();
+    }
+
+    void insert(environment const & env, expr const & e, expr const & r) {
+        /* We collect the dependencies without holding the lock. */
+        list<declaration> deps;
+        bool has_deps = get_dependencies(env, e, deps);
+        shard & s = get_shard(e);
+        lock_guard<mutex> lock(s.m_mutex);
+        if (entry const * it = s.m_cache.insert(entry(e, env.get_id(), deps, has_deps, r))) {
+            it->m_env_id   = env.get_id();
+            it->m_deps     = deps;
+            it->m_has_deps = has_deps;
+            it->m_result   = r;
+        }
+    }
+
+    void set_capacity(unsigned c) {
+        for (shard & s : m_shards) {
+            lock_guard<mutex> lock(s.m_mutex);
+            s.m_cache.set_capacity(c / LEAN_KERNEL_SHARED_CACHE_SHARDS);
+        }
+    }
+};
+
+/* In the cache of inferred types, we must take into account binder information (see type_checker::cache). */
+static kernel_shared_cache<is_bi_equal_proc> *       g_shared_infer_cache = nullptr;
+static kernel_shared_cache<std::equal_to<expr>> *    g_shared_whnf_cache  = nullptr;
+
+static bool g_use_krivine_machine = false;
+
+void set_kernel_krivine_machine(bool enabled) {
+    g_use_krivine_machine = enabled;
+}
+
+bool get_kernel_krivine_machine() {
+    return g_use_krivine_machine;
+}
+
+void set_kernel_shared_cache(bool enabled) {
+    g_use_shared_cache = enabled;
+}
+
+void set_kernel_shared_cache_capacity(unsigned capacity) {
+    g_shared_cache_capacity = capacity;
+    if (g_shared_infer_cache) g_shared_infer_cache->set_capacity(capacity);
+    if (g_shared_whnf_cache) g_shared_whnf_cache->set_capacity(capacity);
+}
+
+static bool use_shared_cache(expr const & e) {
+    return g_use_shared_cache && !has_local(e) && !has_metavar(e);
+}
+
 optional<expr> type_checker::expand_macro(expr const & m) {
     lean_assert(is_macro(m));
     return macro_def(m).expand(m, *this);
@@ -216,6 +390,13 @@ expr type_checker::infer_type_core(expr const & e, bool infer_only) {
         auto it = m_infer_type_cache[infer_only].find(e);
         if (it != m_infer_type_cache[infer_only].end())
             return it->second;
+        /* When infer_only is false, the result also depends on m_params and m_trusted_only. */
+        if (infer_only && use_shared_cache(e)) {
+            if (auto r = g_shared_infer_cache->find(m_env, e)) {
+                m_infer_type_cache[infer_only].insert(mk_pair(e, *r));
+                return *r;
+            }
+        }
     }
 
     expr r;
@@ -235,8 +416,11 @@ expr type_checker::infer_type_core(expr const & e, bool infer_only) {
     case expr_kind::Let:       r = infer_let(e, infer_only);            break;
     }
 
-    if (m_memoize)
+    if (m_memoize) {
         m_infer_type_cache[infer_only].insert(mk_pair(e, r));
+        if (infer_only && use_shared_cache(e))
+            g_shared_infer_cache->insert(m_env, e, r);
+    }
     return r;
 }
 
@@ -307,6 +491,13 @@ expr type_checker::whnf_core(expr const & e) {
             return it->second;
     }
 
+    if (m_machine) {
+        expr r = m_machine->whnf_core(e);
+        if (m_memoize)
+            m_whnf_core_cache.insert(mk_pair(e, r));
+        return r;
+    }
+
     // do the actual work
     expr r;
     switch (e.kind()) {
@@ -408,6 +599,22 @@ expr type_checker::whnf(expr const & e) {
         auto it = m_whnf_cache.find(e);
         if (it != m_whnf_cache.end())
             return it->second;
+        if (use_shared_cache(e)) {
+            if (auto r = g_shared_whnf_cache->find(m_env, e)) {
+                m_whnf_cache.insert(mk_pair(e, *r));
+                return *r;
+            }
+        }
+    }
+
+    if (m_machine) {
+        expr r = m_machine->whnf(e);
+        if (m_memoize) {
+            m_whnf_cache.insert(mk_pair(e, r));
+            if (use_shared_cache(e))
+                g_shared_whnf_cache->insert(m_env, e, r);
+        }
+        return r;
     }
 
     expr t = e;
@@ -417,8 +624,11 @@ expr type_checker::whnf(expr const & e) {
             t = *next_t;
         } else {
             auto r = t1;
-            if (m_memoize)
+            if (m_memoize) {
                 m_whnf_cache.insert(mk_pair(e, r));
+                if (use_shared_cache(e))
+                    g_shared_whnf_cache->insert(m_env, e, r);
+            }
             return r;
         }
     }
@@ -578,6 +788,15 @@ void type_checker::cache_failure(expr const & t, expr const & s) {
         m_failure_cache.insert(mk_pair(s, t));
 }
 
+/** \brief Unfold the head constant of \c e (its declaration is \c d), and put the result in weak head normal form. */
+expr type_checker::lazy_delta_unfold(expr const & e, declaration const & d) {
+    if (m_delta_stats) {
+        (*m_delta_stats)[d.get_name()].m_unfolds++;
+        m_num_delta_unfolds++;
+    }
+    return whnf_core(*unfold_definition(e));
+}
+
 /** \brief Perform one lazy delta-reduction step.
      Return
      - l_true if t_n and s_n are definitionally equal.
@@ -591,15 +810,19 @@ auto type_checker::lazy_delta_reduction_step(expr & t_n, expr & s_n) -> reductio
     if (!d_t && !d_s) {
         return reduction_status::DefUnknown;
     } else if (d_t && !d_s) {
-        t_n = whnf_core(*unfold_definition(t_n));
+        t_n = lazy_delta_unfold(t_n, *d_t);
     } else if (!d_t && d_s) {
-        s_n = whnf_core(*unfold_definition(s_n));
+        s_n = lazy_delta_unfold(s_n, *d_s);
     } else {
         int c = compare(d_t->get_hints(), d_s->get_hints());
+        if (c == 0 && !is_eqp(*d_t, *d_s)) {
+            /* the heights do not decide, use the unfolding hints of the imported modules */
+            c = compare_delta_hints(m_env, d_t->get_name(), d_s->get_name());
+        }
         if (c < 0) {
-            t_n = whnf_core(*unfold_definition(t_n));
+            t_n = lazy_delta_unfold(t_n, *d_t);
         } else if (c > 0) {
-            s_n = whnf_core(*unfold_definition(s_n));
+            s_n = lazy_delta_unfold(s_n, *d_s);
         } else {
             if (is_app(t_n) && is_app(s_n) && is_eqp(*d_t, *d_s)) {
                 // If t_n and s_n are both applications of the same (non-opaque) definition,
@@ -614,18 +837,28 @@ auto type_checker::lazy_delta_reduction_step(expr & t_n, expr & s_n) -> reductio
                     // If they are, then t_n and s_n must be definitionally equal, and we can
                     // skip the delta-reduction step.
                     // If the flag use_self_opt() is not true, then we skip this optimization
-                    if (d_t->get_hints().use_self_opt() && !failed_before(t_n, s_n)) {
+                    // (we also skip it if the unfolding hints say that it usually fails).
+                    if (d_t->get_hints().use_self_opt() && !failed_before(t_n, s_n) &&
+                        !get_delta_hint(m_env, d_t->get_name()).m_no_self_opt) {
+                        unsigned num_unfolds = m_num_delta_unfolds;
                         if (is_def_eq(const_levels(get_app_fn(t_n)), const_levels(get_app_fn(s_n))) &&
                             is_def_eq_args(t_n, s_n)) {
+                            if (m_delta_stats)
+                                (*m_delta_stats)[d_t->get_name()].m_successes++;
                             return reduction_status::DefEqual;
                         } else {
+                            if (m_delta_stats) {
+                                delta_stats_entry & entry = (*m_delta_stats)[d_t->get_name()];
+                                entry.m_failures++;
+                                entry.m_failed_cost += m_num_delta_unfolds - num_unfolds;
+                            }
                             cache_failure(t_n, s_n);
                         }
                     }
                 }
             }
-            t_n = whnf_core(*unfold_definition(t_n));
-            s_n = whnf_core(*unfold_definition(s_n));
+            t_n = lazy_delta_unfold(t_n, *d_t);
+            s_n = lazy_delta_unfold(s_n, *d_s);
         }
     }
     switch (quick_is_def_eq(t_n, s_n)) {
@@ -704,9 +937,22 @@ bool type_checker::is_def_eq(expr const & t, expr const & s) {
 
 type_checker::type_checker(environment const & env, bool memoize, bool trusted_only):
     m_env(env), m_memoize(memoize), m_trusted_only(trusted_only), m_params(nullptr) {
+    if (g_use_krivine_machine)
+        m_machine.reset(new krivine_machine(*this));
+    if (delta_stats_enabled())
+        m_delta_stats.reset(new delta_stats());
+}
+
+optional<expr> type_checker::machine_normalize(expr const & e) {
+    if (m_machine)
+        return some_expr(m_machine->normalize(e));
+    return none_expr();
 }
 
-type_checker::~type_checker() {}
+type_checker::~type_checker() {
+    if (m_delta_stats)
+        merge_delta_stats(m_env, *m_delta_stats);
+}
 
 void check_no_metavar(environment const & env, name const & n, expr const & e, bool is_type) {
     if (has_metavar(e))
@@ -749,20 +995,26 @@ static void check_definition(environment const & env, declaration const & d, typ
     }
 }
 
-certified_declaration check(environment const & env, declaration const & d, bool immediately) {
+static void check_declaration_type(environment const & env, declaration const & d, type_checker & checker) {
     check_no_mlocal(env, d.get_name(), d.get_type(), true);
     check_name(env, d.get_name());
     check_duplicated_params(env, d);
-    bool memoize = true; bool trusted_only = d.is_trusted();
-    type_checker checker(env, memoize, trusted_only);
     expr sort = checker.check(d.get_type(), d.get_univ_params());
     checker.ensure_sort(sort, d.get_type());
+}
+
+certified_declaration check(environment const & env, declaration const & d, bool immediately) {
+    scoped_profiler_phase phase("kernel check");
+    bool memoize = true; bool trusted_only = d.is_trusted();
+    type_checker checker(env, memoize, trusted_only);
+    check_declaration_type(env, d, checker);
     if (d.is_definition()) {
         if (!immediately && env.trust_lvl() != 0 && d.is_theorem()) {
             // TODO(gabriel): cancellation
             auto checked_proof =
                     map<expr>(d.get_value_task(),
                               [d, env, memoize, trusted_only] (expr const & val) -> expr {
+                                  scoped_profiler_phase phase("kernel check");
                                   scoped_expr_caching disable(false);
                                   type_checker checker(env, memoize, trusted_only);
                                   check_definition(env, d, checker);
@@ -776,6 +1028,26 @@ certified_declaration check(environment const & env, declaration const & d, bool
     return certified_declaration(env.get_id(), d);
 }
 
+certified_declaration check_deferred(environment const & env, declaration const & d, std::function<void()> & check_value) {
+    bool memoize = true; bool trusted_only = d.is_trusted();
+    {
+        scoped_profiler_phase phase("kernel check");
+        type_checker checker(env, memoize, trusted_only);
+        check_declaration_type(env, d, checker);
+    }
+    if (d.is_definition()) {
+        check_value = [d, env, memoize, trusted_only] {
+            scoped_profiler_phase phase("kernel check");
+            scoped_expr_caching disable(false);
+            type_checker checker(env, memoize, trusted_only);
+            check_definition(env, d, checker);
+        };
+    } else {
+        check_value = nullptr;
+    }
+    return certified_declaration(env.get_id(), d);
+}
+
 certified_declaration certify_unchecked::certify(environment const & env, declaration const & d) {
     if (env.trust_lvl() == 0)
         throw_kernel_exception(env, "environment trust level does not allow users to add declarations that were not type checked");
@@ -790,10 +1062,14 @@ certified_declaration certify_unchecked::certify_or_check(environment const & en
 }
 
 void initialize_type_checker() {
-    g_dont_care = new expr(Const("dontcare"));
+    g_dont_care          = new expr(Const("dontcare"));
+    g_shared_infer_cache = new kernel_shared_cache<is_bi_equal_proc>();
+    g_shared_whnf_cache  = new kernel_shared_cache<std::equal_to<expr>>();
 }
 
 void finalize_type_checker() {
+    delete g_shared_whnf_cache;
+    delete g_shared_infer_cache;
     delete g_dont_care;
 }
 }
@@ -9,6 +9,7 @@ Author: Leonardo de Moura
 #include <memory>
 #include <utility>
 #include <algorithm>
+#include <functional>
 #include "util/lbool.h"
 #include "util/flet.h"
 #include "util/name_set.h"
@@ -18,8 +19,11 @@ Author: Leonardo de Moura
 #include "kernel/expr_maps.h"
 #include "kernel/equiv_manager.h"
 #include "kernel/abstract_type_context.h"
+#include "kernel/delta_hints.h"
 
 namespace lean {
+class krivine_machine;
+
 /** \brief Lean Type Checker. It can also be used to infer types, check whether a
     type \c A is convertible to a type \c B, etc. */
 class type_checker : public abstract_type_context {
@@ -38,6 +42,12 @@ class type_checker : public abstract_type_context {
     equiv_manager             m_eqv_manager;
     expr_pair_set             m_failure_cache;
     level_param_names const * m_params;
+    /* When set, it is used to compute weak head normal forms instead of substitution (see \c krivine_machine). */
+    std::unique_ptr<krivine_machine> m_machine;
+    /* Statistics of the lazy delta reduction, they are only collected when \c delta_stats_enabled()
+       and merged with the global ones when the type checker is destroyed. */
+    std::unique_ptr<delta_stats> m_delta_stats;
+    unsigned                     m_num_delta_unfolds = 0;
 
     pair<expr, expr> open_binding_body(expr const & e);
     expr ensure_sort_core(expr e, expr const & s);
@@ -72,6 +82,7 @@ class type_checker : public abstract_type_context {
     bool is_def_eq_proof_irrel(expr const & t, expr const & s);
     bool failed_before(expr const & t, expr const & s) const;
     void cache_failure(expr const & t, expr const & s);
+    expr lazy_delta_unfold(expr const & e, declaration const & d);
     reduction_status lazy_delta_reduction_step(expr & t_n, expr & s_n);
     lbool lazy_delta_reduction(expr & t_n, expr & s_n);
     bool is_def_eq_core(expr const & t, expr const & s);
@@ -129,6 +140,10 @@ public:
     /** \brief Return a metavariable that may be stucking the \c e's reduction. */
     virtual optional<expr> is_stuck(expr const & e);
 
+    /** \brief Return the normal form of \c e. It is only available when this type checker uses the
+        Krivine machine (see \c set_kernel_krivine_machine). */
+    optional<expr> machine_normalize(expr const & e);
+
     template<typename F>
     typename std::result_of<F()>::type with_params(level_param_names const & ps, F && f) {
         flet<level_param_names const *> updt(m_params, &ps);
@@ -138,12 +153,30 @@ public:
 
 typedef std::shared_ptr<type_checker> type_checker_ref;
 
+/** \brief Set whether type checkers created afterwards reduce terms using an abstract machine with closures
+    (see \c krivine_machine) instead of substitution (the default). */
+void set_kernel_krivine_machine(bool enabled);
+bool get_kernel_krivine_machine();
+
+/** \brief Set whether type checkers reuse the results for closed terms computed by other type checkers,
+    including the ones of other modules (enabled by default). */
+void set_kernel_shared_cache(bool enabled);
+/** \brief Set the maximum number of entries of each cache shared by the type checkers.
+    The least recently used entries are evicted first. */
+void set_kernel_shared_cache_capacity(unsigned capacity);
+
 void check_no_metavar(environment const & env, name const & n, expr const & e, bool is_type);
 
 /** \brief Type check the given declaration, and return a certified declaration if it is type correct.
     Throw an exception if the declaration is type incorrect. */
 certified_declaration check(environment const & env, declaration const & d, bool immediately = false);
 
+/** \brief Similar to \c check, but only the type of \c d is checked. If \c d is a definition, then
+    \c check_value is set to a procedure that type checks its value, and throws an exception if it is type incorrect.
+    The resulting environment must not be trusted before this procedure has been successfully executed.
+    It can be executed in a different thread, and is used to check independent declarations in parallel. */
+certified_declaration check_deferred(environment const & env, declaration const & d, std::function<void()> & check_value);
+
 void initialize_type_checker();
 void finalize_type_checker();
 }
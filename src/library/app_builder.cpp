@@ -118,6 +118,16 @@ public:
     }
 
     environment const & env() const { return m_env; }
+
+    /* The entries in m_map only depend on the types of constants,
+       but the relation tables may have been modified. */
+    void set_env(environment const & env) {
+        m_env          = env;
+        m_rel_getter   = mk_relation_info_getter(env);
+        m_refl_getter  = mk_refl_info_getter(env);
+        m_symm_getter  = mk_symm_info_getter(env);
+        m_trans_getter = mk_trans_info_getter(env);
+    }
 };
 
 typedef cache_compatibility_helper<app_builder_cache> app_builder_cache_helper;
@@ -7,20 +7,45 @@ Author: Leonardo de Moura
 #pragma once
 #include <memory>
 #include "library/type_context.h"
+#include "library/reducible.h"
+#include "library/class.h"
 
 namespace lean {
 /** \brief Helper class for making sure we have a cache that is compatible
-    with a given environment and transparency mode. */
+    with a given environment and transparency mode.
+
+    The cache survives when the environment is extended, that is, when the new environment
+    is a descendant of the one used to create the cache, and the reducibility annotations
+    and instances have not been modified. Adding declarations does not change the type
+    or the unfolding of existing constants, so the cached facts are still valid.
+    In this case, the method <tt>Cache::set_env(env)</tt> is invoked, and it must discard or
+    refresh any data that depends on other parts of the environment (e.g., relation tables). */
 template<typename Cache>
 class cache_compatibility_helper {
-    std::unique_ptr<Cache> m_cache_ptr[LEAN_NUM_TRANSPARENCY_MODES];
+    struct entry {
+        std::unique_ptr<Cache> m_cache_ptr;
+        unsigned               m_reducibility_fingerprint;
+        unsigned               m_instance_fingerprint;
+    };
+    entry m_entries[LEAN_NUM_TRANSPARENCY_MODES];
 public:
     Cache & get_cache_for(environment const & env, transparency_mode m) {
-        unsigned midx = static_cast<unsigned>(m);
-        if (!m_cache_ptr[midx] || !is_eqp(env, m_cache_ptr[midx]->env())) {
-            m_cache_ptr[midx].reset(new Cache(env));
+        entry & e = m_entries[static_cast<unsigned>(m)];
+        if (e.m_cache_ptr && is_eqp(env, e.m_cache_ptr->env()))
+            return *e.m_cache_ptr.get();
+        unsigned red_fingerprint  = get_reducibility_fingerprint(env);
+        unsigned inst_fingerprint = get_instance_fingerprint(env);
+        if (e.m_cache_ptr &&
+            env.is_descendant(e.m_cache_ptr->env()) &&
+            red_fingerprint  == e.m_reducibility_fingerprint &&
+            inst_fingerprint == e.m_instance_fingerprint) {
+            e.m_cache_ptr->set_env(env);
+        } else {
+            e.m_cache_ptr.reset(new Cache(env));
+            e.m_reducibility_fingerprint = red_fingerprint;
+            e.m_instance_fingerprint     = inst_fingerprint;
         }
-        return *m_cache_ptr[midx].get();
+        return *e.m_cache_ptr.get();
     }
 
     Cache & get_cache_for(type_context const & ctx) {
@@ -28,7 +53,7 @@ public:
     }
 
     void clear() {
-        for (unsigned i = 0; i < 4; i++) m_cache_ptr[i].reset();
+        for (entry & e : m_entries) e.m_cache_ptr.reset();
     }
 };
 
@@ -37,6 +37,13 @@ struct congr_lemma_cache {
         m_env(env),
         m_relation_info_getter(mk_relation_info_getter(env)) {}
     environment const & env() const { return m_env; }
+    /* The relation congruence lemmas depend on the relation table, which may have been modified. */
+    void set_env(environment const & env) {
+        m_env = env;
+        m_relation_info_getter = mk_relation_info_getter(env);
+        m_rel_cache[0].clear();
+        m_rel_cache[1].clear();
+    }
 };
 
 typedef cache_compatibility_helper<congr_lemma_cache> congr_lemma_cache_helper;
@@ -0,0 +1,65 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include <string>
+#include "kernel/delta_hints.h"
+#include "library/module.h"
+#include "library/delta_hint_table.h"
+
+#ifndef LEAN_MAX_DELTA_HINTS_PER_MODULE
+#define LEAN_MAX_DELTA_HINTS_PER_MODULE 256
+#endif
+
+namespace lean {
+struct delta_hint_modification : public modification {
+    LEAN_MODIFICATION("dhint")
+
+    name       m_name;
+    delta_hint m_hint;
+
+    delta_hint_modification() {}
+    delta_hint_modification(name const & n, delta_hint const & h):m_name(n), m_hint(h) {}
+
+    void perform(environment & env) const override {
+        env = add_delta_hint(env, m_name, m_hint);
+    }
+
+    void serialize(serializer & s) const override {
+        s << m_name << m_hint.m_priority << m_hint.m_no_self_opt;
+    }
+
+    static std::shared_ptr<modification const> deserialize(deserializer & d) {
+        name n; unsigned p; bool no_self_opt;
+        d >> n >> p >> no_self_opt;
+        return std::make_shared<delta_hint_modification>(n, delta_hint(p, no_self_opt));
+    }
+};
+
+environment save_delta_hint_table(environment const & env) {
+    if (!delta_stats_enabled())
+        return env;
+    environment new_env = env;
+    unsigned num = 0;
+    for (auto const & p : get_module_delta_stats(env)) {
+        if (num == LEAN_MAX_DELTA_HINTS_PER_MODULE)
+            break;
+        /* ignore auxiliary constants that were type checked but not added to the module */
+        if (!env.find(p.first))
+            continue;
+        new_env = module::add(new_env, std::make_shared<delta_hint_modification>(p.first, p.second.to_hint()));
+        num++;
+    }
+    return new_env;
+}
+
+void initialize_delta_hint_table() {
+    delta_hint_modification::init();
+}
+
+void finalize_delta_hint_table() {
+    delta_hint_modification::finalize();
+}
+}
@@ -0,0 +1,18 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#pragma once
+#include "kernel/environment.h"
+
+namespace lean {
+/** \brief When the lazy delta statistics are enabled (see \c enable_delta_stats), store the unfolding hints
+    derived from the statistics collected for the module being compiled (see \c reset_delta_stats) in it.
+    The hints of the imported modules are merged, and used by the kernel and \c type_context. */
+environment save_delta_hint_table(environment const & env);
+
+void initialize_delta_hint_table();
+void finalize_delta_hint_table();
+}
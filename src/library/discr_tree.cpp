@@ -103,6 +103,7 @@ discr_tree::node_cell::node_cell(node_cell const & s):
     m_rc(0), m_id(mk_id()),
     m_children(s.m_children),
     m_star_child(s.m_star_child),
+    m_skip(s.m_skip),
     m_values(s.m_values) {
 }
 
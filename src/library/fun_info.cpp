@@ -49,6 +49,7 @@ struct fun_info_cache {
     prefix_cache  m_cache_prefix;
     fun_info_cache(environment const & env):m_env(env) {}
     environment const & env() const { return m_env; }
+    void set_env(environment const & env) { m_env = env; }
 };
 
 typedef cache_compatibility_helper<fun_info_cache> fun_info_cache_helper;
@@ -34,6 +34,7 @@ Author: Leonardo de Moura
 #include "library/relation_manager.h"
 #include "library/user_recursors.h"
 #include "library/noncomputable.h"
+#include "library/delta_hint_table.h"
 #include "library/aux_recursors.h"
 #include "library/type_context.h"
 #include "library/local_context.h"
@@ -52,6 +53,7 @@ Author: Leonardo de Moura
 #include "library/congr_lemma.h"
 #include "library/check.h"
 #include "library/parray.h"
+#include "library/discr_tree.h"
 #include "library/profiling.h"
 
 namespace lean {
@@ -102,6 +104,7 @@ void initialize_library_module() {
     initialize_relation_manager();
     initialize_user_recursors();
     initialize_noncomputable();
+    initialize_delta_hint_table();
     initialize_aux_recursors();
     initialize_app_builder();
     initialize_fun_info();
@@ -117,9 +120,11 @@ void initialize_library_module() {
     initialize_check();
     initialize_congr_lemma();
     initialize_parray();
+    initialize_discr_tree();
 }
 
 void finalize_library_module() {
+    finalize_discr_tree();
     finalize_parray();
     finalize_congr_lemma();
     finalize_check();
@@ -135,6 +140,7 @@ void finalize_library_module() {
     finalize_fun_info();
     finalize_app_builder();
     finalize_aux_recursors();
+    finalize_delta_hint_table();
     finalize_noncomputable();
     finalize_user_recursors();
     finalize_relation_manager();
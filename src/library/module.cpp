@@ -20,7 +20,9 @@ Author: Leonardo de Moura
 #include "util/interrupt.h"
 #include "util/name_map.h"
 #include "util/file_lock.h"
+#include "util/sampling_profiler.h"
 #include "kernel/type_checker.h"
+#include "kernel/delta_hints.h"
 #include "kernel/quotient/quotient.h"
 #include "library/module.h"
 #include "library/noncomputable.h"
@@ -166,7 +168,8 @@ environment add_transient_decl_pos_info(environment const & env, name const & de
 }
 
 static char const * g_olean_end_file = "EndFile";
-static char const * g_olean_header   = "oleanfile";
+/* The header is bumped whenever the layout of the file changes. Version 2 added the lazy section. */
+static char const * g_olean_header   = "oleanfile2";
 
 serializer & operator<<(serializer & s, module_name const & n) {
     if (n.m_relative)
@@ -188,7 +191,66 @@ deserializer & operator>>(deserializer & d, module_name & r) {
     return d;
 }
 
+/* Objects of the lazy section are serialized independently of each other, and of the
+   code section. So, they do not share subterms with the rest of the file, but they
+   can be deserialized in any order. */
+class lazy_section_serializer : public serializer::extension {
+public:
+    std::vector<std::string> m_objects;
+};
+
+class lazy_section_deserializer : public deserializer::extension {
+public:
+    /* m_file is kept alive by the tasks created by read_lazy_expr */
+    std::shared_ptr<mapped_file const>     m_file;
+    std::vector<std::pair<size_t, size_t>> m_objects;
+};
+
+struct lazy_section_sd {
+    unsigned m_s_extid;
+    unsigned m_d_extid;
+    lazy_section_sd() {
+        m_s_extid = serializer::register_extension([](){
+                return std::unique_ptr<serializer::extension>(new lazy_section_serializer());
+            });
+        m_d_extid = deserializer::register_extension([](){
+                return std::unique_ptr<deserializer::extension>(new lazy_section_deserializer());
+            });
+    }
+};
+
+static lazy_section_sd * g_lazy_section_sd = nullptr;
+
+void write_lazy_expr(serializer & s, expr const & e) {
+    std::ostringstream out(std::ios_base::binary);
+    serializer s1(out);
+    s1 << e;
+    auto & ext = s.get_extension<lazy_section_serializer>(g_lazy_section_sd->m_s_extid);
+    s << static_cast<unsigned>(ext.m_objects.size());
+    ext.m_objects.push_back(out.str());
+}
+
+task<expr> read_lazy_expr(deserializer & d) {
+    unsigned idx = d.read_unsigned();
+    auto & ext = d.get_extension<lazy_section_deserializer>(g_lazy_section_sd->m_d_extid);
+    if (idx >= ext.m_objects.size())
+        throw corrupted_stream_exception();
+    std::shared_ptr<mapped_file const> file = ext.m_file;
+    size_t offset = ext.m_objects[idx].first;
+    size_t size   = ext.m_objects[idx].second;
+    optional<std::string> fname = d.get_fname();
+    /* The task is not submitted, it is executed when it is forced.
+       We do not use the current cancellation token since the task outlives the import. */
+    return task_builder<expr>([file, offset, size, fname] {
+            memory_istream in(file->data() + offset, file->data() + offset + size);
+            scoped_expr_caching enable_caching(false);
+            deserializer d(in, fname);
+            return read_expr(d);
+        }).build_without_cancellation();
+}
+
 void write_module(loaded_module const & mod, std::ostream & out) {
+    scoped_profiler_phase phase("olean I/O");
     std::ostringstream out1(std::ios_base::binary);
     serializer s1(out1);
 
@@ -199,9 +261,14 @@ void write_module(loaded_module const & mod, std::ostream & out) {
     }
     s1 << g_olean_end_file;
 
+    std::vector<std::string> const & lazy_objects =
+        s1.get_extension<lazy_section_serializer>(g_lazy_section_sd->m_s_extid).m_objects;
+
     serializer s2(out);
     std::string r = out1.str();
     unsigned h    = hash(r.size(), [&](unsigned i) { return r[i]; });
+    for (std::string const & o : lazy_objects)
+        h = hash(h, hash_str(o.size(), o.c_str(), 11));
     s2 << g_olean_header << LEAN_VERSION_MAJOR << LEAN_VERSION_MINOR << LEAN_VERSION_PATCH;
     s2 << h;
     s2 << static_cast<bool>(get(mod.m_uses_sorry));
@@ -209,10 +276,17 @@ void write_module(loaded_module const & mod, std::ostream & out) {
     s2 << static_cast<unsigned>(mod.m_imports.size());
     for (auto m : mod.m_imports)
         s2 << m;
+    // store offset table of the lazy section
+    s2 << static_cast<unsigned>(lazy_objects.size());
+    for (std::string const & o : lazy_objects)
+        s2.write_unsigned(o.size());
     // store object code
     s2.write_unsigned(r.size());
     for (unsigned i = 0; i < r.size(); i++)
         s2.write_char(r[i]);
+    // store lazy section
+    for (std::string const & o : lazy_objects)
+        out.write(o.data(), o.size());
 }
 
 static task<bool> has_sorry(modification_list const & mods) {
@@ -285,12 +359,28 @@ struct decl_modification : public modification {
         env = import_helper::add_unchecked(env, decl);
     }
 
+    /* Proofs are stored in the lazy section of the .olean file,
+       they are only deserialized when they are needed (e.g., trust level 0). */
     void serialize(serializer & s) const override {
-        s << m_decl << m_trust_lvl;
+        if (m_decl.is_theorem()) {
+            s << true << m_decl.get_name() << m_decl.get_univ_params() << m_decl.get_type();
+            write_lazy_expr(s, m_decl.get_value());
+        } else {
+            s << false << m_decl;
+        }
+        s << m_trust_lvl;
     }
 
     static std::shared_ptr<modification const> deserialize(deserializer & d) {
-        auto decl = read_declaration(d);
+        declaration decl;
+        if (d.read_bool()) {
+            name n               = read_name(d);
+            level_param_names ps = read_level_params(d);
+            expr t               = read_expr(d);
+            decl = mk_theorem(n, ps, t, read_lazy_expr(d));
+        } else {
+            decl = read_declaration(d);
+        }
         unsigned trust_lvl; d >> trust_lvl;
         return std::make_shared<decl_modification>(std::move(decl), trust_lvl);
     }
@@ -479,13 +569,12 @@ environment add_inductive(environment                       env,
 }
 } // end of namespace module
 
-olean_data parse_olean(std::istream & in, std::string const & file_name, bool check_hash) {
+olean_data parse_olean(std::shared_ptr<mapped_file const> const & file, std::string const & file_name, bool check_hash) {
+    scoped_profiler_phase phase("olean I/O");
     unsigned major, minor, patch, claimed_hash;
-    unsigned code_size;
-    std::vector<module_name> imports;
-    std::vector<char> code;
-    bool uses_sorry;
+    olean_data r;
 
+    memory_istream in(file->data(), file->data() + file->size());
     deserializer d1(in, optional<std::string>(file_name));
     std::string header;
     d1 >> header;
@@ -494,27 +583,45 @@ olean_data parse_olean(std::istream & in, std::string const & file_name, bool ch
     d1 >> major >> minor >> patch >> claimed_hash;
     // Enforce version?
 
-    d1 >> uses_sorry;
+    d1 >> r.m_uses_sorry;
 
     unsigned num_imports  = d1.read_unsigned();
     for (unsigned i = 0; i < num_imports; i++) {
-        module_name r;
-        d1 >> r;
-        imports.push_back(r);
+        module_name m;
+        d1 >> m;
+        r.m_imports.push_back(m);
     }
 
-    code_size = d1.read_unsigned();
-    code.resize(code_size);
-    d1.read(code);
+    unsigned num_lazy = d1.read_unsigned();
+    buffer<size_t> lazy_sizes;
+    for (unsigned i = 0; i < num_lazy; i++)
+        lazy_sizes.push_back(d1.read_unsigned());
+
+    r.m_code_size  = d1.read_unsigned();
+    r.m_code_begin = in.get_pos();
+    if (!in || r.m_code_begin + r.m_code_size > file->size())
+        throw corrupted_file_exception(file_name);
+
+    size_t offset = r.m_code_begin + r.m_code_size;
+    for (size_t sz : lazy_sizes) {
+        r.m_lazy_objects.emplace_back(offset, sz);
+        offset += sz;
+    }
+    if (offset > file->size())
+        throw corrupted_file_exception(file_name);
 
 //    if (m_senv.env().trust_lvl() <= LEAN_BELIEVER_TRUST_LEVEL) {
     if (check_hash) {
-        unsigned computed_hash = hash(code_size, [&](unsigned i) { return code[i]; });
+        char const * code = file->data() + r.m_code_begin;
+        unsigned computed_hash = hash(r.m_code_size, [&](unsigned i) { return code[i]; });
+        for (auto const & o : r.m_lazy_objects)
+            computed_hash = hash(computed_hash, hash_str(o.second, file->data() + o.first, 11));
         if (claimed_hash != computed_hash)
             throw exception(sstream() << "file '" << file_name << "' has been corrupted, checksum mismatch");
     }
 
-    return { imports, code, uses_sorry };
+    r.m_file = file;
+    return r;
 }
 
 static void import_module(environment & env, std::string const & module_file_name, module_name const & ref,
@@ -552,7 +659,11 @@ environment import_modules(environment const & env0, std::string const & module_
 
     module_ext ext = get_extension(env);
     ext.m_direct_imports = refs;
-    return update(env, ext);
+    env = update(env, ext);
+    /* the unfolding hints of a module are derived from its own lazy delta statistics */
+    if (delta_stats_enabled())
+        env = reset_delta_stats(env);
+    return env;
 }
 
 environment import_modules(environment const & env0, std::string const & module_file_name,
@@ -589,12 +700,16 @@ std::shared_ptr<loaded_module const> cache_preimported_env(
     return lm;
 }
 
-modification_list parse_olean_modifications(std::vector<char> const & olean_code, std::string const & file_name) {
+modification_list parse_olean_modifications(olean_data const & olean, std::string const & file_name) {
+    scoped_profiler_phase phase("olean I/O");
     modification_list ms;
-    std::string s(olean_code.data(), olean_code.size());
-    std::istringstream in(s, std::ios_base::binary);
+    char const * code = olean.m_file->data() + olean.m_code_begin;
+    memory_istream in(code, code + olean.m_code_size);
     scoped_expr_caching enable_caching(false);
     deserializer d(in, optional<std::string>(file_name));
+    auto & lazy_ext = d.get_extension<lazy_section_deserializer>(g_lazy_section_sd->m_d_extid);
+    lazy_ext.m_file    = olean.m_file;
+    lazy_ext.m_objects = olean.m_lazy_objects;
     object_readers & readers = get_object_readers();
     unsigned obj_counter = 0;
     while (true) {
@@ -615,6 +730,7 @@ modification_list parse_olean_modifications(std::vector<char> const & olean_code
 }
 
 void import_module(modification_list const & modifications, std::string const & file_name, environment & env) {
+    scoped_profiler_phase phase("olean I/O");
     for (auto & m : modifications) {
         m->perform(env);
 
@@ -631,15 +747,79 @@ module_loader mk_olean_loader(std::vector<std::string> const & path) {
     return[=] (std::string const & module_fn, module_name const & ref) {
         auto base_dir = dirname(module_fn);
         auto fn = find_file(path, base_dir, ref.m_relative, ref.m_name, ".olean");
-        std::ifstream in(fn, std::ios_base::binary);
-        auto parsed = parse_olean(in, fn, check_hash);
-        auto modifs = parse_olean_modifications(parsed.m_serialized_modifications, fn);
+        auto parsed = parse_olean(std::make_shared<mapped_file>(fn), fn, check_hash);
+        auto modifs = parse_olean_modifications(parsed, fn);
         return std::make_shared<loaded_module>(
                 loaded_module { fn, parsed.m_imports, modifs,
                                 mk_pure_task<bool>(parsed.m_uses_sorry), {} });
     };
 }
 
+/* Loader used by mk_parallel_olean_loader. The first time a module is requested, we read
+   the headers of all .olean files in its transitive closure, and submit one task per file
+   for deserializing its modifications. So, the files are deserialized concurrently while
+   import_modules performs the modifications in topological order. */
+class parallel_olean_loader {
+    typedef task<std::shared_ptr<loaded_module const>> module_task;
+    std::vector<std::string>                      m_path;
+    mutex                                         m_mutex;
+    std::unordered_map<std::string, module_task>  m_modules;
+
+    module_task prefetch(std::string const & fn) {
+        lock_guard<mutex> lock(m_mutex);
+        buffer<std::string> todo;
+        todo.push_back(fn);
+        while (!todo.empty()) {
+            std::string cur = todo.back();
+            todo.pop_back();
+            if (m_modules.count(cur)) continue;
+            try {
+                bool check_hash = false;
+                olean_data parsed = parse_olean(std::make_shared<mapped_file>(cur), cur, check_hash);
+                for (auto & ref : parsed.m_imports) {
+                    try {
+                        todo.push_back(find_file(m_path, dirname(cur), ref.m_relative, ref.m_name, ".olean"));
+                    } catch (exception &) {
+                        // the error is reported when the import is performed
+                    }
+                }
+                auto load = [cur, parsed] {
+                    auto modifs = parse_olean_modifications(parsed, cur);
+                    return std::make_shared<loaded_module const>(
+                        loaded_module { cur, parsed.m_imports, modifs,
+                                        mk_pure_task<bool>(parsed.m_uses_sorry), {} });
+                };
+                if (has_task_queue()) {
+                    module_task t = task_builder<std::shared_ptr<loaded_module const>>(load).build();
+                    m_modules[cur] = t;
+                    taskq().submit(t);
+                } else {
+                    /* e.g., the SMT2 frontend imports the modules before the task queue is created */
+                    m_modules[cur] = mk_pure_task<std::shared_ptr<loaded_module const>>(load());
+                }
+            } catch (exception &) {
+                m_modules[cur] = std::make_shared<task_cell<std::shared_ptr<loaded_module const>>>(std::current_exception());
+            }
+        }
+        return m_modules[fn];
+    }
+
+public:
+    parallel_olean_loader(std::vector<std::string> const & path):m_path(path) {}
+
+    std::shared_ptr<loaded_module const> load(std::string const & module_fn, module_name const & ref) {
+        auto fn = find_file(m_path, dirname(module_fn), ref.m_relative, ref.m_name, ".olean");
+        return get(prefetch(fn));
+    }
+};
+
+module_loader mk_parallel_olean_loader(std::vector<std::string> const & path) {
+    auto ldr = std::make_shared<parallel_olean_loader>(path);
+    return[=] (std::string const & module_fn, module_name const & ref) {
+        return ldr->load(module_fn, ref);
+    };
+}
+
 module_loader mk_dummy_loader() {
     return[=] (std::string const &, module_name const &) -> std::shared_ptr<loaded_module const> {
         throw exception("module importing disabled");
@@ -649,6 +829,7 @@ module_loader mk_dummy_loader() {
 void initialize_module() {
     g_ext            = new module_ext_reg();
     g_object_readers = new object_readers();
+    g_lazy_section_sd = new lazy_section_sd();
     decl_modification::init();
     inductive_modification::init();
     quot_modification::init();
@@ -660,6 +841,7 @@ void finalize_module() {
     pos_info_mod::finalize();
     inductive_modification::finalize();
     decl_modification::finalize();
+    delete g_lazy_section_sd;
     delete g_object_readers;
     delete g_ext;
 }
@@ -11,6 +11,7 @@ Author: Leonardo de Moura
 #include <vector>
 #include "util/serializer.h"
 #include "util/optional.h"
+#include "util/mapped_file.h"
 #include "kernel/pos_info_provider.h"
 #include "kernel/inductive/inductive.h"
 #include "library/io_state.h"
@@ -43,6 +44,9 @@ struct loaded_module {
 };
 using module_loader = std::function<std::shared_ptr<loaded_module const> (std::string const &, module_name const &)>;
 module_loader mk_olean_loader(std::vector<std::string> const &);
+/** \brief Similar to #mk_olean_loader, but the .olean files of all modules in the transitive closure
+    of an import are read and deserialized concurrently on the task queue. */
+module_loader mk_parallel_olean_loader(std::vector<std::string> const &);
 module_loader mk_dummy_loader();
 
 /** \brief Return the list of declarations performed in the current module */
@@ -92,13 +96,23 @@ std::shared_ptr<loaded_module const> cache_preimported_env(
         loaded_module &&, environment const & initial_env,
         std::function<module_loader()> const & mk_mod_ldr);
 
+/** \brief Parsed header of an .olean file.
+
+    The modifications are stored in the code section. Objects written using #write_lazy_expr
+    are stored in the lazy section, which is indexed by an offset table, and are only
+    deserialized on first access. Both sections point into \c m_file, which is usually
+    memory-mapped. */
 struct olean_data {
     std::vector<module_name> m_imports;
-    std::vector<char> m_serialized_modifications;
+    std::shared_ptr<mapped_file const> m_file;
+    size_t m_code_begin = 0;
+    size_t m_code_size  = 0;
+    /* (offset, size) of each object in the lazy section */
+    std::vector<std::pair<size_t, size_t>> m_lazy_objects;
     bool m_uses_sorry;
 };
-olean_data parse_olean(std::istream & in, std::string const & file_name, bool check_hash = true);
-modification_list parse_olean_modifications(std::vector<char> const & serialized_modifications, std::string const & file_name);
+olean_data parse_olean(std::shared_ptr<mapped_file const> const & file, std::string const & file_name, bool check_hash = true);
+modification_list parse_olean_modifications(olean_data const & olean, std::string const & file_name);
 void import_module(modification_list const & modifications, std::string const & file_name, environment & env);
 
 struct modification {
@@ -120,6 +134,15 @@ public:
   static void finalize() {} \
   const char * get_key() const override { return k; }
 
+/** \brief Store \c e in the lazy section of the .olean file being written using \c s.
+    Only the index of the object is written to \c s.
+
+    \remark \c s must have been created by #write_module. */
+void write_lazy_expr(serializer & s, expr const & e);
+/** \brief Read an expression stored using #write_lazy_expr. The expression is only
+    deserialized when the resulting task is forced. */
+task<expr> read_lazy_expr(deserializer & d);
+
 using module_modification_reader = std::function<std::shared_ptr<modification const>(deserializer &)>;
 
 /** \brief Register a module object reader. The key \c k is used to identify the class of objects
@@ -8,11 +8,14 @@ Author: Gabriel Ebner
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <cstdio>
 #include "util/utf8.h"
 #include "util/lean_path.h"
 #include "util/file_lock.h"
 #include "library/module_mgr.h"
 #include "library/module.h"
+#include "library/delta_hint_table.h"
+#include "library/tactic/simp_lemmas.h"
 #include "frontends/lean/pp.h"
 #include "frontends/lean/parser.h"
 #include "library/library_task_builder.h"
@@ -117,8 +120,19 @@ static gtask compile_olean(std::shared_ptr<module_info const> const & mod, log_t
 
         auto olean_fn = olean_of_lean(mod->m_mod);
         exclusive_file_lock output_lock(olean_fn);
-        std::ofstream out(olean_fn, std::ios_base::binary);
-        write_module(*res.m_loaded_module, out);
+        /* We write to a temporary file and rename it, since the old .olean file
+           may still be memory-mapped by a process that is importing it. */
+        auto tmp_fn = olean_fn + ".tmp";
+        {
+            std::ofstream out(tmp_fn, std::ios_base::binary);
+            write_module(*res.m_loaded_module, out);
+            if (!out) throw exception(sstream() << "failed to write '" << tmp_fn << "'");
+        }
+#if defined(LEAN_WINDOWS)
+        std::remove(olean_fn.c_str());
+#endif
+        if (std::rename(tmp_fn.c_str(), olean_fn.c_str()) != 0)
+            throw exception(sstream() << "failed to write '" << olean_fn << "'");
         return unit();
     }).depends_on(mod_dep).depends_on(olean_deps).depends_on(errs), std::string("saving olean"));
 }
@@ -158,12 +172,10 @@ void module_mgr::build_module(module_id const & id, bool can_use_olean, name_set
         std::tie(contents, src, mtime) = m_vfs->load_module(id, !already_have_lean_version && can_use_olean);
 
         if (src == module_src::OLEAN) {
-            auto obj_code = contents;
-
-            std::istringstream in2(obj_code, std::ios_base::binary);
             auto olean_fn = olean_of_lean(id);
             bool check_hash = false;
-            auto parsed_olean = parse_olean(in2, olean_fn, check_hash);
+            auto parsed_olean = parse_olean(std::make_shared<mapped_file>(mapped_file::from_contents(), std::move(contents)),
+                                            olean_fn, check_hash);
 
             auto mod = std::make_shared<module_info>();
 
@@ -190,16 +202,21 @@ void module_mgr::build_module(module_id const & id, bool can_use_olean, name_set
             if (mod->m_trans_mtime > mod->m_mtime)
                 return build_module(id, false, orig_module_stack);
 
-            module_info::parse_result res;
-
             auto deps = mod->m_deps;
-            res.m_loaded_module = cache_preimported_env(
-                    { id, parsed_olean.m_imports,
-                      parse_olean_modifications(parsed_olean.m_serialized_modifications, id),
-                      mk_pure_task<bool>(parsed_olean.m_uses_sorry), {} },
-                    m_initial_env, [=] { return mk_loader(id, deps); });
-
-            mod->m_result = mk_pure_task<module_info::parse_result>(res);
+            auto initial_env = m_initial_env;
+            /* Deserializing the modifications is the expensive part of loading an .olean file.
+               We do it on the task queue, so that the .olean files of all modules in the
+               transitive closure are processed concurrently while we walk the import graph.
+               The modifications are still performed in topological order by import_modules. */
+            mod->m_result = add_library_task(task_builder<module_info::parse_result>([id, parsed_olean, initial_env, deps] {
+                module_info::parse_result res;
+                res.m_loaded_module = cache_preimported_env(
+                        { id, parsed_olean.m_imports,
+                          parse_olean_modifications(parsed_olean, id),
+                          mk_pure_task<bool>(parsed_olean.m_uses_sorry), {} },
+                        initial_env, [=] { return mk_loader(id, deps); });
+                return res;
+            }).wrap(exception_reporter()), std::string("loading olean"));
 
             if (auto & old_mod = m_modules[id])
                 cancel(old_mod->m_cancel);
@@ -283,9 +300,10 @@ module_mgr::build_lean(module_id const & id, std::string const & contents, time_
             module_info::parse_result parse_res;
 
             lean_always_assert(res.m_snapshot_at_end);
+            environment env = save_delta_hint_table(res.m_snapshot_at_end->m_env);
+            env = save_simp_lemmas_snapshot(env, res.m_snapshot_at_end->m_options);
             parse_res.m_loaded_module = cache_preimported_env(
-                    export_module(res.m_snapshot_at_end->m_env, id),
-                    initial_env, [=] { return ldr; });
+                    export_module(env, id), initial_env, [=] { return ldr; });
 
             parse_res.m_opts = res.m_snapshot_at_end->m_options;
 
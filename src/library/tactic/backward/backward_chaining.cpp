@@ -7,24 +7,37 @@ Author: Leonardo de Moura
 #include <limits>
 #include "util/sexpr/option_declarations.h"
 #include "library/trace.h"
+#include "library/util.h"
+#include "library/app_builder.h"
 #include "library/vm/vm_nat.h"
 #include "library/vm/vm_expr.h"
 #include "library/vm/vm_list.h"
 #include "library/tactic/tactic_state.h"
 #include "library/tactic/apply_tactic.h"
+#include "library/tactic/smt/congruence_closure.h"
+#include "library/tactic/smt/array_congruence_closure.h"
 #include "library/tactic/backward/backward_lemmas.h"
 
 #ifndef LEAN_DEFAULT_BACKWARD_CHAINING_MAX_DEPTH
 #define LEAN_DEFAULT_BACKWARD_CHAINING_MAX_DEPTH 8
 #endif
 
+#ifndef LEAN_DEFAULT_BACKWARD_CHAINING_CC
+#define LEAN_DEFAULT_BACKWARD_CHAINING_CC false
+#endif
+
 namespace lean {
 static name * g_backward_chaining_max_depth = nullptr;
+static name * g_backward_chaining_cc        = nullptr;
 
 unsigned get_backward_chaining_max_depth(options const & o) {
     return o.get_unsigned(*g_backward_chaining_max_depth, LEAN_DEFAULT_BACKWARD_CHAINING_MAX_DEPTH);
 }
 
+static bool get_backward_chaining_cc(options const & o) {
+    return o.get_bool(*g_backward_chaining_cc, LEAN_DEFAULT_BACKWARD_CHAINING_CC);
+}
+
 #define lean_back_trace(code) lean_trace(name({"tactic", "back_chaining"}), scope_trace_env _scope1(m_ctx.env(), m_ctx); code)
 
 struct back_chaining_fn {
@@ -35,6 +48,13 @@ struct back_chaining_fn {
     vm_obj               m_pre_tactic;
     vm_obj               m_leaf_tactic;
     backward_lemma_index m_lemmas;
+    /* When m_use_cc is true, the goals that follow from the hypotheses by congruence closure are closed
+       using congruence_closure. Since it is expensive, the goals are first checked using m_fast_cc,
+       which contains the hypotheses of the initial goal. It under-approximates congruence_closure,
+       so congruence_closure is only used when the check succeeds. */
+    bool                     m_use_cc;
+    local_context            m_initial_lctx;
+    array_congruence_closure m_fast_cc;
 
     struct choice {
         tactic_state         m_state;
@@ -48,7 +68,7 @@ struct back_chaining_fn {
 
     back_chaining_fn(tactic_state const & s, transparency_mode md, bool use_instances,
                      unsigned max_depth, vm_obj const & pre_tactic, vm_obj const & leaf_tactic,
-                     backward_lemma_index const & lemmas):
+                     backward_lemma_index const & lemmas, bool use_cc):
         m_initial_state(s),
         m_ctx(mk_type_context_for(s, md)),
         m_use_instances(use_instances),
@@ -56,8 +76,16 @@ struct back_chaining_fn {
         m_pre_tactic(pre_tactic),
         m_leaf_tactic(leaf_tactic),
         m_lemmas(lemmas),
+        m_use_cc(use_cc),
         m_state(m_initial_state) {
         lean_assert(s.goals());
+        if (m_use_cc) {
+            m_initial_lctx = s.get_main_goal_decl()->get_context();
+            m_initial_lctx.for_each([&](local_decl const & d) {
+                    if (m_ctx.is_prop(d.get_type()))
+                        m_fast_cc.add(m_ctx.instantiate_mvars(d.get_type()));
+                });
+        }
     }
 
     vm_obj invoke_tactic(vm_obj const & tac) {
@@ -93,6 +121,68 @@ struct back_chaining_fn {
         }
     }
 
+    /* Return true if m_fast_cc shows that the target follows from the hypotheses of the main goal.
+       The hypotheses that are not in the initial local context (e.g., introduced by the pre tactic) and
+       the target are only added in a new scope, since the next goal may be in a different branch. */
+    bool fast_cc_proves(type_context & ctx, local_context const & lctx, expr const & target) {
+        m_fast_cc.push();
+        lctx.for_each([&](local_decl const & d) {
+                if (!m_initial_lctx.find_local_decl(d.get_name()) && ctx.is_prop(d.get_type()))
+                    m_fast_cc.add(ctx.instantiate_mvars(d.get_type()));
+            });
+        expr lhs, rhs;
+        bool r;
+        if (m_fast_cc.inconsistent()) {
+            r = true;
+        } else if (is_eq(target, lhs, rhs)) {
+            m_fast_cc.internalize(target);
+            r = m_fast_cc.is_eqv(lhs, rhs);
+        } else {
+            m_fast_cc.internalize(target);
+            r = m_fast_cc.is_eqv(target, mk_true());
+        }
+        m_fast_cc.pop();
+        return r;
+    }
+
+    /* Try to close the main goal using congruence closure. */
+    bool try_cc() {
+        metavar_decl g   = *m_state.get_main_goal_decl();
+        type_context ctx = mk_type_context_for(m_state, m_ctx.mode());
+        expr target      = ctx.instantiate_mvars(g.get_type());
+        if (has_expr_metavar(target) || !ctx.is_prop(target) ||
+            !fast_cc_proves(ctx, g.get_context(), target))
+            return false;
+        congruence_closure::state ccs;
+        defeq_can_state dcs = m_state.dcs();
+        congruence_closure cc(ctx, ccs, dcs);
+        g.get_context().for_each([&](local_decl const & d) {
+                if (ctx.is_prop(d.get_type()))
+                    cc.add(d.get_type(), d.mk_ref(), 0);
+            });
+        cc.internalize(target, 0);
+        optional<expr> pr;
+        try {
+            if (cc.inconsistent()) {
+                if (auto H = cc.get_inconsistency_proof())
+                    pr = mk_false_rec(ctx, target, *H);
+            } else if (cc.proved(target)) {
+                if (auto H = cc.get_eq_proof(target, mk_true()))
+                    pr = mk_of_eq_true(ctx, *H);
+            }
+        } catch (app_builder_exception &) {
+        }
+        if (!pr) {
+            lean_back_trace(tout() << "congruence closure failed to prove goal accepted by fast check\n";);
+            return false;
+        }
+        lean_back_trace(tout() << "congruence closure solved goal\n";);
+        metavar_context mctx = ctx.mctx();
+        mctx.assign(head(m_state.goals()), *pr);
+        m_state = set_mctx_goals_dcs(m_state, mctx, tail(m_state.goals()), dcs);
+        return true;
+    }
+
     bool try_lemmas(list<backward_lemma> const & lemmas) {
         m_ctx.set_mctx(m_state.mctx());
         list<backward_lemma> it = lemmas;
@@ -148,6 +238,8 @@ struct back_chaining_fn {
                     return false;
                 goto loop_entry;
             }
+            if (m_use_cc && try_cc())
+                goto loop_entry;
             metavar_decl g = *m_state.get_main_goal_decl();
             expr target    = m_ctx.whnf(g.get_type());
             list<backward_lemma> lemmas = m_lemmas.find(head_index(target));
@@ -177,7 +269,8 @@ vm_obj back_chaining(transparency_mode md, bool use_instances, unsigned max_dept
                      vm_obj const & pre_tactic, vm_obj const & leaf_tactic, backward_lemma_index const & lemmas, tactic_state const & s) {
     optional<metavar_decl> g = s.get_main_goal_decl();
     if (!g) return mk_no_goals_exception(s);
-    return back_chaining_fn(s, md, use_instances, max_depth, pre_tactic, leaf_tactic, lemmas)();
+    bool use_cc = get_backward_chaining_cc(s.get_options());
+    return back_chaining_fn(s, md, use_instances, max_depth, pre_tactic, leaf_tactic, lemmas, use_cc)();
 }
 
 vm_obj tactic_backward_chaining(vm_obj const & md, vm_obj const & use_instances, vm_obj const & max_depth,
@@ -194,9 +287,13 @@ void initialize_backward_chaining() {
     g_backward_chaining_max_depth = new name{"back_chaining", "max_depth"};
     register_unsigned_option(*g_backward_chaining_max_depth, LEAN_DEFAULT_BACKWARD_CHAINING_MAX_DEPTH,
                              "maximum number of nested backward chaining steps");
+    g_backward_chaining_cc = new name{"back_chaining", "cc"};
+    register_bool_option(*g_backward_chaining_cc, LEAN_DEFAULT_BACKWARD_CHAINING_CC,
+                         "(back_chaining) close the goals that follow from the hypotheses by congruence closure");
 }
 
 void finalize_backward_chaining() {
     delete g_backward_chaining_max_depth;
+    delete g_backward_chaining_cc;
 }
 }
@@ -6,15 +6,25 @@ Author: Leonardo de Moura
 */
 #include <vector>
 #include <algorithm>
+#include "util/sexpr/option_declarations.h"
 #include "kernel/error_msgs.h"
 #include "kernel/instantiate.h"
 #include "kernel/for_each_fn.h"
 #include "kernel/find_fn.h"
+#include "kernel/inductive/inductive.h"
+#include "kernel/quotient/quotient.h"
 #include "library/constants.h"
 #include "library/trace.h"
+#include "library/num.h"
+#include "library/projection.h"
+#include "library/discr_tree.h"
+#include "library/unification_hint.h"
 #include "library/util.h"
 #include "library/reducible.h"
+#include "library/class.h"
 #include "library/attribute_manager.h"
+#include "library/module.h"
+#include "library/kernel_serializer.h"
 #include "library/relation_manager.h"
 #include "library/vm/vm_expr.h"
 #include "library/vm/vm_list.h"
@@ -140,6 +150,10 @@ unsigned simp_lemma::get_num_umeta() const {
     return length(m_ptr->m_umetas);
 }
 
+levels const & simp_lemma::get_umetas() const {
+    return m_ptr->m_umetas;
+}
+
 unsigned simp_lemma::get_num_emeta() const {
     return length(m_ptr->m_emetas);
 }
@@ -233,24 +247,335 @@ simp_lemma mk_congr_lemma(name const & id, levels const & umetas, list<expr> con
     return simp_lemma(new congr_lemma_cell(id, umetas, emetas, instances, lhs, rhs, proof, congr_hyps, priority));
 }
 
+#ifndef LEAN_DEFAULT_SIMP_INDEX
+#define LEAN_DEFAULT_SIMP_INDEX true
+#endif
+
+#ifndef LEAN_DEFAULT_SIMP_SNAPSHOT
+#define LEAN_DEFAULT_SIMP_SNAPSHOT true
+#endif
+
+#ifndef LEAN_SIMP_INDEX_MAX_UPDATE_DEPTH
+#define LEAN_SIMP_INDEX_MAX_UPDATE_DEPTH 32
+#endif
+
+static name * g_simp_index      = nullptr;
+static expr * g_simp_index_star = nullptr;
+static name * g_simp_snapshot   = nullptr;
+
+static bool get_simp_index(options const & o) {
+    return o.get_bool(*g_simp_index, LEAN_DEFAULT_SIMP_INDEX);
+}
+
+static bool get_simp_snapshot(options const & o) {
+    return o.get_bool(*g_simp_snapshot, LEAN_DEFAULT_SIMP_SNAPSHOT);
+}
+
+/* Discrimination tree for the lemmas of a simp_lemma_set.
+
+   The discrimination tree only compares terms syntactically, while simp lemmas are matched using is_def_eq.
+   So, the arguments that is_def_eq may relate to terms with a different head symbol are replaced with
+   a wildcard in both the keys and the queries (see mk_simp_index_key). Which arguments these are
+   depends on the transparency mode and on the environment, so we store one tree per transparency mode,
+   and rebuild it when the reducibility annotations or the unification hints change.
+
+   All components of a tree are persistent data structures. When lemmas are inserted into (or erased from)
+   a simp_lemma_set, e.g., by `simp [h]`, the new index records the updates and a reference to the index of
+   the original set, and its trees are obtained by updating (copies of) the trees of the original index. */
+struct simp_lemma_index {
+    struct tree {
+        unsigned                m_reducibility_fingerprint;
+        unsigned                m_uhints_fingerprint;
+        /* constants occurring in unification hints */
+        name_set                m_hinted;
+        discr_tree              m_tree;
+        /* The values stored in m_tree are of the form (Var i), they represent m_lemmas[i].
+           Among the lemmas with the same head symbol and priority, the ones that precede the others in
+           the simp_lemma_set have bigger indices. */
+        unsigned_map<simp_lemma> m_lemmas;
+        unsigned                 m_next_idx = 0;
+        /* indices of the lemmas with a given head symbol */
+        rb_map<head_index, list<unsigned>, head_index::cmp> m_head_lemmas;
+        /* The number of arguments of the left-hand-sides of the lemmas with a given head symbol.
+           The lemmas are also applied to terms with more arguments (see rewrite), so the
+           queries are performed on the prefixes of the term with these numbers of arguments. */
+        rb_map<head_index, list<unsigned>, head_index::cmp> m_lhs_nargs;
+    };
+    /* An update is an insertion (true) or an erasure (false) */
+    typedef std::vector<pair<bool, simp_lemma>> updates;
+    mutex                             m_mutex;
+    std::shared_ptr<tree const>       m_trees[static_cast<unsigned>(transparency_mode::None) + 1];
+    /* The simp_lemma_set before the updates in m_updates were performed, its index, and the length of this chain. */
+    simp_lemma_set                    m_prev_set;
+    std::shared_ptr<simp_lemma_index> m_prev;
+    updates                           m_updates;
+    unsigned                          m_depth = 0;
+};
+
+/* Return the index for the set obtained by performing \c us on \c s, where \c idx is the index of \c s. */
+static std::shared_ptr<simp_lemma_index> update_index(simp_lemma_set const & s, std::shared_ptr<simp_lemma_index> const & idx,
+                                                      simp_lemma_index::updates && us) {
+    if (us.empty())
+        return idx;
+    auto r = std::make_shared<simp_lemma_index>();
+    if (idx->m_depth < LEAN_SIMP_INDEX_MAX_UPDATE_DEPTH) {
+        r->m_prev_set = s;
+        r->m_prev     = idx;
+        r->m_depth    = idx->m_depth + 1;
+        r->m_updates  = std::move(us);
+    }
+    return r;
+}
+
 simp_lemmas_for::simp_lemmas_for():
-    m_eqv(get_eq_name()) {}
+    m_eqv(get_eq_name()),
+    m_simp_index(std::make_shared<simp_lemma_index>()),
+    m_congr_index(std::make_shared<simp_lemma_index>()) {}
 
 simp_lemmas_for::simp_lemmas_for(name const & eqv):
-    m_eqv(eqv) {}
+    m_eqv(eqv),
+    m_simp_index(std::make_shared<simp_lemma_index>()),
+    m_congr_index(std::make_shared<simp_lemma_index>()) {}
 
 void simp_lemmas_for::insert(simp_lemma const & r) {
-    if (r.is_congr())
+    simp_lemma_index::updates us;
+    us.emplace_back(true, r);
+    if (r.is_congr()) {
+        m_congr_index = update_index(m_congr_set, m_congr_index, std::move(us));
         m_congr_set.insert(r.get_lhs(), r);
-    else
+    } else {
+        m_simp_index  = update_index(m_simp_set, m_simp_index, std::move(us));
         m_simp_set.insert(r.get_lhs(), r);
+    }
 }
 
 void simp_lemmas_for::erase(simp_lemma const & r) {
-    if (r.is_congr())
+    simp_lemma_index::updates us;
+    us.emplace_back(false, r);
+    if (r.is_congr()) {
+        m_congr_index = update_index(m_congr_set, m_congr_index, std::move(us));
         m_congr_set.erase(r.get_lhs(), r);
-    else
+    } else {
+        m_simp_index  = update_index(m_simp_set, m_simp_index, std::move(us));
         m_simp_set.erase(r.get_lhs(), r);
+    }
+}
+
+/* Return true if is_def_eq may succeed on \c e and a term with a different head symbol. */
+static bool is_flexible_index_arg(type_context & ctx, name_set const & hinted, expr const & e) {
+    switch (e.kind()) {
+    case expr_kind::Meta: case expr_kind::Lambda: case expr_kind::Let: case expr_kind::Macro:
+        /* eta, zeta and macro expansion */
+        return true;
+    case expr_kind::Local:
+        if (optional<local_decl> d = ctx.lctx().find_local_decl(e))
+            return static_cast<bool>(d->get_value());
+        return false;
+    case expr_kind::Constant: case expr_kind::App:
+        break;
+    default:
+        return false;
+    }
+    expr const & fn = get_app_fn(e);
+    if (!is_constant(fn))
+        return !is_local(fn);
+    name const & n = const_name(fn);
+    environment const & env = ctx.env();
+    if (n == get_nat_succ_name() || n == get_nat_zero_name() || is_num(e))
+        return true;
+    if ((n == get_has_add_add_name() || n == get_has_sub_sub_name()) && get_app_num_args(e) == 4 &&
+        is_num(app_arg(e)))
+        return true; /* offset terms */
+    if (projection_info const * info = get_projection_info(env, n)) {
+        /* The projections of classes are only reduced when instances can be unfolded */
+        return !info->m_inst_implicit || ctx.mode() == transparency_mode::All ||
+            ctx.mode() == transparency_mode::Semireducible || ctx.mode() == transparency_mode::Instances;
+    }
+    return
+        hinted.contains(n) ||
+        inductive::is_elim_rule(env, n) ||
+        is_quotient_decl(env, n) ||
+        ctx.is_aux_recursor(n) ||
+        ctx.is_unfoldable(n);
+}
+
+/* Replace the flexible arguments occurring in \c e with wildcards. */
+static expr mk_simp_index_key(type_context & ctx, name_set const & hinted, expr const & e, bool is_root) {
+    if (!is_root && is_flexible_index_arg(ctx, hinted, e))
+        return *g_simp_index_star;
+    if (!is_app(e))
+        return e;
+    buffer<expr> args;
+    expr const & fn = get_app_args(e, args);
+    bool modified = false;
+    for (expr & arg : args) {
+        expr new_arg = mk_simp_index_key(ctx, hinted, arg, false);
+        if (!is_eqp(new_arg, arg)) {
+            arg      = new_arg;
+            modified = true;
+        }
+    }
+    return modified ? mk_app(fn, args) : e;
+}
+
+static void index_insert(type_context & ctx, simp_lemma_index::tree & t, simp_lemma const & sl) {
+    unsigned idx = t.m_next_idx++;
+    t.m_lemmas.insert(idx, sl);
+    head_index h(sl.get_lhs());
+    list<unsigned> head_lemmas;
+    if (list<unsigned> const * l = t.m_head_lemmas.find(h))
+        head_lemmas = *l;
+    t.m_head_lemmas.insert(h, cons(idx, head_lemmas));
+    unsigned nargs = get_app_num_args(sl.get_lhs());
+    list<unsigned> nargs_list;
+    if (list<unsigned> const * l = t.m_lhs_nargs.find(h))
+        nargs_list = *l;
+    if (std::find(nargs_list.begin(), nargs_list.end(), nargs) == nargs_list.end())
+        t.m_lhs_nargs.insert(h, cons(nargs, nargs_list));
+    try {
+        t.m_tree.insert(ctx, mk_simp_index_key(ctx, t.m_hinted, sl.get_lhs(), true), mk_var(idx));
+    } catch (exception &) {
+        /* lemma is not indexed, it is always a candidate */
+        t.m_tree.insert(ctx, *g_simp_index_star, mk_var(idx));
+    }
+}
+
+/* Erase the lemmas equal to \c sl, see head_map_prio::erase.
+   Remark: the candidates retrieved from the tree are ignored when they are not in m_lemmas anymore,
+   so we do not need to worry whether a key is still computed in the same way. */
+static void index_erase(type_context & ctx, simp_lemma_index::tree & t, simp_lemma const & sl) {
+    head_index h(sl.get_lhs());
+    list<unsigned> const * head_lemmas = t.m_head_lemmas.find(h);
+    if (!head_lemmas)
+        return;
+    buffer<unsigned> to_erase;
+    for (unsigned idx : *head_lemmas) {
+        simp_lemma const * sl2 = t.m_lemmas.find(idx);
+        if (sl2 && *sl2 == sl)
+            to_erase.push_back(idx);
+    }
+    if (to_erase.empty())
+        return;
+    t.m_head_lemmas.insert(h, filter(*head_lemmas, [&](unsigned idx) {
+                return std::find(to_erase.begin(), to_erase.end(), idx) == to_erase.end();
+            }));
+    for (unsigned idx : to_erase) {
+        t.m_lemmas.erase(idx);
+        try {
+            t.m_tree.erase(ctx, mk_simp_index_key(ctx, t.m_hinted, sl.get_lhs(), true), mk_var(idx));
+        } catch (exception &) {
+            t.m_tree.erase(ctx, *g_simp_index_star, mk_var(idx));
+        }
+    }
+}
+
+/* Return the tree of \c idx for the current transparency mode, where \c idx is the index of \c s.
+   If \c idx was obtained by updating another index (see update_index), then the tree is obtained by
+   updating the tree of that index. */
+static std::shared_ptr<simp_lemma_index::tree const> get_simp_index_tree(type_context & ctx, simp_lemma_index & idx,
+                                                                          simp_lemma_set const & s,
+                                                                          unsigned red_fp, unsigned uhints_fp) {
+    lock_guard<mutex> lock(idx.m_mutex);
+    std::shared_ptr<simp_lemma_index::tree const> & t = idx.m_trees[ctx.mode_idx()];
+    if (t && t->m_reducibility_fingerprint == red_fp && t->m_uhints_fingerprint == uhints_fp)
+        return t;
+    if (idx.m_prev) {
+        auto new_t = std::make_shared<simp_lemma_index::tree>(
+            *get_simp_index_tree(ctx, *idx.m_prev, idx.m_prev_set, red_fp, uhints_fp));
+        for (auto const & u : idx.m_updates) {
+            /* head_map_prio::insert replaces the lemmas that are equal to the new one */
+            index_erase(ctx, *new_t, u.second);
+            if (u.first)
+                index_insert(ctx, *new_t, u.second);
+        }
+        t = new_t;
+        return t;
+    }
+    environment const & env = ctx.env();
+    auto new_t = std::make_shared<simp_lemma_index::tree>();
+    new_t->m_reducibility_fingerprint = red_fp;
+    new_t->m_uhints_fingerprint       = uhints_fp;
+    get_unification_hints(env).for_each([&](name_pair const & p, unification_hint_queue const &) {
+            new_t->m_hinted.insert(p.first);
+            new_t->m_hinted.insert(p.second);
+        });
+    /* the lemmas that precede the others in s get bigger indices */
+    buffer<simp_lemma> lemmas;
+    s.for_each_entry([&](head_index const &, simp_lemma const & sl) { lemmas.push_back(sl); });
+    unsigned i = lemmas.size();
+    while (i > 0) {
+        --i;
+        index_insert(ctx, *new_t, lemmas[i]);
+    }
+    t = new_t;
+    return t;
+}
+
+static std::shared_ptr<simp_lemma_index::tree const> get_simp_index_tree(type_context & ctx, simp_lemma_index & idx,
+                                                                          simp_lemma_set const & s) {
+    return get_simp_index_tree(ctx, idx, s, get_reducibility_fingerprint(ctx.env()),
+                               get_attribute_fingerprint(ctx.env(), "unify"));
+}
+
+static void find_simp_index(type_context & ctx, simp_lemma_index & idx, simp_lemma_set const & s,
+                            expr const & e, buffer<simp_lemma> & r) {
+    head_index h(e);
+    list<simp_lemma> const * sls = s.find(h);
+    if (!sls)
+        return;
+    expr const & fn = get_app_fn(e);
+    if ((!is_constant(fn) && !is_local(fn)) || !get_simp_index(ctx.get_options())) {
+        to_buffer(*sls, r);
+        return;
+    }
+    try {
+        auto t = get_simp_index_tree(ctx, idx, s);
+        buffer<unsigned> ids;
+        unsigned e_nargs = get_app_num_args(e);
+        if (list<unsigned> const * lhs_nargs = t->m_lhs_nargs.find(h)) {
+            for (unsigned nargs : *lhs_nargs) {
+                if (nargs > e_nargs)
+                    continue;
+                expr prefix = e;
+                for (unsigned i = nargs; i < e_nargs; i++)
+                    prefix = app_fn(prefix);
+                t->m_tree.find(ctx, mk_simp_index_key(ctx, t->m_hinted, prefix, true), [&](expr const & v) {
+                        ids.push_back(var_idx(v));
+                        return true;
+                    });
+            }
+        }
+        /* the lemmas that are not indexed are found for every prefix */
+        std::sort(ids.begin(), ids.end());
+        ids.shrink(std::unique(ids.begin(), ids.end()) - ids.begin());
+        head_index::cmp cmp;
+        buffer<pair<unsigned, simp_lemma const *>> cs;
+        for (unsigned i : ids) {
+            simp_lemma const * sl = t->m_lemmas.find(i);
+            if (sl && cmp(head_index(sl->get_lhs()), h) == 0)
+                cs.emplace_back(i, sl);
+        }
+        /* priority order, see head_map_prio::insert */
+        std::sort(cs.begin(), cs.end(), [](pair<unsigned, simp_lemma const *> const & c1,
+                                           pair<unsigned, simp_lemma const *> const & c2) {
+                      unsigned p1 = c1.second->get_priority();
+                      unsigned p2 = c2.second->get_priority();
+                      return p1 > p2 || (p1 == p2 && c1.first > c2.first);
+                  });
+        for (auto const & c : cs)
+            r.push_back(*c.second);
+    } catch (exception &) {
+        r.clear();
+        to_buffer(*sls, r);
+    }
+}
+
+void simp_lemmas_for::find(type_context & ctx, expr const & e, buffer<simp_lemma> & r) const {
+    find_simp_index(ctx, *m_simp_index, m_simp_set, e, r);
+}
+
+void simp_lemmas_for::find_congr(type_context & ctx, expr const & e, buffer<simp_lemma> & r) const {
+    find_simp_index(ctx, *m_congr_index, m_congr_set, e, r);
 }
 
 list<simp_lemma> const * simp_lemmas_for::find(head_index const & h) const {
@@ -269,23 +594,25 @@ void simp_lemmas_for::for_each_congr(std::function<void(simp_lemma const &)> con
     m_congr_set.for_each_entry([&](head_index const &, simp_lemma const & r) { fn(r); });
 }
 
-static void erase_core(simp_lemma_set & S, name_set const & ids) {
+static void erase_core(simp_lemma_set & S, std::shared_ptr<simp_lemma_index> & idx, name_set const & ids) {
     // This method is not very smart and doesn't use any indexing or caching.
     // So, it may be a bottleneck in the future
-    buffer<simp_lemma> to_delete;
+    simp_lemma_index::updates to_delete;
     S.for_each_entry([&](head_index const &, simp_lemma const & r) {
             if (ids.contains(r.get_id())) {
-                to_delete.push_back(r);
+                to_delete.emplace_back(false, r);
             }
         });
-    for (simp_lemma const & r : to_delete) {
-        S.erase(r.get_lhs(), r);
+    simp_lemma_set old_S = S;
+    for (auto const & u : to_delete) {
+        S.erase(u.second.get_lhs(), u.second);
     }
+    idx = update_index(old_S, idx, std::move(to_delete));
 }
 
 void simp_lemmas_for::erase(name_set const & ids) {
-    erase_core(m_simp_set, ids);
-    erase_core(m_congr_set, ids);
+    erase_core(m_simp_set, m_simp_index, ids);
+    erase_core(m_congr_set, m_congr_index, ids);
 }
 
 void simp_lemmas_for::erase(buffer<name> const & ids) {
@@ -299,6 +626,7 @@ void simp_lemmas::insert(name const & eqv, simp_lemma const & r) {
     }
     s.insert(r);
     m_sets.insert(eqv, s);
+    reset_derivation();
 }
 
 void simp_lemmas::erase(name const & eqv, simp_lemma const & r) {
@@ -309,6 +637,7 @@ void simp_lemmas::erase(name const & eqv, simp_lemma const & r) {
             m_sets.erase(eqv);
         else
             m_sets.insert(eqv, s);
+        reset_derivation();
     }
 }
 
@@ -326,6 +655,7 @@ void simp_lemmas::erase(name_set const & ids) {
             new_sets.insert(n, new_s);
         });
     m_sets = new_sets;
+    reset_derivation();
 }
 
 void simp_lemmas::erase(buffer<name> const & ids) {
@@ -939,17 +1269,44 @@ static simp_lemmas add_congr_core(type_context & ctx, simp_lemmas const & s, nam
     return new_s;
 }
 
+bool operator==(simp_lemmas_update const & u1, simp_lemmas_update const & u2) {
+    return
+        u1.m_kind == u2.m_kind && u1.m_mode == u2.m_mode && u1.m_id == u2.m_id && u1.m_priority == u2.m_priority &&
+        u1.m_type == u2.m_type && u1.m_proof == u2.m_proof && u1.m_ids == u2.m_ids && is_eqp(u1.m_sets, u2.m_sets);
+}
+
 simp_lemmas add(type_context & ctx, simp_lemmas const & s, name const & id, unsigned priority) {
-    return ext_add_core(ctx, s, id, priority);
+    simp_lemmas r = ext_add_core(ctx, s, id, priority);
+    simp_lemmas_update u(simp_lemmas_update::kind::Add);
+    u.m_mode = ctx.mode(); u.m_id = id; u.m_priority = priority;
+    r.set_derivation(s, u);
+    return r;
 }
 
 simp_lemmas add(type_context & ctx, simp_lemmas const & s, name const & id, expr const & e, expr const & h, unsigned priority) {
     type_context::tmp_mode_scope scope(ctx);
-    return add_core(ctx, s, id, list<level>(), e, h, priority);
+    simp_lemmas r = add_core(ctx, s, id, list<level>(), e, h, priority);
+    simp_lemmas_update u(simp_lemmas_update::kind::AddHyp);
+    u.m_mode = ctx.mode(); u.m_id = id; u.m_priority = priority; u.m_type = e; u.m_proof = h;
+    r.set_derivation(s, u);
+    return r;
 }
 
 simp_lemmas add_congr(type_context & ctx, simp_lemmas const & s, name const & id, unsigned priority) {
-    return add_congr_core(ctx, s, id, priority);
+    simp_lemmas r = add_congr_core(ctx, s, id, priority);
+    simp_lemmas_update u(simp_lemmas_update::kind::AddCongr);
+    u.m_mode = ctx.mode(); u.m_id = id; u.m_priority = priority;
+    r.set_derivation(s, u);
+    return r;
+}
+
+simp_lemmas erase(simp_lemmas const & s, list<name> const & ids) {
+    simp_lemmas r = s;
+    r.erase(to_name_set(ids));
+    simp_lemmas_update u(simp_lemmas_update::kind::Erase);
+    u.m_ids = ids;
+    r.set_derivation(s, u);
+    return r;
 }
 
 simp_lemmas join(simp_lemmas const & s1, simp_lemmas const & s2) {
@@ -971,6 +1328,9 @@ simp_lemmas join(simp_lemmas const & s1, simp_lemmas const & s2) {
     for (unsigned i = clemmas.size() - 1; i + 1 > 0; --i)
         new_s1.insert(clemmas[i].first, clemmas[i].second);
 
+    simp_lemmas_update u(simp_lemmas_update::kind::Join);
+    u.m_sets = s2.m_sets;
+    new_s1.set_derivation(s1, u);
     return new_s1;
 }
 
@@ -988,15 +1348,252 @@ static void on_add_congr_lemma(environment const & env, name const & c, bool) {
     add_congr_core(ctx, s, c, LEAN_DEFAULT_PRIORITY);
 }
 
+/* Snapshots of the processed simp and congruence lemmas.
+
+   When a module is exported, the lemmas tagged with the attributes of the simp_lemmas collections are processed
+   using transparency_mode::Reducible, and the resulting (relation, simp_lemma) pairs are stored in the .olean
+   file (see save_simp_lemmas_snapshot). On import, they are merged into the following extension, and
+   get_simp_lemmas_from_attribute and get_congr_lemmas_from_attribute reuse them instead of analysing
+   the lemmas again. The pairs are stored in the order produced by simp_lemmas::for_each.
+
+   The result of the analysis depends on the reducibility annotations and the relation attributes, which may be
+   modified by the importing modules (e.g., `attribute [reducible] f` or `attribute [refl] R`). So each entry also stores the status (see get_snapshot_status)
+   of the constants occurring in the types of the lemmas and in the values of the reducible definitions
+   occurring in them, and it is only reused if these are still the same. */
+struct simp_snapshot_entry {
+    list<pair<name, unsigned>>   m_deps;
+    list<pair<name, simp_lemma>> m_lemmas;
+    simp_snapshot_entry() {}
+    simp_snapshot_entry(list<pair<name, unsigned>> const & deps, list<pair<name, simp_lemma>> const & lemmas):
+        m_deps(deps), m_lemmas(lemmas) {}
+};
+
+/* The status of a constant consists of its reducibility annotation, whether it is an instance, and whether it is
+   a reflexive, transitive or symmetric relation. The latter determine whether a lemma `R a b` is used to
+   rewrite `a` into `b` or `R a b` into `true` (see is_simp_relation). */
+static unsigned get_snapshot_status(environment const & env, name const & n) {
+    return
+        32 * static_cast<unsigned>(get_reducible_status(env, n)) +
+        (is_instance(env, n)       ? 1 : 0) +
+        (is_relation(env, n)       ? 2 : 0) +
+        (is_refl_relation(env, n)  ? 4 : 0) +
+        (is_trans_relation(env, n) ? 8 : 0) +
+        (is_symm_relation(env, n)  ? 16 : 0);
+}
+
+static list<pair<name, unsigned>> get_snapshot_deps(environment const & env, buffer<name> const & ids) {
+    name_set visited;
+    buffer<name> todo;
+    auto visit = [&](expr const & e) {
+        for_each(e, [&](expr const & c, unsigned) {
+                if (is_constant(c) && !visited.contains(const_name(c))) {
+                    visited.insert(const_name(c));
+                    todo.push_back(const_name(c));
+                }
+                return true;
+            });
+    };
+    for (name const & id : ids)
+        visit(env.get(id).get_type());
+    buffer<pair<name, unsigned>> deps;
+    while (!todo.empty()) {
+        name n = todo.back();
+        todo.pop_back();
+        deps.emplace_back(n, get_snapshot_status(env, n));
+        if (get_reducible_status(env, n) == reducible_status::Reducible) {
+            optional<declaration> d = env.find(n);
+            if (d && d->is_definition())
+                visit(d->get_value());
+        }
+    }
+    return to_list(deps);
+}
+
+static bool is_valid_snapshot_entry(environment const & env, simp_snapshot_entry const & e) {
+    for (auto const & p : e.m_deps) {
+        if (get_snapshot_status(env, p.first) != p.second)
+            return false;
+    }
+    return true;
+}
+
+struct simp_snapshot_ext : public environment_extension {
+    name_map<simp_snapshot_entry> m_simp;
+    name_map<simp_snapshot_entry> m_congr;
+};
+
+struct simp_snapshot_ext_reg {
+    unsigned m_ext_id;
+    simp_snapshot_ext_reg() { m_ext_id = environment::register_extension(std::make_shared<simp_snapshot_ext>()); }
+};
+
+static simp_snapshot_ext_reg * g_simp_snapshot_ext = nullptr;
+
+static simp_snapshot_ext const & get_simp_snapshot_ext(environment const & env) {
+    return static_cast<simp_snapshot_ext const &>(env.get_extension(g_simp_snapshot_ext->m_ext_id));
+}
+
+static environment update(environment const & env, simp_snapshot_ext const & ext) {
+    return env.update(g_simp_snapshot_ext->m_ext_id, std::make_shared<simp_snapshot_ext>(ext));
+}
+
+static void write_simp_lemma(serializer & s, simp_lemma const & sl) {
+    s << static_cast<char>(sl.kind()) << sl.get_id() << sl.get_umetas();
+    write_list(s, sl.get_emetas());
+    write_list(s, sl.get_instances());
+    s << sl.get_lhs() << sl.get_rhs() << sl.get_priority();
+    switch (sl.kind()) {
+    case simp_lemma_kind::Refl:
+        break;
+    case simp_lemma_kind::Simp:
+        s << sl.get_proof() << sl.is_permutation();
+        break;
+    case simp_lemma_kind::Congr:
+        s << sl.get_proof();
+        write_list(s, sl.get_congr_hyps());
+        break;
+    }
+}
+
+static simp_lemma read_simp_lemma(deserializer & d) {
+    char k; name id;
+    d >> k >> id;
+    levels umetas         = read_levels(d);
+    list<expr> emetas     = read_list<expr>(d);
+    list<bool> instances  = read_list<bool>(d);
+    expr lhs, rhs; unsigned prio;
+    d >> lhs >> rhs >> prio;
+    switch (static_cast<simp_lemma_kind>(k)) {
+    case simp_lemma_kind::Refl:
+        return mk_rfl_lemma(id, umetas, emetas, instances, lhs, rhs, prio);
+    case simp_lemma_kind::Simp: {
+        expr proof; bool is_perm;
+        d >> proof >> is_perm;
+        return mk_simp_lemma(id, umetas, emetas, instances, lhs, rhs, proof, is_perm, prio);
+    }
+    case simp_lemma_kind::Congr: {
+        expr proof;
+        d >> proof;
+        list<expr> congr_hyps = read_list<expr>(d);
+        return mk_congr_lemma(id, umetas, emetas, instances, lhs, rhs, proof, congr_hyps, prio);
+    }}
+    throw corrupted_stream_exception();
+}
+
+struct simp_snapshot_modification : public modification {
+    LEAN_MODIFICATION("simp_snapshot")
+
+    bool                m_congr;
+    name                m_id;
+    simp_snapshot_entry m_lemmas;
+
+    simp_snapshot_modification() {}
+    simp_snapshot_modification(bool congr, name const & id, simp_snapshot_entry const & lemmas):
+        m_congr(congr), m_id(id), m_lemmas(lemmas) {}
+
+    void perform(environment & env) const override {
+        simp_snapshot_ext ext = get_simp_snapshot_ext(env);
+        if (m_congr)
+            ext.m_congr.insert(m_id, m_lemmas);
+        else
+            ext.m_simp.insert(m_id, m_lemmas);
+        env = update(env, ext);
+    }
+
+    void serialize(serializer & s) const override {
+        s << m_congr << m_id << length(m_lemmas.m_deps);
+        for (auto const & p : m_lemmas.m_deps)
+            s << p.first << p.second;
+        s << length(m_lemmas.m_lemmas);
+        for (auto const & p : m_lemmas.m_lemmas) {
+            s << p.first;
+            write_simp_lemma(s, p.second);
+        }
+    }
+
+    static std::shared_ptr<modification const> deserialize(deserializer & d) {
+        bool congr; name id; unsigned num;
+        d >> congr >> id >> num;
+        buffer<pair<name, unsigned>> deps;
+        for (unsigned i = 0; i < num; i++) {
+            name n; unsigned status;
+            d >> n >> status;
+            deps.emplace_back(n, status);
+        }
+        d >> num;
+        buffer<pair<name, simp_lemma>> lemmas;
+        for (unsigned i = 0; i < num; i++) {
+            name eqv = read_name(d);
+            lemmas.emplace_back(eqv, read_simp_lemma(d));
+        }
+        return std::make_shared<simp_snapshot_modification>(congr, id, simp_snapshot_entry(to_list(deps), to_list(lemmas)));
+    }
+};
+
+static simp_lemma update_priority(simp_lemma const & sl, unsigned prio) {
+    if (sl.get_priority() == prio)
+        return sl;
+    switch (sl.kind()) {
+    case simp_lemma_kind::Refl:
+        return mk_rfl_lemma(sl.get_id(), sl.get_umetas(), sl.get_emetas(), sl.get_instances(),
+                            sl.get_lhs(), sl.get_rhs(), prio);
+    case simp_lemma_kind::Simp:
+        return mk_simp_lemma(sl.get_id(), sl.get_umetas(), sl.get_emetas(), sl.get_instances(),
+                             sl.get_lhs(), sl.get_rhs(), sl.get_proof(), sl.is_permutation(), prio);
+    case simp_lemma_kind::Congr:
+        return mk_congr_lemma(sl.get_id(), sl.get_umetas(), sl.get_emetas(), sl.get_instances(),
+                              sl.get_lhs(), sl.get_rhs(), sl.get_proof(), sl.get_congr_hyps(), prio);
+    }
+    lean_unreachable();
+}
+
+/* Insert the lemmas of a snapshot entry in \c s, in the same order \c join would. */
+static simp_lemmas add_snapshot_entry(simp_lemmas const & s, simp_snapshot_entry const & e, unsigned prio) {
+    buffer<pair<name, simp_lemma>> lemmas;
+    to_buffer(e.m_lemmas, lemmas);
+    simp_lemmas new_s = s;
+    unsigned i = lemmas.size();
+    while (i > 0) {
+        i--;
+        new_s.insert(lemmas[i].first, update_priority(lemmas[i].second, prio));
+    }
+    return new_s;
+}
+
+static simp_snapshot_entry to_snapshot_entry(environment const & env, name const & id, simp_lemmas const & s, bool congr) {
+    buffer<name> ids;
+    ids.push_back(id);
+    if (!congr)
+        get_ext_eqn_lemmas_for(env, id, ids);
+    buffer<pair<name, simp_lemma>> lemmas;
+    auto fn = [&](name const & eqv, simp_lemma const & sl) { lemmas.emplace_back(eqv, sl); };
+    if (congr)
+        s.for_each_congr(fn);
+    else
+        s.for_each(fn);
+    return simp_snapshot_entry(get_snapshot_deps(env, ids), to_list(lemmas));
+}
+
 static simp_lemmas get_simp_lemmas_from_attribute(type_context & ctx, name const & attr_name, simp_lemmas result) {
     auto const & attr = get_attribute(ctx.env(), attr_name);
     buffer<name> simp_lemmas;
     attr.get_instances(ctx.env(), simp_lemmas);
+    name_map<simp_snapshot_entry> const * snapshot = nullptr;
+    if (ctx.mode() == transparency_mode::Reducible)
+        snapshot = &get_simp_snapshot_ext(ctx.env()).m_simp;
     unsigned i = simp_lemmas.size();
     while (i > 0) {
         i--;
         name const & id = simp_lemmas[i];
-        result = ext_add_core(ctx, result, id, attr.get_prio(ctx.env(), id));
+        unsigned prio   = attr.get_prio(ctx.env(), id);
+        if (snapshot) {
+            simp_snapshot_entry const * e = snapshot->find(id);
+            if (e && is_valid_snapshot_entry(ctx.env(), *e)) {
+                result = add_snapshot_entry(result, *e, prio);
+                continue;
+            }
+        }
+        result = ext_add_core(ctx, result, id, prio);
     }
     return result;
 }
@@ -1005,11 +1602,22 @@ static simp_lemmas get_congr_lemmas_from_attribute(type_context & ctx, name cons
     auto const & attr = get_attribute(ctx.env(), attr_name);
     buffer<name> congr_lemmas;
     attr.get_instances(ctx.env(), congr_lemmas);
+    name_map<simp_snapshot_entry> const * snapshot = nullptr;
+    if (ctx.mode() == transparency_mode::Reducible)
+        snapshot = &get_simp_snapshot_ext(ctx.env()).m_congr;
     unsigned i = congr_lemmas.size();
     while (i > 0) {
         i--;
         name const & id = congr_lemmas[i];
-        result = add_congr_core(ctx, result, id, attr.get_prio(ctx.env(), id));
+        unsigned prio   = attr.get_prio(ctx.env(), id);
+        if (snapshot) {
+            simp_snapshot_entry const * e = snapshot->find(id);
+            if (e && is_valid_snapshot_entry(ctx.env(), *e)) {
+                result = add_snapshot_entry(result, *e, prio);
+                continue;
+            }
+        }
+        result = add_congr_core(ctx, result, id, prio);
     }
     return result;
 }
@@ -1048,15 +1656,22 @@ static simp_lemmas_config const & get_simp_lemmas_config(simp_lemmas_token tk) {
     return (*g_simp_lemmas_configs)[tk];
 }
 
+/* The relation attributes determine which lemmas are used to rewrite modulo a relation (see is_simp_relation). */
+static unsigned get_relation_fingerprint(environment const & env) {
+    return hash(get_attribute_fingerprint(env, "refl"),
+                hash(get_attribute_fingerprint(env, "trans"), get_attribute_fingerprint(env, "symm")));
+}
+
 /* This is the cache for internally used simp_lemma collections */
 class simp_lemmas_cache {
     struct entry {
         environment           m_env;
         std::vector<unsigned> m_fingerprints;
         unsigned              m_reducibility_fingerprint;
+        unsigned              m_relation_fingerprint;
         optional<simp_lemmas> m_lemmas;
         entry(environment const & env):
-            m_env(env), m_reducibility_fingerprint(0) {}
+            m_env(env), m_reducibility_fingerprint(0), m_relation_fingerprint(0) {}
     };
     std::vector<entry>        m_entries[LEAN_NUM_TRANSPARENCY_MODES];
 
@@ -1090,6 +1705,7 @@ public:
         }
         C.m_lemmas = lemmas;
         C.m_reducibility_fingerprint = get_reducibility_fingerprint(env);
+        C.m_relation_fingerprint     = get_relation_fingerprint(env);
         return lemmas;
     }
 
@@ -1103,6 +1719,8 @@ public:
             return false;
         if (get_reducibility_fingerprint(env) != C.m_reducibility_fingerprint)
             return false;
+        if (get_relation_fingerprint(env) != C.m_relation_fingerprint)
+            return false;
         auto & cfg = get_simp_lemmas_config(tk);
         unsigned i = 0;
         for (name const & attr_name : cfg.m_simp_attrs) {
@@ -1151,6 +1769,49 @@ simp_lemmas get_simp_lemmas(environment const & env, transparency_mode m, name c
         throw exception(sstream() << "unknown simp_lemmas collection '" << tk_name << "'");
 }
 
+static environment save_simp_snapshot_entries(environment const & env, type_context & ctx, bool congr) {
+    simp_snapshot_ext const & ext = get_simp_snapshot_ext(env);
+    name_map<simp_snapshot_entry> const & snapshot = congr ? ext.m_congr : ext.m_simp;
+    environment new_env = env;
+    name_set attrs, ids;
+    for (simp_lemmas_config const & cfg : *g_simp_lemmas_configs) {
+        for (name const & attr_name : congr ? cfg.m_congr_attrs : cfg.m_simp_attrs) {
+            if (attrs.contains(attr_name))
+                continue;
+            attrs.insert(attr_name);
+            buffer<name> lemmas;
+            get_attribute(env, attr_name).get_instances(env, lemmas);
+            for (name const & id : lemmas) {
+                if (ids.contains(id))
+                    continue;
+                simp_snapshot_entry const * e = snapshot.find(id);
+                if (e && is_valid_snapshot_entry(env, *e))
+                    continue;
+                ids.insert(id);
+                simp_lemmas s;
+                try {
+                    s = congr ? add_congr_core(ctx, s, id, LEAN_DEFAULT_PRIORITY) :
+                        ext_add_core(ctx, s, id, LEAN_DEFAULT_PRIORITY);
+                } catch (exception &) {
+                    /* the lemma will be processed again by get_simp_lemmas */
+                    continue;
+                }
+                new_env = module::add(new_env, std::make_shared<simp_snapshot_modification>(
+                                          congr, id, to_snapshot_entry(env, id, s, congr)));
+            }
+        }
+    }
+    return new_env;
+}
+
+environment save_simp_lemmas_snapshot(environment const & env, options const & opts) {
+    if (!get_simp_snapshot(opts))
+        return env;
+    type_context ctx(env, transparency_mode::Reducible);
+    environment new_env = save_simp_snapshot_entries(env, ctx, false);
+    return save_simp_snapshot_entries(new_env, ctx, true);
+}
+
 static bool instantiate_emetas(type_context & ctx, list<expr> const & _emetas, list<bool> const & _instances) {
     buffer<expr> emetas;
     buffer<bool> instances;
@@ -1308,12 +1969,7 @@ vm_obj simp_lemmas_join(vm_obj const & lemmas1, vm_obj const & lemmas2) {
 }
 
 vm_obj simp_lemmas_erase(vm_obj const & lemmas, vm_obj const & lemma_list) {
-    name_set S;
-    for (name const & l : to_list_name(lemma_list))
-        S.insert(l);
-    simp_lemmas new_lemmas = to_simp_lemmas(lemmas);
-    new_lemmas.erase(S);
-    return to_obj(new_lemmas);
+    return to_obj(erase(to_simp_lemmas(lemmas), to_list_name(lemma_list)));
 }
 
 static optional<expr> prove(type_context & ctx, vm_obj const & prove_fn, expr const & e, tactic_state s) {
@@ -1419,12 +2075,13 @@ vm_obj simp_lemmas_rewrite_core(transparency_mode const & m, simp_lemmas const &
     simp_lemmas_for const * sr = sls.find(R);
     if (!sr) return tactic::mk_exception("failed to apply simp_lemmas, no lemmas for the given relation", s);
 
-    list<simp_lemma> const * srs = sr->find(e);
-    if (!srs) return tactic::mk_exception("failed to apply simp_lemmas, no simp lemma", s);
-
     type_context ctx = mk_type_context_for(s, m);
 
-    for (simp_lemma const & lemma : *srs) {
+    buffer<simp_lemma> srs;
+    sr->find(ctx, e, srs);
+    if (srs.empty()) return tactic::mk_exception("failed to apply simp_lemmas, no simp lemma", s);
+
+    for (simp_lemma const & lemma : srs) {
         simp_result r = simp_lemma_rewrite(ctx, lemma, prove_fn, e, s);
         if (!is_eqp(r.get_new(), e)) {
             lean_trace("simp_lemmas", scope_trace_env scope(ctx.env(), ctx);
@@ -1528,6 +2185,15 @@ void initialize_simp_lemmas() {
     g_name2simp_token     = new name_map<unsigned>();
     g_default_token       = register_simp_attribute("default", {"simp", "wrapper_eq"}, {"congr"});
     g_refl_lemma_attr     = new name{"_refl_lemma"};
+    g_simp_index          = new name{"simp", "index"};
+    g_simp_index_star     = new expr(mk_metavar("_simp_index_star", mk_Prop()));
+    register_bool_option(*g_simp_index, LEAN_DEFAULT_SIMP_INDEX,
+                         "(simp) use a discrimination tree to select the simp lemmas that may match a term");
+    g_simp_snapshot       = new name{"simp", "snapshot"};
+    register_bool_option(*g_simp_snapshot, LEAN_DEFAULT_SIMP_SNAPSHOT,
+                         "(simp) store the processed simp and congruence lemmas in the .olean file of the module");
+    g_simp_snapshot_ext   = new simp_snapshot_ext_reg();
+    simp_snapshot_modification::init();
     register_trace_class("simp_lemmas");
     register_trace_class("simp_lemmas_cache");
     register_trace_class(name{"simp_lemmas", "failure"});
@@ -1555,5 +2221,10 @@ void finalize_simp_lemmas() {
     delete g_name2simp_token;
     delete g_dummy;
     delete g_refl_lemma_attr;
+    delete g_simp_index;
+    delete g_simp_index_star;
+    delete g_simp_snapshot;
+    simp_snapshot_modification::finalize();
+    delete g_simp_snapshot_ext;
 }
 }
@@ -44,6 +44,9 @@ public:
     unsigned get_num_umeta() const;
     unsigned get_num_emeta() const;
 
+    /** \brief Return the universe metavariables used to instantiate the universe parameters of the lemma. */
+    levels const & get_umetas() const;
+
     /** \brief Return a list containing the expression metavariables in reverse order. */
     list<expr> const & get_emetas() const;
 
@@ -76,11 +79,16 @@ struct simp_lemma_prio_fn { unsigned operator()(simp_lemma const & s) const { re
 
 typedef head_map_prio<simp_lemma, simp_lemma_prio_fn>  simp_lemma_set;
 
+struct simp_lemma_index;
+
 /** \brief Simplification and congruence lemmas for a given equivalence relation */
 class simp_lemmas_for {
     name           m_eqv;
     simp_lemma_set m_simp_set;
     simp_lemma_set m_congr_set;
+    /* Discrimination tree indices for m_simp_set and m_congr_set, the trees are built on demand. */
+    std::shared_ptr<simp_lemma_index> m_simp_index;
+    std::shared_ptr<simp_lemma_index> m_congr_index;
 public:
     simp_lemmas_for();
     simp_lemmas_for(name const & eqv);
@@ -96,13 +104,53 @@ public:
     /* Return the Congr simp_lemma's for the given head index */
     list<simp_lemma> const * find_congr(head_index const & h) const;
     void for_each_congr(std::function<void(simp_lemma const &)> const & fn) const;
+    /* Store in \c r the Simp/Refl simp_lemma's (in priority order) whose left-hand side may match \c e.
+       It is a subset of <tt>find(head_index(e))</tt> retrieved using a discrimination tree. */
+    void find(type_context & ctx, expr const & e, buffer<simp_lemma> & r) const;
+    /* Similar to the previous method, but for Congr simp_lemma's */
+    void find_congr(type_context & ctx, expr const & e, buffer<simp_lemma> & r) const;
+};
+
+/** \brief An operation used to derive a simp_lemmas object from another one (see simp_lemmas::is_same_derivation). */
+struct simp_lemmas_update {
+    enum class kind { Add, AddHyp, AddCongr, Erase, Join };
+    kind                      m_kind;
+    transparency_mode         m_mode;
+    name                      m_id;
+    unsigned                  m_priority;
+    /* the type and proof of the hypothesis (AddHyp) */
+    expr                      m_type;
+    expr                      m_proof;
+    /* the erased lemmas (Erase) */
+    list<name>                m_ids;
+    /* the lemmas of the second argument (Join) */
+    name_map<simp_lemmas_for> m_sets;
+    simp_lemmas_update(kind k):m_kind(k), m_mode(transparency_mode::None), m_priority(0) {}
 };
 
+bool operator==(simp_lemmas_update const & u1, simp_lemmas_update const & u2);
+inline bool operator!=(simp_lemmas_update const & u1, simp_lemmas_update const & u2) { return !(u1 == u2); }
+
 /** \brief Collection of simplification and congruence lemmas for different equivalence relations.
     \remark Refl lemmas are use only for eq */
 class simp_lemmas {
     name_map<simp_lemmas_for> m_sets; // mapping from relation name to simp_lemmas_for
+    /* The object was obtained by applying m_updates (the most recent first) to the object with lemmas m_base.
+       The low level methods insert and erase(eqv, r) reset them, i.e., the object becomes its own base. */
+    name_map<simp_lemmas_for> m_base;
+    list<simp_lemmas_update>  m_updates;
+    void reset_derivation() { m_base = m_sets; m_updates = list<simp_lemmas_update>(); }
 public:
+    /** \brief Record that this object was obtained by applying \c u to \c s. */
+    void set_derivation(simp_lemmas const & s, simp_lemmas_update const & u) {
+        m_base = s.m_base; m_updates = cons(u, s.m_updates);
+    }
+    /** \brief Return true iff \c s1 and \c s2 were obtained by applying the same operations to the same object.
+        Then, they contain the same lemmas. The persistent simplifier cache uses this test, since tactics such as
+        `simp [h]` build a new object at each invocation. */
+    friend bool is_same_derivation(simp_lemmas const & s1, simp_lemmas const & s2) {
+        return is_eqp(s1.m_base, s2.m_base) && s1.m_updates == s2.m_updates;
+    }
     bool empty() const { return m_sets.empty(); }
     void insert(name const & eqv, simp_lemma const & r);
     void erase(name const & eqv, simp_lemma const & r);
@@ -119,6 +167,8 @@ public:
     format pp_simp(formatter const & fmt) const;
     format pp_congr(formatter const & fmt) const;
     format pp(formatter const & fmt) const;
+    friend bool is_eqp(simp_lemmas const & s1, simp_lemmas const & s2) { return is_eqp(s1.m_sets, s2.m_sets); }
+    friend simp_lemmas join(simp_lemmas const & s1, simp_lemmas const & s2);
 };
 
 typedef unsigned simp_lemmas_token;
@@ -133,9 +183,16 @@ simp_lemmas get_simp_lemmas(environment const & env, transparency_mode m, simp_l
 simp_lemmas get_default_simp_lemmas(environment const & env, transparency_mode m);
 simp_lemmas get_simp_lemmas(environment const & env, transparency_mode m, name const & tk_name);
 
+/** \brief Store in the module being compiled the processed form (using transparency_mode::Reducible) of the lemmas
+    tagged with the attributes of the registered simp_lemmas collections, when they are not already stored in
+    the imported modules. When the option simp.snapshot is false, \c env is returned.
+    \c get_simp_lemmas reuses the stored lemmas instead of analysing them again. */
+environment save_simp_lemmas_snapshot(environment const & env, options const & opts);
+
 simp_lemmas add(type_context & ctx, simp_lemmas const & s, name const & id, unsigned priority);
 simp_lemmas add(type_context & ctx, simp_lemmas const & s, name const & id, expr const & e, expr const & h, unsigned priority);
 simp_lemmas add_congr(type_context & ctx, simp_lemmas const & s, name const & id, unsigned priority);
+simp_lemmas erase(simp_lemmas const & s, list<name> const & ids);
 simp_lemmas join(simp_lemmas const & s1, simp_lemmas const & s2);
 
 /** \brief Return true iff 'e' is of the form 'lhs rel rhs' where rel is a transitive and reflexive
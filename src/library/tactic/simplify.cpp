@@ -15,6 +15,7 @@ Author: Daniel Selsam, Leonardo de Moura
 #include "kernel/abstract.h"
 #include "kernel/expr_maps.h"
 #include "kernel/find_fn.h"
+#include "kernel/expr_arena.h"
 #include "kernel/instantiate.h"
 #include "library/trace.h"
 #include "library/annotation.h"
@@ -56,6 +57,15 @@ Author: Daniel Selsam, Leonardo de Moura
 #ifndef LEAN_DEFAULT_SIMPLIFY_LIFT_EQ
 #define LEAN_DEFAULT_SIMPLIFY_LIFT_EQ true
 #endif
+#ifndef LEAN_DEFAULT_SIMPLIFY_PERSISTENT_CACHE
+#define LEAN_DEFAULT_SIMPLIFY_PERSISTENT_CACHE false
+#endif
+#ifndef LEAN_SIMPLIFY_CACHE_MAX_SLOTS
+#define LEAN_SIMPLIFY_CACHE_MAX_SLOTS 8
+#endif
+#ifndef LEAN_SIMPLIFY_CACHE_MAX_SIZE
+#define LEAN_SIMPLIFY_CACHE_MAX_SIZE 100000
+#endif
 
 namespace lean {
 #define lean_simp_trace(CTX, N, CODE) lean_trace(N, scope_trace_env _scope1(CTX.env(), CTX); CODE)
@@ -87,6 +97,41 @@ simp_config::simp_config(vm_obj const & obj) {
     m_proj               = to_bool(cfield(obj, 9));
 }
 
+bool operator==(simp_config const & c1, simp_config const & c2) {
+    return
+        c1.m_max_steps          == c2.m_max_steps &&
+        c1.m_contextual         == c2.m_contextual &&
+        c1.m_lift_eq            == c2.m_lift_eq &&
+        c1.m_canonize_instances == c2.m_canonize_instances &&
+        c1.m_canonize_proofs    == c2.m_canonize_proofs &&
+        c1.m_use_axioms         == c2.m_use_axioms &&
+        c1.m_zeta               == c2.m_zeta &&
+        c1.m_beta               == c2.m_beta &&
+        c1.m_eta                == c2.m_eta &&
+        c1.m_proj               == c2.m_proj &&
+        c1.m_use_matcher        == c2.m_use_matcher;
+}
+
+static name * g_simplify_persistent_cache = nullptr;
+
+static bool get_simplify_persistent_cache(options const & o) {
+    return o.get_bool(*g_simplify_persistent_cache, LEAN_DEFAULT_SIMPLIFY_PERSISTENT_CACHE);
+}
+
+optional<persistent_simplify_cache> get_persistent_simplify_cache(tactic_state const & s) {
+    if (!get_simplify_persistent_cache(s.get_options()))
+        return optional<persistent_simplify_cache>();
+    if (simplify_cache_ptr const & c = s.get_simplify_cache())
+        return optional<persistent_simplify_cache>(*c);
+    return optional<persistent_simplify_cache>(persistent_simplify_cache());
+}
+
+tactic_state set_persistent_simplify_cache(tactic_state const & s, optional<persistent_simplify_cache> const & c) {
+    if (!c)
+        return s;
+    return set_simplify_cache(s, std::make_shared<persistent_simplify_cache>(*c));
+}
+
 /* -----------------------------------
    Core simplification procedure.
    ------------------------------------ */
@@ -242,10 +287,10 @@ simp_result simplify_core_fn::try_user_congrs(expr const & e) {
     simp_lemmas_for const * sls = m_slss.find(m_rel);
     if (!sls) return simp_result(e);
 
-    list<simp_lemma> const * cls = sls->find_congr(e);
-    if (!cls) return simp_result(e);
+    buffer<simp_lemma> cls;
+    sls->find_congr(m_ctx, e, cls);
 
-    for (simp_lemma const & cl : *cls) {
+    for (simp_lemma const & cl : cls) {
         simp_result r = try_user_congr(e, cl);
         if (r.get_new() != e)
             return r;
@@ -255,7 +300,7 @@ simp_result simplify_core_fn::try_user_congrs(expr const & e) {
 
 simp_result simplify_core_fn::try_user_congr(expr const & e, simp_lemma const & cl) {
     tmp_type_context tmp_ctx(m_ctx, cl.get_num_umeta(), cl.get_num_emeta());
-    if (!tmp_ctx.is_def_eq(cl.get_lhs(), e))
+    if (!match(tmp_ctx, cl, e))
         return simp_result(e);
 
     lean_simp_trace(tmp_ctx, name({"debug", "simplify", "try_congruence"}),
@@ -505,12 +550,10 @@ simp_result simplify_core_fn::rewrite(expr const & e) {
     simp_lemmas_for const * sr = m_slss.find(m_rel);
     if (!sr) return simp_result(e);
 
-    list<simp_lemma> const * srs = sr->find(e);
-    if (!srs) {
-        return simp_result(e);
-    }
+    buffer<simp_lemma> srs;
+    sr->find(m_ctx, e, srs);
 
-    for (simp_lemma const & lemma : *srs) {
+    for (simp_lemma const & lemma : srs) {
         simp_result r = rewrite(e, lemma);
         if (!is_eqp(r.get_new(), e)) {
             lean_simp_trace_d(m_ctx, name({"simplify", "rewrite"}),
@@ -524,7 +567,11 @@ simp_result simplify_core_fn::rewrite(expr const & e) {
 }
 
 bool simplify_core_fn::match(tmp_type_context & ctx, simp_lemma const & sl, expr const & t) {
-    return ctx.is_def_eq(sl.get_lhs(), t);
+    m_num_match_attempts++;
+    if (!ctx.is_def_eq(sl.get_lhs(), t))
+        return false;
+    m_num_match_successes++;
+    return true;
 }
 
 /* If both e and sl.get_lhs() are of the form (f ...),
@@ -541,6 +588,9 @@ static bool should_trace_failure(expr const & e, simp_lemma const & sl) {
 }
 
 simp_result simplify_core_fn::rewrite_core(expr const & e, simp_lemma const & sl) {
+    /* Most rewriting attempts fail, the terms created by the matcher are allocated in an arena,
+       and the result is copied out. */
+    expr_arena_scope arena;
     tmp_type_context tmp_ctx(m_ctx, sl.get_num_umeta(), sl.get_num_emeta());
 
     if (!match(tmp_ctx, sl, e)) {
@@ -592,10 +642,10 @@ simp_result simplify_core_fn::rewrite_core(expr const & e, simp_lemma const & sl
     }
 
     if (sl.is_refl()) {
-        return simp_result(new_rhs);
+        return simp_result(copy_out_of_arena(new_rhs));
     } else {
         expr pf = tmp_ctx.instantiate_mvars(sl.get_proof());
-        return simp_result(new_rhs, pf);
+        return simp_result(copy_out_of_arena(new_rhs), copy_out_of_arena(pf));
     }
 }
 
@@ -653,6 +703,11 @@ simp_result simplify_core_fn::visit(expr const & e, optional<expr> const & paren
     if (it != m_cache.end())
         return it->second;
 
+    if (optional<simp_result> r = find_in_persistent_cache(e)) {
+        m_cache.insert(mk_pair(e, *r));
+        return *r;
+    }
+
     simp_result curr_result(e);
     if (auto r1 = pre(e, parent)) {
         if (!r1->second) {
@@ -852,20 +907,135 @@ simp_result simplify_core_fn::simplify(expr const & e) {
     while (true) {
         m_need_restart = false;
         r = join(r, visit(r.get_new(), none_expr()));
-        if (!m_need_restart || !should_defeq_canonize())
+        if (!m_need_restart || !should_defeq_canonize()) {
+            save_in_persistent_cache();
             return r;
+        }
         m_cache.clear();
     }
 }
 
+void simplify_core_fn::set_persistent_cache(persistent_simplify_cache & c) {
+    m_pcache      = &c;
+    m_pcache_lctx = m_ctx.lctx();
+    environment const & env = m_ctx.env();
+    if (!c.m_env || !env.is_descendant(*c.m_env))
+        c.m_slots.clear();
+    c.m_env = env;
+    /* move the slot for m_slss and m_cfg to the front */
+    unsigned i = 0;
+    for (; i < c.m_slots.size(); i++) {
+        if ((is_eqp(c.m_slots[i].m_slss, m_slss) || is_same_derivation(c.m_slots[i].m_slss, m_slss)) &&
+            c.m_slots[i].m_cfg == m_cfg)
+            break;
+    }
+    if (i < c.m_slots.size()) {
+        persistent_simplify_cache::slot s = c.m_slots[i];
+        s.m_slss = m_slss;
+        c.m_slots.erase(c.m_slots.begin() + i);
+        c.m_slots.insert(c.m_slots.begin(), s);
+    } else {
+        if (c.m_slots.size() >= LEAN_SIMPLIFY_CACHE_MAX_SLOTS)
+            c.m_slots.pop_back();
+        c.m_slots.insert(c.m_slots.begin(), persistent_simplify_cache::slot(m_slss, m_cfg));
+    }
+    /* the results of the slot can only be reused if the local constants they contain are still available */
+    persistent_simplify_cache::slot & s = c.m_slots[0];
+    bool compatible = true;
+    s.m_locals.for_each([&](name const & n, expr const & type) {
+            if (compatible) {
+                optional<local_decl> d = m_pcache_lctx.find_local_decl(n);
+                compatible = d && d->get_type() == type;
+            }
+        });
+    if (!compatible)
+        c.m_slots[0] = persistent_simplify_cache::slot(m_slss, m_cfg);
+}
+
+optional<simp_result> simplify_core_fn::find_in_persistent_cache(expr const & e) {
+    if (!m_pcache)
+        return optional<simp_result>();
+    persistent_simplify_cache::slot const & s = m_pcache->m_slots[0];
+    /* the simp set is modified by contextual simplification */
+    if (!is_eqp(m_slss, s.m_slss))
+        return optional<simp_result>();
+    if (auto rs = s.m_results.find(m_rel)) {
+        if (auto r = rs->find(e)) {
+            m_pcache->m_num_hits++;
+            return optional<simp_result>(*r);
+        }
+    }
+    m_pcache->m_num_misses++;
+    return optional<simp_result>();
+}
+
+/* Return true iff the local constants occurring in \c e are declared in the local context of
+   the simplifier invocation (i.e., they are not auxiliary locals created when visiting binders),
+   and store them in \c locals. */
+bool simplify_core_fn::collect_pcache_locals(expr const & e, name_map<expr> & locals) const {
+    bool ok = true;
+    for_each(e, [&](expr const & t, unsigned) {
+            if (!ok || !has_local(t))
+                return false;
+            if (is_local(t)) {
+                if (optional<local_decl> d = m_pcache_lctx.find_local_decl(t))
+                    locals.insert(mlocal_name(t), d->get_type());
+                else
+                    ok = false;
+                return false;
+            }
+            return true;
+        });
+    return ok;
+}
+
+void simplify_core_fn::save_in_persistent_cache() {
+    if (!m_pcache)
+        return;
+    persistent_simplify_cache::slot & s = m_pcache->m_slots[0];
+    if (!is_eqp(m_slss, s.m_slss))
+        return;
+    rb_expr_map<simp_result> rs;
+    if (auto old_rs = s.m_results.find(m_rel))
+        rs = *old_rs;
+    for (auto const & p : m_cache) {
+        if (s.m_size >= LEAN_SIMPLIFY_CACHE_MAX_SIZE)
+            break;
+        simp_result const & r = p.second;
+        if (has_metavar(p.first) || has_metavar(r.get_new()) || (r.has_proof() && has_metavar(r.get_proof())))
+            continue;
+        if (rs.contains(p.first))
+            continue;
+        name_map<expr> locals = s.m_locals;
+        if (!collect_pcache_locals(p.first, locals) || !collect_pcache_locals(r.get_new(), locals) ||
+            (r.has_proof() && !collect_pcache_locals(r.get_proof(), locals)))
+            continue;
+        s.m_locals = locals;
+        rs.insert(p.first, r);
+        s.m_size++;
+    }
+    s.m_results.insert(m_rel, rs);
+}
+
 simp_result simplify_core_fn::operator()(name const & rel, expr const & e) {
+    unsigned num_attempts  = m_num_match_attempts;
+    unsigned num_successes = m_num_match_successes;
+    simp_result r;
     if (m_rel != rel) {
         flet<name> _(m_rel, rel);
         freset<simplify_cache> reset_cache(m_cache);
-        return simplify(e);
+        r = simplify(e);
     } else {
-        return simplify(e);
+        r = simplify(e);
     }
+    lean_simp_trace(m_ctx, name({"simplify", "stats"}),
+                    tout() << "lemma matches: " << m_num_match_attempts - num_attempts << " attempts, "
+                    << m_num_match_successes - num_successes << " successes\n";
+                    if (m_pcache) {
+                        tout() << "persistent cache: " << m_pcache->get_num_hits() << " hits, "
+                               << m_pcache->get_num_misses() << " misses\n";
+                    });
+    return r;
 }
 
 static expr mk_mpr(type_context & ctx, name const & rel, expr const & h1, expr const & h2) {
@@ -1171,13 +1341,15 @@ vm_obj tactic_simplify_core(vm_obj const & c, vm_obj const & slss, vm_obj const
         type_context ctx     = mk_type_context_for(s, transparency_mode::Reducible);
         defeq_can_state dcs  = s.dcs();
         simplify_fn simp(ctx, dcs, to_simp_lemmas(slss), cfg);
+        optional<persistent_simplify_cache> cache = get_persistent_simplify_cache(s);
+        if (cache) simp.set_persistent_cache(*cache);
         simp_result result   = simp(to_name(rel), to_expr(e));
         if (result.get_new() != to_expr(e)) {
             result = finalize(ctx, to_name(rel), result);
-            tactic_state new_s = set_dcs(s, dcs);
+            tactic_state new_s = set_persistent_simplify_cache(set_dcs(s, dcs), cache);
             return tactic::mk_success(mk_vm_pair(to_obj(result.get_new()), to_obj(result.get_proof())), new_s);
         } else {
-            return tactic::mk_exception("simplify tactic failed to simplify", s);
+            return tactic::mk_exception("simplify tactic failed to simplify", set_persistent_simplify_cache(s, cache));
         }
     } catch (exception & e) {
         return tactic::mk_exception(e, s);
@@ -1225,6 +1397,9 @@ vm_obj tactic_ext_simplify_core(unsigned DEBUG_CODE(num), vm_obj const * args) {
 }
 
 void initialize_simplify() {
+    g_simplify_persistent_cache = new name{"simplify", "persistent_cache"};
+    register_bool_option(*g_simplify_persistent_cache, LEAN_DEFAULT_SIMPLIFY_PERSISTENT_CACHE,
+                         "(simplify) reuse the results of previous simplifier invocations in the same tactic proof");
     register_trace_class("simplify");
     register_trace_class(name({"simplify", "failure"}));
     register_trace_class(name({"simplify", "rewrite_failure"}));
@@ -1233,6 +1408,7 @@ void initialize_simplify() {
     register_trace_class(name({"simplify", "congruence"}));
     register_trace_class(name({"simplify", "rewrite"}));
     register_trace_class(name({"simplify", "perm"}));
+    register_trace_class(name({"simplify", "stats"}));
     register_trace_class(name({"debug", "simplify", "try_congruence"}));
 
     DECLARE_VM_BUILTIN(name({"tactic", "simplify_core"}), tactic_simplify_core);
@@ -1241,5 +1417,6 @@ void initialize_simplify() {
 }
 
 void finalize_simplify() {
+    delete g_simplify_persistent_cache;
 }
 }
@@ -4,7 +4,9 @@ Released under Apache 2.0 license as described in the file LICENSE.
 Author: Daniel Selsam, Leonardo de Moura
 */
 #pragma once
+#include <vector>
 #include "kernel/expr_pair.h"
+#include "library/expr_lt.h"
 #include "library/type_context.h"
 #include "library/defeq_canonizer.h"
 #include "library/vm/vm.h"
@@ -44,6 +46,48 @@ struct simp_config {
     simp_config(vm_obj const & o);
 };
 
+bool operator==(simp_config const & c1, simp_config const & c2);
+inline bool operator!=(simp_config const & c1, simp_config const & c2) { return !(c1 == c2); }
+
+/* Simplification results shared by the simplifier invocations of a tactic proof (e.g., `simp at *`,
+   the `simp` steps of a tactic block, and the preprocessing of `smt_tactic`).
+   It is stored in the tactic_state when the option simplify.persistent_cache is true.
+
+   The results are grouped in slots, one for each set of simp lemmas and configuration. The sets are
+   compared using the operations used to build them (see is_same_derivation), since tactics such as
+   `simp [h]` build a new simp_lemmas object at each invocation. The results of a slot are reused when the local constants
+   they contain are still declared with the same type, and the environment is a descendant of the
+   environment where they were produced. Results containing metavariables are not stored. */
+class persistent_simplify_cache {
+    friend class simplify_core_fn;
+    struct slot {
+        /* the last simp_lemmas object used with this slot */
+        simp_lemmas                        m_slss;
+        simp_config                        m_cfg;
+        /* mapping from relation to the results for this relation */
+        name_map<rb_expr_map<simp_result>> m_results;
+        unsigned                           m_size{0};
+        /* local constants occurring in m_results and their types */
+        name_map<expr>                     m_locals;
+        slot(simp_lemmas const & slss, simp_config const & cfg):
+            m_slss(slss), m_cfg(cfg) {}
+    };
+    optional<environment> m_env;
+    /* The most recently used slot is the first one */
+    std::vector<slot>     m_slots;
+    unsigned              m_num_hits{0};
+    unsigned              m_num_misses{0};
+public:
+    unsigned get_num_hits() const { return m_num_hits; }
+    unsigned get_num_misses() const { return m_num_misses; }
+};
+
+class tactic_state;
+/* Return the cache stored in \c s if the option simplify.persistent_cache is true */
+optional<persistent_simplify_cache> get_persistent_simplify_cache(tactic_state const & s);
+/* Store \c c in \c s, it is a no-op if \c c is none. */
+tactic_state set_persistent_simplify_cache(tactic_state const & s, optional<persistent_simplify_cache> const & c);
+
 /* Core simplification procedure. It performs the following tasks:
    1- Manages the cache;
    2- Applies congruence lemmas;
@@ -76,10 +120,17 @@ protected:
     /* Logging */
     unsigned                  m_num_steps{0};
     bool                      m_need_restart{false};
+    /* Number of simp/congruence lemmas whose left-hand side was matched against a term, and number of successful matches */
+    unsigned                  m_num_match_attempts{0};
+    unsigned                  m_num_match_successes{0};
 
     /* Options */
     simp_config               m_cfg;
 
+    /* Cache shared with other invocations (optional), and the local context of these invocations */
+    persistent_simplify_cache * m_pcache{nullptr};
+    local_context             m_pcache_lctx;
+
     simp_result join(simp_result const & r1, simp_result const & r2);
     void inc_num_steps();
     bool is_dependent_fn(expr const & f);
@@ -136,6 +187,10 @@ protected:
 
     bool match(tmp_type_context & ctx, simp_lemma const & sl, expr const & t);
 
+    optional<simp_result> find_in_persistent_cache(expr const & e);
+    bool collect_pcache_locals(expr const & e, name_map<expr> & locals) const;
+    void save_in_persistent_cache();
+
 public:
     simplify_core_fn(type_context & ctx, defeq_canonizer::state & dcs, simp_lemmas const & slss,
                      simp_config const & cfg);
@@ -143,6 +198,9 @@ public:
     environment const & env() const;
     simp_result operator()(name const & rel, expr const & e);
 
+    /* Reuse and update the results stored in \c c in the following invocations. */
+    void set_persistent_cache(persistent_simplify_cache & c);
+
     optional<expr> prove_by_simp(name const & rel, expr const & e);
 };
 
@@ -0,0 +1,209 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include <algorithm>
+#include <utility>
+#include "util/hash.h"
+#include "library/util.h"
+#include "library/tactic/smt/array_congruence_closure.h"
+
+namespace lean {
+constexpr unsigned array_congruence_closure::null_id;
+
+unsigned array_congruence_closure::signature_hash::operator()(signature const & s) const {
+    return hash(s.first, s.second);
+}
+
+array_congruence_closure::array_congruence_closure() {
+    m_true  = internalize(mk_true());
+    m_false = internalize(mk_false());
+}
+
+void array_congruence_closure::push_trail(trail_kind k, unsigned id1, unsigned id2, signature const & sig) {
+    /* the updates are not recorded when there is nothing to backtrack to */
+    if (!m_scopes.empty())
+        m_trail.emplace_back(k, id1, id2, sig);
+}
+
+unsigned array_congruence_closure::mk_node(expr const & e, unsigned fn, unsigned arg) {
+    unsigned id = m_nodes.size();
+    m_nodes.emplace_back(e, id, fn, arg);
+    m_uses.emplace_back();
+    m_ids.insert(mk_pair(e, id));
+    push_trail(trail_kind::Node, id, null_id);
+    return id;
+}
+
+auto array_congruence_closure::get_signature(unsigned app) const -> signature {
+    node const & n = m_nodes[app];
+    return signature(m_nodes[n.m_fn].m_root, m_nodes[n.m_arg].m_root);
+}
+
+void array_congruence_closure::add_use(unsigned r, unsigned app) {
+    m_uses[r].push_back(app);
+    push_trail(trail_kind::Use, r, app);
+}
+
+void array_congruence_closure::insert_congruence(unsigned app) {
+    signature sig = get_signature(app);
+    auto it = m_table.find(sig);
+    if (it == m_table.end()) {
+        m_table.insert(mk_pair(sig, app));
+        push_trail(trail_kind::TableInsert, app, null_id, sig);
+    } else if (it->second != app) {
+        m_todo.emplace_back(app, it->second);
+    }
+}
+
+unsigned array_congruence_closure::internalize(expr const & e) {
+    auto it = m_ids.find(e);
+    if (it != m_ids.end())
+        return it->second;
+    if (is_app(e)) {
+        unsigned fn  = internalize(app_fn(e));
+        unsigned arg = internalize(app_arg(e));
+        unsigned id  = mk_node(e, fn, arg);
+        unsigned fn_root  = m_nodes[fn].m_root;
+        unsigned arg_root = m_nodes[arg].m_root;
+        add_use(fn_root, id);
+        if (arg_root != fn_root)
+            add_use(arg_root, id);
+        insert_congruence(id);
+        process_todo();
+        return id;
+    } else {
+        return mk_node(e, null_id, null_id);
+    }
+}
+
+void array_congruence_closure::merge_core(unsigned id1, unsigned id2) {
+    unsigned r1 = m_nodes[id1].m_root;
+    unsigned r2 = m_nodes[id2].m_root;
+    if (r1 == r2)
+        return;
+    /* the smaller equivalence class (r2) is merged into the bigger one */
+    if (m_nodes[r1].m_size < m_nodes[r2].m_size)
+        std::swap(r1, r2);
+    /* remove the applications whose signature is going to change from the congruence table */
+    for (unsigned app : m_uses[r2]) {
+        signature sig = get_signature(app);
+        auto it = m_table.find(sig);
+        if (it != m_table.end() && it->second == app) {
+            m_table.erase(it);
+            push_trail(trail_kind::TableErase, app, null_id, sig);
+        }
+    }
+    unsigned it = r2;
+    do {
+        m_nodes[it].m_root = r1;
+        it = m_nodes[it].m_next;
+    } while (it != r2);
+    std::swap(m_nodes[r1].m_next, m_nodes[r2].m_next);
+    m_nodes[r1].m_size += m_nodes[r2].m_size;
+    push_trail(trail_kind::Merge, r1, r2);
+    for (unsigned app : m_uses[r2]) {
+        insert_congruence(app);
+        add_use(r1, app);
+    }
+}
+
+void array_congruence_closure::process_todo() {
+    while (!m_todo.empty()) {
+        std::pair<unsigned, unsigned> p = m_todo.back();
+        m_todo.pop_back();
+        merge_core(p.first, p.second);
+    }
+}
+
+void array_congruence_closure::add_eqv(expr const & e1, expr const & e2) {
+    unsigned id1 = internalize(e1);
+    unsigned id2 = internalize(e2);
+    m_todo.emplace_back(id1, id2);
+    process_todo();
+}
+
+void array_congruence_closure::add(expr const & p) {
+    expr A, lhs, B, rhs;
+    if (is_not_or_ne(p, lhs)) {
+        add_eqv(lhs, mk_false());
+        return;
+    }
+    if (is_eq(p, lhs, rhs) || is_iff(p, lhs, rhs)) {
+        add_eqv(lhs, rhs);
+    } else if (is_heq(p, A, lhs, B, rhs) && A == B) {
+        /* the heterogeneous equalities between terms of different types are not merged, see header */
+        add_eqv(lhs, rhs);
+    }
+    add_eqv(p, mk_true());
+}
+
+bool array_congruence_closure::is_eqv(expr const & e1, expr const & e2) const {
+    auto it1 = m_ids.find(e1);
+    auto it2 = m_ids.find(e2);
+    if (it1 == m_ids.end() || it2 == m_ids.end())
+        return e1 == e2;
+    return m_nodes[it1->second].m_root == m_nodes[it2->second].m_root;
+}
+
+bool array_congruence_closure::inconsistent() const {
+    return m_nodes[m_true].m_root == m_nodes[m_false].m_root;
+}
+
+expr array_congruence_closure::get_root(expr const & e) const {
+    auto it = m_ids.find(e);
+    if (it == m_ids.end())
+        return e;
+    return m_nodes[m_nodes[it->second].m_root].m_expr;
+}
+
+void array_congruence_closure::push() {
+    lean_assert(m_todo.empty());
+    m_scopes.push_back(m_trail.size());
+}
+
+void array_congruence_closure::undo(trail_entry const & t) {
+    switch (t.m_kind) {
+    case trail_kind::Node:
+        lean_assert(t.m_id1 + 1 == m_nodes.size());
+        m_ids.erase(m_nodes.back().m_expr);
+        m_nodes.pop_back();
+        m_uses.pop_back();
+        break;
+    case trail_kind::Merge: {
+        unsigned r1 = t.m_id1;
+        unsigned r2 = t.m_id2;
+        std::swap(m_nodes[r1].m_next, m_nodes[r2].m_next);
+        m_nodes[r1].m_size -= m_nodes[r2].m_size;
+        unsigned it = r2;
+        do {
+            m_nodes[it].m_root = r2;
+            it = m_nodes[it].m_next;
+        } while (it != r2);
+        break;
+    }
+    case trail_kind::Use:
+        lean_assert(m_uses[t.m_id1].back() == t.m_id2);
+        m_uses[t.m_id1].pop_back();
+        break;
+    case trail_kind::TableInsert:
+        m_table.erase(t.m_sig);
+        break;
+    case trail_kind::TableErase:
+        m_table.insert(mk_pair(t.m_sig, t.m_id1));
+        break;
+    }
+}
+
+void array_congruence_closure::pop() {
+    lean_assert(!m_scopes.empty());
+    unsigned old_size = m_scopes.back();
+    m_scopes.pop_back();
+    while (m_trail.size() > old_size) {
+        undo(m_trail.back());
+        m_trail.pop_back();
+    }
+}
+}
@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#pragma once
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "kernel/expr_maps.h"
+
+namespace lean {
+/* Congruence closure for ground terms that does not produce proofs.
+
+   It is an alternative to congruence_closure when only the equivalence classes are needed
+   (e.g., when congruence closure is used as a filter). The terms are numbered when they
+   are internalized, and applications are curried: (f a b) is the binary application of (f a) to b.
+   The union-find data-structure, the use lists and the congruence table are stored in arrays.
+   Union-by-size is used without path compression, and the updates are recorded in a trail.
+   So, push/pop are cheap, but, unlike congruence_closure::state, this object is not persistent.
+
+   The types of the terms are ignored, but heterogeneous equalities are only used when both sides
+   have the same type. So, the equivalence classes under-approximate the consequences of the hypotheses:
+   if is_eqv(a, b) returns true, then a and b are heterogeneously equal, and equal if they have the same type.
+   If it returns false, nothing is known, since the only propagation rules are congruence, (p = true) for
+   hypotheses p, and (p = false) for hypotheses (not p) and (a ≠ b) where p is (a = b). In particular, there
+   is no propositional, AC, injectivity, beta or subsingleton propagation, and terms that congruence_closure
+   proves equal may be in different equivalence classes here. */
+class array_congruence_closure {
+    static constexpr unsigned null_id = static_cast<unsigned>(-1);
+
+    struct node {
+        expr     m_expr;
+        /* function and argument of binary applications, null_id for other terms */
+        unsigned m_fn;
+        unsigned m_arg;
+        /* union-find data, m_size is meaningful only for roots */
+        unsigned m_root;
+        unsigned m_next;
+        unsigned m_size;
+        node(expr const & e, unsigned id, unsigned fn, unsigned arg):
+            m_expr(e), m_fn(fn), m_arg(arg), m_root(id), m_next(id), m_size(1) {}
+    };
+
+    typedef std::pair<unsigned, unsigned> signature;
+    struct signature_hash {
+        unsigned operator()(signature const & s) const;
+    };
+    typedef std::unordered_map<signature, unsigned, signature_hash> congruence_table;
+
+    enum class trail_kind { Node, Merge, Use, TableInsert, TableErase };
+    struct trail_entry {
+        trail_kind m_kind;
+        unsigned   m_id1;
+        unsigned   m_id2;
+        signature  m_sig;
+        trail_entry(trail_kind k, unsigned id1, unsigned id2, signature const & sig = signature()):
+            m_kind(k), m_id1(id1), m_id2(id2), m_sig(sig) {}
+    };
+
+    std::vector<node>                  m_nodes;
+    /* m_uses[r] contains the binary applications whose function or argument is in the equivalence
+       class of r, it is meaningful only for roots. */
+    std::vector<std::vector<unsigned>> m_uses;
+    expr_struct_map<unsigned>          m_ids;
+    congruence_table                   m_table;
+    std::vector<trail_entry>           m_trail;
+    std::vector<unsigned>              m_scopes;
+    /* pairs of terms that must be merged */
+    std::vector<std::pair<unsigned, unsigned>> m_todo;
+    unsigned                           m_true;
+    unsigned                           m_false;
+
+    void push_trail(trail_kind k, unsigned id1, unsigned id2, signature const & sig = signature());
+    unsigned mk_node(expr const & e, unsigned fn, unsigned arg);
+    signature get_signature(unsigned app) const;
+    void add_use(unsigned r, unsigned app);
+    void insert_congruence(unsigned app);
+    void merge_core(unsigned id1, unsigned id2);
+    void process_todo();
+    void undo(trail_entry const & t);
+
+public:
+    array_congruence_closure();
+
+    unsigned internalize(expr const & e);
+    /* Merge the equivalence classes of e1 and e2. */
+    void add_eqv(expr const & e1, expr const & e2);
+    /* Add the hypothesis with type \c p, the equalities, heterogeneous equalities between terms of the same type,
+       and iff-propositions are merged, q is merged with false when p is (not q) or (a ≠ b) and q is (a = b),
+       and p is merged with true otherwise. */
+    void add(expr const & p);
+
+    bool is_eqv(expr const & e1, expr const & e2) const;
+    bool inconsistent() const;
+    /* Return the root of the equivalence class of \c e, or \c e itself if it was not internalized. */
+    expr get_root(expr const & e) const;
+
+    void push();
+    void pop();
+    unsigned get_num_scopes() const { return m_scopes.size(); }
+    unsigned get_num_terms() const { return m_nodes.size(); }
+};
+}
@@ -17,6 +17,7 @@ Author: Leonardo de Moura
 #include "library/vm/vm_option.h"
 #include "library/tactic/tactic_state.h"
 #include "library/tactic/smt/congruence_closure.h"
+#include "library/tactic/smt/array_congruence_closure.h"
 #include "library/tactic/smt/hinst_lemmas.h"
 #include "library/tactic/smt/ematch.h"
 
@@ -237,6 +238,28 @@ vm_obj cc_state_proof_for_false(vm_obj const & ccs, vm_obj const & _s) {
         });
 }
 
+vm_obj tactic_fast_cc_is_eqv(vm_obj const & e1, vm_obj const & e2, vm_obj const & _s) {
+    tactic_state const & s   = tactic::to_state(_s);
+    optional<metavar_decl> g = s.get_main_goal_decl();
+    if (!g) return mk_no_goals_exception(s);
+    try {
+        type_context ctx = mk_type_context_for(s);
+        array_congruence_closure cc;
+        g->get_context().for_each([&](local_decl const & d) {
+                if (ctx.is_prop(d.get_type()))
+                    cc.add(ctx.instantiate_mvars(d.get_type()));
+            });
+        expr a = ctx.instantiate_mvars(to_expr(e1));
+        expr b = ctx.instantiate_mvars(to_expr(e2));
+        cc.internalize(a);
+        cc.internalize(b);
+        bool r = cc.inconsistent() || cc.is_eqv(a, b);
+        return tactic::mk_success(mk_vm_bool(r), s);
+    } catch (exception & ex) {
+        return tactic::mk_exception(ex, s);
+    }
+}
+
 void initialize_congruence_tactics() {
     DECLARE_VM_BUILTIN(name({"cc_state", "mk_core"}),              cc_state_mk_core);
     DECLARE_VM_BUILTIN(name({"cc_state", "next"}),                 cc_state_next);
@@ -259,6 +282,7 @@ void initialize_congruence_tactics() {
     DECLARE_VM_BUILTIN(name({"cc_state", "eqv_proof"}),            cc_state_eqv_proof);
     DECLARE_VM_BUILTIN(name({"cc_state", "proof_for"}),            cc_state_proof_for);
     DECLARE_VM_BUILTIN(name({"cc_state", "refutation_for"}),       cc_state_refutation_for);
+    DECLARE_VM_BUILTIN(name({"tactic", "fast_cc_is_eqv"}),         tactic_fast_cc_is_eqv);
 }
 
 void finalize_congruence_tactics() {
@@ -5,10 +5,15 @@ Released under Apache 2.0 license as described in the file LICENSE.
 Author: Leonardo de Moura
 */
 #include <algorithm>
+#include <unordered_map>
+#include <vector>
 #include "util/interrupt.h"
 #include "util/small_object_allocator.h"
+#include "util/sexpr/option_declarations.h"
 #include "library/trace.h"
 #include "library/util.h"
+#include "library/expr_lt.h"
+#include "library/expr_pair_maps.h"
 #include "library/constants.h"
 #include "library/app_builder.h"
 #include "library/fun_info.h"
@@ -91,6 +96,85 @@ vm_obj ematch_state::mk_vm_ematch_config() const {
     return mk_vm_constructor(0, mk_vm_nat(get_config().m_max_instances), mk_vm_nat(get_config().m_max_generation));
 }
 
+#ifndef LEAN_DEFAULT_EMATCH_FILTER
+#define LEAN_DEFAULT_EMATCH_FILTER true
+#endif
+
+static name * g_ematch_filter = nullptr;
+
+static bool get_ematch_filter(options const & o) {
+    return o.get_bool(*g_ematch_filter, LEAN_DEFAULT_EMATCH_FILTER);
+}
+
+/* Filter instruction: the equivalence class of the m_arg-th argument of a term matching the pattern
+   must contain a congruence root (or a term in a heterogeneous equivalence class) of the form
+   (m_fn ...) with m_nargs arguments. Otherwise, process_match fails for this argument. */
+struct ematch_filter_instr {
+    unsigned m_arg;
+    expr     m_fn;
+    unsigned m_nargs;
+    /* m_fn may contain universe meta-variables with index < m_num_uvars */
+    unsigned m_num_uvars;
+    ematch_filter_instr(unsigned arg, expr const & fn, unsigned nargs, unsigned num_uvars):
+        m_arg(arg), m_fn(fn), m_nargs(nargs), m_num_uvars(num_uvars) {}
+};
+
+struct ematch_filter_instr_cmp {
+    int operator()(ematch_filter_instr const & i1, ematch_filter_instr const & i2) const {
+        if (i1.m_arg != i2.m_arg)
+            return i1.m_arg < i2.m_arg ? -1 : 1;
+        if (i1.m_nargs != i2.m_nargs)
+            return i1.m_nargs < i2.m_nargs ? -1 : 1;
+        return expr_quick_cmp()(i1.m_fn, i2.m_fn);
+    }
+};
+
+/* Pre-match filter compiled from the patterns. It is NOT a matcher: it only checks the head symbol
+   of the pattern arguments that are applications, and a term passing the filter is still matched by
+   process_match. The filter instructions are shared by all patterns of all lemmas, and ematch_fn
+   evaluates each instruction at most once per equivalence class in each ematching round. So, given
+   n lemmas whose patterns have the form (f (g ?x) ?y), the check for (g _) is performed once for each
+   term (f a b), instead of n times by process_match.
+
+   Remark: the candidate terms are still selected using the modification times stored in
+   the congruence closure module, there is no index from merges to the patterns they may enable. */
+struct ematch_filter_code {
+    std::vector<ematch_filter_instr>                               m_instrs;
+    rb_map<ematch_filter_instr, unsigned, ematch_filter_instr_cmp> m_instr_idx;
+    /* pattern -> indices of its instructions in m_instrs */
+    rb_expr_map<list<unsigned>>                                    m_code;
+
+    unsigned intern(ematch_filter_instr const & instr) {
+        if (unsigned const * idx = m_instr_idx.find(instr)) {
+            m_instrs[*idx].m_num_uvars = std::max(m_instrs[*idx].m_num_uvars, instr.m_num_uvars);
+            return *idx;
+        }
+        unsigned idx = m_instrs.size();
+        m_instrs.push_back(instr);
+        m_instr_idx.insert(instr, idx);
+        return idx;
+    }
+
+    list<unsigned> const & compile(hinst_lemma const & lemma, expr const & p) {
+        if (list<unsigned> const * code = m_code.find(p))
+            return *code;
+        buffer<unsigned> code;
+        buffer<expr> p_args;
+        get_app_args(p, p_args);
+        for (unsigned i = 0; i < p_args.size(); i++) {
+            expr const & fn = get_app_fn(p_args[i]);
+            if (is_app(p_args[i]) && is_constant(fn))
+                code.push_back(intern(ematch_filter_instr(i, fn, get_app_num_args(p_args[i]), lemma.m_num_uvars)));
+        }
+        m_code.insert(p, to_list(code));
+        return *m_code.find(p);
+    }
+};
+
+struct root_instr_hash {
+    unsigned operator()(pair<expr, unsigned> const & p) const { return hash(p.first.hash(), p.second); }
+};
+
 /* Allocator for ematching constraints. */
 MK_THREAD_LOCAL_GET(small_object_allocator, get_emc_allocator, "ematch constraint");
 
@@ -276,11 +360,21 @@ class ematch_fn {
     ematch_state &                m_em_state;
     congruence_closure &          m_cc;
     buffer<new_instance> &        m_new_instances;
+    bool                          m_filter;
     unsigned                      m_gen;
 
     state                         m_state;
     buffer<pair<state, unsigned>> m_choice_stack;
 
+    /* Results of the filter instructions (see ematch_filter_code) for the root of an equivalence class,
+       and of the (it_fn =?= instr.m_fn) tests they perform. */
+    std::unordered_map<pair<expr, unsigned>, bool, root_instr_hash> m_instr_results;
+    expr_pair_struct_map<bool>    m_compatible_fns;
+    /* Terms that may be matched by a pattern with the given head symbol, and the subset of
+       modified terms (i.e., mt == gmt). See ematch_terms_core. */
+    rb_map<head_index, unsigned, head_index::cmp> m_candidate_idx[2];
+    std::vector<std::vector<expr>> m_candidates;
+
     expr instantiate_mvars(expr const & e) {
         return m_ctx.instantiate_mvars(e);
     }
@@ -316,7 +410,12 @@ class ematch_fn {
 
     expr tmp_internalize(expr const & e) {
         expr new_e = m_cc.normalize(e);
-        m_cc.internalize(new_e, 0);
+        if (!m_cc.get_entry(new_e)) {
+            m_cc.internalize(new_e, 0);
+            /* The new terms may have been merged with existing equivalence classes (e.g., by congruence),
+               so the results of the filter instructions for their roots may have changed. */
+            m_instr_results.clear();
+        }
         return new_e;
     }
 
@@ -715,6 +814,90 @@ class ematch_fn {
         return match_args(s, p_args, it);
     }
 
+    ematch_filter_code & get_code() {
+        std::shared_ptr<ematch_filter_code> & code = m_em_state.m_code;
+        if (!code)
+            code = std::make_shared<ematch_filter_code>();
+        else if (code.use_count() > 1)
+            code = std::make_shared<ematch_filter_code>(*code);
+        return *code;
+    }
+
+    bool is_compatible_fn(expr const & it_fn, ematch_filter_instr const & instr) {
+        if (!is_constant(it_fn))
+            return true;
+        if (const_name(it_fn) == const_name(instr.m_fn))
+            return true;
+        if (!m_ctx.is_unfoldable(const_name(it_fn)) && !m_ctx.is_unfoldable(const_name(instr.m_fn)))
+            return false;
+        expr_pair key(it_fn, instr.m_fn);
+        auto it = m_compatible_fns.find(key);
+        if (it != m_compatible_fns.end())
+            return it->second;
+        type_context::tmp_mode_scope scope(m_ctx, instr.m_num_uvars, 0);
+        bool r = m_ctx.is_def_eq(it_fn, instr.m_fn);
+        m_compatible_fns.insert(mk_pair(key, r));
+        return r;
+    }
+
+    /* Return false if process_match must fail for an argument matching instr, and
+       equivalent to the argument \c a. */
+    bool eval_instr(ematch_filter_code const & code, unsigned idx, expr const & a) {
+        if (!m_cc.get_entry(a))
+            return true;
+        pair<expr, unsigned> key(m_cc.get_root(a), idx);
+        auto r_it = m_instr_results.find(key);
+        if (r_it != m_instr_results.end())
+            return r_it->second;
+        ematch_filter_instr const & instr = code.m_instrs[idx];
+        bool r  = false;
+        expr it = a;
+        do {
+            if (get_app_num_args(it) == instr.m_nargs &&
+                m_cc.get_generation_of(it) < m_em_state.m_config.m_max_generation &&
+                (m_cc.is_congr_root(it) || m_cc.in_heterogeneous_eqc(it)) &&
+                is_compatible_fn(get_app_fn(it), instr)) {
+                r = true;
+                break;
+            }
+            it = m_cc.get_next(it);
+        } while (it != a);
+        m_instr_results.insert(mk_pair(key, r));
+        return r;
+    }
+
+    /* Return false if the pattern p cannot match t, using the filter instructions compiled for p.
+       Only the arguments that are matched using process_match are checked. */
+    bool may_match(expr const & p, expr const & t) {
+        if (!m_filter || !m_em_state.m_code)
+            return true;
+        ematch_filter_code const & code = *m_em_state.m_code;
+        list<unsigned> const * p_code = code.m_code.find(p);
+        if (!p_code || !*p_code)
+            return true;
+        buffer<expr> t_args;
+        expr const & t_fn = get_app_args(t, t_args);
+        unsigned nargs    = get_app_num_args(p);
+        if (t_args.size() < nargs)
+            return true;
+        fun_info finfo                 = get_fun_info(m_ctx, t_fn, nargs);
+        list<ss_param_info> sinfo      = get_subsingleton_info(m_ctx, t_fn, nargs);
+        list<param_info> const * it1   = &finfo.get_params_info();
+        list<ss_param_info> const *it2 = &sinfo;
+        list<unsigned> const * it3     = p_code;
+        for (unsigned i = 0; i < nargs && *it3; i++) {
+            if (code.m_instrs[head(*it3)].m_arg == i) {
+                bool match = !(*it1 && head(*it1).is_inst_implicit()) && !(*it2 && head(*it2).is_subsingleton());
+                if (match && !eval_instr(code, head(*it3), t_args[i]))
+                    return false;
+                it3 = &tail(*it3);
+            }
+            if (*it1) it1 = &tail(*it1);
+            if (*it2) it2 = &tail(*it2);
+        }
+        return true;
+    }
+
     bool check_generation(expr const & t) {
         unsigned gen = m_cc.get_generation_of(t);
         if (gen >= m_em_state.m_config.m_max_generation) {
@@ -733,7 +916,8 @@ class ematch_fn {
         buffer<pair<state, unsigned>> new_states;
         if (auto s = m_em_state.get_app_map().find(head_index(f))) {
             s->for_each([&](expr const & t) {
-                    if (check_generation(t) && (m_cc.is_congr_root(t) || m_cc.in_heterogeneous_eqc(t))) {
+                    if (check_generation(t) && (m_cc.is_congr_root(t) || m_cc.in_heterogeneous_eqc(t)) &&
+                        may_match(p, t)) {
                         state new_state = m_state;
                         if (match_args_prefix(new_state, p_args, t))
                             new_states.emplace_back(new_state, m_cc.get_generation_of(t));
@@ -974,18 +1158,37 @@ class ematch_fn {
         main(lemma, init_state, ps[0], t);
     }
 
-    void ematch_terms_core(hinst_lemma const & lemma, buffer<expr> const & ps, bool filter) {
-        expr const & fn  = get_app_fn(ps[0]);
-        unsigned gmt     = m_cc.get_gmt();
-        state init_state = mk_inital_state(ps);
-        if (rb_expr_set const * s = m_em_state.get_app_map().find(head_index(fn))) {
+    /* Return the terms that may be matched by patterns of the form (fn ...).
+       If filter is true, then only modified terms are returned. */
+    std::vector<expr> const & get_candidates(expr const & fn, bool filter) {
+        head_index h(fn);
+        if (unsigned const * idx = m_candidate_idx[filter].find(h))
+            return m_candidates[*idx];
+        unsigned idx = m_candidates.size();
+        m_candidate_idx[filter].insert(h, idx);
+        m_candidates.push_back(std::vector<expr>());
+        unsigned gmt = m_cc.get_gmt();
+        if (rb_expr_set const * s = m_em_state.get_app_map().find(h)) {
             s->for_each([&](expr const & t) {
                     if ((m_cc.is_congr_root(t) || m_cc.in_heterogeneous_eqc(t)) &&
                         (!filter || m_cc.get_mt(t) == gmt)) {
-                        main(lemma, init_state, ps[0], t);
+                        m_candidates[idx].push_back(t);
                     }
                 });
         }
+        return m_candidates[idx];
+    }
+
+    void ematch_terms_core(hinst_lemma const & lemma, buffer<expr> const & ps, bool filter) {
+        expr const & fn  = get_app_fn(ps[0]);
+        state init_state = mk_inital_state(ps);
+        ematch_filter_code & code = get_code();
+        for (expr const & p : ps)
+            code.compile(lemma, p);
+        for (expr const & t : get_candidates(fn, filter)) {
+            if (m_cc.get_generation_of(t) >= m_em_state.m_config.m_max_generation || may_match(ps[0], t))
+                main(lemma, init_state, ps[0], t);
+        }
     }
 
     /* Match internalized terms in m_em_state with the given multipatterns.
@@ -1018,7 +1221,8 @@ class ematch_fn {
 
 public:
     ematch_fn(type_context & ctx, ematch_state & ems, congruence_closure & cc, buffer<new_instance> & new_insts):
-        m_ctx(ctx), m_em_state(ems), m_cc(cc), m_new_instances(new_insts) {}
+        m_ctx(ctx), m_em_state(ems), m_cc(cc), m_new_instances(new_insts),
+        m_filter(get_ematch_filter(ctx.get_options())) {}
 
     void ematch_term(hinst_lemma const & lemma, expr const & t) {
         /* The following scope is a temporary workaround, we need to refactor this module
@@ -1152,6 +1356,9 @@ vm_obj ematch_all_core(vm_obj const & md, vm_obj const & _ccs, vm_obj const & _e
 }
 
 void initialize_ematch() {
+    g_ematch_filter = new name{"ematch", "filter"};
+    register_bool_option(*g_ematch_filter, LEAN_DEFAULT_EMATCH_FILTER,
+                         "(ematch) before matching a pattern, check that the arguments of the term have the heads required by the pattern (pre-match filter)");
     register_trace_class(name{"smt", "ematch"});
     register_trace_class(name({"debug", "smt", "ematch"}));
 
@@ -1161,5 +1368,6 @@ void initialize_ematch() {
     DECLARE_VM_BUILTIN(name({"tactic", "ematch_all_core"}),        ematch_all_core);
 }
 void finalize_ematch() {
+    delete g_ematch_filter;
 }
 }
@@ -5,6 +5,7 @@ Released under Apache 2.0 license as described in the file LICENSE.
 Author: Leonardo de Moura
 */
 #pragma once
+#include <memory>
 #include "library/type_context.h"
 #include "library/head_map.h"
 #include "library/tactic/smt/congruence_closure.h"
@@ -20,6 +21,7 @@ struct ematch_config {
 };
 
 class ematch_fn;
+struct ematch_filter_code;
 
 class ematch_state {
     friend class ematch_fn;
@@ -30,6 +32,9 @@ class ematch_state {
     ematch_config         m_config;
     hinst_lemmas          m_lemmas;
     hinst_lemmas          m_new_lemmas;
+    /* Filter instructions compiled from the patterns of the lemmas above, see ematch.cpp.
+       It is a cache, and it is shared by the copies of this object. */
+    std::shared_ptr<ematch_filter_code> m_code;
 public:
     ematch_state(ematch_config const & cfg, hinst_lemmas const & lemmas = hinst_lemmas()):
         m_config(cfg), m_new_lemmas(lemmas) {}
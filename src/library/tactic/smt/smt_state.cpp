@@ -221,12 +221,15 @@ static simplify_fn mk_simp(type_context & ctx, defeq_can_state & dcs, smt_pre_co
     return simplify_fn(ctx, dcs, cfg.m_simp_lemmas, scfg);
 }
 
-static simp_result preprocess(type_context & ctx, defeq_can_state & dcs, smt_pre_config const & cfg, expr const & e) {
+static simp_result preprocess(type_context & ctx, defeq_can_state & dcs, smt_pre_config const & cfg, expr const & e,
+                              optional<persistent_simplify_cache> * cache = nullptr) {
     type_context::zeta_scope         scope1(ctx, cfg.m_zeta);
     type_context::transparency_scope scope2(ctx, transparency_mode::Reducible);
     dsimplify_fn dsimp       = mk_dsimp(ctx, dcs, cfg);
     expr new_e               = dsimp(e);
     simplify_fn simp         = mk_simp(ctx, dcs, cfg);
+    if (cache && *cache)
+        simp.set_persistent_cache(**cache);
     simp_result r            = simp(get_eq_name(), new_e);
     return r;
 }
@@ -237,7 +240,9 @@ static vm_obj preprocess(tactic_state s, smt_pre_config const & cfg) {
     type_context ctx         = mk_type_context_for(s, transparency_mode::Reducible);
     expr target              = g->get_type();
     defeq_can_state dcs      = s.dcs();
-    simp_result r            = preprocess(ctx, dcs, cfg, target);
+    optional<persistent_simplify_cache> cache = get_persistent_simplify_cache(s);
+    simp_result r            = preprocess(ctx, dcs, cfg, target, &cache);
+    s                        = set_persistent_simplify_cache(s, cache);
     if (!r.has_proof()) {
         tactic_state new_s = set_dcs(s, dcs);
         return change(r.get_new(), new_s);
@@ -890,9 +895,10 @@ vm_obj smt_tactic_preprocess(vm_obj const & e, vm_obj const & ss, vm_obj const &
     type_context ctx    = mk_type_context_for(ts);
     smt_goal g          = to_smt_goal(head(ss));
     defeq_can_state dcs = ts.dcs();
-    simp_result r       = preprocess(ctx, dcs, g.get_pre_config(), to_expr(e));
+    optional<persistent_simplify_cache> cache = get_persistent_simplify_cache(ts);
+    simp_result r       = preprocess(ctx, dcs, g.get_pre_config(), to_expr(e), &cache);
     r                   = finalize(ctx, get_eq_name(), r);
-    tactic_state new_ts = set_mctx_dcs(ts, ctx.mctx(), dcs);
+    tactic_state new_ts = set_persistent_simplify_cache(set_mctx_dcs(ts, ctx.mctx(), dcs), cache);
     return mk_smt_tactic_success(mk_vm_pair(to_obj(r.get_new()), to_obj(r.get_proof())), ss, to_obj(new_ts));
     LEAN_TACTIC_CATCH(ts);
 }
@@ -48,8 +48,8 @@ void tactic_state_cell::dealloc() {
 
 tactic_state::tactic_state(environment const & env, options const & o, name const & decl_name, metavar_context const & ctx,
                            list<expr> const & gs, expr const & main, defeq_canonizer::state const & dcs,
-                           tactic_user_state const & us) {
-    m_ptr = new tactic_state_cell(env, o, decl_name, ctx, gs, main, dcs, us);
+                           tactic_user_state const & us, simplify_cache_ptr const & sc) {
+    m_ptr = new tactic_state_cell(env, o, decl_name, ctx, gs, main, dcs, us, sc);
     m_ptr->inc_ref();
 }
 
@@ -80,25 +80,25 @@ tactic_state mk_tactic_state_for_metavar(environment const & env, options const
 }
 
 tactic_state set_options(tactic_state const & s, options const & o) {
-    return tactic_state(s.env(), o, s.decl_name(), s.mctx(), s.goals(), s.main(), s.dcs(), s.us());
+    return tactic_state(s.env(), o, s.decl_name(), s.mctx(), s.goals(), s.main(), s.dcs(), s.us(), s.sc());
 }
 
 tactic_state set_env(tactic_state const & s, environment const & env) {
-    return tactic_state(env, s.get_options(), s.decl_name(), s.mctx(), s.goals(), s.main(), s.dcs(), s.us());
+    return tactic_state(env, s.get_options(), s.decl_name(), s.mctx(), s.goals(), s.main(), s.dcs(), s.us(), s.sc());
 }
 
 tactic_state set_mctx(tactic_state const & s, metavar_context const & mctx) {
     if (is_eqp(s.mctx(), mctx)) return s;
-    return tactic_state(s.env(), s.get_options(), s.decl_name(), mctx, s.goals(), s.main(), s.dcs(), s.us());
+    return tactic_state(s.env(), s.get_options(), s.decl_name(), mctx, s.goals(), s.main(), s.dcs(), s.us(), s.sc());
 }
 
 tactic_state set_mctx_dcs(tactic_state const & s, metavar_context const & mctx, defeq_can_state const & dcs) {
     if (is_eqp(s.mctx(), mctx) && is_eqp(s.dcs(), dcs)) return s;
-    return tactic_state(s.env(), s.get_options(), s.decl_name(), mctx, s.goals(), s.main(), dcs, s.us());
+    return tactic_state(s.env(), s.get_options(), s.decl_name(), mctx, s.goals(), s.main(), dcs, s.us(), s.sc());
 }
 
 tactic_state set_env_mctx(tactic_state const & s, environment const & env, metavar_context const & mctx) {
-    return tactic_state(env, s.get_options(), s.decl_name(), mctx, s.goals(), s.main(), s.dcs(), s.us());
+    return tactic_state(env, s.get_options(), s.decl_name(), mctx, s.goals(), s.main(), s.dcs(), s.us(), s.sc());
 }
 
 static list<expr> consume_solved_prefix(metavar_context const & mctx, list<expr> const & gs) {
@@ -112,12 +112,12 @@ static list<expr> consume_solved_prefix(metavar_context const & mctx, list<expr>
 
 tactic_state set_goals(tactic_state const & s, list<expr> const & gs) {
     return tactic_state(s.env(), s.get_options(), s.decl_name(), s.mctx(), consume_solved_prefix(s.mctx(), gs),
-                        s.main(), s.dcs(), s.us());
+                        s.main(), s.dcs(), s.us(), s.sc());
 }
 
 tactic_state set_mctx_goals_dcs(tactic_state const & s, metavar_context const & mctx, list<expr> const & gs, defeq_can_state const & dcs) {
     return tactic_state(s.env(), s.get_options(), s.decl_name(), mctx, consume_solved_prefix(mctx, gs), s.main(), dcs,
-                        s.us());
+                        s.us(), s.sc());
 }
 
 tactic_state set_mctx_goals(tactic_state const & s, metavar_context const & mctx, list<expr> const & gs) {
@@ -127,7 +127,7 @@ tactic_state set_mctx_goals(tactic_state const & s, metavar_context const & mctx
 tactic_state set_env_mctx_goals(tactic_state const & s, environment const & env,
                                 metavar_context const & mctx, list<expr> const & gs) {
     return tactic_state(env, s.get_options(), s.decl_name(), mctx, consume_solved_prefix(mctx, gs),
-                        s.main(), s.dcs(), s.us());
+                        s.main(), s.dcs(), s.us(), s.sc());
 }
 
 tactic_state set_mctx_lctx_dcs(tactic_state const & s, metavar_context const & mctx, local_context const & lctx, defeq_can_state const & dcs) {
@@ -138,7 +138,7 @@ tactic_state set_mctx_lctx_dcs(tactic_state const & s, metavar_context const & m
     }
     metavar_context new_mctx = mctx;
     expr mvar = new_mctx.mk_metavar_decl(lctx, mk_true());
-    return tactic_state(s.env(), s.get_options(), s.decl_name(), new_mctx, to_list(mvar), mvar, s.dcs(), s.us());
+    return tactic_state(s.env(), s.get_options(), s.decl_name(), new_mctx, to_list(mvar), mvar, s.dcs(), s.us(), s.sc());
 }
 
 tactic_state set_mctx_lctx(tactic_state const & s, metavar_context const & mctx, local_context const & lctx) {
@@ -147,11 +147,16 @@ tactic_state set_mctx_lctx(tactic_state const & s, metavar_context const & mctx,
 
 tactic_state set_defeq_can_state(tactic_state const & s, defeq_can_state const & dcs) {
     if (is_eqp(s.dcs(), dcs)) return s;
-    return tactic_state(s.env(), s.get_options(), s.decl_name(), s.mctx(), s.goals(), s.main(), dcs, s.us());
+    return tactic_state(s.env(), s.get_options(), s.decl_name(), s.mctx(), s.goals(), s.main(), dcs, s.us(), s.sc());
+}
+
+tactic_state set_simplify_cache(tactic_state const & s, simplify_cache_ptr const & sc) {
+    if (s.sc() == sc) return s;
+    return tactic_state(s.env(), s.get_options(), s.decl_name(), s.mctx(), s.goals(), s.main(), s.dcs(), s.us(), sc);
 }
 
 tactic_state set_user_state(tactic_state const & s, tactic_user_state const & us) {
-    return tactic_state(s.env(), s.get_options(), s.decl_name(), s.mctx(), s.goals(), s.main(), s.dcs(), us);
+    return tactic_state(s.env(), s.get_options(), s.decl_name(), s.mctx(), s.goals(), s.main(), s.dcs(), us, s.sc());
 }
 
 format tactic_state::pp_expr(formatter_factory const & fmtf, expr const & e) const {
@@ -6,6 +6,7 @@ Author: Leonardo de Moura
 */
 #pragma once
 #include <algorithm>
+#include <memory>
 #include "util/sstream.h"
 #include "kernel/environment.h"
 #include "library/metavar_context.h"
@@ -17,6 +18,10 @@ Author: Leonardo de Moura
 namespace lean {
 typedef defeq_canonizer::state defeq_can_state;
 
+class persistent_simplify_cache;
+/* Simplification results shared by the simplifier invocations of a tactic proof (see simplify.h) */
+typedef std::shared_ptr<persistent_simplify_cache const> simplify_cache_ptr;
+
 struct tactic_user_state {
     unsigned_map<vm_obj> m_mem;
     list<unsigned>       m_free_refs;
@@ -38,15 +43,17 @@ class tactic_state_cell {
     expr              m_main;
     defeq_can_state   m_defeq_can_state;
     tactic_user_state m_tactic_user_state;
+    simplify_cache_ptr m_simplify_cache;
     friend class tactic_state;
     void dealloc();
 public:
     tactic_state_cell(environment const & env, options const & o, name const & decl_name,
                       metavar_context const & ctx, list<expr> const & gs,
-                      expr const & main, defeq_can_state const & s, tactic_user_state const & us):
+                      expr const & main, defeq_can_state const & s, tactic_user_state const & us,
+                      simplify_cache_ptr const & sc):
         m_rc(0), m_env(env), m_options(o), m_decl_name(decl_name),
         m_mctx(ctx), m_goals(gs), m_main(main), m_defeq_can_state(s),
-        m_tactic_user_state(us) {}
+        m_tactic_user_state(us), m_simplify_cache(sc) {}
 };
 
 class tactic_state {
@@ -60,7 +67,8 @@ private:
 public:
     tactic_state(environment const & env, options const & o, name const & decl_name,
                  metavar_context const & ctx, list<expr> const & gs,
-                 expr const & main, defeq_can_state const & s, tactic_user_state const & us);
+                 expr const & main, defeq_can_state const & s, tactic_user_state const & us,
+                 simplify_cache_ptr const & sc = simplify_cache_ptr());
     tactic_state(tactic_state const & s):m_ptr(s.m_ptr) { if (m_ptr) m_ptr->inc_ref(); }
     tactic_state(tactic_state && s):m_ptr(s.m_ptr) { s.m_ptr = nullptr; }
     ~tactic_state() { if (m_ptr) m_ptr->dec_ref(); }
@@ -78,6 +86,8 @@ public:
     defeq_can_state const & dcs() const { return get_defeq_canonizer_state(); }
     tactic_user_state const & get_user_state() const { return m_ptr->m_tactic_user_state; }
     tactic_user_state const & us() const { return get_user_state(); }
+    simplify_cache_ptr const & get_simplify_cache() const { return m_ptr->m_simplify_cache; }
+    simplify_cache_ptr const & sc() const { return get_simplify_cache(); }
 
     tactic_state & operator=(tactic_state const & s) { LEAN_COPY_REF(s); }
     tactic_state & operator=(tactic_state && s) { LEAN_MOVE_REF(s); }
@@ -119,6 +129,7 @@ tactic_state set_env_mctx_goals(tactic_state const & s, environment const & env,
 tactic_state set_mctx_goals_dcs(tactic_state const & s, metavar_context const & mctx, list<expr> const & gs, defeq_can_state const & dcs);
 tactic_state set_defeq_can_state(tactic_state const & s, defeq_can_state const & dcs);
 tactic_state set_user_state(tactic_state const & s, tactic_user_state const & us);
+tactic_state set_simplify_cache(tactic_state const & s, simplify_cache_ptr const & sc);
 inline tactic_state set_dcs(tactic_state const & s, defeq_can_state const & dcs) { return set_defeq_can_state(s, dcs); }
 
 
@@ -7,13 +7,17 @@ Author: Leonardo de Moura
 #include <algorithm>
 #include "util/flet.h"
 #include "util/interrupt.h"
+#include "util/sampling_profiler.h"
 #include "util/sexpr/option_declarations.h"
 #include "kernel/instantiate.h"
 #include "kernel/abstract.h"
 #include "kernel/error_msgs.h"
 #include "kernel/replace_fn.h"
 #include "kernel/for_each_fn.h"
+#include "kernel/expr_arena.h"
+#include "kernel/delta_hints.h"
 #include "kernel/inductive/inductive.h"
+#include "kernel/quotient/quotient.h"
 #include "library/trace.h"
 #include "library/class.h"
 #include "library/pp_options.h"
@@ -32,6 +36,7 @@ Author: Leonardo de Moura
 #include "library/fun_info.h"
 #include "library/num.h"
 #include "library/quote.h"
+#include "library/discr_tree.h"
 
 #ifndef LEAN_DEFAULT_CLASS_INSTANCE_MAX_DEPTH
 #define LEAN_DEFAULT_CLASS_INSTANCE_MAX_DEPTH 32
@@ -45,6 +50,14 @@ Author: Leonardo de Moura
 #define LEAN_DEFAULT_UNFOLD_LEMMAS false
 #endif
 
+#ifndef LEAN_DEFAULT_CLASS_INSTANCE_TABLING
+#define LEAN_DEFAULT_CLASS_INSTANCE_TABLING false
+#endif
+
+#ifndef LEAN_DEFAULT_CLASS_INSTANCE_INDEX
+#define LEAN_DEFAULT_CLASS_INSTANCE_INDEX true
+#endif
+
 /* Comment the following line for disabling the thread local caches.
    This is useful for debugging cache management bugs. */
 #define LEAN_TYPE_CONTEXT_CACHE_RESULTS
@@ -59,6 +72,9 @@ namespace lean {
 static name * g_class_instance_max_depth = nullptr;
 static name * g_nat_offset_threshold     = nullptr;
 static name * g_unfold_lemmas            = nullptr;
+static name * g_class_instance_index     = nullptr;
+static name * g_class_instance_tabling   = nullptr;
+static expr * g_instance_index_star      = nullptr;
 
 unsigned get_class_instance_max_depth(options const & o) {
     return o.get_unsigned(*g_class_instance_max_depth, LEAN_DEFAULT_CLASS_INSTANCE_MAX_DEPTH);
@@ -72,6 +88,14 @@ bool get_unfold_lemmas(options const & o) {
     return o.get_bool(*g_unfold_lemmas, LEAN_DEFAULT_UNFOLD_LEMMAS);
 }
 
+bool get_class_instance_tabling(options const & o) {
+    return o.get_bool(*g_class_instance_tabling, LEAN_DEFAULT_CLASS_INSTANCE_TABLING);
+}
+
+bool get_class_instance_index(options const & o) {
+    return o.get_bool(*g_class_instance_index, LEAN_DEFAULT_CLASS_INSTANCE_INDEX);
+}
+
 bool is_at_least_semireducible(transparency_mode m) {
     return m == transparency_mode::All || m == transparency_mode::Semireducible;
 }
@@ -242,12 +266,22 @@ bool type_context::tmp_locals::all_let_decls() const {
    ===================== */
 MK_THREAD_LOCAL_GET_DEF(type_context_cache_manager, get_tcm);
 
+/* The type_context_cache outlives the arena scopes (see expr_arena_scope) that are active when
+   its entries are created, so we copy them out of the arena instead of keeping its chunks alive. */
+static expr copy_for_cache(expr const & e) {
+    return in_expr_arena() ? copy_out_of_arena(e) : e;
+}
+
+static optional<expr> copy_for_cache(optional<expr> const & e) {
+    return e ? some_expr(copy_for_cache(*e)) : e;
+}
+
 void type_context::cache_failure(expr const & CACHE_CODE(t), expr const & CACHE_CODE(s)) {
     CACHE_CODE(
         if (t.hash() <= s.hash())
-            get_failure_cache().insert(mk_pair(t, s));
+            get_failure_cache().insert(mk_pair(copy_for_cache(t), copy_for_cache(s)));
         else
-            get_failure_cache().insert(mk_pair(s, t));
+            get_failure_cache().insert(mk_pair(copy_for_cache(s), copy_for_cache(t)));
         )
 }
 
@@ -906,6 +940,7 @@ expr type_context::whnf(expr const & e) {
             if (it != cache.end())
                 return it->second;
         });
+    scoped_profiler_phase phase("whnf");
     reset_used_assignment reset(*this);
     unsigned postponed_sz = m_postponed.size();
     expr t = e;
@@ -917,7 +952,7 @@ expr type_context::whnf(expr const & e) {
             if ((!in_tmp_mode() || !has_expr_metavar(t1)) &&
                 !m_used_assignment && !is_stuck(t1) &&
                 postponed_sz == m_postponed.size() && !m_transparency_pred && !m_unfold_pred) {
-                CACHE_CODE(cache.insert(mk_pair(e, t1)););
+                CACHE_CODE(cache.insert(mk_pair(copy_for_cache(e), copy_for_cache(t1))););
             }
             return t1;
         }
@@ -1042,7 +1077,7 @@ expr type_context::infer_core(expr const & e) {
 #ifndef LEAN_NO_TYPE_INFER_CACHE
     CACHE_CODE(
         if (!m_used_assignment && postponed_sz == m_postponed.size())
-            cache.insert(mk_pair(e, r)););
+            cache.insert(mk_pair(copy_for_cache(e), copy_for_cache(r))););
 #endif
     return r;
 }
@@ -3017,6 +3052,10 @@ lbool type_context::is_def_eq_delta(expr const & t, expr const & s) {
                (i.e., we mimic the behavior of the kernel type checker. */
             if (!has_expr_metavar(t) && !has_expr_metavar(s)) {
                 int c = compare(d_t->get_hints(), d_s->get_hints());
+                if (c == 0) {
+                    /* the heights do not decide, use the unfolding hints of the imported modules */
+                    c = compare_delta_hints(env(), d_t->get_name(), d_s->get_name());
+                }
                 if (c < 0) {
                     return to_lbool(is_def_eq_core_core(*unfold_definition(t), s));
                 } else if (c > 0) {
@@ -3188,6 +3227,7 @@ bool type_context::is_def_eq_core(expr const & t, expr const & s) {
 }
 
 bool type_context::is_def_eq(expr const & t, expr const & s) {
+    scoped_profiler_phase phase("unification");
     scope S(*this);
     flet<bool> in_is_def_eq(m_in_is_def_eq, true);
     bool success = is_def_eq_core(t, s);
@@ -3335,8 +3375,14 @@ struct instance_synthesizer {
     struct stack_entry {
         expr     m_mvar;
         unsigned m_depth;
+        /* When m_complete is true, this entry is a marker for the tabled subgoal m_mvar, and all
+           subgoals produced while solving it have been solved. m_choice_idx is its choice point. */
+        bool     m_complete;
+        unsigned m_choice_idx;
         stack_entry(expr const & m, unsigned d):
-            m_mvar(m), m_depth(d) {}
+            m_mvar(m), m_depth(d), m_complete(false), m_choice_idx(0) {}
+        stack_entry(expr const & m, unsigned d, unsigned idx):
+            m_mvar(m), m_depth(d), m_complete(true), m_choice_idx(idx) {}
     };
 
     struct state {
@@ -3347,6 +3393,11 @@ struct instance_synthesizer {
         list<expr>         m_local_instances;
         list<name>         m_instances;
         state              m_state;
+        /* Tabling information (see tabled_resolution). m_num_loops is the value of
+           instance_synthesizer::m_num_loops when the choice point was created. */
+        optional<expr>     m_table_key;
+        bool               m_answered{false};
+        unsigned           m_num_loops{0};
     };
 
     type_context &        m_ctx;
@@ -3357,11 +3408,29 @@ struct instance_synthesizer {
     transparency_mode     m_old_transparency_mode;
     bool                  m_old_zeta;
 
+    /* Tabled resolution.
+
+       When class.instance_tabling is set to true, we store the answers of subgoals in m_table.
+       The keys are the subgoal types where unassigned metavariables are renamed in order of occurrence.
+       We only store answers for subgoals without metavariables, and they are also
+       shared with other resolutions using m_instance_cache. After we find the answer for one of
+       these subgoals, we do not backtrack into its alternatives.
+       We also store failures (i.e., subgoals that have no answers) and, since we use depth-first search,
+       we cut loops: a subgoal which is a variant of a subgoal being solved fails.
+       A failure is not stored if a loop was cut while the failed subgoal was being solved. */
+    bool                  m_tabling;
+    expr_struct_map<optional<expr>> m_table;
+    expr_struct_set       m_in_progress;
+    unsigned              m_num_table_hits{0};
+    unsigned              m_num_table_answers{0};
+    unsigned              m_num_loops{0};
+
     instance_synthesizer(type_context & ctx):
         m_ctx(ctx),
         m_displayed_trace_header(false),
         m_old_transparency_mode(m_ctx.m_transparency_mode),
-        m_old_zeta(m_ctx.m_zeta) {
+        m_old_zeta(m_ctx.m_zeta),
+        m_tabling(get_class_instance_tabling(m_ctx.get_options())) {
         lean_assert(m_ctx.in_tmp_mode());
         m_ctx.m_transparency_mode = transparency_mode::Instances;
         m_ctx.m_zeta              = true;
@@ -3485,7 +3554,7 @@ struct instance_synthesizer {
         return to_list(selected);
     }
 
-    bool mk_choice_point(expr const & mvar) {
+    bool mk_choice_point(expr const & mvar, optional<expr> const & table_key) {
         lean_assert(is_metavar(mvar));
         if (m_choices.size() > m_ctx.m_cache->m_ci_max_depth) {
             throw_class_exception(m_ctx.infer(m_main_mvar),
@@ -3509,13 +3578,257 @@ struct instance_synthesizer {
         if (!cname)
             return false;
         r.m_local_instances = get_local_instances(*cname);
-        r.m_instances = get_class_instances(env(), *cname);
+        r.m_instances = get_instance_candidates(*cname, mvar_type);
         if (empty(r.m_local_instances) && empty(r.m_instances))
             return false;
+        if (table_key) {
+            /* Add completion marker below the subgoals produced by the alternatives. */
+            r.m_table_key   = table_key;
+            r.m_num_loops   = m_num_loops;
+            m_in_progress.insert(*table_key);
+            stack_entry const & e = head(m_state.m_stack);
+            m_state.m_stack = cons(e, cons(stack_entry(mvar, e.m_depth, m_choices.size() - 1), tail(m_state.m_stack)));
+        }
         r.m_state = m_state;
         return true;
     }
 
+    /* Return the key for tabling a subgoal of type \c type, i.e., \c type with its unassigned temporary
+       metavariables renamed in order of occurrence. Return none if \c type contains universe metavariables. */
+    optional<expr> mk_table_key(expr const & type) {
+        if (has_univ_metavar(type))
+            return none_expr();
+        expr_struct_map<expr> renaming;
+        expr key = replace(type, [&](expr const & e, unsigned) {
+                if (!has_expr_metavar(e))
+                    return some_expr(e);
+                if (is_idx_metavar(e)) {
+                    auto it = renaming.find(e);
+                    if (it != renaming.end())
+                        return some_expr(it->second);
+                    expr new_e = mk_idx_metavar(renaming.size(), mk_Prop());
+                    renaming.insert(mk_pair(e, new_e));
+                    return some_expr(new_e);
+                }
+                return none_expr();
+            });
+        return some_expr(key);
+    }
+
+    void push_failed_choice_point() {
+        m_choices.push_back(choice());
+        push_scope();
+        m_choices.back().m_state = m_state;
+    }
+
+    /* Try to solve \c e using the table. Return l_undef if the table does not contain information about it. */
+    lbool try_table(stack_entry const & e, expr const & key) {
+        optional<optional<expr>> r;
+        auto it = m_table.find(key);
+        if (it != m_table.end()) {
+            r = it->second;
+        } else if (!has_metavar(key)) {
+#ifndef LEAN_NO_TYPE_CLASS_CACHE
+            CACHE_CODE(
+                auto it2 = m_ctx.m_cache->m_instance_cache.find(key);
+                if (it2 != m_ctx.m_cache->m_instance_cache.end())
+                    r = it2->second;);
+#endif
+        }
+        if (r) {
+            m_num_table_hits++;
+            lean_trace_plain("class_instances",
+                             scope_trace_env scope(m_ctx.env(), m_ctx);
+                             tout() << "(" << e.m_depth << ") table hit: " << key << " := ";
+                             if (*r) tout() << **r << "\n"; else tout() << "failed\n";);
+            if (!*r) {
+                push_failed_choice_point();
+                return l_false;
+            }
+            m_ctx.assign(e.m_mvar, **r);
+            m_state.m_stack = tail(m_state.m_stack);
+            return l_true;
+        }
+        if (m_in_progress.find(key) != m_in_progress.end()) {
+            m_num_loops++;
+            lean_trace_plain("class_instances",
+                             scope_trace_env scope(m_ctx.env(), m_ctx);
+                             tout() << "(" << e.m_depth << ") loop: " << key << "\n";);
+            push_failed_choice_point();
+            return l_false;
+        }
+        return l_undef;
+    }
+
+    /* The subgoal associated with the completion marker \c e has been solved. */
+    void complete_subgoal(stack_entry const & e) {
+        lean_assert(e.m_choice_idx < m_choices.size());
+        choice & c = m_choices[e.m_choice_idx];
+        lean_assert(c.m_table_key);
+        expr const & key = *c.m_table_key;
+        c.m_answered = true;
+        m_in_progress.erase(key);
+        if (has_metavar(key))
+            return;
+        expr answer = m_ctx.instantiate_mvars(e.m_mvar);
+        if (has_metavar(answer))
+            return;
+        m_num_table_answers++;
+        m_table[key] = some_expr(answer);
+        cache_result(key, some_expr(answer));
+        lean_trace_plain("class_instances",
+                         scope_trace_env scope(m_ctx.env(), m_ctx);
+                         tout() << "(" << e.m_depth << ") new answer: " << key << " := " << answer << "\n";);
+        /* We do not backtrack into the alternatives of the subgoal and its descendants. */
+        for (unsigned i = e.m_choice_idx; i < m_choices.size(); i++) {
+            m_choices[i].m_local_instances = list<expr>();
+            m_choices[i].m_instances       = list<name>();
+        }
+    }
+
+    /* The choice point \c c is about to be removed, and all its alternatives have been tried. */
+    void remove_choice_point(choice const & c) {
+        if (!c.m_table_key)
+            return;
+        expr const & key = *c.m_table_key;
+        m_in_progress.erase(key);
+        if (!c.m_answered && c.m_num_loops == m_num_loops) {
+            lean_trace_plain("class_instances",
+                             scope_trace_env scope(m_ctx.env(), m_ctx);
+                             tout() << "new failure: " << key << "\n";);
+            m_table[key] = none_expr();
+        }
+    }
+
+    static bool is_nat_offset_head(name const & n) {
+        return
+            n == get_nat_zero_name() || n == get_nat_succ_name() ||
+            n == get_has_zero_zero_name() || n == get_has_one_one_name() ||
+            n == get_has_add_add_name() || n == get_has_sub_sub_name() ||
+            n == get_bit0_name() || n == get_bit1_name();
+    }
+
+    /* Return the key used to index the explicit argument \c e of a class application, or none if \c e
+       must be treated as a wildcard.
+
+       The key is the head symbol of the weak head normal form of \c e. We only use constants that cannot
+       be unfolded using transparency_mode::Instances, and are not handled by special unification procedures
+       (projections, recursors, offset constraints and unification hints). So, is_def_eq fails for terms
+       with different keys. When \c is_query is false, \c e is an argument of an instance result type,
+       and its local constants are instance parameters (i.e., wildcards). */
+    optional<expr> mk_instance_index_arg(type_context & ctx, expr const & e, bool is_query) {
+        expr e_n = ctx.whnf(e);
+        if (is_sort(e_n) || is_pi(e_n))
+            return some_expr(e_n);
+        expr const & fn = get_app_fn(e_n);
+        if (is_local(fn))
+            return is_query ? some_expr(fn) : none_expr();
+        if (!is_constant(fn))
+            return none_expr();
+        name const & n = const_name(fn);
+        if (is_nat_offset_head(n) ||
+            m_ctx.m_cache->m_instance_index_hinted.contains(n) ||
+            is_projection(env(), n) ||
+            inductive::is_elim_rule(env(), n) ||
+            is_quotient_decl(env(), n) ||
+            ctx.m_cache->is_aux_recursor(n) ||
+            ctx.m_cache->is_transparent(transparency_mode::Instances, n))
+            return none_expr();
+        return some_expr(fn);
+    }
+
+    /* Given a class application `C a_1 ... a_n`, return `C k_1 ... k_n` where k_i is the key of a_i (or a wildcard). */
+    optional<expr> mk_instance_index_key(type_context & ctx, expr const & type, name const & cname, bool is_query) {
+        buffer<expr> args;
+        expr const & fn = get_app_args(type, args);
+        if (!is_constant(fn) || const_name(fn) != cname)
+            return none_expr();
+        fun_info info = get_fun_info(ctx, fn);
+        if (length(info.get_params_info()) != args.size())
+            return none_expr();
+        unsigned i = 0;
+        for (param_info const & pinfo : info.get_params_info()) {
+            optional<expr> k;
+            if (!pinfo.is_prop() && !pinfo.is_inst_implicit() && !pinfo.is_implicit())
+                k = mk_instance_index_arg(ctx, args[i], is_query);
+            args[i] = k ? *k : *g_instance_index_star;
+            i++;
+        }
+        return some_expr(mk_app(fn, args));
+    }
+
+    type_context_cache::instance_index const & get_instance_index(name const & cname) {
+        type_context_cache & cache = *m_ctx.m_cache;
+        auto it = cache.m_instance_index.find(cname);
+        if (it != cache.m_instance_index.end())
+            return it->second;
+        type_context_cache::instance_index idx;
+        idx.m_tree = std::make_shared<discr_tree>();
+        type_context aux(env(), m_ctx.get_options(), transparency_mode::Instances);
+        for (name const & inst_name : get_class_instances(env(), cname)) {
+            optional<declaration> decl = env().find(inst_name);
+            if (!decl)
+                continue;
+            try {
+                type_context::tmp_locals locals(aux);
+                expr type = decl->get_type();
+                while (true) {
+                    expr new_type = aux.relaxed_whnf(type);
+                    if (!is_pi(new_type))
+                        break;
+                    type = instantiate(binding_body(new_type), locals.push_local_from_binding(new_type));
+                }
+                if (auto key = mk_instance_index_key(aux, type, cname, false)) {
+                    idx.m_tree->insert(aux, *key, mk_constant(inst_name));
+                    idx.m_indexed.insert(inst_name);
+                }
+            } catch (exception &) {
+                /* instance is not indexed, it will always be tried */
+            }
+        }
+        return cache.m_instance_index.insert(mk_pair(cname, idx)).first->second;
+    }
+
+    /* Return the global instances of \c cname (in priority order) that may produce an element of \c mvar_type. */
+    list<name> get_instance_candidates(name const & cname, expr const & mvar_type) {
+        list<name> insts = get_class_instances(env(), cname);
+        if (!insts || !get_class_instance_index(m_ctx.get_options()))
+            return insts;
+        type_context_cache & cache = *m_ctx.m_cache;
+        if (!is_eqp(cache.m_instance_index_uhints, m_ctx.m_uhints)) {
+            cache.m_instance_index.clear();
+            cache.m_instance_index_uhints = m_ctx.m_uhints;
+            cache.m_instance_index_hinted = name_set();
+            m_ctx.m_uhints.for_each([&](name_pair const & p, unification_hint_queue const &) {
+                    cache.m_instance_index_hinted.insert(p.first);
+                    cache.m_instance_index_hinted.insert(p.second);
+                });
+        }
+        if (cache.m_instance_index_hinted.contains(cname) || is_pi(m_ctx.relaxed_whnf(mvar_type)))
+            return insts;
+        optional<expr> key = mk_instance_index_key(m_ctx, mvar_type, cname, true);
+        if (!key)
+            return insts;
+        type_context_cache::instance_index const & idx = get_instance_index(cname);
+        name_set selected;
+        idx.m_tree->find(m_ctx, *key, [&](expr const & inst) {
+                selected.insert(const_name(inst));
+                return true;
+            });
+        list<name> r = filter(insts, [&](name const & inst_name) {
+                return !idx.m_indexed.contains(inst_name) || selected.contains(inst_name);
+            });
+        unsigned num_indexed    = length(insts);
+        unsigned num_candidates = length(r);
+        cache.m_num_indexed_instances   += num_indexed;
+        cache.m_num_candidate_instances += num_candidates;
+        lean_trace_plain("class_instances",
+                         tout() << "instance index: " << num_candidates << " of " << num_indexed
+                         << " instances of " << cname << " are candidates (total: "
+                         << cache.m_num_candidate_instances << " of " << cache.m_num_indexed_instances << ")\n";);
+        return r;
+    }
+
     bool process_next_alt_core(stack_entry const & e, list<expr> & insts) {
         while (!empty(insts)) {
             expr inst       = head(insts);
@@ -3621,9 +3934,23 @@ struct instance_synthesizer {
     bool process_next_mvar() {
         lean_assert(!is_done());
         stack_entry e = head(m_state.m_stack);
+        if (e.m_complete) {
+            m_state.m_stack = tail(m_state.m_stack);
+            complete_subgoal(e);
+            return true;
+        }
         if (process_special(e))
             return true;
-        if (!mk_choice_point(e.m_mvar))
+        optional<expr> table_key;
+        if (m_tabling) {
+            table_key = mk_table_key(m_ctx.instantiate_mvars(m_ctx.infer(e.m_mvar)));
+            if (table_key) {
+                lbool r = try_table(e, *table_key);
+                if (r != l_undef)
+                    return r == l_true;
+            }
+        }
+        if (!mk_choice_point(e.m_mvar, table_key))
             return false;
         m_state.m_stack = tail(m_state.m_stack);
         return process_next_alt(e);
@@ -3634,6 +3961,8 @@ struct instance_synthesizer {
             return false;
         lean_assert(!m_choices.empty());
         while (true) {
+            if (m_tabling)
+                remove_choice_point(m_choices.back());
             m_choices.pop_back();
             pop_scope();
             if (m_choices.empty())
@@ -3676,7 +4005,7 @@ struct instance_synthesizer {
 #ifndef LEAN_NO_TYPE_CLASS_CACHE
         CACHE_CODE(
             if (!has_expr_metavar(type))
-                m_ctx.m_cache->m_instance_cache.insert(mk_pair(type, inst)););
+                m_ctx.m_cache->m_instance_cache.insert(mk_pair(copy_for_cache(type), copy_for_cache(inst))););
 #endif
     }
 
@@ -3732,6 +4061,10 @@ struct instance_synthesizer {
 
     optional<expr> main(expr const & type) {
         auto r = mk_class_instance_core(type);
+        lean_trace_plain("class_instances",
+                         if (m_tabling && m_displayed_trace_header)
+                             tout() << "tabled resolution: " << m_num_table_hits << " table hit(s), "
+                                    << m_num_table_answers << " answer(s), " << m_num_loops << " loop(s) cut\n";);
         if (r) {
             for (unsigned i = 0; i < m_choices.size(); i++) {
                 m_ctx.commit_scope();
@@ -3838,21 +4171,32 @@ static void instantiate_replacements(type_context & ctx,
 }
 
 optional<expr> type_context::mk_class_instance(expr const & type) {
+    scoped_profiler_phase phase("instance synthesis");
     scope S(*this);
     optional<expr> result;
     buffer<level_pair> u_replacements;
     buffer<expr_pair>  e_replacements;
-    if (in_tmp_mode()) {
-        expr new_type = preprocess_class(type, u_replacements, e_replacements);
-        result        = instance_synthesizer(*this)(new_type);
-        if (result)
-            instantiate_replacements(*this, u_replacements, e_replacements);
-    } else {
-        tmp_mode_scope s(*this);
-        expr new_type = preprocess_class(type, u_replacements, e_replacements);
-        result        = instance_synthesizer(*this)(new_type);
-        if (result)
-            instantiate_replacements(*this, u_replacements, e_replacements);
+    {
+        /* Most of the terms created during the search are discarded, we allocate them in an arena,
+           and copy out the ones we keep. */
+        expr_arena_scope arena;
+        if (in_tmp_mode()) {
+            expr new_type = preprocess_class(type, u_replacements, e_replacements);
+            result        = instance_synthesizer(*this)(new_type);
+            if (result)
+                instantiate_replacements(*this, u_replacements, e_replacements);
+        } else {
+            tmp_mode_scope s(*this);
+            expr new_type = preprocess_class(type, u_replacements, e_replacements);
+            result        = instance_synthesizer(*this)(new_type);
+            if (result)
+                instantiate_replacements(*this, u_replacements, e_replacements);
+        }
+        if (result) {
+            result = copy_out_of_arena(*result);
+            for (expr_pair & p : e_replacements)
+                p.second = copy_out_of_arena(p.second);
+        }
     }
     if (result) {
         for (level_pair & p : u_replacements) {
@@ -3881,13 +4225,13 @@ optional<expr> type_context::mk_subsingleton_instance(expr const & type) {
             return it->second;);
     expr Type  = whnf(infer(type));
     if (!is_sort(Type)) {
-        m_cache->m_subsingleton_cache.insert(mk_pair(type, none_expr()));
+        m_cache->m_subsingleton_cache.insert(mk_pair(copy_for_cache(type), none_expr()));
         return none_expr();
     }
     level lvl    = sort_level(Type);
     expr subsingleton = mk_app(mk_constant(get_subsingleton_name(), {lvl}), type);
     auto r = mk_class_instance(subsingleton);
-    CACHE_CODE(m_cache->m_subsingleton_cache.insert(mk_pair(type, r)););
+    CACHE_CODE(m_cache->m_subsingleton_cache.insert(mk_pair(copy_for_cache(type), copy_for_cache(r))););
     return r;
 }
 
@@ -4054,10 +4398,23 @@ void initialize_type_context() {
     g_unfold_lemmas = new name{"type_context", "unfold_lemmas"};
     register_bool_option(*g_unfold_lemmas, LEAN_DEFAULT_UNFOLD_LEMMAS,
         "(type-context) whether to unfold lemmas (e.g., during elaboration)");
+    g_class_instance_index = new name{"class", "instance_index"};
+    register_bool_option(*g_class_instance_index, LEAN_DEFAULT_CLASS_INSTANCE_INDEX,
+                         "(class) use a discrimination tree for selecting the global instances that are tried "
+                         "in class-instance resolution");
+    g_class_instance_tabling = new name{"class", "instance_tabling"};
+    register_bool_option(*g_class_instance_tabling, LEAN_DEFAULT_CLASS_INSTANCE_TABLING,
+                         "(class) tabled class-instance resolution: reuse the answers and failures of subgoals, "
+                         "and cut loops, the search does not backtrack into subgoals without metavariables "
+                         "after their first answer is found");
+    g_instance_index_star = new expr(mk_metavar("_instance_index_star", mk_Prop()));
 }
 
 void finalize_type_context() {
     delete g_class_instance_max_depth;
     delete g_nat_offset_threshold;
+    delete g_class_instance_index;
+    delete g_class_instance_tabling;
+    delete g_instance_index_star;
 }
 }
@@ -10,6 +10,7 @@ Author: Leonardo de Moura
 #include <unordered_set>
 #include "util/flet.h"
 #include "util/lbool.h"
+#include "util/name_set.h"
 #include "kernel/environment.h"
 #include "kernel/abstract_type_context.h"
 #include "kernel/expr_maps.h"
@@ -22,6 +23,8 @@ Author: Leonardo de Moura
 #include "library/unification_hint.h"
 
 namespace lean {
+class discr_tree;
+
 class class_exception : public generic_exception {
 public:
     class_exception(expr const & m, char const * msg):generic_exception(m, msg) {}
@@ -125,6 +128,25 @@ class type_context_cache {
     instance_cache                m_instance_cache;
     subsingleton_cache            m_subsingleton_cache;
 
+    /* Index for the global instances of each class C. The discrimination tree stores instances
+       using the head symbols of the explicit arguments of the C-application they produce.
+       The instances of C that could not be indexed are not in m_indexed, and are always tried.
+       See instance_synthesizer::get_instance_candidates. */
+    struct instance_index {
+        std::shared_ptr<discr_tree> m_tree;
+        name_set                    m_indexed;
+    };
+    typedef std::unordered_map<name, instance_index, name_hash> instance_index_map;
+    instance_index_map            m_instance_index;
+    /* Unification hints used to build m_instance_index, and the heads occurring in them.
+       These heads are never used as keys, and the index is reset when the hints change. */
+    unification_hints             m_instance_index_uhints;
+    name_set                      m_instance_index_hinted;
+    /* Number of global instances of the classes visited by type class resolution (indexed),
+       and how many of them were selected by m_instance_index (candidates). */
+    unsigned                      m_num_indexed_instances{0};
+    unsigned                      m_num_candidate_instances{0};
+
     pos_info_provider const *     m_pip{nullptr};
     optional<pos_info>            m_ci_pos;
 
@@ -457,6 +479,9 @@ public:
 
     transparency_mode mode() const { return m_transparency_mode; }
     unsigned mode_idx() const { return static_cast<unsigned>(mode()); }
+    /* Return true iff the definition \c n can be unfolded using the current transparency mode. */
+    bool is_unfoldable(name const & n) { return static_cast<bool>(is_transparent(n)); }
+    bool is_aux_recursor(name const & n) { return m_cache->is_aux_recursor(n); }
 
     expr eta_expand(expr const & e);
 
@@ -7,6 +7,7 @@ Author: Leonardo de Moura
 
 #include <string>
 #include <algorithm>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -27,6 +28,7 @@ Author: Leonardo de Moura
 #include "library/util.h"
 #include "library/vm/vm.h"
 #include "library/vm/vm_name.h"
+#include "library/vm/vm_nat.h"
 #include "library/vm/vm_option.h"
 #include "library/vm/vm_expr.h"
 #include "library/normalize.h"
@@ -727,6 +729,54 @@ vm_instr mk_closure_instr(unsigned fn_idx, unsigned n) {
     return r;
 }
 
+static optional<superop> get_superop(vm_instr const & i1, vm_instr const & i2) {
+    switch (i1.op()) {
+    case opcode::Push:
+        switch (i2.op()) {
+        case opcode::Push:         return optional<superop>(superop::PushPush);
+        case opcode::Proj:         return optional<superop>(superop::PushProj);
+        case opcode::InvokeGlobal: return optional<superop>(superop::PushInvokeGlobal);
+        default:                   return optional<superop>();
+        }
+    case opcode::Proj:
+        if (i2.op() == opcode::Cases2)
+            return optional<superop>(superop::ProjCases2);
+        return optional<superop>();
+    default:
+        return optional<superop>();
+    }
+}
+
+/* Function indices of the nat builtins that have specialized instructions, they are set by initialize_vm. */
+static std::vector<std::pair<unsigned, superop>> * g_nat_superops = nullptr;
+
+static optional<superop> get_nat_superop(vm_instr const & i) {
+    if (i.op() != opcode::InvokeCFun)
+        return optional<superop>();
+    for (auto const & p : *g_nat_superops) {
+        if (p.first == i.get_fn_idx())
+            return optional<superop>(p.second);
+    }
+    return optional<superop>();
+}
+
+void fuse_superinstructions(unsigned code_sz, vm_instr * code) {
+    for (unsigned i = 0; i < code_sz; i++) {
+        if (auto op = get_nat_superop(code[i]))
+            code[i].m_dispatch = static_cast<unsigned char>(*op);
+    }
+    /* The pairs must not overlap: the second instruction of a pair is executed as a plain instruction. */
+    unsigned i = 0;
+    while (i + 1 < code_sz) {
+        if (auto op = get_superop(code[i], code[i+1])) {
+            code[i].m_dispatch = static_cast<unsigned char>(*op);
+            i += 2;
+        } else {
+            i++;
+        }
+    }
+}
+
 void vm_instr::release_memory() {
     switch (m_op) {
     case opcode::CasesN:
@@ -800,12 +850,12 @@ void vm_instr::copy_args(vm_instr const & i) {
 }
 
 vm_instr::vm_instr(vm_instr const & i):
-    m_op(i.m_op) {
+    m_op(i.m_op), m_dispatch(static_cast<unsigned char>(i.m_op)) {
     copy_args(i);
 }
 
 vm_instr::vm_instr(vm_instr && i):
-    m_op(i.m_op) {
+    m_op(i.m_op), m_dispatch(static_cast<unsigned char>(i.m_op)) {
     switch (m_op) {
     case opcode::Num:
         m_mpz    = i.m_mpz;
@@ -828,14 +878,16 @@ vm_instr::~vm_instr() {
 
 vm_instr & vm_instr::operator=(vm_instr const & s) {
     release_memory();
-    m_op = s.m_op;
+    m_op       = s.m_op;
+    m_dispatch = static_cast<unsigned char>(s.m_op);
     copy_args(s);
     return *this;
 }
 
 vm_instr & vm_instr::operator=(vm_instr && s) {
     release_memory();
-    m_op = s.m_op;
+    m_op       = s.m_op;
+    m_dispatch = static_cast<unsigned char>(s.m_op);
     switch (m_op) {
     case opcode::Num:
         m_mpz    = s.m_mpz;
@@ -1003,6 +1055,7 @@ vm_decl_cell::vm_decl_cell(name const & n, unsigned idx, expr const & e, unsigne
     m_code = new vm_instr[code_sz];
     for (unsigned i = 0; i < code_sz; i++)
         m_code[i] = code[i];
+    fuse_superinstructions(code_sz, m_code);
 }
 
 vm_decl_cell::~vm_decl_cell() {
@@ -1361,6 +1414,23 @@ vm_state::vm_state(environment const & env, options const & opts):
     if (get_debugger(opts) && has_monitor(env)) {
         debugger_init();
     }
+    /* The sampling profiler reads the call stack from a different thread. */
+    m_profiling = is_sampling_profiler_active();
+}
+
+void vm_state::collect_profiler_frames(unsigned begin, unsigned end, buffer<unsigned> & frames) {
+    lean_assert(m_profiling);
+    unique_lock<mutex> lk(m_call_stack_mtx);
+    end = std::min(end, static_cast<unsigned>(m_call_stack.size()));
+    for (unsigned i = begin; i < end; i++) {
+        if (m_call_stack[i].m_curr_fn_idx != g_null_fn_idx)
+            frames.push_back(m_call_stack[i].m_curr_fn_idx);
+    }
+}
+
+unsigned vm_state::get_num_profiler_frames() {
+    unique_lock<mutex> lk(m_call_stack_mtx);
+    return m_call_stack.size();
 }
 
 vm_state::~vm_state() {
@@ -2792,27 +2862,99 @@ void vm_state::display_registers(std::ostream & out) const {
     out << "pc: " << m_pc << ", bp: " << m_bp << "\n";
 }
 
-void vm_state::run() {
+/* Instruction dispatch in vm_state::run_core.
+
+   When LEAN_VM_THREADED_DISPATCH is defined, every instruction handler jumps directly to the handler
+   of the next instruction using a computed goto (direct threading). Otherwise, the handlers
+   jump back to a switch statement. */
+#if defined(__GNUC__) && !defined(LEAN_VM_NO_THREADED_DISPATCH)
+#define LEAN_VM_THREADED_DISPATCH
+#endif
+
+#if defined(LEAN_DEBUG)
+/* We only trace VM in debug mode */
+#define VM_TRACE()                                              \
+    lean_trace(name({"vm", "run"}),                             \
+               tout() << m_pc << ": ";                          \
+               instr->display(tout().get_stream());             \
+               tout() << "\n";                                  \
+               display_stack(tout().get_stream());              \
+               tout() << "\n";)
+#else
+#define VM_TRACE()
+#endif
+
+#define VM_FETCH() {                                            \
+        if (Debugging) debugger_step();                         \
+        instr = m_code + m_pc;                                  \
+        VM_TRACE();                                             \
+    }
+
+/* The debugger must see every instruction, so superinstructions are only used when Debugging is false. */
+#define VM_DISPATCH_IDX() (Debugging ? static_cast<unsigned>(instr->op()) : instr->get_dispatch_idx())
+
+#if defined(LEAN_VM_THREADED_DISPATCH)
+#define VM_NEXT() { VM_FETCH(); goto *dispatch_table[VM_DISPATCH_IDX()]; }
+#define VM_CASE(op) lbl_op_##op
+#define VM_SUPER_CASE(op) lbl_super_##op
+#define VM_CONTINUE_WITH(op) { instr = m_code + m_pc; goto lbl_op_##op; }
+#else
+#define VM_NEXT() goto main_loop
+#define VM_CASE(op) case static_cast<unsigned>(opcode::op)
+#define VM_SUPER_CASE(op) case static_cast<unsigned>(superop::op)
+#define VM_CONTINUE_WITH(op) {                                  \
+        instr = m_code + m_pc;                                  \
+        dispatch_idx = static_cast<unsigned>(opcode::op);       \
+        goto dispatch;                                          \
+    }
+#endif
+
+/* cfun fn, where fn is a binary nat builtin.
+   The profiler records a frame for every cfun, so we use the generic InvokeCFun code when it is enabled. */
+#define VM_NAT_BINOP(fn) {                                              \
+        if (LEAN_UNLIKELY(m_profiling)) VM_CONTINUE_WITH(InvokeCFun);   \
+        check_interrupted();                                            \
+        check_heartbeat();                                              \
+        check_memory("vm");                                             \
+        unsigned sz = m_stack.size();                                   \
+        m_stack[sz - 2] = fn(m_stack[sz - 1], m_stack[sz - 2]);         \
+        m_stack.pop_back();                                             \
+        m_pc++;                                                         \
+        VM_NEXT();                                                      \
+    }
+
+template <bool Debugging>
+void vm_state::run_core() {
     lean_assert(m_code);
     unsigned init_call_stack_sz = m_call_stack.size();
+    vm_instr const * instr;
     m_pc = 0;
+#if defined(LEAN_VM_THREADED_DISPATCH)
+    /* The entries must be in the same order as the opcode and superop enumerations. */
+    static void * const dispatch_table[] = {
+        &&lbl_op_Push, &&lbl_op_Move, &&lbl_op_Ret, &&lbl_op_Drop, &&lbl_op_Goto,
+        &&lbl_op_SConstructor, &&lbl_op_Constructor, &&lbl_op_Num,
+        &&lbl_op_Destruct, &&lbl_op_Cases2, &&lbl_op_CasesN, &&lbl_op_NatCases, &&lbl_op_BuiltinCases, &&lbl_op_Proj,
+        &&lbl_op_Apply, &&lbl_op_InvokeGlobal, &&lbl_op_InvokeBuiltin, &&lbl_op_InvokeCFun,
+        &&lbl_op_Closure, &&lbl_op_Unreachable, &&lbl_op_Expr, &&lbl_op_LocalInfo,
+        &&lbl_super_PushPush, &&lbl_super_PushProj, &&lbl_super_PushInvokeGlobal, &&lbl_super_ProjCases2,
+        &&lbl_super_NatAdd, &&lbl_super_NatSub, &&lbl_super_NatMul, &&lbl_super_NatDiv, &&lbl_super_NatMod,
+        &&lbl_super_NatDecEq, &&lbl_super_NatDecLe, &&lbl_super_NatDecLt
+    };
+    static_assert(sizeof(dispatch_table) / sizeof(dispatch_table[0]) == LEAN_VM_NUM_DISPATCH_IDXS,
+                  "VM dispatch table is out of sync with the opcodes");
+    VM_NEXT();
+    {
+#else
+    unsigned dispatch_idx;
     while (true) {
       main_loop:
-        if (LEAN_UNLIKELY(m_debugging)) {
-            debugger_step();
-        }
-        vm_instr const & instr = m_code[m_pc];
-        DEBUG_CODE({
-                /* We only trace VM in debug mode */
-                lean_trace(name({"vm", "run"}),
-                           tout() << m_pc << ": ";
-                           instr.display(tout().get_stream());
-                           tout() << "\n";
-                           display_stack(tout().get_stream());
-                           tout() << "\n";)
-                    });
-        switch (instr.op()) {
-        case opcode::Push:
+        VM_FETCH();
+        dispatch_idx = VM_DISPATCH_IDX();
+      dispatch:
+        switch (dispatch_idx) {
+#endif
+        VM_CASE(Push):
             /* Instruction: push i
 
                stack before,      after
@@ -2824,10 +2966,10 @@ void vm_state::run() {
                v                  v
                                   a_i
             */
-            m_stack.push_back(m_stack[m_bp + instr.get_idx()]);
+            m_stack.push_back(m_stack[m_bp + instr->get_idx()]);
             m_pc++;
-            goto main_loop;
-        case opcode::Move: {
+            VM_NEXT();
+        VM_CASE(Move): {
             /* Instruction: move i
 
                stack before,      after
@@ -2839,18 +2981,18 @@ void vm_state::run() {
                v                  v
                                   a_i
             */
-            unsigned off = m_bp + instr.get_idx();
+            unsigned off = m_bp + instr->get_idx();
             lean_vm_check(off < m_stack.size());
-            if (LEAN_UNLIKELY(m_debugging)) {
+            if (LEAN_UNLIKELY(Debugging)) {
                 m_stack.push_back(m_stack[off]);
             } else {
                 m_stack.push_back(mk_vm_unit());
                 swap(m_stack.back(), m_stack[off]);
             }
             m_pc++;
-            goto main_loop;
+            VM_NEXT();
         }
-        case opcode::Drop: {
+        VM_CASE(Drop): {
             /* Instruction: drop n
 
                stack before,      after
@@ -2861,23 +3003,23 @@ void vm_state::run() {
                a_n
                v
             */
-            unsigned num = instr.get_num();
+            unsigned num = instr->get_num();
             unsigned sz  = m_stack.size();
             lean_vm_check(sz > num);
             swap(m_stack[sz - num - 1], m_stack[sz - 1]);
             m_stack.resize(sz - num);
-            if (m_debugging) shrink_stack_info();
+            if (Debugging) shrink_stack_info();
             m_pc++;
-            goto main_loop;
+            VM_NEXT();
         }
-        case opcode::Goto:
+        VM_CASE(Goto):
             /* Instruction: goto pc
 
                m_pc := pc
             */
-            m_pc = instr.get_goto_pc();
-            goto main_loop;
-        case opcode::SConstructor:
+            m_pc = instr->get_goto_pc();
+            VM_NEXT();
+        VM_CASE(SConstructor):
             /** Instruction: scnstr i
 
                 stack before,      after
@@ -2885,10 +3027,10 @@ void vm_state::run() {
                 v    ==>           v
                 #i
             */
-            m_stack.push_back(mk_vm_simple(instr.get_cidx()));
+            m_stack.push_back(mk_vm_simple(instr->get_cidx()));
             m_pc++;
-            goto main_loop;
-        case opcode::Constructor: {
+            VM_NEXT();
+        VM_CASE(Constructor): {
             /** Instruction: cnstr i n
 
                 stack before,      after
@@ -2898,17 +3040,17 @@ void vm_state::run() {
                 ...
                 a_n
             */
-            unsigned nfields = instr.get_nfields();
+            unsigned nfields = instr->get_nfields();
             unsigned sz      = m_stack.size();
             lean_vm_check(nfields <= sz);
-            vm_obj new_value = mk_vm_constructor(instr.get_cidx(), nfields, m_stack.data() + sz - nfields);
+            vm_obj new_value = mk_vm_constructor(instr->get_cidx(), nfields, m_stack.data() + sz - nfields);
             m_stack.resize(sz - nfields + 1);
             swap(m_stack.back(), new_value);
-            if (m_debugging) shrink_stack_info();
+            if (Debugging) shrink_stack_info();
             m_pc++;
-            goto main_loop;
+            VM_NEXT();
         }
-        case opcode::Closure: {
+        VM_CASE(Closure): {
             /** Instruction: closure fn n
 
                 stack before,      after
@@ -2918,17 +3060,17 @@ void vm_state::run() {
                 ...
                 a_1
             */
-            unsigned nargs     = instr.get_nargs();
+            unsigned nargs     = instr->get_nargs();
             unsigned sz        = m_stack.size();
             lean_vm_check(nargs <= sz);
-            vm_obj new_value   = mk_vm_closure(instr.get_fn_idx(), nargs, m_stack.data() + sz - nargs);
+            vm_obj new_value   = mk_vm_closure(instr->get_fn_idx(), nargs, m_stack.data() + sz - nargs);
             m_stack.resize(sz - nargs + 1);
             swap(m_stack.back(), new_value);
-            if (m_debugging) shrink_stack_info();
+            if (Debugging) shrink_stack_info();
             m_pc++;
-            goto main_loop;
+            VM_NEXT();
         }
-        case opcode::Num:
+        VM_CASE(Num):
             /** Instruction: num n
 
                 stack before,      after
@@ -2936,10 +3078,10 @@ void vm_state::run() {
                 v    ==>           v
                                    n
             */
-            m_stack.push_back(mk_vm_mpz(instr.get_mpz()));
+            m_stack.push_back(mk_vm_mpz(instr->get_mpz()));
             m_pc++;
-            goto main_loop;
-        case opcode::Expr:
+            VM_NEXT();
+        VM_CASE(Expr):
             /** Instruction: pexpr e
 
                 stack before,      after
@@ -2947,15 +3089,15 @@ void vm_state::run() {
                 v    ==>           v
                                    e
             */
-            m_stack.push_back(to_obj(instr.get_expr()));
+            m_stack.push_back(to_obj(instr->get_expr()));
             m_pc++;
-            goto main_loop;
-        case opcode::LocalInfo:
-            if (m_debugging)
-                push_local_info(instr.get_local_idx(), instr.get_local_info());
+            VM_NEXT();
+        VM_CASE(LocalInfo):
+            if (Debugging)
+                push_local_info(instr->get_local_idx(), instr->get_local_info());
             m_pc++;
-            goto main_loop;
-        case opcode::Destruct: {
+            VM_NEXT();
+        VM_CASE(Destruct): {
             /** Instruction: destruct
 
                 stack before,              after
@@ -2969,9 +3111,9 @@ void vm_state::run() {
             stack_pop_back();
             push_fields(top);
             m_pc++;
-            goto main_loop;
+            VM_NEXT();
         }
-        case opcode::Cases2: {
+        VM_CASE(Cases2): {
             /** Instruction: cases2 pc1 pc2
 
                 stack before,              after
@@ -2987,10 +3129,10 @@ void vm_state::run() {
             vm_obj top = m_stack.back();
             stack_pop_back();
             push_fields(top);
-            m_pc = instr.get_cases2_pc(cidx(top));
-            goto main_loop;
+            m_pc = instr->get_cases2_pc(cidx(top));
+            VM_NEXT();
         }
-        case opcode::NatCases: {
+        VM_CASE(NatCases): {
             /** Instruction: natcases pc1 pc2
 
                 stack before,              after (if n = 0)    after (if n > 0)
@@ -3007,12 +3149,12 @@ void vm_state::run() {
                 if (val == 0) {
                     stack_pop_back();
                     m_pc++;
-                    goto main_loop;
+                    VM_NEXT();
                 } else {
                     vm_obj new_value = mk_vm_simple(val - 1);
                     swap(top, new_value);
-                    m_pc = instr.get_cases2_pc(1);
-                    goto main_loop;
+                    m_pc = instr->get_cases2_pc(1);
+                    VM_NEXT();
                 }
             } else {
                 /* to_mpz checks lean_vm_check(is_mpz(top)) */
@@ -3020,16 +3162,16 @@ void vm_state::run() {
                 if (val == 0) {
                     stack_pop_back();
                     m_pc++;
-                    goto main_loop;
+                    VM_NEXT();
                 } else {
                     vm_obj new_value = mk_vm_mpz(val - 1);
                     swap(top, new_value);
-                    m_pc = instr.get_cases2_pc(1);
-                    goto main_loop;
+                    m_pc = instr->get_cases2_pc(1);
+                    VM_NEXT();
                 }
             }
         }
-        case opcode::CasesN: {
+        VM_CASE(CasesN): {
             /** Instruction: casesn pc_0 ... pc_[n-1]
 
                 stack before,              after
@@ -3044,23 +3186,23 @@ void vm_state::run() {
             vm_obj top = m_stack.back();
             stack_pop_back();
             push_fields(top);
-            m_pc = instr.get_casesn_pc(cidx(top));
-            goto main_loop;
+            m_pc = instr->get_casesn_pc(cidx(top));
+            VM_NEXT();
         }
-        case opcode::BuiltinCases: {
+        VM_CASE(BuiltinCases): {
             /** Instruction: builtin_cases
                 It is similar to CasesN, but uses the vm_cases_function to extract the data.
             */
             vm_obj top = m_stack.back();
             stack_pop_back();
-            vm_cases_function fn = get_builtin_cases(instr.get_cases_idx());
+            vm_cases_function fn = get_builtin_cases(instr->get_cases_idx());
             buffer<vm_obj> data;
             unsigned cidx = fn(top, data);
             std::copy(data.begin(), data.end(), std::back_inserter(m_stack));
-            m_pc = instr.get_casesn_pc(cidx);
-            goto main_loop;
+            m_pc = instr->get_casesn_pc(cidx);
+            VM_NEXT();
         }
-        case opcode::Proj: {
+        VM_CASE(Proj): {
             /** Instruction: proj i
 
                stack before,              after
@@ -3070,13 +3212,13 @@ void vm_state::run() {
 
             */
             vm_obj & top = m_stack.back();
-            top = cfield(top, instr.get_idx());
+            top = cfield(top, instr->get_idx());
             m_pc++;
-            goto main_loop;
+            VM_NEXT();
         }
-        case opcode::Unreachable:
+        VM_CASE(Unreachable):
             throw exception("VM unreachable instruction has been reached");
-        case opcode::Ret:
+        VM_CASE(Ret):
             /**
                Instruction: ret
 
@@ -3102,8 +3244,8 @@ void vm_state::run() {
             if (pop_frame() == init_call_stack_sz)
                 return;
             else
-                goto main_loop;
-        case opcode::Apply: {
+                VM_NEXT();
+        VM_CASE(Apply): {
             /**
                Instruction: apply
 
@@ -3141,7 +3283,7 @@ void vm_state::run() {
                 stack_pop_back();
                 m_stack.push_back(closure);
                 m_pc++;
-                goto main_loop;
+                VM_NEXT();
             } else if (is_native_closure(closure)) {
                 vm_native_closure const * c = to_native_closure(closure);
                 unsigned arity              = c->get_arity();
@@ -3160,15 +3302,15 @@ void vm_state::run() {
                     vm_obj new_value = update_native_closure(closure, nargs, m_stack.data() + sz - nargs);
                     m_stack.resize(sz - nargs + 1);
                     swap(m_stack.back(), new_value);
-                    if (m_debugging) shrink_stack_info();
+                    if (Debugging) shrink_stack_info();
                     m_pc++;
-                    goto main_loop;
+                    VM_NEXT();
                 } else {
                     lean_assert(nargs == arity);
                     buffer<vm_obj> args;
                     /* Case 2 */
                     invoke_fn(c->get_fn(), arity);
-                    goto main_loop;
+                    VM_NEXT();
                 }
             } else {
                 unsigned fn_idx   = cfn_idx(closure);
@@ -3191,18 +3333,18 @@ void vm_state::run() {
                     vm_obj new_value = mk_vm_closure(fn_idx, nargs, m_stack.data() + sz - nargs);
                     m_stack.resize(sz - nargs + 1);
                     swap(m_stack.back(), new_value);
-                    if (m_debugging) shrink_stack_info();
+                    if (Debugging) shrink_stack_info();
                     m_pc++;
-                    goto main_loop;
+                    VM_NEXT();
                 } else {
                     lean_assert(nargs == arity);
                     /* Case 2 */
                     invoke(d);
-                    goto main_loop;
+                    VM_NEXT();
                 }
             }
         }
-        case opcode::InvokeGlobal: {
+        VM_CASE(InvokeGlobal): {
             check_interrupted();
             check_heartbeat();
             check_memory("vm");
@@ -3225,19 +3367,19 @@ void vm_state::run() {
 
                where n is fn.arity
             */
-            vm_decl decl = get_decl(instr.get_fn_idx());
+            vm_decl decl = get_decl(instr->get_fn_idx());
             /* If d is 0-ary, then check if value is cached */
             if (decl.get_arity() == 0 && decl.get_idx() < m_cache_vector.size()) {
                 if (auto r = m_cache_vector[decl.get_idx()]) {
                     m_stack.push_back(*r);
                     m_pc++;
-                    goto main_loop;
+                    VM_NEXT();
                 }
             }
             invoke_global(decl);
-            goto main_loop;
+            VM_NEXT();
         }
-        case opcode::InvokeBuiltin: {
+        VM_CASE(InvokeBuiltin): {
             check_interrupted();
             check_heartbeat();
             check_memory("vm");
@@ -3255,11 +3397,11 @@ void vm_state::run() {
 
                Remark: note that the arguments are in reverse order.
             */
-            vm_decl decl = get_decl(instr.get_fn_idx());
+            vm_decl decl = get_decl(instr->get_fn_idx());
             invoke_builtin(decl);
-            goto main_loop;
+            VM_NEXT();
         }
-        case opcode::InvokeCFun: {
+        VM_CASE(InvokeCFun): {
             check_interrupted();
             check_heartbeat();
             check_memory("vm");
@@ -3268,10 +3410,59 @@ void vm_state::run() {
 
                Similar to InvokeBuiltin
             */
-            vm_decl decl = get_decl(instr.get_fn_idx());
+            vm_decl decl = get_decl(instr->get_fn_idx());
             invoke_cfun(decl);
-            goto main_loop;
-        }}
+            VM_NEXT();
+        }
+        VM_SUPER_CASE(PushPush):
+            /* push i; push j */
+            m_stack.push_back(m_stack[m_bp + instr->get_idx()]);
+            m_pc++;
+            VM_CONTINUE_WITH(Push);
+        VM_SUPER_CASE(PushProj):
+            /* push i; proj j */
+            m_stack.push_back(m_stack[m_bp + instr->get_idx()]);
+            m_pc++;
+            VM_CONTINUE_WITH(Proj);
+        VM_SUPER_CASE(PushInvokeGlobal):
+            /* push i; ginvoke fn */
+            m_stack.push_back(m_stack[m_bp + instr->get_idx()]);
+            m_pc++;
+            VM_CONTINUE_WITH(InvokeGlobal);
+        VM_SUPER_CASE(ProjCases2): {
+            /* proj i; cases2 pc1 pc2 */
+            vm_obj & top = m_stack.back();
+            top = cfield(top, instr->get_idx());
+            m_pc++;
+            VM_CONTINUE_WITH(Cases2);
+        }
+        VM_SUPER_CASE(NatAdd):   VM_NAT_BINOP(nat_add);
+        VM_SUPER_CASE(NatSub):   VM_NAT_BINOP(nat_sub);
+        VM_SUPER_CASE(NatMul):   VM_NAT_BINOP(nat_mul);
+        VM_SUPER_CASE(NatDiv):   VM_NAT_BINOP(nat_div);
+        VM_SUPER_CASE(NatMod):   VM_NAT_BINOP(nat_mod);
+        VM_SUPER_CASE(NatDecEq): VM_NAT_BINOP(nat_decidable_eq);
+        VM_SUPER_CASE(NatDecLe): VM_NAT_BINOP(nat_decidable_le);
+        VM_SUPER_CASE(NatDecLt): VM_NAT_BINOP(nat_decidable_lt);
+#if !defined(LEAN_VM_THREADED_DISPATCH)
+        default:
+            lean_unreachable();
+        }
+#endif
+    }
+}
+
+void vm_state::run() {
+    if (LEAN_UNLIKELY(m_profiling && is_sampling_profiler_active())) {
+        scoped_profiler_phase scope("vm", *this);
+        if (m_debugging)
+            run_core<true>();
+        else
+            run_core<false>();
+    } else if (m_debugging) {
+        run_core<true>();
+    } else {
+        run_core<false>();
     }
 }
 
@@ -3402,7 +3593,7 @@ void vm_state::profiler::stop() {
     if (!m_stop && m_thread_ptr) {
         m_stop = true;
         m_thread_ptr->join();
-        m_state.m_profiling = false;
+        m_state.m_profiling = is_sampling_profiler_active();
     }
 }
 
@@ -3679,6 +3870,15 @@ void finalize_vm_core() {
 
 void initialize_vm() {
     g_ext = new vm_decls_reg();
+    g_nat_superops = new std::vector<std::pair<unsigned, superop>>({
+            {get_vm_index(name({"nat", "add"})),          superop::NatAdd},
+            {get_vm_index(name({"nat", "sub"})),          superop::NatSub},
+            {get_vm_index(name({"nat", "mul"})),          superop::NatMul},
+            {get_vm_index(name({"nat", "div"})),          superop::NatDiv},
+            {get_vm_index(name({"nat", "mod"})),          superop::NatMod},
+            {get_vm_index(name({"nat", "decidable_eq"})), superop::NatDecEq},
+            {get_vm_index(name({"nat", "decidable_le"})), superop::NatDecLe},
+            {get_vm_index(name({"nat", "decidable_lt"})), superop::NatDecLt}});
     // g_may_update_vm_builtins = false;
     vm_reserve_modification::init();
     vm_code_modification::init();
@@ -3696,6 +3896,7 @@ void initialize_vm() {
 
 void finalize_vm() {
     delete g_ext;
+    delete g_nat_superops;
     vm_reserve_modification::finalize();
     vm_code_modification::finalize();
     vm_monitor_modification::finalize();
@@ -15,6 +15,7 @@ Author: Leonardo de Moura
 #include "util/interrupt.h"
 #include "util/small_object_allocator.h"
 #include "util/serializer.h"
+#include "util/sampling_profiler.h"
 #include "util/numerics/mpz.h"
 #include "kernel/environment.h"
 #include "kernel/pos_info_provider.h"
@@ -320,9 +321,25 @@ enum class opcode {
     Closure, Unreachable, Expr, LocalInfo
 };
 
+/** \brief Superinstructions are frequent instruction pairs that are executed by vm_state::run using a single dispatch.
+    The first instruction of the pair is tagged with the superinstruction, and the second one is left unchanged.
+    So, jumps to the second instruction are still valid. The tags are set by fuse_superinstructions,
+    and they are neither copied nor serialized.
+
+    The Nat* tags are not pairs: they specialize a single InvokeCFun instruction for a nat arithmetic builtin.
+    They invoke the builtin directly on the VM stack, without the generic calling convention of vm_state::invoke_fn. */
+enum class superop : unsigned char {
+    PushPush = static_cast<unsigned char>(opcode::LocalInfo) + 1, PushProj, PushInvokeGlobal, ProjCases2,
+    NatAdd, NatSub, NatMul, NatDiv, NatMod, NatDecEq, NatDecLe, NatDecLt
+};
+
+#define LEAN_VM_NUM_DISPATCH_IDXS (static_cast<unsigned>(superop::NatDecLt) + 1)
+
 /** \brief VM instructions */
 class vm_instr {
-    opcode m_op;
+    opcode        m_op;
+    /* Index used by vm_state::run for dispatching this instruction, it is either m_op or a superop. */
+    unsigned char m_dispatch;
     union {
         struct {
             unsigned m_fn_idx;  /* InvokeGlobal, InvokeBuiltin, InvokeCFun and Closure. */
@@ -379,12 +396,13 @@ class vm_instr {
     friend vm_instr mk_closure_instr(unsigned fn_idx, unsigned n);
     friend vm_instr mk_expr_instr(expr const &e);
     friend vm_instr mk_local_info_instr(unsigned idx, name const & n, optional<expr> const & e);
+    friend void fuse_superinstructions(unsigned code_sz, vm_instr * code);
 
     void release_memory();
     void copy_args(vm_instr const & i);
 public:
-    vm_instr():m_op(opcode::Ret) {}
-    vm_instr(opcode op):m_op(op) {}
+    vm_instr():m_op(opcode::Ret), m_dispatch(static_cast<unsigned char>(opcode::Ret)) {}
+    vm_instr(opcode op):m_op(op), m_dispatch(static_cast<unsigned char>(op)) {}
     vm_instr(vm_instr const & i);
     vm_instr(vm_instr && i);
     ~vm_instr();
@@ -393,6 +411,7 @@ public:
     vm_instr & operator=(vm_instr && s);
 
     opcode op() const { return m_op; }
+    unsigned get_dispatch_idx() const { return m_dispatch; }
 
     unsigned get_fn_idx() const {
         lean_assert(m_op == opcode::InvokeGlobal || m_op == opcode::InvokeBuiltin ||
@@ -521,6 +540,9 @@ vm_instr mk_closure_instr(unsigned fn_idx, unsigned n);
 vm_instr mk_expr_instr(expr const &e);
 vm_instr mk_local_info_instr(unsigned idx, name const & n, optional<expr> const & e);
 
+/** \brief Tag the instruction pairs in \c code that can be executed as superinstructions. */
+void fuse_superinstructions(unsigned code_sz, vm_instr * code);
+
 class vm_state;
 class vm_instr;
 
@@ -597,7 +619,7 @@ public:
 };
 
 /** \brief Virtual machine for executing VM bytecode. */
-class vm_state {
+class vm_state : private profiler_frame_source {
     typedef std::vector<vm_decl> decl_vector;
     typedef std::vector<optional<vm_obj>> cache_vector;
     typedef unsigned_map<vm_decl> decl_map;
@@ -640,6 +662,10 @@ class vm_state {
     debugger_state_ptr          m_debugger_state_ptr;
     bool                        m_was_updated{false}; /* set to true if update_env is invoked */
 
+    /* profiler_frame_source API, the frames are the function indices of the call stack. */
+    void collect_profiler_frames(unsigned begin, unsigned end, buffer<unsigned> & frames) override;
+    unsigned get_num_profiler_frames() override;
+
     void debugger_init();
     void debugger_step();
     void push_local_info(unsigned idx, vm_local_info const & info);
@@ -655,6 +681,7 @@ class vm_state {
     void invoke_cfun(vm_decl const & d);
     void invoke_global(vm_decl const & d);
     void invoke(vm_decl const & d);
+    template <bool Debugging> void run_core();
     void run();
     void execute(vm_instr const * code);
     vm_obj invoke_closure(vm_obj const & fn, unsigned nargs);
@@ -884,6 +911,10 @@ environment add_native(environment const & env, name const & n, unsigned arity,
 unsigned get_vm_index(name const & n);
 unsigned get_vm_index_bound();
 name get_vm_name(unsigned idx);
+#if defined(LEAN_MULTI_THREAD)
+/** \brief Return the sampling interval in milliseconds (option profiler.freq) */
+unsigned get_profiler_freq(options const & opts);
+#endif
 optional<name> find_vm_name(unsigned idx);
 
 /** \brief Reserve an index for the given function in the VM, the expression
@@ -5,6 +5,7 @@ Released under Apache 2.0 license as described in the file LICENSE.
 Author: Leonardo de Moura
 */
 #include <iostream>
+#include <limits>
 #include "library/vm/vm.h"
 #include "library/vm/vm_nat.h"
 
@@ -96,51 +97,117 @@ static mpz const & to_mpz2(vm_obj const & o) {
     }
 }
 
+/* As in vm_nat.cpp, the builtins below have a fast path for arguments that fit in a long int.
+   The result is computed using overflow checked arithmetic, and mpz is only used on overflow. */
+
+static inline bool to_long(vm_obj const & o, long & r) {
+    if (LEAN_LIKELY(is_simple(o))) {
+        r = to_small_int(o);
+        return true;
+    } else {
+        mpz const & v = to_mpz(o);
+        if (!v.is_long_int())
+            return false;
+        r = v.get_long_int();
+        return true;
+    }
+}
+
+static inline bool to_long(vm_obj const & o1, vm_obj const & o2, long & r1, long & r2) {
+    return to_long(o1, r1) && to_long(o2, r2);
+}
+
+static vm_obj mk_vm_long_int(long n) {
+    return is_small_int(static_cast<long long>(n)) ? mk_vm_simple(to_unsigned(static_cast<int>(n))) : mk_vm_mpz(mpz(n));
+}
+
+/* Return true iff a + b overflows, and store the sum in r otherwise. */
+static inline bool add_overflow(long a, long b, long & r) {
+    if ((b > 0 && a > std::numeric_limits<long>::max() - b) ||
+        (b < 0 && a < std::numeric_limits<long>::min() - b))
+        return true;
+    r = a + b;
+    return false;
+}
+
+/* Return true iff a * b overflows, and store the product in r otherwise. */
+static inline bool mul_overflow(long a, long b, long & r) {
+    long max = std::numeric_limits<long>::max();
+    long min = std::numeric_limits<long>::min();
+    if (a > 0) {
+        if (b > 0 ? a > max / b : b < min / a) return true;
+    } else if (a < 0) {
+        if (b > 0 ? a < min / b : b < max / a) return true;
+    }
+    r = a * b;
+    return false;
+}
+
 vm_obj int_add(vm_obj const & a1, vm_obj const & a2) {
-    if (is_simple(a1) && is_simple(a2)) {
+    long v1, v2, r;
+    if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         return mk_vm_int(to_small_int(a1) + to_small_int(a2));
+    } else if (to_long(a1, a2, v1, v2) && !add_overflow(v1, v2, r)) {
+        return mk_vm_long_int(r);
     } else {
-        return mk_vm_mpz(to_mpz1(a1) + to_mpz2(a2));
+        return mk_vm_int(to_mpz1(a1) + to_mpz2(a2));
     }
 }
 
 vm_obj int_mul(vm_obj const & a1, vm_obj const & a2) {
-    if (is_simple(a1) && is_simple(a2)) {
-        long long r = static_cast<long long>(to_small_int(a1)) * static_cast<long long>(to_small_int(a2));
-        if (is_small_int(r)) {
-            return mk_vm_simple(to_unsigned(r));
+    long v1, v2, r;
+    if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
+        long long p = static_cast<long long>(to_small_int(a1)) * static_cast<long long>(to_small_int(a2));
+        if (is_small_int(p)) {
+            return mk_vm_simple(to_unsigned(p));
         }
     }
-    return mk_vm_mpz(to_mpz1(a1) * to_mpz2(a2));
+    if (to_long(a1, a2, v1, v2) && !mul_overflow(v1, v2, r)) {
+        return mk_vm_long_int(r);
+    } else {
+        return mk_vm_int(to_mpz1(a1) * to_mpz2(a2));
+    }
 }
 
 vm_obj int_decidable_eq(vm_obj const & a1, vm_obj const & a2) {
-    if (is_simple(a1) && is_simple(a2)) {
+    long v1, v2;
+    if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         return mk_vm_bool(to_small_int(a1) == to_small_int(a2));
+    } else if (to_long(a1, a2, v1, v2)) {
+        return mk_vm_bool(v1 == v2);
     } else {
         return mk_vm_bool(to_mpz1(a1) == to_mpz2(a2));
     }
 }
 
 vm_obj int_decidable_le(vm_obj const & a1, vm_obj const & a2) {
-    if (is_simple(a1) && is_simple(a2)) {
+    long v1, v2;
+    if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         return mk_vm_bool(to_small_int(a1) <= to_small_int(a2));
+    } else if (to_long(a1, a2, v1, v2)) {
+        return mk_vm_bool(v1 <= v2);
     } else {
         return mk_vm_bool(to_mpz1(a1) <= to_mpz2(a2));
     }
 }
 
 vm_obj int_decidable_lt(vm_obj const & a1, vm_obj const & a2) {
-    if (is_simple(a1) && is_simple(a2)) {
+    long v1, v2;
+    if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         return mk_vm_bool(to_small_int(a1) < to_small_int(a2));
+    } else if (to_long(a1, a2, v1, v2)) {
+        return mk_vm_bool(v1 < v2);
     } else {
         return mk_vm_bool(to_mpz1(a1) < to_mpz2(a2));
     }
 }
 
 vm_obj int_neg(vm_obj const & a) {
-    if (is_simple(a)) {
+    long v;
+    if (LEAN_LIKELY(is_simple(a))) {
         return mk_vm_int(-to_small_int(a));
+    } else if (to_long(a, v) && v != std::numeric_limits<long>::min()) {
+        return mk_vm_long_int(-v);
     } else {
         return mk_vm_int(0 - to_mpz1(a));
     }
@@ -5,7 +5,9 @@ Released under Apache 2.0 license as described in the file LICENSE.
 Author: Leonardo de Moura
 */
 #include <iostream>
+#include "util/int64.h"
 #include "library/vm/vm.h"
+#include "library/vm/vm_nat.h"
 #include "library/vm/vm_string.h"
 
 namespace lean {
@@ -75,33 +77,76 @@ static mpz const & to_mpz2(vm_obj const & o) {
     }
 }
 
+/* The builtins below have three paths: both arguments are small nats; both arguments fit in 64 bits,
+   and the result is computed using overflow checked 64-bit arithmetic; and the general case using mpz.
+   The second path avoids GMP temporaries for numerals in [LEAN_MAX_SMALL_NAT, 2^64). */
+
+static inline bool to_uint64(vm_obj const & o, uint64 & r) {
+    if (LEAN_LIKELY(is_simple(o))) {
+        r = cidx(o);
+        return true;
+    } else {
+        mpz const & v = to_mpz(o);
+        if (!v.is_unsigned_long_int())
+            return false;
+        r = v.get_unsigned_long_int();
+        return true;
+    }
+}
+
+static inline bool to_uint64(vm_obj const & o1, vm_obj const & o2, uint64 & r1, uint64 & r2) {
+    return to_uint64(o1, r1) && to_uint64(o2, r2);
+}
+
+static vm_obj mk_vm_nat_u64(uint64 n) {
+    if (LEAN_LIKELY(n < LEAN_MAX_SMALL_NAT))
+        return mk_vm_simple(static_cast<unsigned>(n));
+    else
+        return mk_vm_mpz(mpz(n));
+}
+
+/* Return true iff a * b overflows, and store the product in r otherwise. */
+static inline bool mul_overflow(uint64 a, uint64 b, uint64 & r) {
+    r = a * b;
+    return a != 0 && r / a != b;
+}
+
 vm_obj nat_succ(vm_obj const & a) {
+    uint64 v;
     if (LEAN_LIKELY(is_simple(a))) {
         return mk_vm_nat(cidx(a) + 1);
+    } else if (to_uint64(a, v) && v + 1 != 0) {
+        return mk_vm_nat_u64(v + 1);
     } else {
         return mk_vm_mpz(to_mpz1(a) + 1);
     }
 }
 
 vm_obj nat_add(vm_obj const & a1, vm_obj const & a2) {
+    uint64 v1, v2;
     if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         return mk_vm_nat(cidx(a1) + cidx(a2));
+    } else if (to_uint64(a1, a2, v1, v2) && v1 + v2 >= v1) {
+        return mk_vm_nat_u64(v1 + v2);
     } else {
         return mk_vm_mpz(to_mpz1(a1) + to_mpz2(a2));
     }
 }
 
 vm_obj nat_mul(vm_obj const & a1, vm_obj const & a2) {
+    uint64 v1, v2, r;
     if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
-        unsigned long long r = static_cast<unsigned long long>(cidx(a1)) * static_cast<unsigned long long>(cidx(a2));
-        if (LEAN_LIKELY(r < LEAN_MAX_SMALL_NAT)) {
-            return mk_vm_simple(r);
-        }
+        /* small nats are smaller than 2^31, so the product fits in 64 bits */
+        return mk_vm_nat_u64(static_cast<uint64>(cidx(a1)) * static_cast<uint64>(cidx(a2)));
+    } else if (to_uint64(a1, a2, v1, v2) && !mul_overflow(v1, v2, r)) {
+        return mk_vm_nat_u64(r);
+    } else {
+        return mk_vm_nat(to_mpz1(a1) * to_mpz2(a2));
     }
-    return mk_vm_mpz(to_mpz1(a1) * to_mpz2(a2));
 }
 
 vm_obj nat_sub(vm_obj const & a1, vm_obj const & a2) {
+    uint64 v1, v2;
     if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         unsigned v1 = cidx(a1);
         unsigned v2 = cidx(a2);
@@ -109,6 +154,11 @@ vm_obj nat_sub(vm_obj const & a1, vm_obj const & a2) {
             return mk_vm_simple(0);
         else
             return mk_vm_nat(v1 - v2);
+    } else if (to_uint64(a1, a2, v1, v2)) {
+        if (v2 > v1)
+            return mk_vm_simple(0);
+        else
+            return mk_vm_nat_u64(v1 - v2);
     } else {
         mpz const & v1 = to_mpz1(a1);
         mpz const & v2 = to_mpz2(a2);
@@ -120,6 +170,7 @@ vm_obj nat_sub(vm_obj const & a1, vm_obj const & a2) {
 }
 
 vm_obj nat_div(vm_obj const & a1, vm_obj const & a2) {
+    uint64 v1, v2;
     if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         unsigned v1 = cidx(a1);
         unsigned v2 = cidx(a2);
@@ -127,6 +178,11 @@ vm_obj nat_div(vm_obj const & a1, vm_obj const & a2) {
             return mk_vm_simple(0);
         else
             return mk_vm_nat(v1 / v2);
+    } else if (to_uint64(a1, a2, v1, v2)) {
+        if (v2 == 0)
+            return mk_vm_simple(0);
+        else
+            return mk_vm_nat_u64(v1 / v2);
     } else {
         mpz const & v1 = to_mpz1(a1);
         mpz const & v2 = to_mpz2(a2);
@@ -138,6 +194,7 @@ vm_obj nat_div(vm_obj const & a1, vm_obj const & a2) {
 }
 
 vm_obj nat_mod(vm_obj const & a1, vm_obj const & a2) {
+    uint64 v1, v2;
     if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         unsigned v1 = cidx(a1);
         unsigned v2 = cidx(a2);
@@ -145,6 +202,11 @@ vm_obj nat_mod(vm_obj const & a1, vm_obj const & a2) {
             return a1;
         else
             return mk_vm_nat(v1 % v2);
+    } else if (to_uint64(a1, a2, v1, v2)) {
+        if (v2 == 0)
+            return a1;
+        else
+            return mk_vm_nat_u64(v1 % v2);
     } else {
         mpz const & v1 = to_mpz1(a1);
         mpz const & v2 = to_mpz2(a2);
@@ -156,68 +218,95 @@ vm_obj nat_mod(vm_obj const & a1, vm_obj const & a2) {
 }
 
 vm_obj nat_gcd(vm_obj const & a1, vm_obj const & a2) {
+    uint64 v1, v2;
+    if (to_uint64(a1, a2, v1, v2)) {
+        while (v2 != 0) {
+            uint64 r = v1 % v2;
+            v1 = v2;
+            v2 = r;
+        }
+        return mk_vm_nat_u64(v1);
+    }
     mpz r;
     gcd(r, to_mpz1(a1), to_mpz2(a2));
     return mk_vm_nat(r);
 }
 
 vm_obj nat_shiftl(vm_obj const & a1, vm_obj const & a2) {
-    if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
-        unsigned v1 = cidx(a1);
+    uint64 v1;
+    if (LEAN_LIKELY(is_simple(a2)) && to_uint64(a1, v1)) {
         unsigned v2 = cidx(a2);
-        if (v1 >> (31 - v2) == 0) // LEAN_MAX_SMALL_NAT = 1 >> 31
-            return mk_vm_nat(v1 << v2);
+        if (v1 == 0)
+            return mk_vm_simple(0);
+        if (v2 < 64 && (v1 >> (63 - v2)) == 0)
+            return mk_vm_nat_u64(v1 << v2);
     }
-    mpz v1 = to_mpz1(a1);
-    mul2k(v1, v1, to_unsigned(a2));
-    return mk_vm_mpz(v1);
+    mpz v1_mpz = to_mpz1(a1);
+    mul2k(v1_mpz, v1_mpz, to_unsigned(a2));
+    return mk_vm_mpz(v1_mpz);
 }
 
 vm_obj nat_shiftr(vm_obj const & a1, vm_obj const & a2) {
-    if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
-        return mk_vm_nat(cidx(a1) >> cidx(a2));
+    uint64 v1;
+    if (LEAN_LIKELY(is_simple(a2)) && to_uint64(a1, v1)) {
+        unsigned v2 = cidx(a2);
+        return v2 < 64 ? mk_vm_nat_u64(v1 >> v2) : mk_vm_simple(0);
     } else {
         mpz v1 = to_mpz1(a1);
         div2k(v1, v1, to_unsigned(a2));
-        return mk_vm_mpz(v1);
+        return mk_vm_nat(v1);
     }
 }
 
 vm_obj nat_land(vm_obj const & a1, vm_obj const & a2) {
+    uint64 v1, v2;
     if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         return mk_vm_nat(cidx(a1) & cidx(a2));
+    } else if (to_uint64(a1, a2, v1, v2)) {
+        return mk_vm_nat_u64(v1 & v2);
     } else {
-        return mk_vm_mpz(to_mpz1(a1) & to_mpz2(a2));
+        return mk_vm_nat(to_mpz1(a1) & to_mpz2(a2));
     }
 }
 
 vm_obj nat_lor(vm_obj const & a1, vm_obj const & a2) {
+    uint64 v1, v2;
     if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         return mk_vm_nat(cidx(a1) | cidx(a2));
+    } else if (to_uint64(a1, a2, v1, v2)) {
+        return mk_vm_nat_u64(v1 | v2);
     } else {
         return mk_vm_mpz(to_mpz1(a1) | to_mpz2(a2));
     }
 }
 
 vm_obj nat_lxor(vm_obj const & a1, vm_obj const & a2) {
+    uint64 v1, v2;
     if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         return mk_vm_nat(cidx(a1) ^ cidx(a2));
+    } else if (to_uint64(a1, a2, v1, v2)) {
+        return mk_vm_nat_u64(v1 ^ v2);
     } else {
-        return mk_vm_mpz(to_mpz1(a1) ^ to_mpz2(a2));
+        return mk_vm_nat(to_mpz1(a1) ^ to_mpz2(a2));
     }
 }
 
 vm_obj nat_ldiff(vm_obj const & a1, vm_obj const & a2) {
+    uint64 v1, v2;
     if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         return mk_vm_nat(cidx(a1) & ~cidx(a2));
+    } else if (to_uint64(a1, a2, v1, v2)) {
+        return mk_vm_nat_u64(v1 & ~v2);
     } else {
-        return mk_vm_mpz(to_mpz1(a1) & ~to_mpz2(a2));
+        return mk_vm_nat(to_mpz1(a1) & ~to_mpz2(a2));
     }
 }
 
 vm_obj nat_test_bit(vm_obj const & a1, vm_obj const & a2) {
-    if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
-        return mk_vm_bool((cidx(a1) & (1u << cidx(a2))) != 0);
+    uint64 v1;
+    if (LEAN_LIKELY(is_simple(a2)) && to_uint64(a1, v1)) {
+        unsigned v2 = cidx(a2);
+        return mk_vm_bool(v2 < 64 && ((v1 >> v2) & 1) != 0);
     } else {
         mpz const & v1 = to_mpz1(a1);
         mpz const & v2 = to_mpz2(a2);
@@ -229,24 +318,33 @@ vm_obj nat_test_bit(vm_obj const & a1, vm_obj const & a2) {
 }
 
 vm_obj nat_decidable_eq(vm_obj const & a1, vm_obj const & a2) {
+    uint64 v1, v2;
     if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         return mk_vm_bool(cidx(a1) == cidx(a2));
+    } else if (to_uint64(a1, a2, v1, v2)) {
+        return mk_vm_bool(v1 == v2);
     } else {
         return mk_vm_bool(to_mpz1(a1) == to_mpz2(a2));
     }
 }
 
 vm_obj nat_decidable_le(vm_obj const & a1, vm_obj const & a2) {
+    uint64 v1, v2;
     if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         return mk_vm_bool(cidx(a1) <= cidx(a2));
+    } else if (to_uint64(a1, a2, v1, v2)) {
+        return mk_vm_bool(v1 <= v2);
     } else {
         return mk_vm_bool(to_mpz1(a1) <= to_mpz2(a2));
     }
 }
 
 vm_obj nat_decidable_lt(vm_obj const & a1, vm_obj const & a2) {
+    uint64 v1, v2;
     if (LEAN_LIKELY(is_simple(a1) && is_simple(a2))) {
         return mk_vm_bool(cidx(a1) < cidx(a2));
+    } else if (to_uint64(a1, a2, v1, v2)) {
+        return mk_vm_bool(v1 < v2);
     } else {
         return mk_vm_bool(to_mpz1(a1) < to_mpz2(a2));
     }
@@ -12,6 +12,16 @@ namespace lean {
 unsigned to_unsigned(vm_obj const & o);
 optional<unsigned> try_to_unsigned(vm_obj const & o);
 unsigned force_to_unsigned(vm_obj const & o, unsigned def = std::numeric_limits<unsigned>::max());
+/* The following builtins are also invoked directly by the specialized VM instructions (see superop). */
+vm_obj nat_add(vm_obj const & a1, vm_obj const & a2);
+vm_obj nat_sub(vm_obj const & a1, vm_obj const & a2);
+vm_obj nat_mul(vm_obj const & a1, vm_obj const & a2);
+vm_obj nat_div(vm_obj const & a1, vm_obj const & a2);
+vm_obj nat_mod(vm_obj const & a1, vm_obj const & a2);
+vm_obj nat_decidable_eq(vm_obj const & a1, vm_obj const & a2);
+vm_obj nat_decidable_le(vm_obj const & a1, vm_obj const & a2);
+vm_obj nat_decidable_lt(vm_obj const & a1, vm_obj const & a2);
+
 void initialize_vm_nat();
 void finalize_vm_nat();
 }
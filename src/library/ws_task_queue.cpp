@@ -0,0 +1,411 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <vector>
+#include "library/ws_task_queue.h"
+#include "util/interrupt.h"
+#include "util/flet.h"
+
+#ifndef LEAN_WS_MAX_INLINE_DEPTH
+#define LEAN_WS_MAX_INLINE_DEPTH 16
+#endif
+
+#if defined(LEAN_MULTI_THREAD)
+namespace lean {
+
+LEAN_THREAD_PTR(gtask, g_current_task);
+struct scoped_current_task : flet<gtask *> {
+    scoped_current_task(gtask * t) : flet(g_current_task, t) {}
+};
+
+/* Worker threads of a ws_task_queue store it in g_owner.
+   g_queue_idx is the index of the worker queue, it is equal to m_num_workers for helper threads. */
+LEAN_THREAD_PTR(ws_task_queue, g_owner);
+LEAN_THREAD_VALUE(unsigned, g_queue_idx, 0);
+/* Number of tasks executed by wait_for_finish in the current thread. */
+LEAN_THREAD_VALUE(unsigned, g_inline_depth, 0);
+
+constexpr chrono::milliseconds g_ws_max_idle_time = chrono::milliseconds(100);
+
+ws_task_queue::worker_queue::worker_queue() : m_best_prio(UINT_MAX) {}
+
+ws_task_queue::ws_task_queue(unsigned num_workers) :
+    m_num_workers(std::max(num_workers, 1u)),
+    m_next_queue(0), m_num_queued(0), m_num_unfinished(0), m_num_sleeping(0), m_num_blocked(0),
+    m_shutting_down(false) {
+    for (unsigned i = 0; i < m_num_workers; i++)
+        m_queues.emplace_back(new worker_queue);
+    unique_lock<mutex> lock(m_threads_mutex);
+    for (unsigned i = 0; i < m_num_workers; i++)
+        spawn_thread(i);
+}
+
+ws_task_queue::~ws_task_queue() {
+    join();
+    {
+        unique_lock<mutex> lock(m_idle_mutex);
+        m_shutting_down = true;
+        m_wake_up.notify_all();
+    }
+    unique_lock<mutex> lock(m_threads_mutex);
+    for (auto & t : m_threads)
+        t->join();
+}
+
+mutex & ws_task_queue::get_init_mutex(gtask const & t) {
+    return m_init_mutexes[std::hash<gtask_cell *>()(t.get()) % LEAN_WS_NUM_INIT_MUTEXES];
+}
+
+/* Spawn a thread for the worker queue \c idx, or a helper thread if \c idx == m_num_workers.
+   \pre m_threads_mutex is locked */
+void ws_task_queue::spawn_thread(unsigned idx) {
+    if (idx == m_num_workers) m_num_helpers++;
+    m_threads.emplace_back(new lthread([this, idx]() {
+        save_stack_info(false);
+        g_owner     = this;
+        g_queue_idx = idx;
+        worker_loop(idx == m_num_workers);
+    }));
+}
+
+void ws_task_queue::worker_loop(bool is_helper) {
+    while (!m_shutting_down.load()) {
+        /* Helper threads only run tasks while workers are blocked. */
+        if (!is_helper || m_num_blocked.load() > 0) {
+            if (auto t = pop()) {
+                if (claim(*t))
+                    run(*t);
+                continue;
+            }
+        }
+        sleep(is_helper);
+    }
+}
+
+void ws_task_queue::sleep(bool is_helper) {
+    unique_lock<mutex> lock(m_idle_mutex);
+    m_num_sleeping++;
+    /* Remark: push increments m_num_queued before checking m_num_sleeping, so we cannot miss a task. */
+    if (!m_shutting_down.load() && (m_num_queued.load() == 0 || (is_helper && m_num_blocked.load() == 0)))
+        m_wake_up.wait_for(lock, g_ws_max_idle_time);
+    m_num_sleeping--;
+}
+
+void ws_task_queue::wake_up() {
+    if (m_num_sleeping.load() > 0) {
+        unique_lock<mutex> lock(m_idle_mutex);
+        m_wake_up.notify_all();
+    }
+}
+
+void ws_task_queue::push(gtask const & t, unsigned prio) {
+    unsigned idx = g_owner == this ? g_queue_idx : m_num_workers;
+    if (idx >= m_num_workers)
+        idx = m_next_queue++ % m_num_workers;
+    worker_queue & q = *m_queues[idx];
+    {
+        unique_lock<mutex> lock(q.m_mutex);
+        q.m_queue[prio].push_back(t);
+        q.m_best_prio = q.m_queue.begin()->first;
+    }
+    m_num_queued++;
+    wake_up();
+}
+
+optional<gtask> ws_task_queue::pop() {
+    unsigned own = g_owner == this ? g_queue_idx : m_num_workers;
+    while (m_num_queued.load() > 0) {
+        /* Find the queue with the highest priority task, ties are resolved in favor of our own queue. */
+        unsigned best_idx  = m_num_workers;
+        unsigned best_prio = UINT_MAX;
+        if (own < m_num_workers) {
+            best_idx  = own;
+            best_prio = m_queues[own]->m_best_prio.load();
+        }
+        for (unsigned i = 0; i < m_num_workers; i++) {
+            unsigned prio = m_queues[i]->m_best_prio.load();
+            if (prio < best_prio) {
+                best_idx  = i;
+                best_prio = prio;
+            }
+        }
+        if (best_prio == UINT_MAX)
+            return optional<gtask>();
+        worker_queue & q = *m_queues[best_idx];
+        unique_lock<mutex> lock(q.m_mutex);
+        if (q.m_queue.empty())
+            continue;
+        auto it = q.m_queue.begin();
+        gtask t = std::move(it->second.front());
+        it->second.pop_front();
+        if (it->second.empty())
+            q.m_queue.erase(it);
+        q.m_best_prio = q.m_queue.empty() ? UINT_MAX : q.m_queue.begin()->first;
+        m_num_queued--;
+        return optional<gtask>(t);
+    }
+    return optional<gtask>();
+}
+
+/* Move a queued task to the Running state. Return false if the task is not queued anymore
+   (e.g., it was cancelled, or it was already executed using a different entry in the worker queues). */
+bool ws_task_queue::claim(gtask const & t) {
+    if (get_state(t).load() != task_state::Queued)
+        return false;
+    ws_sched_info & info = get_sched_info(t);
+    unique_lock<mutex> lock(info.m_mutex);
+    if (get_state(t).load() != task_state::Queued)
+        return false;
+    get_state(t) = task_state::Running;
+    return true;
+}
+
+void ws_task_queue::run(gtask const & t) {
+    reset_heartbeat();
+    {
+        gtask t_copy = t;
+        scoped_current_task scope_cur_task(&t_copy);
+        execute(t_copy);
+    }
+    reset_heartbeat();
+    handle_finished(t);
+}
+
+void ws_task_queue::handle_finished(gtask const & t) {
+    lean_always_assert(get_state(t).load() > task_state::Running);
+    ws_sched_info & info = get_sched_info(t);
+    std::vector<gtask> rdeps;
+    bool was_waiting;
+    {
+        unique_lock<mutex> lock(info.m_mutex);
+        rdeps.swap(info.m_reverse_deps);
+        was_waiting    = info.m_waiting;
+        info.m_waiting = false;
+        /* We keep the scheduling information since other threads may still access it. */
+        get_data(t)->m_imp.reset();
+        info.m_has_finished.notify_all();
+    }
+    if (was_waiting) {
+        unique_lock<mutex> lock(m_waiting_mutex);
+        m_waiting.erase(t);
+    }
+    for (auto & rdep : rdeps) {
+        if (--get_sched_info(rdep).m_pending == 0)
+            enqueue(rdep);
+    }
+    if (--m_num_unfinished == 0) {
+        unique_lock<mutex> lock(m_idle_mutex);
+        m_all_finished.notify_all();
+    }
+}
+
+/* Create the scheduling information for \c t if it is in the Created state,
+   and return true if this is the case. */
+bool ws_task_queue::init_sched_info(gtask const & t, unsigned prio) {
+    unique_lock<mutex> lock(get_init_mutex(t));
+    if (get_state(t).load() != task_state::Created)
+        return false;
+    get_data(t)->m_sched_info.reset(new ws_sched_info(prio));
+    m_num_unfinished++;
+    get_state(t) = task_state::Waiting;
+    return true;
+}
+
+void ws_task_queue::register_deps(gtask const & t, unsigned prio) {
+    check_stack("ws_task_queue::register_deps");
+    ws_sched_info & info = get_sched_info(t);
+    buffer<gtask> deps;
+    {
+        unique_lock<mutex> lock(info.m_mutex);
+        if (get_state(t).load() != task_state::Waiting)
+            return;
+        try {
+            get_data(t)->m_imp->get_dependencies(deps);
+        } catch (...) {}
+    }
+
+    bool has_pending_deps = false;
+    for (auto & dep : deps) {
+        if (!dep) continue;
+        submit_core(dep, prio);
+        if (get_state(dep).load() > task_state::Running)
+            continue;
+        ws_sched_info & dep_info = get_sched_info(dep);
+        unique_lock<mutex> lock(dep_info.m_mutex);
+        if (get_state(dep).load() <= task_state::Running) {
+            has_pending_deps = true;
+            info.m_pending++;
+            dep_info.m_reverse_deps.push_back(t);
+        }
+    }
+
+    if (has_pending_deps) {
+        /* Remark: t cannot be enqueued before we decrement m_pending below. */
+        {
+            unique_lock<mutex> lock(info.m_mutex);
+            info.m_waiting = true;
+        }
+        unique_lock<mutex> lock(m_waiting_mutex);
+        m_waiting.insert(t);
+    }
+    if (--info.m_pending == 0)
+        enqueue(t);
+}
+
+void ws_task_queue::enqueue(gtask const & t) {
+    ws_sched_info & info = get_sched_info(t);
+    bool was_waiting;
+    {
+        unique_lock<mutex> lock(info.m_mutex);
+        if (get_state(t).load() != task_state::Waiting)
+            return;
+        get_state(t)   = task_state::Queued;
+        was_waiting    = info.m_waiting;
+        info.m_waiting = false;
+    }
+    if (was_waiting) {
+        unique_lock<mutex> lock(m_waiting_mutex);
+        m_waiting.erase(t);
+    }
+    push(t, info.m_prio.load());
+}
+
+void ws_task_queue::submit_core(gtask const & t, unsigned prio) {
+    if (!t || get_state(t).load() >= task_state::Running) return;
+    if (init_sched_info(t, prio)) {
+        register_deps(t, prio);
+    } else {
+        bump_prio(t, prio);
+    }
+}
+
+void ws_task_queue::bump_prio(gtask const & t, unsigned new_prio) {
+    if (get_state(t).load() >= task_state::Running) return;
+    ws_sched_info & info = get_sched_info(t);
+    buffer<gtask> deps;
+    bool requeue = false;
+    {
+        unique_lock<mutex> lock(info.m_mutex);
+        if (new_prio >= info.m_prio.load())
+            return;
+        info.m_prio = new_prio;
+        switch (get_state(t).load()) {
+        case task_state::Queued:
+            requeue = true;
+            break;
+        case task_state::Waiting:
+            try {
+                get_data(t)->m_imp->get_dependencies(deps);
+            } catch (...) {}
+            break;
+        default:
+            break;
+        }
+    }
+    if (requeue) {
+        /* The old entry is skipped when it is dequeued. */
+        push(t, new_prio);
+    }
+    for (auto & dep : deps)
+        submit_core(dep, new_prio);
+}
+
+void ws_task_queue::submit(gtask const & t, unsigned prio) {
+    submit_core(t, prio);
+}
+
+void ws_task_queue::submit(gtask const & t) {
+    submit(t, get_default_prio());
+}
+
+void ws_task_queue::wait_for_finish(gtask const & t) {
+    if (!t || get_state(t).load() > task_state::Running) return;
+    submit_core(t, get_default_prio());
+    if (get_state(t).load() > task_state::Running) return;
+    bool is_worker = g_owner == this;
+    if (is_worker && g_inline_depth < LEAN_WS_MAX_INLINE_DEPTH && claim(t)) {
+        flet<unsigned> inc_depth(g_inline_depth, g_inline_depth + 1);
+        run(t);
+        return;
+    }
+    if (is_worker) {
+        unique_lock<mutex> lock(m_threads_mutex);
+        m_num_blocked++;
+        if (m_num_helpers < m_num_blocked.load())
+            spawn_thread(m_num_workers);
+    }
+    if (is_worker) wake_up();
+    {
+        ws_sched_info & info = get_sched_info(t);
+        unique_lock<mutex> lock(info.m_mutex);
+        info.m_has_finished.wait(lock, [&] { return get_state(t).load() > task_state::Running; });
+    }
+    if (is_worker) m_num_blocked--;
+    switch (get_state(t).load()) {
+        case task_state::Failed: case task_state::Success: return;
+        default: throw exception("invalid task state");
+    }
+}
+
+void ws_task_queue::cancel_core(gtask const & t) {
+    if (!t) return;
+    if (get_state(t).load() == task_state::Created) {
+        unique_lock<mutex> lock(get_init_mutex(t));
+        if (get_state(t).load() == task_state::Created) {
+            fail(t, std::make_exception_ptr(cancellation_exception()));
+            return;
+        }
+    }
+    if (get_state(t).load() >= task_state::Running) return;
+    ws_sched_info & info = get_sched_info(t);
+    {
+        unique_lock<mutex> lock(info.m_mutex);
+        task_state s = get_state(t).load();
+        if (s != task_state::Waiting && s != task_state::Queued)
+            return;
+        fail(t, std::make_exception_ptr(cancellation_exception()));
+    }
+    handle_finished(t);
+}
+
+void ws_task_queue::fail_and_dispose(gtask const & t) {
+    cancel_core(t);
+}
+
+void ws_task_queue::evacuate() {
+    buffer<gtask> to_cancel;
+    for (auto & q : m_queues) {
+        unique_lock<mutex> lock(q->m_mutex);
+        for (auto & p : q->m_queue)
+            for (auto & t : p.second)
+                to_cancel.push_back(t);
+    }
+    {
+        unique_lock<mutex> lock(m_waiting_mutex);
+        for (auto & t : m_waiting)
+            to_cancel.push_back(t);
+    }
+    for (auto & t : to_cancel)
+        cancel_core(t);
+}
+
+void ws_task_queue::join() {
+    unique_lock<mutex> lock(m_idle_mutex);
+    m_all_finished.wait(lock, [&] { return m_num_unfinished.load() == 0; });
+}
+
+unsigned ws_task_queue::get_default_prio() {
+    if (g_current_task && get_data(*g_current_task)) {
+        return get_sched_info(*g_current_task).m_prio.load();
+    } else {
+        return 0;
+    }
+}
+}
+#endif
@@ -0,0 +1,122 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#pragma once
+#include <deque>
+#include <vector>
+#include <unordered_set>
+#include <map>
+#include <memory>
+#include "util/task.h"
+
+#ifndef LEAN_WS_NUM_INIT_MUTEXES
+#define LEAN_WS_NUM_INIT_MUTEXES 32
+#endif
+
+namespace lean {
+
+#if defined(LEAN_MULTI_THREAD)
+
+/** \brief Work-stealing task queue.
+
+    Every worker owns a priority queue (a map from priorities to deques).
+    Tasks submitted by a worker are added to its own queue, and tasks submitted by
+    other threads are distributed in round-robin fashion. A worker takes the next task
+    from its own queue, unless another queue has a task with higher priority (i.e., smaller
+    number), in which case it steals it.
+
+    In contrast to mt_task_queue, there is no global lock: the dependency information and the
+    state transitions of each task are protected by a mutex stored in its scheduling information.
+    A priority bump re-inserts the task, and outdated entries are skipped when they are dequeued.
+
+    When a worker waits for a queued task, it executes it directly. Otherwise, a helper thread is
+    spawned to keep the number of active threads. */
+class ws_task_queue : public task_queue {
+    struct ws_sched_info : public scheduling_info {
+        mutex              m_mutex;
+        atomic<unsigned>   m_prio;
+        /* Number of unfinished dependencies, plus one while the dependencies are being registered. */
+        atomic<int>        m_pending;
+        std::vector<gtask> m_reverse_deps;
+        bool               m_waiting = false;
+        condition_variable m_has_finished;
+
+        ws_sched_info(unsigned prio) : m_prio(prio), m_pending(1) {}
+    };
+
+    struct worker_queue {
+        mutex                                 m_mutex;
+        std::map<unsigned, std::deque<gtask>> m_queue;
+        /* Priority of the first task in m_queue, or UINT_MAX if it is empty. */
+        atomic<unsigned>                      m_best_prio;
+        worker_queue();
+    };
+
+    unsigned                                   m_num_workers;
+    std::vector<std::unique_ptr<worker_queue>> m_queues;
+    atomic<unsigned>                           m_next_queue;
+    atomic<unsigned>                           m_num_queued;
+    atomic<unsigned>                           m_num_unfinished;
+    atomic<unsigned>                           m_num_sleeping;
+    atomic<unsigned>                           m_num_blocked;
+    atomic<bool>                               m_shutting_down;
+
+    mutex                                      m_idle_mutex;
+    condition_variable                         m_wake_up;
+    condition_variable                         m_all_finished;
+
+    mutex                                      m_threads_mutex;
+    std::vector<std::unique_ptr<lthread>>      m_threads;
+    unsigned                                   m_num_helpers = 0;
+
+    mutex                                      m_waiting_mutex;
+    std::unordered_set<gtask>                  m_waiting;
+
+    mutex                                      m_init_mutexes[LEAN_WS_NUM_INIT_MUTEXES];
+    mutex & get_init_mutex(gtask const & t);
+
+    ws_sched_info & get_sched_info(gtask const & t) {
+        return static_cast<ws_sched_info &>(*get_data(t)->m_sched_info);
+    }
+
+    void spawn_thread(unsigned idx);
+    void worker_loop(bool is_helper);
+    void sleep(bool is_helper);
+    void wake_up();
+
+    void push(gtask const & t, unsigned prio);
+    optional<gtask> pop();
+    bool claim(gtask const & t);
+    void run(gtask const & t);
+
+    bool init_sched_info(gtask const & t, unsigned prio);
+    void register_deps(gtask const & t, unsigned prio);
+    void submit_core(gtask const & t, unsigned prio);
+    void bump_prio(gtask const & t, unsigned prio);
+    void enqueue(gtask const & t);
+    void cancel_core(gtask const & t);
+    void handle_finished(gtask const & t);
+
+    unsigned get_default_prio();
+
+public:
+    ws_task_queue(unsigned num_workers);
+    ~ws_task_queue();
+
+    void wait_for_finish(gtask const & t) override;
+    void fail_and_dispose(gtask const & t) override;
+
+    void submit(gtask const & t, unsigned prio) override;
+    void submit(gtask const & t) override;
+
+    void evacuate() override;
+
+    void join() override;
+};
+
+#endif
+
+}
@@ -13,6 +13,7 @@ Author: Leonardo de Moura
 #include <utility>
 #include <vector>
 #include "library/eval_helper.h"
+#include "library/profiling.h"
 #include "util/timer.h"
 #include "util/task_builder.h"
 #include "util/stackinfo.h"
@@ -24,16 +25,22 @@ Author: Leonardo de Moura
 #include "util/thread.h"
 #include "util/lean_path.h"
 #include "util/file_lock.h"
+#include "util/sampling_profiler.h"
+#include "util/cache_stats.h"
 #include "util/sexpr/options.h"
 #include "util/sexpr/option_declarations.h"
 #include "kernel/environment.h"
 #include "kernel/kernel_exception.h"
 #include "kernel/type_checker.h"
 #include "kernel/formatter.h"
+#include "kernel/expr_arena.h"
+#include "kernel/delta_hints.h"
 #include "library/st_task_queue.h"
 #include "library/mt_task_queue.h"
+#include "library/ws_task_queue.h"
 #include "library/module_mgr.h"
 #include "kernel/standard_kernel.h"
+#include "kernel/nat/nat.h"
 #include "library/module.h"
 #include "library/type_context.h"
 #include "library/io_state_stream.h"
@@ -47,6 +54,7 @@ Author: Leonardo de Moura
 #include "library/native_compiler/options.h"
 #include "library/native_compiler/native_compiler.h"
 #include "library/trace.h"
+#include "library/vm/vm.h"
 #include "init/init.h"
 #include "shell/simple_pos_info_provider.h"
 #include "shell/leandoc.h"
@@ -109,6 +117,9 @@ static void display_help(std::ostream & out) {
 #if defined(LEAN_MULTI_THREAD)
     std::cout << "  --threads=num -j   number of threads used to process lean files\n";
     std::cout << "  --tstack=num -s    thread stack size in Kb\n";
+    std::cout << "  --work-stealing    use the work-stealing task scheduler\n";
+    std::cout << "  --flamegraph=file  sample the elaborator, kernel and VM, and write the collapsed stacks\n"
+              << "                     to the given file (sampling interval: -D profiler.freq=ms)\n";
 #endif
     std::cout << "  --deps             just print dependencies of a Lean input\n";
 #if defined(LEAN_JSON)
@@ -117,7 +128,20 @@ static void display_help(std::ostream & out) {
     std::cout << "  --server           start lean in server mode\n";
     std::cout << "  --server=file      start lean in server mode, redirecting standard input from the specified file (for debugging)\n";
 #endif
-    std::cout << "  --profile          display elaboration/type checking time for each definition/theorem\n";
+    std::cout << "  --profile          display elaboration/type checking time for each definition/theorem,\n"
+              << "                     and the hit rates of the expression caches\n";
+    std::cout << "  --intern           share structurally equal terms created by different threads and modules,\n"
+              << "                     and display the memory saved\n";
+    std::cout << "  --nat-ext          evaluate closed arithmetic on nat numerals in the kernel using\n"
+              << "                     arbitrary precision integers\n";
+    std::cout << "  --krivine          reduce terms in the kernel and #reduce using an abstract machine with\n"
+              << "                     closures instead of substitution\n";
+    std::cout << "  --arena            allocate the temporary terms of type class resolution and simp matching\n"
+              << "                     in per-thread arenas\n";
+    std::cout << "  --delta-stats      record which definitions the kernel unfolds, display the statistics,\n"
+              << "                     and store unfolding hints in the .olean files\n";
+    std::cout << "  --kernel-cache=num maximum number of kernel results for closed terms shared by all declarations\n"
+              << "                     and modules (default: 65536, 0 disables the shared cache)\n";
     DEBUG_CODE(
     std::cout << "  --debug=tag        enable assertions with the given tag\n";
         )
@@ -127,6 +151,29 @@ static void display_help(std::ostream & out) {
     std::cout << "  --test-suite       capture output and status code from each input file $f in $f.produced and $f.status, respectively\n";
 }
 
+static void display_interning_stats(std::ostream & out, char const * what, intern_table_stats const & s) {
+    out << "interned " << what << ": " << s.m_size << " live, " << s.m_num_hits << " of " << s.m_num_lookups
+        << " lookups shared, " << s.m_num_bytes_saved / 1024 << " KB saved\n";
+}
+
+static void display_interning_stats(std::ostream & out) {
+    display_interning_stats(out, "expressions", get_expr_interning_stats());
+    display_interning_stats(out, "levels", get_level_interning_stats());
+}
+
+/** \brief Run the sampling profiler, and write the collapsed stacks to a file on destruction. */
+class flamegraph_writer {
+    std::string       m_file_name;
+    sampling_profiler m_profiler;
+public:
+    flamegraph_writer(std::string const & file_name, unsigned interval_ms):
+        m_file_name(file_name), m_profiler(interval_ms) {}
+    ~flamegraph_writer() {
+        std::ofstream out(m_file_name);
+        m_profiler.write_collapsed(out, [] (unsigned idx) { return get_vm_name(idx).to_string(); });
+    }
+};
+
 static struct option g_long_options[] = {
     {"version",      no_argument,       0, 'v'},
     {"help",         no_argument,       0, 'h'},
@@ -139,6 +186,12 @@ static struct option g_long_options[] = {
     {"memory",       required_argument, 0, 'M'},
     {"trust",        required_argument, 0, 't'},
     {"profile",      no_argument,       0, 'P'},
+    {"intern",       no_argument,       0, 'I'},
+    {"krivine",      no_argument,       0, 'K'},
+    {"nat-ext",      no_argument,       0, 'N'},
+    {"arena",        no_argument,       0, 'Z'},
+    {"delta-stats",  no_argument,       0, 'L'},
+    {"kernel-cache", required_argument, 0, 'k'},
     {"threads",      required_argument, 0, 'j'},
     {"quiet",        no_argument,       0, 'q'},
     {"deps",         no_argument,       0, 'd'},
@@ -155,6 +208,8 @@ static struct option g_long_options[] = {
     {"doc",          required_argument, 0, 'r'},
 #if defined(LEAN_MULTI_THREAD)
     {"tstack",       required_argument, 0, 's'},
+    {"work-stealing", no_argument,      0, 'W'},
+    {"flamegraph",   required_argument, 0, 'F'},
 #endif
 #ifdef LEAN_DEBUG
     {"debug",        required_argument, 0, 'B'},
@@ -163,9 +218,9 @@ static struct option g_long_options[] = {
 };
 
 static char const * g_opt_str =
-    "PdD:qpgvhet:012E:A:B:j:012rM:012T:012"
+    "PdD:qpgvhet:012E:A:B:j:012rM:012T:012IKNZLk:"
 #if defined(LEAN_MULTI_THREAD)
-    "s:012"
+    "s:012WF:"
 #endif
 ; // NOLINT
 
@@ -343,10 +398,12 @@ int main(int argc, char ** argv) {
     bool compile            = false;
     bool only_deps          = false;
     bool test_suite         = false;
+    bool use_nat_ext        = false;
     unsigned num_threads    = 0;
 #if defined(LEAN_MULTI_THREAD)
     num_threads = hardware_concurrency();
 #endif
+    bool work_stealing      = false;
 #if defined(LEAN_JSON)
     bool json_output        = false;
 #endif
@@ -358,6 +415,7 @@ int main(int argc, char ** argv) {
     optional<std::string> doc;
     optional<std::string> server_in;
     optional<std::string> run_arg;
+    optional<std::string> flamegraph;
     std::string native_output;
     while (true) {
         int c = getopt_long(argc, argv, g_opt_str, g_long_options, NULL);
@@ -367,6 +425,12 @@ int main(int argc, char ** argv) {
         case 'j':
             num_threads = static_cast<unsigned>(atoi(optarg));
             break;
+        case 'W':
+            work_stealing = true;
+            break;
+        case 'F':
+            flamegraph = std::string(optarg);
+            break;
         case 'v':
             display_header(std::cout);
             return 0;
@@ -452,6 +516,28 @@ int main(int argc, char ** argv) {
         case 'P':
             opts = opts.update("profiler", true);
             break;
+        case 'I':
+            enable_expr_interning();
+            break;
+        case 'K':
+            set_kernel_krivine_machine(true);
+            break;
+        case 'N':
+            use_nat_ext = true;
+            break;
+        case 'Z':
+            enable_expr_arenas(true);
+            break;
+        case 'L':
+            enable_delta_stats(true);
+            break;
+        case 'k': {
+            unsigned capacity = atoi(optarg);
+            set_kernel_shared_cache(capacity > 0);
+            if (capacity > 0)
+                set_kernel_shared_cache_capacity(capacity);
+            break;
+        }
         case 'E':
             export_txt = std::string(optarg);
             break;
@@ -485,7 +571,8 @@ int main(int argc, char ** argv) {
         set_max_heartbeat_thousands(timeout);
     }
 
-    environment env = mk_environment(trust_lvl);
+    environment env = use_nat_ext ? mk_environment(trust_lvl, std::unique_ptr<normalizer_extension>(new nat_normalizer_extension()))
+                                  : mk_environment(trust_lvl);
 
     io_state ios(opts, lean::mk_pretty_formatter_factory());
 
@@ -505,7 +592,7 @@ int main(int argc, char ** argv) {
             std::cin.rdbuf(file_in->rdbuf());
         }
 
-        server(num_threads, path.get_path(), env, ios).run();
+        server(num_threads, work_stealing, path.get_path(), env, ios).run();
         return 0;
     }
 #endif
@@ -539,11 +626,30 @@ int main(int argc, char ** argv) {
         return ok ? 0 : 1;
     }
 
+    std::unique_ptr<flamegraph_writer> flamegraph_out;
+#if defined(LEAN_MULTI_THREAD)
+    if (flamegraph)
+        flamegraph_out.reset(new flamegraph_writer(*flamegraph, get_profiler_freq(opts)));
+#endif
+
     try {
+        /* The caches of the worker threads report their counters when the threads finish,
+           so the cache statistics are displayed after the task queue has been destroyed. */
+        struct display_cache_stats_fn {
+            bool m_enabled;
+            ~display_cache_stats_fn() {
+                if (m_enabled) {
+                    flush_thread_cache_stats();
+                    display_cache_stats(std::cout);
+                }
+            }
+        } display_cache_stats_at_exit{get_profiler(opts)};
         std::shared_ptr<task_queue> tq;
 #if defined(LEAN_MULTI_THREAD)
         if (num_threads == 0) {
             tq = std::make_shared<st_task_queue>();
+        } else if (work_stealing) {
+            tq = std::make_shared<ws_task_queue>(num_threads);
         } else {
             tq = std::make_shared<mt_task_queue>(num_threads);
         }
@@ -696,6 +802,11 @@ int main(int argc, char ** argv) {
             gen_doc(env, opts, out);
         }
 
+        if (is_expr_interning_enabled())
+            display_interning_stats(std::cout);
+        if (delta_stats_enabled())
+            display_delta_stats(std::cout, 50);
+
         return ((ok && !get(has_errors(lt.get_root()))) || test_suite) ? 0 : 1;
     } catch (lean::throwable & ex) {
         lean::message_builder(env, ios, "<unknown>", lean::pos_info(1, 1), lean::ERROR).set_exception(ex).report();
@@ -22,6 +22,7 @@ Authors: Gabriel Ebner, Leonardo de Moura, Sebastian Ullrich
 #include "util/sexpr/option_declarations.h"
 #include "util/timer.h"
 #include "library/mt_task_queue.h"
+#include "library/ws_task_queue.h"
 #include "library/st_task_queue.h"
 #include "library/attribute_manager.h"
 #include "library/tactic/tactic_state.h"
@@ -293,7 +294,7 @@ public:
     }
 };
 
-server::server(unsigned num_threads, search_path const & path, environment const & initial_env, io_state const & ios) :
+server::server(unsigned num_threads, bool work_stealing, search_path const & path, environment const & initial_env, io_state const & ios) :
         m_path(path), m_initial_env(initial_env), m_ios(ios) {
     m_ios.set_regular_channel(std::make_shared<stderr_channel>());
     m_ios.set_diagnostic_channel(std::make_shared<stderr_channel>());
@@ -310,6 +311,8 @@ server::server(unsigned num_threads, search_path const & path, environment const
 #if defined(LEAN_MULTI_THREAD)
     if (num_threads == 0) {
         m_tq.reset(new st_task_queue);
+    } else if (work_stealing) {
+        m_tq.reset(new ws_task_queue(num_threads));
     } else {
         m_tq.reset(new mt_task_queue(num_threads));
     }
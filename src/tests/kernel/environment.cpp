@@ -13,6 +13,8 @@ Author: Leonardo de Moura
 #include "kernel/type_checker.h"
 #include "kernel/abstract.h"
 #include "kernel/kernel_exception.h"
+#include "kernel/delta_hints.h"
+#include "kernel/batch_check.h"
 #include "kernel/init_module.h"
 #include "library/init_module.h"
 #include "library/print.h"
@@ -94,6 +96,69 @@ static void tst2() {
     expr b = Const("b");
 }
 
+static void tst3() {
+    environment env;
+    lean_assert(compare_delta_hints(env, "f", "g") == 0);
+    env = add_delta_hint(env, "f", delta_hint(3, false));
+    env = add_delta_hint(env, "g", delta_hint(2, true));
+    lean_assert(compare_delta_hints(env, "f", "g") < 0);
+    lean_assert(compare_delta_hints(env, "g", "h") < 0);
+    /* hints of different modules are merged */
+    env = add_delta_hint(env, "g", delta_hint(2, false));
+    lean_assert(compare_delta_hints(env, "f", "g") > 0);
+    lean_assert(get_delta_hint(env, "g").m_no_self_opt);
+    lean_assert(!get_delta_hint(env, "f").m_no_self_opt);
+    delta_stats_entry e;
+    e.m_unfolds  = 10;
+    e.m_failures = 20;
+    lean_assert(e.to_hint().m_priority == 10);
+    lean_assert(e.to_hint().m_no_self_opt);
+    e.m_successes = 10;
+    lean_assert(!e.to_hint().m_no_self_opt);
+    /* the statistics of different modules are kept separately */
+    environment env1 = reset_delta_stats(env);
+    environment env2 = reset_delta_stats(env);
+    delta_stats s;
+    s["f"] = e;
+    merge_delta_stats(env, s);
+    lean_assert(get_module_delta_stats(env).empty());
+    merge_delta_stats(add_delta_hint(env1, "h", delta_hint(1, false)), s);
+    merge_delta_stats(env1, s);
+    lean_assert(get_module_delta_stats(env2).empty());
+    auto s1 = get_module_delta_stats(env1);
+    lean_assert(s1.size() == 1 && s1[0].first == "f");
+    lean_assert(s1[0].second.m_unfolds == 20);
+}
+
+static void tst4() {
+    reducibility_hints hints = reducibility_hints::mk_abbreviation();
+    expr A = Const("A");
+    std::vector<batch_declaration> decls;
+    decls.emplace_back(mk_axiom("A", level_param_names(), mk_Type()));
+    decls.emplace_back(mk_axiom("x", level_param_names(), A));
+    decls.emplace_back(mk_definition("y", level_param_names(), A, Const("x"), hints));
+    decls.emplace_back(mk_definition("bad", level_param_names(), A, mk_Prop(), hints));
+    decls.emplace_back(mk_definition("z", level_param_names(), A, Const("bad"), hints));
+    decls.emplace_back(mk_definition("w", level_param_names(), A, Const("y"), hints), std::vector<name>({"y"}));
+    decls.emplace_back(mk_definition("y", level_param_names(), A, Const("x"), hints));
+    environment env;
+    std::vector<batch_check_result> results;
+    environment new_env = check_batch(env, decls, results);
+    lean_assert(results.size() == decls.size());
+    lean_assert(results[0].m_ok && results[1].m_ok && results[2].m_ok);
+    lean_assert(!results[3].m_ok);
+    lean_assert(!results[4].m_ok);
+    std::cout << "expected error: " << results[4].m_error << "\n";
+    lean_assert(results[5].m_ok);
+    /* duplicate declaration */
+    lean_assert(!results[6].m_ok);
+    lean_assert(results[2].m_name == "y");
+    /* the resulting environment only contains the declarations preceding the first failure */
+    lean_assert(new_env.find("y"));
+    lean_assert(!new_env.find("bad"));
+    lean_assert(!new_env.find("w"));
+}
+
 namespace lean {
 class environment_id_tester {
 public:
@@ -179,6 +244,8 @@ int main() {
     init_default_print_fn();
     tst1();
     tst2();
+    tst3();
+    tst4();
     environment_id_tester::tst1();
     environment_id_tester::tst2();
     finalize_library_module();
@@ -17,6 +17,7 @@ Author: Leonardo de Moura
 #include "kernel/free_vars.h"
 #include "kernel/abstract.h"
 #include "kernel/instantiate.h"
+#include "kernel/expr_arena.h"
 #include "kernel/init_module.h"
 #include "library/init_module.h"
 #include "library/max_sharing.h"
@@ -376,6 +377,46 @@ static void tst18() {
     lean_assert(!has_local(mk_app(f, a0, a0, a0, a0)));
 }
 
+static void tst19() {
+    enable_expr_arenas(true);
+    expr f = Const("f");
+    expr a = Local("a", mk_Prop());
+    expr survivor, copy;
+    {
+        expr_arena_scope arena;
+        expr t = a;
+        for (unsigned i = 0; i < 10000; i++) {
+            t = mk_app(f, t, mk_var(i % 7));
+            if (i == 100)
+                survivor = t;
+        }
+        lean_assert(t.raw()->is_arena_cell());
+        {
+            expr_arena_scope nested;
+            lean_assert(mk_app(f, a).raw()->is_arena_cell());
+        }
+        lean_assert(mk_app(f, a).raw()->is_arena_cell());
+        copy = copy_out_of_arena(survivor);
+        lean_assert(!copy.raw()->is_arena_cell());
+        lean_assert(is_eqp(copy_out_of_arena(copy), copy));
+    }
+    lean_assert(!mk_app(f, a).raw()->is_arena_cell());
+    /* cells that survive the scope remain valid */
+    lean_assert(survivor.raw()->is_arena_cell());
+    lean_assert(survivor == copy);
+    lean_assert(get_weight(survivor) == get_weight(copy));
+    {
+        expr_arena_scope arena;
+        lean_assert(mk_app(f, survivor) == mk_app(f, copy));
+    }
+    survivor = expr();
+    enable_expr_arenas(false);
+    {
+        expr_arena_scope arena;
+        lean_assert(!mk_app(f, a).raw()->is_arena_cell());
+    }
+}
+
 int main() {
     save_stack_info();
     initialize_util_module();
@@ -403,6 +444,7 @@ int main() {
     tst16();
     tst17();
     tst18();
+    tst19();
     std::cout << "sizeof(expr):            " << sizeof(expr) << "\n";
     std::cout << "sizeof(expr_cell):       " << sizeof(expr_cell) << "\n";
     std::cout << "sizeof(expr_app):        " << sizeof(expr_app) << "\n";
@@ -0,0 +1,109 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include <vector>
+#include "util/test.h"
+#include "util/thread.h"
+#include "util/init_module.h"
+#include "util/sexpr/init_module.h"
+#include "kernel/init_module.h"
+#include "kernel/expr.h"
+#include "library/init_module.h"
+using namespace lean;
+
+static expr mk_term(unsigned n) {
+    level u = mk_succ(mk_param_univ("u"));
+    expr A = mk_sort(u);
+    expr f = mk_constant("f", {u});
+    expr r = mk_var(0);
+    for (unsigned i = 0; i < n; i++)
+        r = mk_app(f, r, mk_constant("a"));
+    return mk_lambda("x", A, r);
+}
+
+static void tst1() {
+    lean_assert(is_eqp(mk_succ(mk_param_univ("u")), mk_succ(mk_param_univ("u"))));
+    lean_assert(is_eqp(mk_term(10), mk_term(10)));
+    lean_assert(!is_eqp(mk_term(10), mk_term(11)));
+    expr A = mk_Prop();
+    /* binder names are taken into account */
+    lean_assert(!is_eqp(mk_lambda("x", A, mk_var(0)), mk_lambda("y", A, mk_var(0))));
+    lean_assert(is_eqp(mk_lambda("x", A, mk_var(0)), mk_lambda("x", A, mk_var(0))));
+    /* local constants and expressions with position information are not shared */
+    lean_assert(!is_eqp(mk_local("l", A), mk_local("l", A)));
+    lean_assert(!is_eqp(mk_constant("a", {}, 5), mk_constant("a", {}, 5)));
+}
+
+static void tst2() {
+    unsigned sz = get_expr_interning_stats().m_size;
+    {
+        expr e = mk_term(100);
+        lean_assert(get_expr_interning_stats().m_size > sz + 100);
+    }
+    /* the table does not keep expressions alive */
+    lean_assert(get_expr_interning_stats().m_size < sz + 10);
+    intern_table_stats s = get_expr_interning_stats();
+    lean_assert(s.m_num_hits > 0);
+    lean_assert(s.m_num_hits <= s.m_num_lookups);
+}
+
+static void tst3() {
+#if defined(LEAN_MULTI_THREAD)
+    expr e = mk_term(200);
+    std::vector<std::unique_ptr<lthread>> threads;
+    std::vector<unsigned> shared(8, 0);
+    for (unsigned i = 0; i < 8; i++) {
+        threads.push_back(std::unique_ptr<lthread>(new lthread([&, i] {
+                        for (unsigned j = 0; j < 100; j++) {
+                            /* terms created and released concurrently with the lookups of the other threads */
+                            mk_term(j);
+                        }
+                        shared[i] = is_eqp(mk_term(200), e);
+                    })));
+    }
+    for (auto & t : threads) t->join();
+    for (unsigned b : shared)
+        lean_assert(b);
+#endif
+}
+
+static void tst4() {
+    /* tagging a shared cell must not change the other references to it */
+    expr e1 = mk_app(mk_constant("f"), mk_constant("a"));
+    expr e2 = mk_app(mk_constant("f"), mk_constant("a"));
+    lean_assert(is_eqp(e1, e2));
+    e1.set_tag(7);
+    lean_assert(e1.get_tag() == 7);
+    lean_assert(e2.get_tag() == nulltag);
+    lean_assert(!is_eqp(e1, e2));
+    lean_assert(e1 == e2);
+    /* the hash-consing table can be disabled in the current thread */
+    {
+        scoped_expr_interning disable(false);
+        lean_assert(!is_eqp(mk_app(mk_constant("f"), mk_constant("a")), e2));
+    }
+    lean_assert(is_eqp(mk_app(mk_constant("f"), mk_constant("a")), e2));
+}
+
+int main() {
+    save_stack_info();
+    initialize_util_module();
+    initialize_sexpr_module();
+    initialize_kernel_module();
+    initialize_library_core_module();
+    initialize_library_module();
+    enable_expr_interning();
+    tst1();
+    tst2();
+    tst3();
+    tst4();
+    finalize_library_module();
+    finalize_library_core_module();
+    finalize_kernel_module();
+    finalize_sexpr_module();
+    finalize_util_module();
+    return has_violations() ? 1 : 0;
+}
@@ -65,6 +65,24 @@ static void tst2() {
     lean_assert(!is_equivalent(zero, p2));
 }
 
+static void tst3() {
+    level one = mk_succ(level());
+    level p1 = mk_param_univ("p1");
+    level p2 = mk_param_univ("p2");
+    level l  = mk_max(mk_succ(mk_max(p2, p1)), mk_max(p1, one));
+    /* the normal form is memoized, and the results of is_equivalent and is_geq are cached */
+    level n  = normalize(l);
+    lean_assert(is_eqp(normalize(l), n));
+    lean_assert(normalize(n) == n);
+    for (unsigned i = 0; i < 2; i++) {
+        lean_assert(is_equivalent(l, mk_max(mk_succ(p1), mk_succ(p2))));
+        lean_assert(!is_equivalent(l, mk_max(p1, mk_succ(p2))));
+        lean_assert(is_geq(l, mk_max(p1, p2)));
+        lean_assert(!is_geq(mk_max(p1, p2), l));
+        lean_assert(is_geq(mk_imax(p1, mk_succ(p2)), p1));
+    }
+}
+
 int main() {
     save_stack_info();
     initialize_util_module();
@@ -74,6 +92,7 @@ int main() {
     initialize_library_module();
     tst1();
     tst2();
+    tst3();
     finalize_library_module();
     finalize_library_core_module();
     finalize_kernel_module();
@@ -0,0 +1,125 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include "util/test.h"
+#include "util/init_module.h"
+#include "util/sexpr/init_module.h"
+#include "kernel/init_module.h"
+#include "library/init_module.h"
+#include "library/util.h"
+#include "library/constants.h"
+#include "library/tactic/smt/array_congruence_closure.h"
+using namespace lean;
+
+static void tst1() {
+    array_congruence_closure cc;
+    expr a = Const("a");
+    expr b = Const("b");
+    expr c = Const("c");
+    expr f = Const("f");
+    expr g = Const("g");
+    expr fab = mk_app(f, a, b);
+    expr fcb = mk_app(f, c, b);
+    cc.internalize(fab);
+    cc.internalize(fcb);
+    lean_always_assert(!cc.is_eqv(fab, fcb));
+    cc.push();
+    cc.add_eqv(a, c);
+    lean_always_assert(cc.is_eqv(fab, fcb));
+    lean_always_assert(cc.is_eqv(mk_app(f, a), mk_app(f, c)));
+    lean_always_assert(!cc.is_eqv(a, b));
+    cc.push();
+    expr gfab = mk_app(g, fab);
+    expr gfcb = mk_app(g, fcb);
+    cc.internalize(gfab);
+    cc.internalize(gfcb);
+    lean_always_assert(cc.is_eqv(gfab, gfcb));
+    cc.add_eqv(b, c);
+    lean_always_assert(cc.is_eqv(a, b));
+    lean_always_assert(cc.get_root(a) == cc.get_root(b));
+    cc.pop();
+    lean_always_assert(cc.is_eqv(fab, fcb));
+    lean_always_assert(!cc.is_eqv(a, b));
+    lean_always_assert(!cc.is_eqv(gfab, gfcb));
+    cc.pop();
+    lean_always_assert(!cc.is_eqv(fab, fcb));
+    lean_always_assert(!cc.is_eqv(a, c));
+    lean_always_assert(cc.get_num_scopes() == 0);
+}
+
+static void tst2() {
+    /* f (f (f a)) = a → f (f (f (f (f a)))) = a → f a = a */
+    array_congruence_closure cc;
+    expr a = Const("a");
+    expr f = Const("f");
+    expr fa = a;
+    buffer<expr> fs;
+    for (unsigned i = 0; i <= 5; i++) {
+        fs.push_back(fa);
+        fa = mk_app(f, fa);
+    }
+    unsigned num_terms = cc.get_num_terms();
+    cc.push();
+    cc.add_eqv(fs[3], a);
+    cc.add_eqv(fs[5], a);
+    lean_always_assert(cc.is_eqv(fs[1], a));
+    cc.pop();
+    lean_always_assert(!cc.is_eqv(fs[1], a));
+    lean_always_assert(cc.get_num_terms() == num_terms);
+}
+
+static void tst3() {
+    array_congruence_closure cc;
+    expr p = Const("p");
+    expr q = Const("q");
+    expr a = Const("a");
+    cc.push();
+    cc.add(mk_app(p, a));
+    cc.add(mk_not(mk_app(q, a)));
+    lean_always_assert(cc.is_eqv(mk_app(p, a), mk_true()));
+    lean_always_assert(!cc.inconsistent());
+    cc.add(mk_iff(mk_app(p, a), mk_app(q, a)));
+    lean_always_assert(cc.inconsistent());
+    cc.pop();
+    lean_always_assert(!cc.inconsistent());
+}
+
+static void tst4() {
+    /* heterogeneous equalities are only used when both sides have the same type */
+    array_congruence_closure cc;
+    expr A = Const("A");
+    expr B = Const("B");
+    expr a = Const("a");
+    expr b = Const("b");
+    expr c = Const("c");
+    expr heq = mk_constant(get_heq_name(), {mk_level_one()});
+    cc.push();
+    cc.add(mk_app({heq, A, a, B, b}));
+    lean_always_assert(!cc.is_eqv(a, b));
+    cc.add(mk_app({heq, A, a, A, c}));
+    lean_always_assert(cc.is_eqv(a, c));
+    cc.pop();
+    lean_always_assert(!cc.is_eqv(a, c));
+}
+
+int main() {
+    save_stack_info();
+    initialize_util_module();
+    initialize_sexpr_module();
+    initialize_kernel_module();
+    initialize_library_core_module();
+    initialize_library_module();
+    tst1();
+    tst2();
+    tst3();
+    tst4();
+    finalize_library_module();
+    finalize_library_core_module();
+    finalize_kernel_module();
+    finalize_sexpr_module();
+    finalize_util_module();
+    return has_violations() ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include <vector>
+#include "util/test.h"
+#include "util/task_builder.h"
+#include "util/init_module.h"
+#include "util/sexpr/init_module.h"
+#include "kernel/init_module.h"
+#include "library/init_module.h"
+#include "library/st_task_queue.h"
+#include "library/ws_task_queue.h"
+using namespace lean;
+
+static task<unsigned> mk_fib(unsigned n) {
+    return task_builder<unsigned>([=] {
+        if (n < 2) return n;
+        auto t1 = mk_fib(n - 1);
+        auto t2 = mk_fib(n - 2);
+        return get(t1) + get(t2);
+    }).build();
+}
+
+static void tst_nested() {
+    lean_assert_eq(get(mk_fib(15)), 610u);
+}
+
+static void tst_chain() {
+    task<unsigned> t = mk_pure_task(0u);
+    for (unsigned i = 0; i < 1000; i++)
+        t = map<unsigned>(t, [] (unsigned n) { return n + 1; }).build();
+    lean_assert_eq(get(t), 1000u);
+}
+
+static void tst_diamond() {
+    auto root = task_builder<unsigned>([] { return 1u; }).build();
+    std::vector<task<unsigned>> mids;
+    for (unsigned i = 0; i < 100; i++)
+        mids.push_back(map<unsigned>(root, [=] (unsigned n) { return n + i; }).build());
+    auto sum = map<unsigned>(traverse(mids), [] (std::vector<unsigned> const & ns) {
+        unsigned r = 0;
+        for (unsigned n : ns) r += n;
+        return r;
+    }).build();
+    lean_assert_eq(get(sum), 100u + 99u * 100u / 2u);
+}
+
+static void tst_cancel() {
+    auto ctok = mk_cancellation_token();
+    auto blocker = task_builder<unit>([] { return unit(); }).set_cancellation_token(ctok).build();
+    std::vector<task<unsigned>> ts;
+    for (unsigned i = 0; i < 100; i++)
+        ts.push_back(map<unsigned>(blocker, [=] (unit) { return i; }).set_cancellation_token(ctok).build());
+    cancel(ctok);
+    for (auto & t : ts) {
+        try {
+            get(t);
+        } catch (cancellation_exception) {}
+        lean_assert(t->peek_is_finished());
+    }
+}
+
+int main() {
+    save_stack_info();
+    initialize_util_module();
+    initialize_sexpr_module();
+    initialize_kernel_module();
+    initialize_library_core_module();
+    initialize_library_module();
+
+    {
+#if defined(LEAN_MULTI_THREAD)
+        ws_task_queue q(4);
+#else
+        st_task_queue q;
+#endif
+        set_task_queue(&q);
+        tst_nested();
+        tst_chain();
+        tst_diamond();
+        tst_cancel();
+        q.join();
+    }
+
+    finalize_library_module();
+    finalize_library_core_module();
+    finalize_kernel_module();
+    finalize_sexpr_module();
+    finalize_util_module();
+    return has_violations() ? 1 : 0;
+}
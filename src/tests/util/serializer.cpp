@@ -17,6 +17,7 @@ Author: Leonardo de Moura
 #include "util/list.h"
 #include "util/name.h"
 #include "util/init_module.h"
+#include "util/mapped_file.h"
 using namespace lean;
 
 template<typename T>
@@ -171,6 +172,27 @@ static void tst4() {
     lean_assert_eq(d5, o5);
 }
 
+static void tst5() {
+    std::ostringstream out;
+    serializer s(out);
+    s << std::string("olean") << 10u << 300u << true;
+    std::string data = out.str();
+    memory_istream in(data.data(), data.data() + data.size());
+    deserializer d(in);
+    std::string hdr; unsigned u1, u2; bool b;
+    d >> hdr >> u1 >> u2;
+    lean_assert_eq(in.get_pos(), hdr.size() + 1 + 1 + 5);
+    d >> b;
+    lean_assert_eq(hdr, "olean");
+    lean_assert_eq(u1, 10u);
+    lean_assert_eq(u2, 300u);
+    lean_assert(b);
+    lean_assert_eq(in.get_pos(), data.size());
+    mapped_file f(mapped_file::from_contents(), std::move(data));
+    lean_assert(!f.is_mapped());
+    lean_assert_eq(f.size(), in.get_pos());
+}
+
 int main() {
     save_stack_info();
     initialize_util_module();
@@ -179,6 +201,7 @@ int main() {
     tst2();
     tst3();
     tst4();
+    tst5();
     finalize_util_module();
     return has_violations() ? 1 : 0;
 }
@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include "util/test.h"
+#include "util/set_assoc_cache.h"
+using namespace lean;
+
+static cache_stats g_eviction_stats("test eviction");
+static cache_stats g_resize_stats("test resize");
+static cache_stats g_flush_stats("test flush");
+
+/* With capacity 2*LEAN_CACHE_WAYS there are two sets, and all even hash codes are mapped to the first one. */
+static void tst1() {
+    set_assoc_cache<unsigned, unsigned> cache(g_eviction_stats, 2*LEAN_CACHE_WAYS);
+    for (unsigned i = 0; i < LEAN_CACHE_WAYS; i++)
+        cache.insert(2*i, i, 10*i);
+    for (unsigned i = 0; i < LEAN_CACHE_WAYS; i++)
+        lean_assert(*cache.find(2*i, i) == 10*i);
+    /* the entries of the other set are not affected */
+    cache.insert(1, 100, 1000);
+    lean_assert(*cache.find(1, 100) == 1000);
+    /* the key 0 is used more recently than the key 1, and the set is full */
+    lean_assert(*cache.find(0, 0) == 0);
+    cache.insert(2*LEAN_CACHE_WAYS, LEAN_CACHE_WAYS, 10*LEAN_CACHE_WAYS);
+    lean_assert(*cache.find(2*LEAN_CACHE_WAYS, LEAN_CACHE_WAYS) == 10*LEAN_CACHE_WAYS);
+    lean_assert(cache.find(2, 1) == nullptr);
+    lean_assert(*cache.find(0, 0) == 0);
+    lean_assert(*cache.find(1, 100) == 1000);
+    /* updating an existing key does not evict */
+    cache.insert(0, 0, 42);
+    lean_assert(*cache.find(0, 0) == 42);
+    cache.flush_stats();
+    lean_assert(g_eviction_stats.m_evictions.load() == 1);
+    lean_assert(g_eviction_stats.m_resizes.load() == 0);
+    cache.clear();
+    lean_assert(cache.find(0, 0) == nullptr);
+    lean_assert(cache.find(1, 100) == nullptr);
+}
+
+static void tst2() {
+    unsigned C = 4*LEAN_CACHE_WAYS;
+    set_assoc_cache<unsigned, unsigned> cache(g_resize_stats, C);
+    lean_assert(cache.capacity() == C);
+    /* the cache grows until it can hold a working set that is bigger than its initial capacity */
+    unsigned N = 3 * C * LEAN_CACHE_MAX_GROWTH / 4;
+    for (unsigned r = 0; r < 100; r++) {
+        for (unsigned i = 0; i < N; i++) {
+            if (!cache.find(i, i))
+                cache.insert(i, i, i);
+        }
+    }
+    lean_assert(cache.capacity() == C * LEAN_CACHE_MAX_GROWTH);
+    for (unsigned i = 0; i < N; i++)
+        lean_assert(*cache.find(i, i) == i);
+    unsigned num_resizes = g_resize_stats.m_resizes.load();
+    lean_assert(num_resizes > 0);
+    /* a cache that never hits shrinks back to its initial capacity */
+    for (unsigned r = 0; r < 100; r++) {
+        for (unsigned i = 0; i < N; i++)
+            cache.find(i, i + 1);
+        cache.clear();
+    }
+    lean_assert(cache.capacity() == C);
+    lean_assert(g_resize_stats.m_resizes.load() > num_resizes);
+}
+
+static void tst3() {
+    {
+        set_assoc_cache<unsigned, unsigned> cache(g_flush_stats, 2*LEAN_CACHE_WAYS);
+        cache.insert(0, 0, 0);
+        for (unsigned i = 0; i < 3; i++)
+            cache.find(0, 0);
+        cache.find(0, 1);
+        /* counters are only reported once */
+        flush_thread_cache_stats();
+        flush_thread_cache_stats();
+        lean_assert(g_flush_stats.m_hits.load() == 3);
+        lean_assert(g_flush_stats.m_misses.load() == 1);
+        cache.find(0, 0);
+    }
+    lean_assert(g_flush_stats.m_hits.load() == 4);
+    lean_assert(g_flush_stats.m_misses.load() == 1);
+}
+
+int main() {
+    tst1();
+    tst2();
+    tst3();
+    return has_violations() ? 1 : 0;
+}
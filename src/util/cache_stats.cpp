@@ -0,0 +1,53 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include "util/cache_stats.h"
+
+namespace lean {
+/* cache_stats objects are created during static initialization, which is single threaded,
+   and g_cache_stats is zero-initialized before any of them. */
+static cache_stats * g_cache_stats = nullptr;
+
+cache_stats::cache_stats(char const * name):
+    m_name(name), m_next(g_cache_stats), m_hits(0), m_misses(0), m_evictions(0), m_resizes(0) {
+    g_cache_stats = this;
+}
+
+LEAN_THREAD_VALUE(cache_counters *, g_thread_cache_counters, nullptr);
+
+cache_counters::cache_counters():m_prev(nullptr), m_next(g_thread_cache_counters) {
+    if (m_next)
+        m_next->m_prev = this;
+    g_thread_cache_counters = this;
+}
+
+cache_counters::~cache_counters() {
+    if (m_prev)
+        m_prev->m_next = m_next;
+    else
+        g_thread_cache_counters = m_next;
+    if (m_next)
+        m_next->m_prev = m_prev;
+}
+
+void flush_thread_cache_stats() {
+    for (cache_counters * c = g_thread_cache_counters; c; c = c->m_next)
+        c->flush_stats();
+}
+
+void display_cache_stats(std::ostream & out) {
+    for (cache_stats * s = g_cache_stats; s; s = s->m_next) {
+        uint64 hits   = s->m_hits.load();
+        uint64 misses = s->m_misses.load();
+        if (hits + misses == 0)
+            continue;
+        uint64 permille = (1000 * hits) / (hits + misses);
+        out << s->m_name << " cache: " << hits << " hits, " << misses << " misses ("
+            << permille / 10 << "." << permille % 10 << "% hit rate), "
+            << s->m_evictions.load() << " evictions, " << s->m_resizes.load() << " resizes\n";
+    }
+}
+}
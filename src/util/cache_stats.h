@@ -0,0 +1,55 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#pragma once
+#include <iostream>
+#include "util/thread.h"
+#include "util/int64.h"
+
+namespace lean {
+/** \brief Counters shared by all instances (in all threads) of a kind of cache.
+
+    Objects of this class must have static storage duration, they register themselves
+    in a global list that is used by \c display_cache_stats. */
+class cache_stats {
+    char const *   m_name;
+    cache_stats *  m_next;
+public:
+    atomic<uint64> m_hits;
+    atomic<uint64> m_misses;
+    atomic<uint64> m_evictions;
+    atomic<uint64> m_resizes;
+
+    cache_stats(char const * name);
+    char const * get_name() const { return m_name; }
+    friend void display_cache_stats(std::ostream & out);
+};
+
+/** \brief Base class for caches that accumulate their counters locally and only
+    periodically add them to a \c cache_stats object.
+
+    Instances must be created and destroyed by the same thread, they are kept in a thread local list
+    that is used by \c flush_thread_cache_stats. */
+class cache_counters {
+    cache_counters * m_prev;
+    cache_counters * m_next;
+public:
+    cache_counters();
+    cache_counters(cache_counters const &) = delete;
+    cache_counters & operator=(cache_counters const &) = delete;
+    virtual ~cache_counters();
+    /** \brief Add the counters that have not been reported yet to the associated \c cache_stats. */
+    virtual void flush_stats() = 0;
+    friend void flush_thread_cache_stats();
+};
+
+/** \brief Flush the counters of the caches owned by the current thread.
+    Remark: the caches of other threads flush their counters when the threads finish. */
+void flush_thread_cache_stats();
+
+/** \brief Display the counters of all caches that have been used. */
+void display_cache_stats(std::ostream & out);
+}
@@ -9,6 +9,7 @@ Author: Leonardo de Moura
 #include "util/serializer.h"
 #include "util/name.h"
 #include "util/thread.h"
+#include "util/sampling_profiler.h"
 #include "util/memory_pool.h"
 #include "util/fresh_name.h"
 
@@ -17,6 +18,7 @@ void initialize_util_module() {
     initialize_debug();
     initialize_serializer();
     initialize_thread();
+    initialize_sampling_profiler();
     initialize_ascii();
     initialize_name();
     initialize_fresh_name();
@@ -25,6 +27,7 @@ void finalize_util_module() {
     finalize_fresh_name();
     finalize_name();
     finalize_ascii();
+    finalize_sampling_profiler();
     finalize_thread();
     finalize_serializer();
     finalize_debug();
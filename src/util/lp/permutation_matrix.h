@@ -123,7 +123,7 @@ namespace lean {
 
         unsigned size() const { return static_cast<unsigned>(m_rev.size()); }
 
-        unsigned * values() const { return m_permutation; }
+        unsigned * values() const { return const_cast<unsigned *>(m_permutation.data()); }
     }; // end of the permutation class
 
 #ifdef LEAN_DEBUG
@@ -0,0 +1,56 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include <string>
+#include <utility>
+#include "util/path.h"
+#include "util/mapped_file.h"
+
+#if !defined(LEAN_WINDOWS) && !defined(LEAN_EMSCRIPTEN)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define LEAN_USE_MMAP
+#endif
+
+namespace lean {
+mapped_file::mapped_file(std::string const & fname) {
+#if defined(LEAN_USE_MMAP)
+    int fd = open(fname.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw file_not_found_exception(fname);
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void * addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            m_data   = static_cast<char const *>(addr);
+            m_size   = st.st_size;
+            m_mapped = true;
+        }
+    }
+    close(fd);
+    if (m_mapped)
+        return;
+#endif
+    m_contents = read_file(fname, std::ios_base::binary);
+    m_data     = m_contents.data();
+    m_size     = m_contents.size();
+}
+
+mapped_file::mapped_file(from_contents, std::string && contents):
+    m_contents(std::move(contents)) {
+    m_data = m_contents.data();
+    m_size = m_contents.size();
+}
+
+mapped_file::~mapped_file() {
+#if defined(LEAN_USE_MMAP)
+    if (m_mapped)
+        munmap(const_cast<char *>(m_data), m_size);
+#endif
+}
+}
@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#pragma once
+#include <string>
+#include <istream>
+#include <streambuf>
+#include <cstddef>
+
+namespace lean {
+/** \brief Read-only view of the contents of a file.
+
+    On POSIX systems the file is memory-mapped, so pages are only read from disk
+    when they are accessed. If the file cannot be mapped (or on Windows), the contents
+    are read into memory.
+
+    \remark Writers must not truncate a file that may be mapped by a running process,
+    they should write a temporary file and rename it. */
+class mapped_file {
+    char const * m_data   = nullptr;
+    size_t       m_size   = 0;
+    bool         m_mapped = false;
+    std::string  m_contents;
+public:
+    struct from_contents {};
+    explicit mapped_file(std::string const & fname);
+    /** \brief Wrap contents that have already been loaded into memory. */
+    mapped_file(from_contents, std::string && contents);
+    mapped_file(mapped_file const &) = delete;
+    mapped_file & operator=(mapped_file const &) = delete;
+    ~mapped_file();
+
+    char const * data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool is_mapped() const { return m_mapped; }
+};
+
+/** \brief Stream buffer for reading the range [begin, end) without copying it. */
+class memory_streambuf : public std::streambuf {
+public:
+    memory_streambuf(char const * begin, char const * end) {
+        char * b = const_cast<char *>(begin);
+        setg(b, b, const_cast<char *>(end));
+    }
+    /** \brief Number of characters consumed so far. */
+    size_t get_pos() const { return gptr() - eback(); }
+};
+
+/** \brief Input stream for reading the range [begin, end) without copying it. */
+class memory_istream : private memory_streambuf, public std::istream {
+public:
+    memory_istream(char const * begin, char const * end):
+        memory_streambuf(begin, end), std::istream(static_cast<memory_streambuf *>(this)) {}
+    size_t get_pos() const { return memory_streambuf::get_pos(); }
+};
+}
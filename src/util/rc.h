@@ -16,6 +16,15 @@ atomic<unsigned> m_rc;                                                  \
 public:                                                                 \
 unsigned get_rc() const { return atomic_load(&m_rc); }                  \
 void inc_ref() { atomic_fetch_add_explicit(&m_rc, 1u, memory_order_relaxed); } \
+/* Increment the counter unless it is zero, i.e., unless the object is being deallocated. */ \
+bool try_inc_ref() {                                                    \
+    unsigned rc = get_rc();                                             \
+    while (rc != 0) {                                                   \
+        if (m_rc.compare_exchange_strong(rc, rc + 1))                   \
+            return true;                                                \
+    }                                                                   \
+    return false;                                                       \
+}                                                                       \
 bool dec_ref_core() {                                                   \
     lean_assert(get_rc() > 0);                                          \
     if (atomic_fetch_sub_explicit(&m_rc, 1u, memory_order_release) == 1u) { \
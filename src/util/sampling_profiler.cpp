@@ -0,0 +1,233 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#include <map>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include "util/sampling_profiler.h"
+#include "util/exception.h"
+
+#ifndef LEAN_PROFILER_MAX_PHASE_DEPTH
+#define LEAN_PROFILER_MAX_PHASE_DEPTH 256
+#endif
+
+namespace lean {
+namespace sampling_profiler_imp {
+atomic<bool> g_active(false);
+}
+
+struct profiler_phase_stack {
+    struct entry {
+        atomic<char const *>            m_phase;
+        atomic<profiler_frame_source *> m_source;
+        atomic<unsigned>                m_begin; /* number of frames of m_source when the phase was entered */
+        entry():m_phase(nullptr), m_source(nullptr), m_begin(0) {}
+    };
+    /* m_mutex protects the entries with frame sources, they are only read by the sampling thread while
+       holding it, and they are only removed while holding it. */
+    mutex            m_mutex;
+    atomic<unsigned> m_depth;
+    entry            m_entries[LEAN_PROFILER_MAX_PHASE_DEPTH];
+    profiler_phase_stack():m_depth(0) {}
+};
+
+static mutex *                               g_stacks_mutex = nullptr;
+static std::vector<profiler_phase_stack *> * g_stacks       = nullptr;
+
+static void finalize_profiler_phase_stack(void * p) {
+    profiler_phase_stack * s = static_cast<profiler_phase_stack *>(p);
+    if (g_stacks_mutex) {
+        lock_guard<mutex> lock(*g_stacks_mutex);
+        g_stacks->erase(std::remove(g_stacks->begin(), g_stacks->end(), s), g_stacks->end());
+    }
+    delete s;
+}
+
+LEAN_THREAD_PTR(profiler_phase_stack, g_phase_stack);
+
+static void finalize_phase_stack_tlocal(void * p) {
+    finalize_profiler_phase_stack(p);
+    g_phase_stack = nullptr;
+}
+
+static profiler_phase_stack & get_phase_stack() {
+    if (!g_phase_stack) {
+        g_phase_stack = new profiler_phase_stack();
+        {
+            lock_guard<mutex> lock(*g_stacks_mutex);
+            g_stacks->push_back(g_phase_stack);
+        }
+        register_thread_finalizer(finalize_phase_stack_tlocal, g_phase_stack);
+    }
+    return *g_phase_stack;
+}
+
+void scoped_profiler_phase::push(char const * phase, profiler_frame_source * source) {
+    m_stack      = &get_phase_stack();
+    m_depth      = m_stack->m_depth.load();
+    m_has_source = source != nullptr;
+    if (m_depth < LEAN_PROFILER_MAX_PHASE_DEPTH) {
+        auto & e = m_stack->m_entries[m_depth];
+        if (source) {
+            lock_guard<mutex> lock(m_stack->m_mutex);
+            e.m_phase.store(phase);
+            e.m_source.store(source);
+            e.m_begin.store(source->get_num_profiler_frames());
+            m_stack->m_depth.store(m_depth + 1);
+            return;
+        }
+        e.m_phase.store(phase);
+        e.m_source.store(nullptr);
+    }
+    m_stack->m_depth.store(m_depth + 1);
+}
+
+void scoped_profiler_phase::pop() {
+    /* We restore the depth instead of decrementing it, this is robust with respect to profiler restarts. */
+    if (m_has_source) {
+        lock_guard<mutex> lock(m_stack->m_mutex);
+        m_stack->m_depth.store(m_depth);
+    } else {
+        m_stack->m_depth.store(m_depth);
+    }
+}
+
+/* Frame of a sample: either a phase name, or a frame index reported by a frame source. */
+struct profiler_frame {
+    char const * m_phase;
+    unsigned     m_idx;
+    bool operator<(profiler_frame const & o) const {
+        if (m_phase != o.m_phase) return std::less<char const *>()(m_phase, o.m_phase);
+        return m_idx < o.m_idx;
+    }
+    bool operator==(profiler_frame const & o) const { return m_phase == o.m_phase && m_idx == o.m_idx; }
+};
+
+struct sampling_profiler::imp {
+    unsigned                                          m_interval_ms;
+    mutex                                             m_mutex;
+    condition_variable                                m_stop_cv;
+    bool                                              m_stop = false;
+    std::map<std::vector<profiler_frame>, unsigned>   m_samples;
+    std::unique_ptr<lthread>                          m_thread;
+
+    static void add_frame(std::vector<profiler_frame> & stack, profiler_frame const & f) {
+        /* Collapse direct recursion, e.g., whnf calling whnf. */
+        if (stack.empty() || !(stack.back() == f))
+            stack.push_back(f);
+    }
+
+    void sample(profiler_phase_stack & s, std::vector<profiler_frame> & stack) {
+        lock_guard<mutex> lock(s.m_mutex);
+        unsigned depth = std::min(s.m_depth.load(), static_cast<unsigned>(LEAN_PROFILER_MAX_PHASE_DEPTH));
+        buffer<unsigned> frames;
+        for (unsigned i = 0; i < depth; i++) {
+            auto & e = s.m_entries[i];
+            char const * phase = e.m_phase.load();
+            if (!phase) continue;
+            add_frame(stack, profiler_frame{phase, 0});
+            if (profiler_frame_source * src = e.m_source.load()) {
+                /* The frames of src belong to this phase until the next phase with the same source. */
+                unsigned end = src->get_num_profiler_frames();
+                for (unsigned j = i + 1; j < depth; j++) {
+                    if (s.m_entries[j].m_source.load() == src) {
+                        end = s.m_entries[j].m_begin.load();
+                        break;
+                    }
+                }
+                frames.clear();
+                src->collect_profiler_frames(e.m_begin.load(), end, frames);
+                for (unsigned idx : frames)
+                    add_frame(stack, profiler_frame{nullptr, idx});
+            }
+        }
+    }
+
+    void take_samples() {
+        lock_guard<mutex> lock(*g_stacks_mutex);
+        std::vector<profiler_frame> stack;
+        for (profiler_phase_stack * s : *g_stacks) {
+            stack.clear();
+            sample(*s, stack);
+            if (!stack.empty())
+                m_samples[stack]++;
+        }
+    }
+
+    void run() {
+        unique_lock<mutex> lock(m_mutex);
+        while (!m_stop) {
+            m_stop_cv.wait_for(lock, chrono::milliseconds(m_interval_ms));
+            if (m_stop) break;
+            lock.unlock();
+            take_samples();
+            lock.lock();
+        }
+    }
+};
+
+sampling_profiler::sampling_profiler(unsigned interval_ms):m_ptr(new imp) {
+#if defined(LEAN_MULTI_THREAD)
+    if (sampling_profiler_imp::g_active.exchange(true))
+        throw exception("sampling profiler is already running");
+    m_ptr->m_interval_ms = std::max(interval_ms, 1u);
+    imp * p = m_ptr.get();
+    m_ptr->m_thread.reset(new lthread([=] { p->run(); }));
+#else
+    (void)interval_ms;
+    throw exception("sampling profiler is not available in single threaded builds");
+#endif
+}
+
+sampling_profiler::~sampling_profiler() {
+    stop();
+}
+
+void sampling_profiler::stop() {
+    if (!m_ptr->m_thread) return;
+    {
+        lock_guard<mutex> lock(m_ptr->m_mutex);
+        m_ptr->m_stop = true;
+        m_ptr->m_stop_cv.notify_all();
+    }
+    m_ptr->m_thread->join();
+    m_ptr->m_thread.reset();
+    sampling_profiler_imp::g_active.store(false);
+}
+
+void sampling_profiler::write_collapsed(std::ostream & out, std::function<std::string(unsigned)> const & frame_name) {
+    stop();
+    std::map<std::string, unsigned> lines;
+    for (auto const & s : m_ptr->m_samples) {
+        std::string line;
+        for (profiler_frame const & f : s.first) {
+            if (!line.empty()) line += ';';
+            std::string n = f.m_phase ? std::string(f.m_phase) : frame_name(f.m_idx);
+            /* ';' and ' ' are separators in the collapsed stack format */
+            std::replace(n.begin(), n.end(), ';', ':');
+            std::replace(n.begin(), n.end(), ' ', '_');
+            line += n;
+        }
+        lines[line] += s.second;
+    }
+    for (auto const & l : lines)
+        out << l.first << " " << l.second << "\n";
+}
+
+void initialize_sampling_profiler() {
+    g_stacks_mutex = new mutex;
+    g_stacks       = new std::vector<profiler_phase_stack *>();
+}
+
+void finalize_sampling_profiler() {
+    delete g_stacks;
+    delete g_stacks_mutex;
+    g_stacks       = nullptr;
+    g_stacks_mutex = nullptr;
+}
+}
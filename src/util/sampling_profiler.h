@@ -0,0 +1,90 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#pragma once
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "util/thread.h"
+#include "util/compiler_hints.h"
+#include "util/buffer.h"
+
+namespace lean {
+
+/** \brief Source of additional profiler frames, such as the call stack of a VM.
+    The frames are identified by indices, which are converted into names when the profile is written. */
+class profiler_frame_source {
+public:
+    virtual ~profiler_frame_source() {}
+    /** \brief Append the frames with positions in <tt>[begin, end)</tt> to \c frames.
+        \c end may be greater than the current number of frames.
+        This method is invoked by the sampling thread. */
+    virtual void collect_profiler_frames(unsigned begin, unsigned end, buffer<unsigned> & frames) = 0;
+    /** \brief Return the current number of frames. It is invoked by the sampling thread. */
+    virtual unsigned get_num_profiler_frames() = 0;
+};
+
+struct profiler_phase_stack;
+
+namespace sampling_profiler_imp {
+extern atomic<bool> g_active;
+}
+
+/** \brief Return true iff the sampling profiler is running. */
+inline bool is_sampling_profiler_active() {
+    return sampling_profiler_imp::g_active.load();
+}
+
+/** \brief Mark the current thread as being in the given phase (e.g., "kernel") while this object is alive.
+    Phases nest, and the sampling profiler records the stack of active phases of every thread.
+    \remark \c phase must be a string literal. When the profiler is not running, this object does nothing. */
+class scoped_profiler_phase {
+    profiler_phase_stack * m_stack = nullptr;
+    unsigned               m_depth;
+    bool                   m_has_source = false;
+    void push(char const * phase, profiler_frame_source * source);
+    void pop();
+public:
+    scoped_profiler_phase(char const * phase) {
+        if (LEAN_UNLIKELY(is_sampling_profiler_active())) push(phase, nullptr);
+    }
+    /** \brief Mark the current thread as being in the given phase, and report the frames of \c source
+        created while this object is alive as children of \c phase. */
+    scoped_profiler_phase(char const * phase, profiler_frame_source & source) {
+        if (LEAN_UNLIKELY(is_sampling_profiler_active())) push(phase, &source);
+    }
+    ~scoped_profiler_phase() {
+        if (m_stack) pop();
+    }
+};
+
+/** \brief Native sampling profiler.
+
+    A background thread periodically records the stack of phases (see \c scoped_profiler_phase) of every thread
+    that is inside at least one phase. Frame sources (e.g., the VM) contribute their own frames to the stack.
+    The samples are aggregated, and can be written in the collapsed stack format used by flamegraph tools.
+    At most one sampling profiler can be running at any time. */
+class sampling_profiler {
+    struct imp;
+    std::unique_ptr<imp> m_ptr;
+public:
+    /** \brief Start sampling every \c interval_ms milliseconds. */
+    sampling_profiler(unsigned interval_ms);
+    ~sampling_profiler();
+
+    /** \brief Stop sampling. */
+    void stop();
+
+    /** \brief Write the samples in collapsed stack format, i.e., each line has the form
+        <tt>phase_1;...;phase_n count</tt>. \c frame_name is used to obtain the names of the frames
+        reported by frame sources. */
+    void write_collapsed(std::ostream & out, std::function<std::string(unsigned)> const & frame_name);
+};
+
+void initialize_sampling_profiler();
+void finalize_sampling_profiler();
+}
@@ -0,0 +1,156 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <functional>
+#include "util/cache_stats.h"
+
+#ifndef LEAN_CACHE_WAYS
+#define LEAN_CACHE_WAYS 4
+#endif
+
+#ifndef LEAN_CACHE_MAX_GROWTH
+#define LEAN_CACHE_MAX_GROWTH 8
+#endif
+
+namespace lean {
+/** \brief Set-associative cache that adapts its capacity to the observed behavior.
+
+    An entry with hash code \c h is stored in the set <tt>h % num_sets</tt>, and each set holds up to
+    \c LEAN_CACHE_WAYS entries ordered by recency, i.e., entries evict each other only when more than
+    \c LEAN_CACHE_WAYS hot keys are mapped to the same set.
+
+    The capacity is reconsidered after a number of lookups proportional to it: the cache doubles
+    (up to \c LEAN_CACHE_MAX_GROWTH times the initial capacity) when a significant fraction of the insertions
+    evict entries, and halves (down to the initial capacity) when its hit rate is very low or most sets are unused.
+    Resizing drops all entries. The hit/miss/eviction counters are accumulated in \c stats
+    when the cache adapts, when it is destroyed, and by \c flush_thread_cache_stats. */
+template<typename Key, typename Value, typename KeyEq = std::equal_to<Key>>
+class set_assoc_cache : public cache_counters {
+    struct entry {
+        Key   m_key;
+        Value m_value;
+        bool  m_valid = false;
+    };
+    cache_stats &         m_stats;
+    KeyEq                 m_eq;
+    unsigned              m_min_sets;
+    unsigned              m_num_sets;
+    std::vector<entry>    m_entries;
+    std::vector<unsigned> m_used; /* sets containing at least one entry */
+    /* counters since the last adaptation */
+    unsigned              m_hits = 0;
+    unsigned              m_misses = 0;
+    unsigned              m_evictions = 0;
+    unsigned              m_inserts = 0;
+    unsigned              m_max_used = 0;
+    /* part of the counters above that has already been added to m_stats */
+    unsigned              m_flushed_hits = 0;
+    unsigned              m_flushed_misses = 0;
+    unsigned              m_flushed_evictions = 0;
+
+    entry * get_set(unsigned h) { return m_entries.data() + (h % m_num_sets) * LEAN_CACHE_WAYS; }
+
+    void reset_entries() {
+        for (unsigned s : m_used) {
+            entry * set = m_entries.data() + s * LEAN_CACHE_WAYS;
+            for (unsigned i = 0; i < LEAN_CACHE_WAYS && set[i].m_valid; i++)
+                set[i] = entry();
+        }
+        m_used.clear();
+    }
+
+    void adapt() {
+        flush_stats();
+        m_max_used = std::max(m_max_used, static_cast<unsigned>(m_used.size()));
+        unsigned lookups  = m_hits + m_misses;
+        unsigned new_sets = m_num_sets;
+        if (4 * m_evictions > m_inserts && m_num_sets < m_min_sets * LEAN_CACHE_MAX_GROWTH)
+            new_sets = 2 * m_num_sets;
+        else if ((32 * m_hits < lookups || 8 * m_max_used < m_num_sets) && m_num_sets > m_min_sets)
+            new_sets = m_num_sets / 2;
+        m_hits = m_misses = m_evictions = m_inserts = m_max_used = 0;
+        m_flushed_hits = m_flushed_misses = m_flushed_evictions = 0;
+        if (new_sets != m_num_sets) {
+            reset_entries();
+            m_num_sets = new_sets;
+            m_entries  = std::vector<entry>(m_num_sets * LEAN_CACHE_WAYS);
+            m_stats.m_resizes++;
+        }
+    }
+
+    void check_adapt() {
+        if (m_hits + m_misses >= 4 * m_num_sets * LEAN_CACHE_WAYS)
+            adapt();
+    }
+
+public:
+    set_assoc_cache(cache_stats & stats, unsigned capacity):
+        m_stats(stats), m_min_sets(std::max(capacity / LEAN_CACHE_WAYS, 1u)), m_num_sets(m_min_sets),
+        m_entries(m_num_sets * LEAN_CACHE_WAYS) {}
+    ~set_assoc_cache() { flush_stats(); }
+
+    virtual void flush_stats() override {
+        m_stats.m_hits      += m_hits - m_flushed_hits;
+        m_stats.m_misses    += m_misses - m_flushed_misses;
+        m_stats.m_evictions += m_evictions - m_flushed_evictions;
+        m_flushed_hits      = m_hits;
+        m_flushed_misses    = m_misses;
+        m_flushed_evictions = m_evictions;
+    }
+
+    /** \brief Return the number of entries the cache can currently hold. */
+    unsigned capacity() const { return m_num_sets * LEAN_CACHE_WAYS; }
+
+    /** \brief Return the value associated with \c k (with hash code \c h), or nullptr. */
+    Value * find(unsigned h, Key const & k) {
+        entry * set = get_set(h);
+        for (unsigned i = 0; i < LEAN_CACHE_WAYS && set[i].m_valid; i++) {
+            if (m_eq(set[i].m_key, k)) {
+                m_hits++;
+                if (i > 0) {
+                    /* move towards the front of the set */
+                    std::swap(set[i], set[i-1]);
+                    i--;
+                }
+                return &set[i].m_value;
+            }
+        }
+        m_misses++;
+        return nullptr;
+    }
+
+    void insert(unsigned h, Key const & k, Value const & v) {
+        check_adapt();
+        m_inserts++;
+        entry * set = get_set(h);
+        for (unsigned i = 0; i < LEAN_CACHE_WAYS && set[i].m_valid; i++) {
+            if (m_eq(set[i].m_key, k)) {
+                set[i].m_value = v;
+                return;
+            }
+        }
+        if (!set[0].m_valid)
+            m_used.push_back(static_cast<unsigned>(set - m_entries.data()) / LEAN_CACHE_WAYS);
+        if (set[LEAN_CACHE_WAYS - 1].m_valid)
+            m_evictions++;
+        for (unsigned i = LEAN_CACHE_WAYS - 1; i > 0; i--)
+            set[i] = std::move(set[i-1]);
+        set[0].m_key   = k;
+        set[0].m_value = v;
+        set[0].m_valid = true;
+    }
+
+    void clear() {
+        m_max_used = std::max(m_max_used, static_cast<unsigned>(m_used.size()));
+        reset_entries();
+        check_adapt();
+    }
+};
+}
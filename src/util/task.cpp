@@ -91,4 +91,8 @@ task_queue & taskq() {
     return *g_taskq;
 }
 
+bool has_task_queue() {
+    return g_taskq != nullptr;
+}
+
 }
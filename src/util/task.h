@@ -150,6 +150,8 @@ public:
 
 void set_task_queue(task_queue *); // NOLINT
 task_queue & taskq();
+/** \brief Return true if a task queue has been set using \c set_task_queue. */
+bool has_task_queue();
 
 template <class Res>
 Res const & get(task<Res> const & t) {
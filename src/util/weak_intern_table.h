@@ -0,0 +1,104 @@
+/*
+Copyright (c) 2026 agent. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+
+Author: agent
+*/
+#pragma once
+#include <unordered_map>
+#include "util/thread.h"
+#include "util/buffer.h"
+#include "util/int64.h"
+
+#ifndef LEAN_NUM_INTERN_TABLE_SHARDS
+#define LEAN_NUM_INTERN_TABLE_SHARDS 64
+#endif
+
+namespace lean {
+struct intern_table_stats {
+    uint64   m_num_lookups     = 0;
+    uint64   m_num_hits        = 0;
+    /* Sum of the sizes of the cells that were discarded because an equal cell was already in the table. */
+    uint64   m_num_bytes_saved = 0;
+    unsigned m_size            = 0;
+};
+
+/** \brief Hash-consing table shared by all threads.
+
+    The table stores weak references: it does not increase the reference counter of the cells it contains,
+    and a cell must be removed using \c erase before it is deallocated. A cell whose reference counter
+    dropped to zero may still be in the table until then, \c intern never returns such a cell.
+
+    The table is split in shards, each one protected by its own mutex.
+
+    \c Ref is a smart pointer (e.g., \c expr), \c Cell the type of its cells (which must provide
+    \c try_inc_ref and \c dec_ref), and \c Eq is used to compare smart pointers. */
+template<typename Ref, typename Cell, typename Eq>
+class weak_intern_table {
+    struct shard {
+        mutex                                     m_mutex;
+        std::unordered_multimap<unsigned, Cell *> m_cells;
+        intern_table_stats                        m_stats;
+    };
+    shard m_shards[LEAN_NUM_INTERN_TABLE_SHARDS];
+    Eq    m_eq;
+
+    shard & get_shard(unsigned h) { return m_shards[h % LEAN_NUM_INTERN_TABLE_SHARDS]; }
+
+public:
+    /** \brief Return a live cell in the table that is equal to \c r, or insert \c r.
+        \c h is the hash code of \c r, and \c sz the size of its cell in bytes.
+        \c mark_interned is invoked on the cell of \c r when it is inserted. */
+    template<typename MarkFn>
+    Ref intern(Ref const & r, Cell * c, unsigned h, unsigned sz, MarkFn && mark_interned) {
+        /* Candidates that turn out to be different from r are released after the mutex is unlocked,
+           releasing the last reference to a cell invokes erase. */
+        buffer<Ref> to_release;
+        shard & s = get_shard(h);
+        lock_guard<mutex> lock(s.m_mutex);
+        s.m_stats.m_num_lookups++;
+        auto range = s.m_cells.equal_range(h);
+        for (auto it = range.first; it != range.second; ++it) {
+            Cell * other = it->second;
+            if (!other->try_inc_ref())
+                continue; /* other is being deallocated */
+            Ref other_ref(other);
+            other->dec_ref(); /* other_ref holds the reference obtained by try_inc_ref */
+            if (m_eq(other_ref, r)) {
+                s.m_stats.m_num_hits++;
+                s.m_stats.m_num_bytes_saved += sz;
+                return other_ref;
+            }
+            to_release.push_back(other_ref);
+        }
+        mark_interned(c);
+        s.m_cells.insert(std::make_pair(h, c));
+        return r;
+    }
+
+    /** \brief Remove \c c from the table, it must be invoked before deallocating an interned cell. */
+    void erase(Cell * c, unsigned h) {
+        shard & s = get_shard(h);
+        lock_guard<mutex> lock(s.m_mutex);
+        auto range = s.m_cells.equal_range(h);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == c) {
+                s.m_cells.erase(it);
+                return;
+            }
+        }
+    }
+
+    intern_table_stats get_stats() {
+        intern_table_stats r;
+        for (shard & s : m_shards) {
+            lock_guard<mutex> lock(s.m_mutex);
+            r.m_num_lookups     += s.m_stats.m_num_lookups;
+            r.m_num_hits        += s.m_stats.m_num_hits;
+            r.m_num_bytes_saved += s.m_stats.m_num_bytes_saved;
+            r.m_size            += s.m_cells.size();
+        }
+        return r;
+    }
+};
+}
@@ -0,0 +1,55 @@
+-- Backward chaining on goals whose last applicable lemma has an equational premise, which follows from the
+-- hypotheses by congruence closure. The other lemmas have premises that are not provable. Compare the cc leaf tactic,
+-- which builds a persistent congruence closure on every leaf, with back_chaining.cc, which first checks the
+-- leaves using the array-based congruence closure.
+constants (f : ℕ → ℕ) (g : ℕ → ℕ → ℕ) (p : ℕ → Prop)
+constants q0 q1 q2 q3 q4 q5 q6 q7 q8 q9 q10 q11 q12 q13 q14 q15 q16 q17 q18 q19 q20 q21 q22 q23 q24 q25 q26 q27 q28 q29 : ℕ → ℕ → Prop
+axiom pq0 {a b : ℕ} : q0 a b → p (g a b)
+axiom pq1 {a b : ℕ} : q1 a b → p (g a b)
+axiom pq2 {a b : ℕ} : q2 a b → p (g a b)
+axiom pq3 {a b : ℕ} : q3 a b → p (g a b)
+axiom pq4 {a b : ℕ} : q4 a b → p (g a b)
+axiom pq5 {a b : ℕ} : q5 a b → p (g a b)
+axiom pq6 {a b : ℕ} : q6 a b → p (g a b)
+axiom pq7 {a b : ℕ} : q7 a b → p (g a b)
+axiom pq8 {a b : ℕ} : q8 a b → p (g a b)
+axiom pq9 {a b : ℕ} : q9 a b → p (g a b)
+axiom pq10 {a b : ℕ} : q10 a b → p (g a b)
+axiom pq11 {a b : ℕ} : q11 a b → p (g a b)
+axiom pq12 {a b : ℕ} : q12 a b → p (g a b)
+axiom pq13 {a b : ℕ} : q13 a b → p (g a b)
+axiom pq14 {a b : ℕ} : q14 a b → p (g a b)
+axiom pq15 {a b : ℕ} : q15 a b → p (g a b)
+axiom pq16 {a b : ℕ} : q16 a b → p (g a b)
+axiom pq17 {a b : ℕ} : q17 a b → p (g a b)
+axiom pq18 {a b : ℕ} : q18 a b → p (g a b)
+axiom pq19 {a b : ℕ} : q19 a b → p (g a b)
+axiom pq20 {a b : ℕ} : q20 a b → p (g a b)
+axiom pq21 {a b : ℕ} : q21 a b → p (g a b)
+axiom pq22 {a b : ℕ} : q22 a b → p (g a b)
+axiom pq23 {a b : ℕ} : q23 a b → p (g a b)
+axiom pq24 {a b : ℕ} : q24 a b → p (g a b)
+axiom pq25 {a b : ℕ} : q25 a b → p (g a b)
+axiom pq26 {a b : ℕ} : q26 a b → p (g a b)
+axiom pq27 {a b : ℕ} : q27 a b → p (g a b)
+axiom pq28 {a b : ℕ} : q28 a b → p (g a b)
+axiom pq29 {a b : ℕ} : q29 a b → p (g a b)
+axiom pf {a b : ℕ} : f a = b → p (g a b)
+attribute [intro] pf pq0 pq1 pq2 pq3 pq4 pq5 pq6 pq7 pq8 pq9 pq10 pq11 pq12 pq13 pq14 pq15 pq16 pq17 pq18 pq19 pq20 pq21 pq22 pq23 pq24 pq25 pq26 pq27 pq28 pq29
+open tactic
+
+meta def repeat_tac (t : tactic unit) : nat → tactic unit
+| 0     := skip
+| (n+1) := do s ← read, t, write s, repeat_tac n
+
+meta def bench_back_chaining (n : nat) : tactic unit :=
+do intros,
+   timetac "leaf cc" (repeat_tac (back_chaining_core skip cc []) n),
+   timetac "back_chaining.cc" (repeat_tac (save_options $ set_bool_option `back_chaining.cc tt >> back_chaining) n),
+   back_chaining_core skip cc []
+
+example (a b c d e : ℕ) : a = c → c = d → d = e → f e = b → p (g a b) :=
+by bench_back_chaining 20
+
+example (a b c0 c1 c2 c3 c4 c5 c6 c7 c8 c9 c10 c11 : ℕ) : a = c0 → c0 = c1 → c1 = c2 → c2 = c3 → c3 = c4 → c4 = c5 → c5 = c6 → c6 = c7 → c7 = c8 → c8 = c9 → c9 = c10 → c10 = c11 → f c11 = b → p (g a b) :=
+by bench_back_chaining 20
@@ -0,0 +1,50 @@
+-- Compare the persistent congruence closure (cc_state) with the array-based one (fast_cc_is_eqv)
+-- on equational goals of the cc test corpus (tests/lean/run/cc*.lean).
+-- Each check builds the congruence closure of the hypotheses, and it is repeated n times.
+open tactic
+
+meta def persistent_is_eqv (lhs rhs : expr) : tactic bool :=
+do s ← cc_state.mk_using_hs,
+   s ← s.internalize lhs,
+   s ← s.internalize rhs,
+   s.is_eqv lhs rhs
+
+meta def repeat_check (t : tactic bool) : nat → tactic unit
+| 0     := skip
+| (n+1) := do b ← t, guard b, repeat_check n
+
+meta def bench_cc (n : nat) : tactic unit :=
+do intros,
+   (lhs, rhs) ← target >>= match_eq,
+   timetac "persistent" (repeat_check (persistent_is_eqv lhs rhs) n),
+   timetac "array" (repeat_check (fast_cc_is_eqv lhs rhs) n),
+   cc
+
+example (a b : nat) (f : nat → nat) : a = b → f a = f b :=
+by bench_cc 1000
+
+example (a₁ a₂ b₁ b₂ c d : nat) :
+        a₁ = c → a₂ = c →
+        b₁ = d → d  = b₂ →
+        a₁ + b₁ + a₁ = a₂ + b₂ + c :=
+by bench_cc 1000
+
+example (a b c a' b' c' : nat) : a = a' → b = b' → c = c' → a + b + c + a = a' + b' + c' + a' :=
+by bench_cc 1000
+
+example (f g : Π {α : Type}, α → α → α) (h : nat → nat) (a b : nat) :
+        h = f a → h b = f a b :=
+by bench_cc 1000
+
+example (f : nat → nat → nat) (a b c d : nat) :
+        c = d → f a = f b → f a c = f b d :=
+by bench_cc 1000
+
+example (f : nat → nat) (a : nat) :
+        f (f (f a)) = a → f (f (f (f (f a)))) = a → f a = a :=
+by bench_cc 1000
+
+example (p : nat → nat → Prop) (f : nat → nat) (a b c d e : nat) :
+        a = c → b = d → b = c → d = e →
+        f (f (f (f (f (f a))))) = f (f (f (f (f (f e))))) :=
+by bench_cc 1000
@@ -0,0 +1,44 @@
+#!/usr/bin/env bash
+# Type check the standard library from scratch with each of the given lean executables,
+# and print the elapsed time and peak memory usage (maximum resident set size) of each run.
+# Usage: memory.sh lean-executable-path...
+# For instance, to measure the compact expression representation, configure a second build
+# directory with -D COMPACT_EXPR=ON, and run: memory.sh build/release/shell/lean build/compact/shell/lean
+# Additional options for lean can be given in LEAN_BENCH_FLAGS.
+if [ $# -lt 1 ]; then
+    echo "Usage: memory.sh lean-executable-path..."
+    exit 1
+fi
+# Run the given command, and print its elapsed time and peak memory usage.
+# GNU time is used when it is available, otherwise the peak is sampled from /proc/<pid>/status (VmHWM).
+measure() {
+    if [ -x /usr/bin/time ]; then
+        /usr/bin/time -f "-- total: %e s, peak memory: %M KB" "$@"
+        return
+    fi
+    local start end pid status peak=0 v
+    start=$(date +%s.%N)
+    "$@" &
+    pid=$!
+    while kill -0 $pid 2> /dev/null; do
+        v=$(awk '/VmHWM/ {print $2}' /proc/$pid/status 2> /dev/null)
+        [ -n "$v" ] && peak=$v
+        sleep 0.1
+    done
+    wait $pid
+    status=$?
+    end=$(date +%s.%N)
+    echo "-- total: $(awk "BEGIN {printf \"%.2f\", $end - $start}") s, peak memory: $peak KB" >&2
+    return $status
+}
+ulimit -s 8192
+LIBRARY="$(cd "$(dirname "$0")/../../library" && pwd)"
+for LEAN in "$@"; do
+    LEAN="$(cd "$(dirname "$LEAN")" && pwd)/$(basename "$LEAN")"
+    TMP=$(mktemp -d)
+    cp -r "$LIBRARY" "$TMP/library"
+    find "$TMP/library" -name "*.olean" -delete
+    echo "-- $LEAN"
+    (cd "$TMP/library" && LEAN_PATH="$TMP/library" measure "$LEAN" --make -j 1 $LEAN_BENCH_FLAGS > /dev/null) || { rm -rf "$TMP"; exit 1; }
+    rm -rf "$TMP"
+done
@@ -0,0 +1,23 @@
+-- Pure beta-reduction: arithmetic on Church numerals checked by `rfl`.
+def church := Π α : Type, (α → α) → α → α
+
+def church.zero : church := λ α f x, x
+def church.succ (n : church) : church := λ α f x, f (n α f x)
+def church.add (n m : church) : church := λ α f x, n α f (m α f x)
+def church.mul (n m : church) : church := λ α f, n α (m α f)
+def church.pow (n m : church) : church := λ α, m (α → α) (n α)
+def church.of_nat : ℕ → church
+| 0     := church.zero
+| (n+1) := church.succ (church.of_nat n)
+
+def church.to_nat (n : church) : ℕ := n ℕ nat.succ 0
+
+def c2  : church := church.succ (church.succ church.zero)
+def c3  : church := church.succ c2
+def c10 : church := church.add (church.mul c3 c3) (church.succ church.zero)
+
+example : church.to_nat (church.pow c2 (church.of_nat 16)) = church.to_nat (church.mul (church.pow c2 (church.of_nat 8)) (church.pow c2 (church.of_nat 8))) := rfl
+example : church.to_nat (church.mul c10 (church.mul c10 c10)) = church.to_nat (church.pow c10 c3) := rfl
+example : church.to_nat (church.pow c3 (church.succ (church.succ c3))) = church.to_nat (church.mul (church.pow c3 c2) (church.pow c3 c3)) := rfl
+
+#reduce church.to_nat (church.mul c10 c10)
@@ -0,0 +1,7 @@
+-- Iota- and delta-heavy kernel reduction: decision procedures evaluated by `dec_trivial`.
+example : 12 * 12 = 144 := dec_trivial
+example : (list.range 40).length = 40 := dec_trivial
+example : list.sum (list.range 30) = 435 := dec_trivial
+example : list.map nat.succ (list.reverse (list.range 25)) = list.iota 25 := dec_trivial
+example : list.repeat 1 50 ≠ list.repeat 1 49 := dec_trivial
+example : 1000 ≠ 999 := dec_trivial
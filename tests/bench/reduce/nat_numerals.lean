@@ -0,0 +1,17 @@
+-- Closed numeral arithmetic checked by the kernel (compare with LEAN_BENCH_FLAGS=--nat-ext).
+-- The declarations are added using add_decl, so that the elaborator does not reduce them.
+open tactic
+
+meta def kernel_rfl (n : name) (type val : pexpr) : tactic unit :=
+do t ← to_expr type, v ← to_expr val,
+   add_decl (declaration.defn n [] t v reducibility_hints.opaque tt)
+
+run_cmd kernel_rfl `nat_numerals.mul1 ``((123:ℕ) * 45 = 5535) ``(@eq.refl ℕ 5535)
+run_cmd kernel_rfl `nat_numerals.sub1 ``((2000:ℕ) - 1999 = 1) ``(@eq.refl ℕ 1)
+run_cmd kernel_rfl `nat_numerals.mul2 ``((99:ℕ) * 99 = 9801) ``(@eq.refl ℕ 9801)
+run_cmd kernel_rfl `nat_numerals.sub2 ``((3000:ℕ) - 2999 * 1 = 1) ``(@eq.refl ℕ 1)
+run_cmd kernel_rfl `nat_numerals.add1 ``((1234:ℕ) + 4321 = 5555) ``(@eq.refl ℕ 5555)
+
+example : 1000 ≠ 999 := dec_trivial
+example : 999 < 1000 := dec_trivial
+example : 12 * 12 ≤ 144 := dec_trivial
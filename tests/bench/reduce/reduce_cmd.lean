@@ -0,0 +1,14 @@
+-- Strong normalization with #reduce.
+def fib : ℕ → ℕ
+| 0     := 0
+| 1     := 1
+| (n+2) := fib n + fib (n+1)
+
+def compose_n {α : Type} (f : α → α) : ℕ → α → α
+| 0     := id
+| (n+1) := f ∘ compose_n n
+
+#reduce fib 12
+#reduce list.map (λ x, x * 2) (list.range 15)
+#reduce (compose_n (λ l : list ℕ, 0 :: l) 50) []
+#reduce λ n : ℕ, compose_n nat.succ 30 n
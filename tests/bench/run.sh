@@ -0,0 +1,22 @@
+#!/usr/bin/env bash
+# Run the benchmarks in the given directories (e.g. vm) and print the timing of each file.
+# Usage: run.sh [lean-executable-path] dir...
+# Additional options for lean can be given in LEAN_BENCH_FLAGS, e.g., to compare the kernel reduction
+# engines on the reduce benchmarks: LEAN_BENCH_FLAGS=--krivine run.sh lean reduce
+# (or LEAN_BENCH_FLAGS=--nat-ext for the kernel nat numeral evaluation)
+if [ $# -lt 2 ]; then
+    echo "Usage: run.sh [lean-executable-path] dir..."
+    exit 1
+fi
+ulimit -s 8192
+LEAN=$1
+shift
+export LEAN_PATH=../../library:.
+cd "$(dirname "$0")"
+for d in "$@"; do
+    for f in "$d"/*.lean; do
+        echo "-- $f"
+        TIMEFORMAT="-- total: %R s"
+        time "$LEAN" -j 0 $LEAN_BENCH_FLAGS "$f" || exit 1
+    done
+done
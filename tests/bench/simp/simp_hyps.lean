@@ -0,0 +1,154 @@
+-- simp invocations with local hypotheses: every `simp [h]` adds lemmas to the default simp set,
+-- so the discrimination tree index has to be updated for each of them.
+constants (f g : ℕ → ℕ) (p : ℕ → Prop)
+
+example (a b : ℕ) (h : f (a + 1) = g b) : f (a + 1) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 2) (h₂ : p (f 2)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 3 = 0) : (f 3 :: xs).length = xs.length + 1 + f 3 := by simp [h]
+example (a b : ℕ) (h : f (a + 4) = g b) : f (a + 4) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 5) (h₂ : p (f 5)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 6 = 0) : (f 6 :: xs).length = xs.length + 1 + f 6 := by simp [h]
+example (a b : ℕ) (h : f (a + 7) = g b) : f (a + 7) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 8) (h₂ : p (f 8)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 9 = 0) : (f 9 :: xs).length = xs.length + 1 + f 9 := by simp [h]
+example (a b : ℕ) (h : f (a + 10) = g b) : f (a + 10) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 11) (h₂ : p (f 11)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 12 = 0) : (f 12 :: xs).length = xs.length + 1 + f 12 := by simp [h]
+example (a b : ℕ) (h : f (a + 13) = g b) : f (a + 13) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 14) (h₂ : p (f 14)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 15 = 0) : (f 15 :: xs).length = xs.length + 1 + f 15 := by simp [h]
+example (a b : ℕ) (h : f (a + 16) = g b) : f (a + 16) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 17) (h₂ : p (f 17)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 18 = 0) : (f 18 :: xs).length = xs.length + 1 + f 18 := by simp [h]
+example (a b : ℕ) (h : f (a + 19) = g b) : f (a + 19) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 20) (h₂ : p (f 20)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 21 = 0) : (f 21 :: xs).length = xs.length + 1 + f 21 := by simp [h]
+example (a b : ℕ) (h : f (a + 22) = g b) : f (a + 22) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 23) (h₂ : p (f 23)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 24 = 0) : (f 24 :: xs).length = xs.length + 1 + f 24 := by simp [h]
+example (a b : ℕ) (h : f (a + 25) = g b) : f (a + 25) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 26) (h₂ : p (f 26)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 27 = 0) : (f 27 :: xs).length = xs.length + 1 + f 27 := by simp [h]
+example (a b : ℕ) (h : f (a + 28) = g b) : f (a + 28) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 29) (h₂ : p (f 29)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 30 = 0) : (f 30 :: xs).length = xs.length + 1 + f 30 := by simp [h]
+example (a b : ℕ) (h : f (a + 31) = g b) : f (a + 31) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 32) (h₂ : p (f 32)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 33 = 0) : (f 33 :: xs).length = xs.length + 1 + f 33 := by simp [h]
+example (a b : ℕ) (h : f (a + 34) = g b) : f (a + 34) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 35) (h₂ : p (f 35)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 36 = 0) : (f 36 :: xs).length = xs.length + 1 + f 36 := by simp [h]
+example (a b : ℕ) (h : f (a + 37) = g b) : f (a + 37) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 38) (h₂ : p (f 38)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 39 = 0) : (f 39 :: xs).length = xs.length + 1 + f 39 := by simp [h]
+example (a b : ℕ) (h : f (a + 40) = g b) : f (a + 40) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 41) (h₂ : p (f 41)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 42 = 0) : (f 42 :: xs).length = xs.length + 1 + f 42 := by simp [h]
+example (a b : ℕ) (h : f (a + 43) = g b) : f (a + 43) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 44) (h₂ : p (f 44)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 45 = 0) : (f 45 :: xs).length = xs.length + 1 + f 45 := by simp [h]
+example (a b : ℕ) (h : f (a + 46) = g b) : f (a + 46) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 47) (h₂ : p (f 47)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 48 = 0) : (f 48 :: xs).length = xs.length + 1 + f 48 := by simp [h]
+example (a b : ℕ) (h : f (a + 49) = g b) : f (a + 49) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 50) (h₂ : p (f 50)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 51 = 0) : (f 51 :: xs).length = xs.length + 1 + f 51 := by simp [h]
+example (a b : ℕ) (h : f (a + 52) = g b) : f (a + 52) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 53) (h₂ : p (f 53)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 54 = 0) : (f 54 :: xs).length = xs.length + 1 + f 54 := by simp [h]
+example (a b : ℕ) (h : f (a + 55) = g b) : f (a + 55) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 56) (h₂ : p (f 56)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 57 = 0) : (f 57 :: xs).length = xs.length + 1 + f 57 := by simp [h]
+example (a b : ℕ) (h : f (a + 58) = g b) : f (a + 58) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 59) (h₂ : p (f 59)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 60 = 0) : (f 60 :: xs).length = xs.length + 1 + f 60 := by simp [h]
+example (a b : ℕ) (h : f (a + 61) = g b) : f (a + 61) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 62) (h₂ : p (f 62)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 63 = 0) : (f 63 :: xs).length = xs.length + 1 + f 63 := by simp [h]
+example (a b : ℕ) (h : f (a + 64) = g b) : f (a + 64) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 65) (h₂ : p (f 65)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 66 = 0) : (f 66 :: xs).length = xs.length + 1 + f 66 := by simp [h]
+example (a b : ℕ) (h : f (a + 67) = g b) : f (a + 67) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 68) (h₂ : p (f 68)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 69 = 0) : (f 69 :: xs).length = xs.length + 1 + f 69 := by simp [h]
+example (a b : ℕ) (h : f (a + 70) = g b) : f (a + 70) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 71) (h₂ : p (f 71)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 72 = 0) : (f 72 :: xs).length = xs.length + 1 + f 72 := by simp [h]
+example (a b : ℕ) (h : f (a + 73) = g b) : f (a + 73) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 74) (h₂ : p (f 74)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 75 = 0) : (f 75 :: xs).length = xs.length + 1 + f 75 := by simp [h]
+example (a b : ℕ) (h : f (a + 76) = g b) : f (a + 76) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 77) (h₂ : p (f 77)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 78 = 0) : (f 78 :: xs).length = xs.length + 1 + f 78 := by simp [h]
+example (a b : ℕ) (h : f (a + 79) = g b) : f (a + 79) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 80) (h₂ : p (f 80)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 81 = 0) : (f 81 :: xs).length = xs.length + 1 + f 81 := by simp [h]
+example (a b : ℕ) (h : f (a + 82) = g b) : f (a + 82) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 83) (h₂ : p (f 83)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 84 = 0) : (f 84 :: xs).length = xs.length + 1 + f 84 := by simp [h]
+example (a b : ℕ) (h : f (a + 85) = g b) : f (a + 85) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 86) (h₂ : p (f 86)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 87 = 0) : (f 87 :: xs).length = xs.length + 1 + f 87 := by simp [h]
+example (a b : ℕ) (h : f (a + 88) = g b) : f (a + 88) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 89) (h₂ : p (f 89)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 90 = 0) : (f 90 :: xs).length = xs.length + 1 + f 90 := by simp [h]
+example (a b : ℕ) (h : f (a + 91) = g b) : f (a + 91) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 92) (h₂ : p (f 92)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 93 = 0) : (f 93 :: xs).length = xs.length + 1 + f 93 := by simp [h]
+example (a b : ℕ) (h : f (a + 94) = g b) : f (a + 94) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 95) (h₂ : p (f 95)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 96 = 0) : (f 96 :: xs).length = xs.length + 1 + f 96 := by simp [h]
+example (a b : ℕ) (h : f (a + 97) = g b) : f (a + 97) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 98) (h₂ : p (f 98)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 99 = 0) : (f 99 :: xs).length = xs.length + 1 + f 99 := by simp [h]
+example (a b : ℕ) (h : f (a + 100) = g b) : f (a + 100) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 101) (h₂ : p (f 101)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 102 = 0) : (f 102 :: xs).length = xs.length + 1 + f 102 := by simp [h]
+example (a b : ℕ) (h : f (a + 103) = g b) : f (a + 103) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 104) (h₂ : p (f 104)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 105 = 0) : (f 105 :: xs).length = xs.length + 1 + f 105 := by simp [h]
+example (a b : ℕ) (h : f (a + 106) = g b) : f (a + 106) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 107) (h₂ : p (f 107)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 108 = 0) : (f 108 :: xs).length = xs.length + 1 + f 108 := by simp [h]
+example (a b : ℕ) (h : f (a + 109) = g b) : f (a + 109) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 110) (h₂ : p (f 110)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 111 = 0) : (f 111 :: xs).length = xs.length + 1 + f 111 := by simp [h]
+example (a b : ℕ) (h : f (a + 112) = g b) : f (a + 112) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 113) (h₂ : p (f 113)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 114 = 0) : (f 114 :: xs).length = xs.length + 1 + f 114 := by simp [h]
+example (a b : ℕ) (h : f (a + 115) = g b) : f (a + 115) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 116) (h₂ : p (f 116)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 117 = 0) : (f 117 :: xs).length = xs.length + 1 + f 117 := by simp [h]
+example (a b : ℕ) (h : f (a + 118) = g b) : f (a + 118) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 119) (h₂ : p (f 119)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 120 = 0) : (f 120 :: xs).length = xs.length + 1 + f 120 := by simp [h]
+example (a b : ℕ) (h : f (a + 121) = g b) : f (a + 121) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 122) (h₂ : p (f 122)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 123 = 0) : (f 123 :: xs).length = xs.length + 1 + f 123 := by simp [h]
+example (a b : ℕ) (h : f (a + 124) = g b) : f (a + 124) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 125) (h₂ : p (f 125)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 126 = 0) : (f 126 :: xs).length = xs.length + 1 + f 126 := by simp [h]
+example (a b : ℕ) (h : f (a + 127) = g b) : f (a + 127) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 128) (h₂ : p (f 128)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 129 = 0) : (f 129 :: xs).length = xs.length + 1 + f 129 := by simp [h]
+example (a b : ℕ) (h : f (a + 130) = g b) : f (a + 130) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 131) (h₂ : p (f 131)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 132 = 0) : (f 132 :: xs).length = xs.length + 1 + f 132 := by simp [h]
+example (a b : ℕ) (h : f (a + 133) = g b) : f (a + 133) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 134) (h₂ : p (f 134)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 135 = 0) : (f 135 :: xs).length = xs.length + 1 + f 135 := by simp [h]
+example (a b : ℕ) (h : f (a + 136) = g b) : f (a + 136) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 137) (h₂ : p (f 137)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 138 = 0) : (f 138 :: xs).length = xs.length + 1 + f 138 := by simp [h]
+example (a b : ℕ) (h : f (a + 139) = g b) : f (a + 139) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 140) (h₂ : p (f 140)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 141 = 0) : (f 141 :: xs).length = xs.length + 1 + f 141 := by simp [h]
+example (a b : ℕ) (h : f (a + 142) = g b) : f (a + 142) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 143) (h₂ : p (f 143)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 144 = 0) : (f 144 :: xs).length = xs.length + 1 + f 144 := by simp [h]
+example (a b : ℕ) (h : f (a + 145) = g b) : f (a + 145) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 146) (h₂ : p (f 146)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 147 = 0) : (f 147 :: xs).length = xs.length + 1 + f 147 := by simp [h]
+example (a b : ℕ) (h : f (a + 148) = g b) : f (a + 148) + 0 = g b * 1 := by simp [h]
+example (a b : ℕ) (h₁ : g a = 149) (h₂ : p (f 149)) : p (f (g a)) := by simp [h₁, h₂]
+example (xs : list ℕ) (h : f 150 = 0) : (f 150 :: xs).length = xs.length + 1 + f 150 := by simp [h]
@@ -0,0 +1,166 @@
+-- E-matching with many lemmas whose patterns have the same head symbol, (f (gᵢ ?x) ?y), on goals containing
+-- many terms (f a b). Only one of the terms has an argument equal to an application of some gᵢ, so almost all
+-- (lemma, term) pairs fail. Compare with -D ematch.filter=false, where they are rejected by process_match.
+constant f : ℕ → ℕ → ℕ
+constants g0 g1 g2 g3 g4 g5 g6 g7 g8 g9 g10 g11 g12 g13 g14 g15 g16 g17 g18 g19 g20 g21 g22 g23 g24 g25 g26 g27 g28 g29 g30 g31 g32 g33 g34 g35 g36 g37 g38 g39 g40 g41 g42 g43 g44 g45 g46 g47 g48 g49 g50 g51 g52 g53 g54 g55 g56 g57 g58 g59 g60 g61 g62 g63 g64 g65 g66 g67 g68 g69 g70 g71 g72 g73 g74 g75 g76 g77 g78 g79 g80 g81 g82 g83 g84 g85 g86 g87 g88 g89 g90 g91 g92 g93 g94 g95 g96 g97 g98 g99 g100 g101 g102 g103 g104 g105 g106 g107 g108 g109 g110 g111 g112 g113 g114 g115 g116 g117 g118 g119 : ℕ → ℕ
+axiom fg0 : ∀ x y, (: f (g0 x) y :) = x + 0
+axiom fg1 : ∀ x y, (: f (g1 x) y :) = x + 1
+axiom fg2 : ∀ x y, (: f (g2 x) y :) = x + 2
+axiom fg3 : ∀ x y, (: f (g3 x) y :) = x + 3
+axiom fg4 : ∀ x y, (: f (g4 x) y :) = x + 4
+axiom fg5 : ∀ x y, (: f (g5 x) y :) = x + 5
+axiom fg6 : ∀ x y, (: f (g6 x) y :) = x + 6
+axiom fg7 : ∀ x y, (: f (g7 x) y :) = x + 7
+axiom fg8 : ∀ x y, (: f (g8 x) y :) = x + 8
+axiom fg9 : ∀ x y, (: f (g9 x) y :) = x + 9
+axiom fg10 : ∀ x y, (: f (g10 x) y :) = x + 10
+axiom fg11 : ∀ x y, (: f (g11 x) y :) = x + 11
+axiom fg12 : ∀ x y, (: f (g12 x) y :) = x + 12
+axiom fg13 : ∀ x y, (: f (g13 x) y :) = x + 13
+axiom fg14 : ∀ x y, (: f (g14 x) y :) = x + 14
+axiom fg15 : ∀ x y, (: f (g15 x) y :) = x + 15
+axiom fg16 : ∀ x y, (: f (g16 x) y :) = x + 16
+axiom fg17 : ∀ x y, (: f (g17 x) y :) = x + 17
+axiom fg18 : ∀ x y, (: f (g18 x) y :) = x + 18
+axiom fg19 : ∀ x y, (: f (g19 x) y :) = x + 19
+axiom fg20 : ∀ x y, (: f (g20 x) y :) = x + 20
+axiom fg21 : ∀ x y, (: f (g21 x) y :) = x + 21
+axiom fg22 : ∀ x y, (: f (g22 x) y :) = x + 22
+axiom fg23 : ∀ x y, (: f (g23 x) y :) = x + 23
+axiom fg24 : ∀ x y, (: f (g24 x) y :) = x + 24
+axiom fg25 : ∀ x y, (: f (g25 x) y :) = x + 25
+axiom fg26 : ∀ x y, (: f (g26 x) y :) = x + 26
+axiom fg27 : ∀ x y, (: f (g27 x) y :) = x + 27
+axiom fg28 : ∀ x y, (: f (g28 x) y :) = x + 28
+axiom fg29 : ∀ x y, (: f (g29 x) y :) = x + 29
+axiom fg30 : ∀ x y, (: f (g30 x) y :) = x + 30
+axiom fg31 : ∀ x y, (: f (g31 x) y :) = x + 31
+axiom fg32 : ∀ x y, (: f (g32 x) y :) = x + 32
+axiom fg33 : ∀ x y, (: f (g33 x) y :) = x + 33
+axiom fg34 : ∀ x y, (: f (g34 x) y :) = x + 34
+axiom fg35 : ∀ x y, (: f (g35 x) y :) = x + 35
+axiom fg36 : ∀ x y, (: f (g36 x) y :) = x + 36
+axiom fg37 : ∀ x y, (: f (g37 x) y :) = x + 37
+axiom fg38 : ∀ x y, (: f (g38 x) y :) = x + 38
+axiom fg39 : ∀ x y, (: f (g39 x) y :) = x + 39
+axiom fg40 : ∀ x y, (: f (g40 x) y :) = x + 40
+axiom fg41 : ∀ x y, (: f (g41 x) y :) = x + 41
+axiom fg42 : ∀ x y, (: f (g42 x) y :) = x + 42
+axiom fg43 : ∀ x y, (: f (g43 x) y :) = x + 43
+axiom fg44 : ∀ x y, (: f (g44 x) y :) = x + 44
+axiom fg45 : ∀ x y, (: f (g45 x) y :) = x + 45
+axiom fg46 : ∀ x y, (: f (g46 x) y :) = x + 46
+axiom fg47 : ∀ x y, (: f (g47 x) y :) = x + 47
+axiom fg48 : ∀ x y, (: f (g48 x) y :) = x + 48
+axiom fg49 : ∀ x y, (: f (g49 x) y :) = x + 49
+axiom fg50 : ∀ x y, (: f (g50 x) y :) = x + 50
+axiom fg51 : ∀ x y, (: f (g51 x) y :) = x + 51
+axiom fg52 : ∀ x y, (: f (g52 x) y :) = x + 52
+axiom fg53 : ∀ x y, (: f (g53 x) y :) = x + 53
+axiom fg54 : ∀ x y, (: f (g54 x) y :) = x + 54
+axiom fg55 : ∀ x y, (: f (g55 x) y :) = x + 55
+axiom fg56 : ∀ x y, (: f (g56 x) y :) = x + 56
+axiom fg57 : ∀ x y, (: f (g57 x) y :) = x + 57
+axiom fg58 : ∀ x y, (: f (g58 x) y :) = x + 58
+axiom fg59 : ∀ x y, (: f (g59 x) y :) = x + 59
+axiom fg60 : ∀ x y, (: f (g60 x) y :) = x + 60
+axiom fg61 : ∀ x y, (: f (g61 x) y :) = x + 61
+axiom fg62 : ∀ x y, (: f (g62 x) y :) = x + 62
+axiom fg63 : ∀ x y, (: f (g63 x) y :) = x + 63
+axiom fg64 : ∀ x y, (: f (g64 x) y :) = x + 64
+axiom fg65 : ∀ x y, (: f (g65 x) y :) = x + 65
+axiom fg66 : ∀ x y, (: f (g66 x) y :) = x + 66
+axiom fg67 : ∀ x y, (: f (g67 x) y :) = x + 67
+axiom fg68 : ∀ x y, (: f (g68 x) y :) = x + 68
+axiom fg69 : ∀ x y, (: f (g69 x) y :) = x + 69
+axiom fg70 : ∀ x y, (: f (g70 x) y :) = x + 70
+axiom fg71 : ∀ x y, (: f (g71 x) y :) = x + 71
+axiom fg72 : ∀ x y, (: f (g72 x) y :) = x + 72
+axiom fg73 : ∀ x y, (: f (g73 x) y :) = x + 73
+axiom fg74 : ∀ x y, (: f (g74 x) y :) = x + 74
+axiom fg75 : ∀ x y, (: f (g75 x) y :) = x + 75
+axiom fg76 : ∀ x y, (: f (g76 x) y :) = x + 76
+axiom fg77 : ∀ x y, (: f (g77 x) y :) = x + 77
+axiom fg78 : ∀ x y, (: f (g78 x) y :) = x + 78
+axiom fg79 : ∀ x y, (: f (g79 x) y :) = x + 79
+axiom fg80 : ∀ x y, (: f (g80 x) y :) = x + 80
+axiom fg81 : ∀ x y, (: f (g81 x) y :) = x + 81
+axiom fg82 : ∀ x y, (: f (g82 x) y :) = x + 82
+axiom fg83 : ∀ x y, (: f (g83 x) y :) = x + 83
+axiom fg84 : ∀ x y, (: f (g84 x) y :) = x + 84
+axiom fg85 : ∀ x y, (: f (g85 x) y :) = x + 85
+axiom fg86 : ∀ x y, (: f (g86 x) y :) = x + 86
+axiom fg87 : ∀ x y, (: f (g87 x) y :) = x + 87
+axiom fg88 : ∀ x y, (: f (g88 x) y :) = x + 88
+axiom fg89 : ∀ x y, (: f (g89 x) y :) = x + 89
+axiom fg90 : ∀ x y, (: f (g90 x) y :) = x + 90
+axiom fg91 : ∀ x y, (: f (g91 x) y :) = x + 91
+axiom fg92 : ∀ x y, (: f (g92 x) y :) = x + 92
+axiom fg93 : ∀ x y, (: f (g93 x) y :) = x + 93
+axiom fg94 : ∀ x y, (: f (g94 x) y :) = x + 94
+axiom fg95 : ∀ x y, (: f (g95 x) y :) = x + 95
+axiom fg96 : ∀ x y, (: f (g96 x) y :) = x + 96
+axiom fg97 : ∀ x y, (: f (g97 x) y :) = x + 97
+axiom fg98 : ∀ x y, (: f (g98 x) y :) = x + 98
+axiom fg99 : ∀ x y, (: f (g99 x) y :) = x + 99
+axiom fg100 : ∀ x y, (: f (g100 x) y :) = x + 100
+axiom fg101 : ∀ x y, (: f (g101 x) y :) = x + 101
+axiom fg102 : ∀ x y, (: f (g102 x) y :) = x + 102
+axiom fg103 : ∀ x y, (: f (g103 x) y :) = x + 103
+axiom fg104 : ∀ x y, (: f (g104 x) y :) = x + 104
+axiom fg105 : ∀ x y, (: f (g105 x) y :) = x + 105
+axiom fg106 : ∀ x y, (: f (g106 x) y :) = x + 106
+axiom fg107 : ∀ x y, (: f (g107 x) y :) = x + 107
+axiom fg108 : ∀ x y, (: f (g108 x) y :) = x + 108
+axiom fg109 : ∀ x y, (: f (g109 x) y :) = x + 109
+axiom fg110 : ∀ x y, (: f (g110 x) y :) = x + 110
+axiom fg111 : ∀ x y, (: f (g111 x) y :) = x + 111
+axiom fg112 : ∀ x y, (: f (g112 x) y :) = x + 112
+axiom fg113 : ∀ x y, (: f (g113 x) y :) = x + 113
+axiom fg114 : ∀ x y, (: f (g114 x) y :) = x + 114
+axiom fg115 : ∀ x y, (: f (g115 x) y :) = x + 115
+axiom fg116 : ∀ x y, (: f (g116 x) y :) = x + 116
+axiom fg117 : ∀ x y, (: f (g117 x) y :) = x + 117
+axiom fg118 : ∀ x y, (: f (g118 x) y :) = x + 118
+axiom fg119 : ∀ x y, (: f (g119 x) y :) = x + 119
+
+example (x0 y0 x1 y1 x2 y2 x3 y3 x4 y4 x5 y5 x6 y6 x7 y7 x8 y8 x9 y9 x10 y10 x11 y11 x12 y12 x13 y13 x14 y14 x15 y15 x16 y16 x17 y17 x18 y18 x19 y19 x20 y20 x21 y21 x22 y22 x23 y23 x24 y24 x25 y25 x26 y26 x27 y27 x28 y28 x29 y29 x30 y30 x31 y31 x32 y32 x33 y33 x34 y34 x35 y35 x36 y36 x37 y37 x38 y38 x39 y39 x40 y40 x41 y41 x42 y42 x43 y43 x44 y44 x45 y45 x46 y46 x47 y47 x48 y48 x49 y49 x50 y50 x51 y51 x52 y52 x53 y53 x54 y54 x55 y55 x56 y56 x57 y57 x58 y58 x59 y59 x60 y60 x61 y61 x62 y62 x63 y63 x64 y64 x65 y65 x66 y66 x67 y67 x68 y68 x69 y69 x70 y70 x71 y71 x72 y72 x73 y73 x74 y74 x75 y75 x76 y76 x77 y77 x78 y78 x79 y79 c : ℕ) (h0 : f x0 y0 = f y0 x0) (h1 : f x1 y1 = f y1 x1) (h2 : f x2 y2 = f y2 x2) (h3 : f x3 y3 = f y3 x3) (h4 : f x4 y4 = f y4 x4) (h5 : f x5 y5 = f y5 x5) (h6 : f x6 y6 = f y6 x6) (h7 : f x7 y7 = f y7 x7) (h8 : f x8 y8 = f y8 x8) (h9 : f x9 y9 = f y9 x9) (h10 : f x10 y10 = f y10 x10) (h11 : f x11 y11 = f y11 x11) (h12 : f x12 y12 = f y12 x12) (h13 : f x13 y13 = f y13 x13) (h14 : f x14 y14 = f y14 x14) (h15 : f x15 y15 = f y15 x15) (h16 : f x16 y16 = f y16 x16) (h17 : f x17 y17 = f y17 x17) (h18 : f x18 y18 = f y18 x18) (h19 : f x19 y19 = f y19 x19) (h20 : f x20 y20 = f y20 x20) (h21 : f x21 y21 = f y21 x21) (h22 : f x22 y22 = f y22 x22) (h23 : f x23 y23 = f y23 x23) (h24 : f x24 y24 = f y24 x24) (h25 : f x25 y25 = f y25 x25) (h26 : f x26 y26 = f y26 x26) (h27 : f x27 y27 = f y27 x27) (h28 : f x28 y28 = f y28 x28) (h29 : f x29 y29 = f y29 x29) (h30 : f x30 y30 = f y30 x30) (h31 : f x31 y31 = f y31 x31) (h32 : f x32 y32 = f y32 x32) (h33 : f x33 y33 = f y33 x33) (h34 : f x34 y34 = f y34 x34) (h35 : f x35 y35 = f y35 x35) (h36 : f x36 y36 = f y36 x36) (h37 : f x37 y37 = f y37 x37) (h38 : f x38 y38 = f y38 x38) (h39 : f x39 y39 = f y39 x39) (h40 : f x40 y40 = f y40 x40) (h41 : f x41 y41 = f y41 x41) (h42 : f x42 y42 = f y42 x42) (h43 : f x43 y43 = f y43 x43) (h44 : f x44 y44 = f y44 x44) (h45 : f x45 y45 = f y45 x45) (h46 : f x46 y46 = f y46 x46) (h47 : f x47 y47 = f y47 x47) (h48 : f x48 y48 = f y48 x48) (h49 : f x49 y49 = f y49 x49) (h50 : f x50 y50 = f y50 x50) (h51 : f x51 y51 = f y51 x51) (h52 : f x52 y52 = f y52 x52) (h53 : f x53 y53 = f y53 x53) (h54 : f x54 y54 = f y54 x54) (h55 : f x55 y55 = f y55 x55) (h56 : f x56 y56 = f y56 x56) (h57 : f x57 y57 = f y57 x57) (h58 : f x58 y58 = f y58 x58) (h59 : f x59 y59 = f y59 x59) (h60 : f x60 y60 = f y60 x60) (h61 : f x61 y61 = f y61 x61) (h62 : f x62 y62 = f y62 x62) (h63 : f x63 y63 = f y63 x63) (h64 : f x64 y64 = f y64 x64) (h65 : f x65 y65 = f y65 x65) (h66 : f x66 y66 = f y66 x66) (h67 : f x67 y67 = f y67 x67) (h68 : f x68 y68 = f y68 x68) (h69 : f x69 y69 = f y69 x69) (h70 : f x70 y70 = f y70 x70) (h71 : f x71 y71 = f y71 x71) (h72 : f x72 y72 = f y72 x72) (h73 : f x73 y73 = f y73 x73) (h74 : f x74 y74 = f y74 x74) (h75 : f x75 y75 = f y75 x75) (h76 : f x76 y76 = f y76 x76) (h77 : f x77 y77 = f y77 x77) (h78 : f x78 y78 = f y78 x78) (h79 : f x79 y79 = f y79 x79) (e : x0 = g0 c) : f x0 y0 = c + 0 :=
+begin [smt]
+  ematch_using [fg0, fg1, fg2, fg3, fg4, fg5, fg6, fg7, fg8, fg9, fg10, fg11, fg12, fg13, fg14, fg15, fg16, fg17, fg18, fg19, fg20, fg21, fg22, fg23, fg24, fg25, fg26, fg27, fg28, fg29, fg30, fg31, fg32, fg33, fg34, fg35, fg36, fg37, fg38, fg39, fg40, fg41, fg42, fg43, fg44, fg45, fg46, fg47, fg48, fg49, fg50, fg51, fg52, fg53, fg54, fg55, fg56, fg57, fg58, fg59, fg60, fg61, fg62, fg63, fg64, fg65, fg66, fg67, fg68, fg69, fg70, fg71, fg72, fg73, fg74, fg75, fg76, fg77, fg78, fg79, fg80, fg81, fg82, fg83, fg84, fg85, fg86, fg87, fg88, fg89, fg90, fg91, fg92, fg93, fg94, fg95, fg96, fg97, fg98, fg99, fg100, fg101, fg102, fg103, fg104, fg105, fg106, fg107, fg108, fg109, fg110, fg111, fg112, fg113, fg114, fg115, fg116, fg117, fg118, fg119]
+end
+example (x0 y0 x1 y1 x2 y2 x3 y3 x4 y4 x5 y5 x6 y6 x7 y7 x8 y8 x9 y9 x10 y10 x11 y11 x12 y12 x13 y13 x14 y14 x15 y15 x16 y16 x17 y17 x18 y18 x19 y19 x20 y20 x21 y21 x22 y22 x23 y23 x24 y24 x25 y25 x26 y26 x27 y27 x28 y28 x29 y29 x30 y30 x31 y31 x32 y32 x33 y33 x34 y34 x35 y35 x36 y36 x37 y37 x38 y38 x39 y39 x40 y40 x41 y41 x42 y42 x43 y43 x44 y44 x45 y45 x46 y46 x47 y47 x48 y48 x49 y49 x50 y50 x51 y51 x52 y52 x53 y53 x54 y54 x55 y55 x56 y56 x57 y57 x58 y58 x59 y59 x60 y60 x61 y61 x62 y62 x63 y63 x64 y64 x65 y65 x66 y66 x67 y67 x68 y68 x69 y69 x70 y70 x71 y71 x72 y72 x73 y73 x74 y74 x75 y75 x76 y76 x77 y77 x78 y78 x79 y79 c : ℕ) (h0 : f x0 y0 = f y0 x0) (h1 : f x1 y1 = f y1 x1) (h2 : f x2 y2 = f y2 x2) (h3 : f x3 y3 = f y3 x3) (h4 : f x4 y4 = f y4 x4) (h5 : f x5 y5 = f y5 x5) (h6 : f x6 y6 = f y6 x6) (h7 : f x7 y7 = f y7 x7) (h8 : f x8 y8 = f y8 x8) (h9 : f x9 y9 = f y9 x9) (h10 : f x10 y10 = f y10 x10) (h11 : f x11 y11 = f y11 x11) (h12 : f x12 y12 = f y12 x12) (h13 : f x13 y13 = f y13 x13) (h14 : f x14 y14 = f y14 x14) (h15 : f x15 y15 = f y15 x15) (h16 : f x16 y16 = f y16 x16) (h17 : f x17 y17 = f y17 x17) (h18 : f x18 y18 = f y18 x18) (h19 : f x19 y19 = f y19 x19) (h20 : f x20 y20 = f y20 x20) (h21 : f x21 y21 = f y21 x21) (h22 : f x22 y22 = f y22 x22) (h23 : f x23 y23 = f y23 x23) (h24 : f x24 y24 = f y24 x24) (h25 : f x25 y25 = f y25 x25) (h26 : f x26 y26 = f y26 x26) (h27 : f x27 y27 = f y27 x27) (h28 : f x28 y28 = f y28 x28) (h29 : f x29 y29 = f y29 x29) (h30 : f x30 y30 = f y30 x30) (h31 : f x31 y31 = f y31 x31) (h32 : f x32 y32 = f y32 x32) (h33 : f x33 y33 = f y33 x33) (h34 : f x34 y34 = f y34 x34) (h35 : f x35 y35 = f y35 x35) (h36 : f x36 y36 = f y36 x36) (h37 : f x37 y37 = f y37 x37) (h38 : f x38 y38 = f y38 x38) (h39 : f x39 y39 = f y39 x39) (h40 : f x40 y40 = f y40 x40) (h41 : f x41 y41 = f y41 x41) (h42 : f x42 y42 = f y42 x42) (h43 : f x43 y43 = f y43 x43) (h44 : f x44 y44 = f y44 x44) (h45 : f x45 y45 = f y45 x45) (h46 : f x46 y46 = f y46 x46) (h47 : f x47 y47 = f y47 x47) (h48 : f x48 y48 = f y48 x48) (h49 : f x49 y49 = f y49 x49) (h50 : f x50 y50 = f y50 x50) (h51 : f x51 y51 = f y51 x51) (h52 : f x52 y52 = f y52 x52) (h53 : f x53 y53 = f y53 x53) (h54 : f x54 y54 = f y54 x54) (h55 : f x55 y55 = f y55 x55) (h56 : f x56 y56 = f y56 x56) (h57 : f x57 y57 = f y57 x57) (h58 : f x58 y58 = f y58 x58) (h59 : f x59 y59 = f y59 x59) (h60 : f x60 y60 = f y60 x60) (h61 : f x61 y61 = f y61 x61) (h62 : f x62 y62 = f y62 x62) (h63 : f x63 y63 = f y63 x63) (h64 : f x64 y64 = f y64 x64) (h65 : f x65 y65 = f y65 x65) (h66 : f x66 y66 = f y66 x66) (h67 : f x67 y67 = f y67 x67) (h68 : f x68 y68 = f y68 x68) (h69 : f x69 y69 = f y69 x69) (h70 : f x70 y70 = f y70 x70) (h71 : f x71 y71 = f y71 x71) (h72 : f x72 y72 = f y72 x72) (h73 : f x73 y73 = f y73 x73) (h74 : f x74 y74 = f y74 x74) (h75 : f x75 y75 = f y75 x75) (h76 : f x76 y76 = f y76 x76) (h77 : f x77 y77 = f y77 x77) (h78 : f x78 y78 = f y78 x78) (h79 : f x79 y79 = f y79 x79) (e : x0 = g7 c) : f x0 y0 = c + 7 :=
+begin [smt]
+  ematch_using [fg0, fg1, fg2, fg3, fg4, fg5, fg6, fg7, fg8, fg9, fg10, fg11, fg12, fg13, fg14, fg15, fg16, fg17, fg18, fg19, fg20, fg21, fg22, fg23, fg24, fg25, fg26, fg27, fg28, fg29, fg30, fg31, fg32, fg33, fg34, fg35, fg36, fg37, fg38, fg39, fg40, fg41, fg42, fg43, fg44, fg45, fg46, fg47, fg48, fg49, fg50, fg51, fg52, fg53, fg54, fg55, fg56, fg57, fg58, fg59, fg60, fg61, fg62, fg63, fg64, fg65, fg66, fg67, fg68, fg69, fg70, fg71, fg72, fg73, fg74, fg75, fg76, fg77, fg78, fg79, fg80, fg81, fg82, fg83, fg84, fg85, fg86, fg87, fg88, fg89, fg90, fg91, fg92, fg93, fg94, fg95, fg96, fg97, fg98, fg99, fg100, fg101, fg102, fg103, fg104, fg105, fg106, fg107, fg108, fg109, fg110, fg111, fg112, fg113, fg114, fg115, fg116, fg117, fg118, fg119]
+end
+example (x0 y0 x1 y1 x2 y2 x3 y3 x4 y4 x5 y5 x6 y6 x7 y7 x8 y8 x9 y9 x10 y10 x11 y11 x12 y12 x13 y13 x14 y14 x15 y15 x16 y16 x17 y17 x18 y18 x19 y19 x20 y20 x21 y21 x22 y22 x23 y23 x24 y24 x25 y25 x26 y26 x27 y27 x28 y28 x29 y29 x30 y30 x31 y31 x32 y32 x33 y33 x34 y34 x35 y35 x36 y36 x37 y37 x38 y38 x39 y39 x40 y40 x41 y41 x42 y42 x43 y43 x44 y44 x45 y45 x46 y46 x47 y47 x48 y48 x49 y49 x50 y50 x51 y51 x52 y52 x53 y53 x54 y54 x55 y55 x56 y56 x57 y57 x58 y58 x59 y59 x60 y60 x61 y61 x62 y62 x63 y63 x64 y64 x65 y65 x66 y66 x67 y67 x68 y68 x69 y69 x70 y70 x71 y71 x72 y72 x73 y73 x74 y74 x75 y75 x76 y76 x77 y77 x78 y78 x79 y79 c : ℕ) (h0 : f x0 y0 = f y0 x0) (h1 : f x1 y1 = f y1 x1) (h2 : f x2 y2 = f y2 x2) (h3 : f x3 y3 = f y3 x3) (h4 : f x4 y4 = f y4 x4) (h5 : f x5 y5 = f y5 x5) (h6 : f x6 y6 = f y6 x6) (h7 : f x7 y7 = f y7 x7) (h8 : f x8 y8 = f y8 x8) (h9 : f x9 y9 = f y9 x9) (h10 : f x10 y10 = f y10 x10) (h11 : f x11 y11 = f y11 x11) (h12 : f x12 y12 = f y12 x12) (h13 : f x13 y13 = f y13 x13) (h14 : f x14 y14 = f y14 x14) (h15 : f x15 y15 = f y15 x15) (h16 : f x16 y16 = f y16 x16) (h17 : f x17 y17 = f y17 x17) (h18 : f x18 y18 = f y18 x18) (h19 : f x19 y19 = f y19 x19) (h20 : f x20 y20 = f y20 x20) (h21 : f x21 y21 = f y21 x21) (h22 : f x22 y22 = f y22 x22) (h23 : f x23 y23 = f y23 x23) (h24 : f x24 y24 = f y24 x24) (h25 : f x25 y25 = f y25 x25) (h26 : f x26 y26 = f y26 x26) (h27 : f x27 y27 = f y27 x27) (h28 : f x28 y28 = f y28 x28) (h29 : f x29 y29 = f y29 x29) (h30 : f x30 y30 = f y30 x30) (h31 : f x31 y31 = f y31 x31) (h32 : f x32 y32 = f y32 x32) (h33 : f x33 y33 = f y33 x33) (h34 : f x34 y34 = f y34 x34) (h35 : f x35 y35 = f y35 x35) (h36 : f x36 y36 = f y36 x36) (h37 : f x37 y37 = f y37 x37) (h38 : f x38 y38 = f y38 x38) (h39 : f x39 y39 = f y39 x39) (h40 : f x40 y40 = f y40 x40) (h41 : f x41 y41 = f y41 x41) (h42 : f x42 y42 = f y42 x42) (h43 : f x43 y43 = f y43 x43) (h44 : f x44 y44 = f y44 x44) (h45 : f x45 y45 = f y45 x45) (h46 : f x46 y46 = f y46 x46) (h47 : f x47 y47 = f y47 x47) (h48 : f x48 y48 = f y48 x48) (h49 : f x49 y49 = f y49 x49) (h50 : f x50 y50 = f y50 x50) (h51 : f x51 y51 = f y51 x51) (h52 : f x52 y52 = f y52 x52) (h53 : f x53 y53 = f y53 x53) (h54 : f x54 y54 = f y54 x54) (h55 : f x55 y55 = f y55 x55) (h56 : f x56 y56 = f y56 x56) (h57 : f x57 y57 = f y57 x57) (h58 : f x58 y58 = f y58 x58) (h59 : f x59 y59 = f y59 x59) (h60 : f x60 y60 = f y60 x60) (h61 : f x61 y61 = f y61 x61) (h62 : f x62 y62 = f y62 x62) (h63 : f x63 y63 = f y63 x63) (h64 : f x64 y64 = f y64 x64) (h65 : f x65 y65 = f y65 x65) (h66 : f x66 y66 = f y66 x66) (h67 : f x67 y67 = f y67 x67) (h68 : f x68 y68 = f y68 x68) (h69 : f x69 y69 = f y69 x69) (h70 : f x70 y70 = f y70 x70) (h71 : f x71 y71 = f y71 x71) (h72 : f x72 y72 = f y72 x72) (h73 : f x73 y73 = f y73 x73) (h74 : f x74 y74 = f y74 x74) (h75 : f x75 y75 = f y75 x75) (h76 : f x76 y76 = f y76 x76) (h77 : f x77 y77 = f y77 x77) (h78 : f x78 y78 = f y78 x78) (h79 : f x79 y79 = f y79 x79) (e : x0 = g14 c) : f x0 y0 = c + 14 :=
+begin [smt]
+  ematch_using [fg0, fg1, fg2, fg3, fg4, fg5, fg6, fg7, fg8, fg9, fg10, fg11, fg12, fg13, fg14, fg15, fg16, fg17, fg18, fg19, fg20, fg21, fg22, fg23, fg24, fg25, fg26, fg27, fg28, fg29, fg30, fg31, fg32, fg33, fg34, fg35, fg36, fg37, fg38, fg39, fg40, fg41, fg42, fg43, fg44, fg45, fg46, fg47, fg48, fg49, fg50, fg51, fg52, fg53, fg54, fg55, fg56, fg57, fg58, fg59, fg60, fg61, fg62, fg63, fg64, fg65, fg66, fg67, fg68, fg69, fg70, fg71, fg72, fg73, fg74, fg75, fg76, fg77, fg78, fg79, fg80, fg81, fg82, fg83, fg84, fg85, fg86, fg87, fg88, fg89, fg90, fg91, fg92, fg93, fg94, fg95, fg96, fg97, fg98, fg99, fg100, fg101, fg102, fg103, fg104, fg105, fg106, fg107, fg108, fg109, fg110, fg111, fg112, fg113, fg114, fg115, fg116, fg117, fg118, fg119]
+end
+example (x0 y0 x1 y1 x2 y2 x3 y3 x4 y4 x5 y5 x6 y6 x7 y7 x8 y8 x9 y9 x10 y10 x11 y11 x12 y12 x13 y13 x14 y14 x15 y15 x16 y16 x17 y17 x18 y18 x19 y19 x20 y20 x21 y21 x22 y22 x23 y23 x24 y24 x25 y25 x26 y26 x27 y27 x28 y28 x29 y29 x30 y30 x31 y31 x32 y32 x33 y33 x34 y34 x35 y35 x36 y36 x37 y37 x38 y38 x39 y39 x40 y40 x41 y41 x42 y42 x43 y43 x44 y44 x45 y45 x46 y46 x47 y47 x48 y48 x49 y49 x50 y50 x51 y51 x52 y52 x53 y53 x54 y54 x55 y55 x56 y56 x57 y57 x58 y58 x59 y59 x60 y60 x61 y61 x62 y62 x63 y63 x64 y64 x65 y65 x66 y66 x67 y67 x68 y68 x69 y69 x70 y70 x71 y71 x72 y72 x73 y73 x74 y74 x75 y75 x76 y76 x77 y77 x78 y78 x79 y79 c : ℕ) (h0 : f x0 y0 = f y0 x0) (h1 : f x1 y1 = f y1 x1) (h2 : f x2 y2 = f y2 x2) (h3 : f x3 y3 = f y3 x3) (h4 : f x4 y4 = f y4 x4) (h5 : f x5 y5 = f y5 x5) (h6 : f x6 y6 = f y6 x6) (h7 : f x7 y7 = f y7 x7) (h8 : f x8 y8 = f y8 x8) (h9 : f x9 y9 = f y9 x9) (h10 : f x10 y10 = f y10 x10) (h11 : f x11 y11 = f y11 x11) (h12 : f x12 y12 = f y12 x12) (h13 : f x13 y13 = f y13 x13) (h14 : f x14 y14 = f y14 x14) (h15 : f x15 y15 = f y15 x15) (h16 : f x16 y16 = f y16 x16) (h17 : f x17 y17 = f y17 x17) (h18 : f x18 y18 = f y18 x18) (h19 : f x19 y19 = f y19 x19) (h20 : f x20 y20 = f y20 x20) (h21 : f x21 y21 = f y21 x21) (h22 : f x22 y22 = f y22 x22) (h23 : f x23 y23 = f y23 x23) (h24 : f x24 y24 = f y24 x24) (h25 : f x25 y25 = f y25 x25) (h26 : f x26 y26 = f y26 x26) (h27 : f x27 y27 = f y27 x27) (h28 : f x28 y28 = f y28 x28) (h29 : f x29 y29 = f y29 x29) (h30 : f x30 y30 = f y30 x30) (h31 : f x31 y31 = f y31 x31) (h32 : f x32 y32 = f y32 x32) (h33 : f x33 y33 = f y33 x33) (h34 : f x34 y34 = f y34 x34) (h35 : f x35 y35 = f y35 x35) (h36 : f x36 y36 = f y36 x36) (h37 : f x37 y37 = f y37 x37) (h38 : f x38 y38 = f y38 x38) (h39 : f x39 y39 = f y39 x39) (h40 : f x40 y40 = f y40 x40) (h41 : f x41 y41 = f y41 x41) (h42 : f x42 y42 = f y42 x42) (h43 : f x43 y43 = f y43 x43) (h44 : f x44 y44 = f y44 x44) (h45 : f x45 y45 = f y45 x45) (h46 : f x46 y46 = f y46 x46) (h47 : f x47 y47 = f y47 x47) (h48 : f x48 y48 = f y48 x48) (h49 : f x49 y49 = f y49 x49) (h50 : f x50 y50 = f y50 x50) (h51 : f x51 y51 = f y51 x51) (h52 : f x52 y52 = f y52 x52) (h53 : f x53 y53 = f y53 x53) (h54 : f x54 y54 = f y54 x54) (h55 : f x55 y55 = f y55 x55) (h56 : f x56 y56 = f y56 x56) (h57 : f x57 y57 = f y57 x57) (h58 : f x58 y58 = f y58 x58) (h59 : f x59 y59 = f y59 x59) (h60 : f x60 y60 = f y60 x60) (h61 : f x61 y61 = f y61 x61) (h62 : f x62 y62 = f y62 x62) (h63 : f x63 y63 = f y63 x63) (h64 : f x64 y64 = f y64 x64) (h65 : f x65 y65 = f y65 x65) (h66 : f x66 y66 = f y66 x66) (h67 : f x67 y67 = f y67 x67) (h68 : f x68 y68 = f y68 x68) (h69 : f x69 y69 = f y69 x69) (h70 : f x70 y70 = f y70 x70) (h71 : f x71 y71 = f y71 x71) (h72 : f x72 y72 = f y72 x72) (h73 : f x73 y73 = f y73 x73) (h74 : f x74 y74 = f y74 x74) (h75 : f x75 y75 = f y75 x75) (h76 : f x76 y76 = f y76 x76) (h77 : f x77 y77 = f y77 x77) (h78 : f x78 y78 = f y78 x78) (h79 : f x79 y79 = f y79 x79) (e : x0 = g21 c) : f x0 y0 = c + 21 :=
+begin [smt]
+  ematch_using [fg0, fg1, fg2, fg3, fg4, fg5, fg6, fg7, fg8, fg9, fg10, fg11, fg12, fg13, fg14, fg15, fg16, fg17, fg18, fg19, fg20, fg21, fg22, fg23, fg24, fg25, fg26, fg27, fg28, fg29, fg30, fg31, fg32, fg33, fg34, fg35, fg36, fg37, fg38, fg39, fg40, fg41, fg42, fg43, fg44, fg45, fg46, fg47, fg48, fg49, fg50, fg51, fg52, fg53, fg54, fg55, fg56, fg57, fg58, fg59, fg60, fg61, fg62, fg63, fg64, fg65, fg66, fg67, fg68, fg69, fg70, fg71, fg72, fg73, fg74, fg75, fg76, fg77, fg78, fg79, fg80, fg81, fg82, fg83, fg84, fg85, fg86, fg87, fg88, fg89, fg90, fg91, fg92, fg93, fg94, fg95, fg96, fg97, fg98, fg99, fg100, fg101, fg102, fg103, fg104, fg105, fg106, fg107, fg108, fg109, fg110, fg111, fg112, fg113, fg114, fg115, fg116, fg117, fg118, fg119]
+end
+example (x0 y0 x1 y1 x2 y2 x3 y3 x4 y4 x5 y5 x6 y6 x7 y7 x8 y8 x9 y9 x10 y10 x11 y11 x12 y12 x13 y13 x14 y14 x15 y15 x16 y16 x17 y17 x18 y18 x19 y19 x20 y20 x21 y21 x22 y22 x23 y23 x24 y24 x25 y25 x26 y26 x27 y27 x28 y28 x29 y29 x30 y30 x31 y31 x32 y32 x33 y33 x34 y34 x35 y35 x36 y36 x37 y37 x38 y38 x39 y39 x40 y40 x41 y41 x42 y42 x43 y43 x44 y44 x45 y45 x46 y46 x47 y47 x48 y48 x49 y49 x50 y50 x51 y51 x52 y52 x53 y53 x54 y54 x55 y55 x56 y56 x57 y57 x58 y58 x59 y59 x60 y60 x61 y61 x62 y62 x63 y63 x64 y64 x65 y65 x66 y66 x67 y67 x68 y68 x69 y69 x70 y70 x71 y71 x72 y72 x73 y73 x74 y74 x75 y75 x76 y76 x77 y77 x78 y78 x79 y79 c : ℕ) (h0 : f x0 y0 = f y0 x0) (h1 : f x1 y1 = f y1 x1) (h2 : f x2 y2 = f y2 x2) (h3 : f x3 y3 = f y3 x3) (h4 : f x4 y4 = f y4 x4) (h5 : f x5 y5 = f y5 x5) (h6 : f x6 y6 = f y6 x6) (h7 : f x7 y7 = f y7 x7) (h8 : f x8 y8 = f y8 x8) (h9 : f x9 y9 = f y9 x9) (h10 : f x10 y10 = f y10 x10) (h11 : f x11 y11 = f y11 x11) (h12 : f x12 y12 = f y12 x12) (h13 : f x13 y13 = f y13 x13) (h14 : f x14 y14 = f y14 x14) (h15 : f x15 y15 = f y15 x15) (h16 : f x16 y16 = f y16 x16) (h17 : f x17 y17 = f y17 x17) (h18 : f x18 y18 = f y18 x18) (h19 : f x19 y19 = f y19 x19) (h20 : f x20 y20 = f y20 x20) (h21 : f x21 y21 = f y21 x21) (h22 : f x22 y22 = f y22 x22) (h23 : f x23 y23 = f y23 x23) (h24 : f x24 y24 = f y24 x24) (h25 : f x25 y25 = f y25 x25) (h26 : f x26 y26 = f y26 x26) (h27 : f x27 y27 = f y27 x27) (h28 : f x28 y28 = f y28 x28) (h29 : f x29 y29 = f y29 x29) (h30 : f x30 y30 = f y30 x30) (h31 : f x31 y31 = f y31 x31) (h32 : f x32 y32 = f y32 x32) (h33 : f x33 y33 = f y33 x33) (h34 : f x34 y34 = f y34 x34) (h35 : f x35 y35 = f y35 x35) (h36 : f x36 y36 = f y36 x36) (h37 : f x37 y37 = f y37 x37) (h38 : f x38 y38 = f y38 x38) (h39 : f x39 y39 = f y39 x39) (h40 : f x40 y40 = f y40 x40) (h41 : f x41 y41 = f y41 x41) (h42 : f x42 y42 = f y42 x42) (h43 : f x43 y43 = f y43 x43) (h44 : f x44 y44 = f y44 x44) (h45 : f x45 y45 = f y45 x45) (h46 : f x46 y46 = f y46 x46) (h47 : f x47 y47 = f y47 x47) (h48 : f x48 y48 = f y48 x48) (h49 : f x49 y49 = f y49 x49) (h50 : f x50 y50 = f y50 x50) (h51 : f x51 y51 = f y51 x51) (h52 : f x52 y52 = f y52 x52) (h53 : f x53 y53 = f y53 x53) (h54 : f x54 y54 = f y54 x54) (h55 : f x55 y55 = f y55 x55) (h56 : f x56 y56 = f y56 x56) (h57 : f x57 y57 = f y57 x57) (h58 : f x58 y58 = f y58 x58) (h59 : f x59 y59 = f y59 x59) (h60 : f x60 y60 = f y60 x60) (h61 : f x61 y61 = f y61 x61) (h62 : f x62 y62 = f y62 x62) (h63 : f x63 y63 = f y63 x63) (h64 : f x64 y64 = f y64 x64) (h65 : f x65 y65 = f y65 x65) (h66 : f x66 y66 = f y66 x66) (h67 : f x67 y67 = f y67 x67) (h68 : f x68 y68 = f y68 x68) (h69 : f x69 y69 = f y69 x69) (h70 : f x70 y70 = f y70 x70) (h71 : f x71 y71 = f y71 x71) (h72 : f x72 y72 = f y72 x72) (h73 : f x73 y73 = f y73 x73) (h74 : f x74 y74 = f y74 x74) (h75 : f x75 y75 = f y75 x75) (h76 : f x76 y76 = f y76 x76) (h77 : f x77 y77 = f y77 x77) (h78 : f x78 y78 = f y78 x78) (h79 : f x79 y79 = f y79 x79) (e : x0 = g28 c) : f x0 y0 = c + 28 :=
+begin [smt]
+  ematch_using [fg0, fg1, fg2, fg3, fg4, fg5, fg6, fg7, fg8, fg9, fg10, fg11, fg12, fg13, fg14, fg15, fg16, fg17, fg18, fg19, fg20, fg21, fg22, fg23, fg24, fg25, fg26, fg27, fg28, fg29, fg30, fg31, fg32, fg33, fg34, fg35, fg36, fg37, fg38, fg39, fg40, fg41, fg42, fg43, fg44, fg45, fg46, fg47, fg48, fg49, fg50, fg51, fg52, fg53, fg54, fg55, fg56, fg57, fg58, fg59, fg60, fg61, fg62, fg63, fg64, fg65, fg66, fg67, fg68, fg69, fg70, fg71, fg72, fg73, fg74, fg75, fg76, fg77, fg78, fg79, fg80, fg81, fg82, fg83, fg84, fg85, fg86, fg87, fg88, fg89, fg90, fg91, fg92, fg93, fg94, fg95, fg96, fg97, fg98, fg99, fg100, fg101, fg102, fg103, fg104, fg105, fg106, fg107, fg108, fg109, fg110, fg111, fg112, fg113, fg114, fg115, fg116, fg117, fg118, fg119]
+end
+example (x0 y0 x1 y1 x2 y2 x3 y3 x4 y4 x5 y5 x6 y6 x7 y7 x8 y8 x9 y9 x10 y10 x11 y11 x12 y12 x13 y13 x14 y14 x15 y15 x16 y16 x17 y17 x18 y18 x19 y19 x20 y20 x21 y21 x22 y22 x23 y23 x24 y24 x25 y25 x26 y26 x27 y27 x28 y28 x29 y29 x30 y30 x31 y31 x32 y32 x33 y33 x34 y34 x35 y35 x36 y36 x37 y37 x38 y38 x39 y39 x40 y40 x41 y41 x42 y42 x43 y43 x44 y44 x45 y45 x46 y46 x47 y47 x48 y48 x49 y49 x50 y50 x51 y51 x52 y52 x53 y53 x54 y54 x55 y55 x56 y56 x57 y57 x58 y58 x59 y59 x60 y60 x61 y61 x62 y62 x63 y63 x64 y64 x65 y65 x66 y66 x67 y67 x68 y68 x69 y69 x70 y70 x71 y71 x72 y72 x73 y73 x74 y74 x75 y75 x76 y76 x77 y77 x78 y78 x79 y79 c : ℕ) (h0 : f x0 y0 = f y0 x0) (h1 : f x1 y1 = f y1 x1) (h2 : f x2 y2 = f y2 x2) (h3 : f x3 y3 = f y3 x3) (h4 : f x4 y4 = f y4 x4) (h5 : f x5 y5 = f y5 x5) (h6 : f x6 y6 = f y6 x6) (h7 : f x7 y7 = f y7 x7) (h8 : f x8 y8 = f y8 x8) (h9 : f x9 y9 = f y9 x9) (h10 : f x10 y10 = f y10 x10) (h11 : f x11 y11 = f y11 x11) (h12 : f x12 y12 = f y12 x12) (h13 : f x13 y13 = f y13 x13) (h14 : f x14 y14 = f y14 x14) (h15 : f x15 y15 = f y15 x15) (h16 : f x16 y16 = f y16 x16) (h17 : f x17 y17 = f y17 x17) (h18 : f x18 y18 = f y18 x18) (h19 : f x19 y19 = f y19 x19) (h20 : f x20 y20 = f y20 x20) (h21 : f x21 y21 = f y21 x21) (h22 : f x22 y22 = f y22 x22) (h23 : f x23 y23 = f y23 x23) (h24 : f x24 y24 = f y24 x24) (h25 : f x25 y25 = f y25 x25) (h26 : f x26 y26 = f y26 x26) (h27 : f x27 y27 = f y27 x27) (h28 : f x28 y28 = f y28 x28) (h29 : f x29 y29 = f y29 x29) (h30 : f x30 y30 = f y30 x30) (h31 : f x31 y31 = f y31 x31) (h32 : f x32 y32 = f y32 x32) (h33 : f x33 y33 = f y33 x33) (h34 : f x34 y34 = f y34 x34) (h35 : f x35 y35 = f y35 x35) (h36 : f x36 y36 = f y36 x36) (h37 : f x37 y37 = f y37 x37) (h38 : f x38 y38 = f y38 x38) (h39 : f x39 y39 = f y39 x39) (h40 : f x40 y40 = f y40 x40) (h41 : f x41 y41 = f y41 x41) (h42 : f x42 y42 = f y42 x42) (h43 : f x43 y43 = f y43 x43) (h44 : f x44 y44 = f y44 x44) (h45 : f x45 y45 = f y45 x45) (h46 : f x46 y46 = f y46 x46) (h47 : f x47 y47 = f y47 x47) (h48 : f x48 y48 = f y48 x48) (h49 : f x49 y49 = f y49 x49) (h50 : f x50 y50 = f y50 x50) (h51 : f x51 y51 = f y51 x51) (h52 : f x52 y52 = f y52 x52) (h53 : f x53 y53 = f y53 x53) (h54 : f x54 y54 = f y54 x54) (h55 : f x55 y55 = f y55 x55) (h56 : f x56 y56 = f y56 x56) (h57 : f x57 y57 = f y57 x57) (h58 : f x58 y58 = f y58 x58) (h59 : f x59 y59 = f y59 x59) (h60 : f x60 y60 = f y60 x60) (h61 : f x61 y61 = f y61 x61) (h62 : f x62 y62 = f y62 x62) (h63 : f x63 y63 = f y63 x63) (h64 : f x64 y64 = f y64 x64) (h65 : f x65 y65 = f y65 x65) (h66 : f x66 y66 = f y66 x66) (h67 : f x67 y67 = f y67 x67) (h68 : f x68 y68 = f y68 x68) (h69 : f x69 y69 = f y69 x69) (h70 : f x70 y70 = f y70 x70) (h71 : f x71 y71 = f y71 x71) (h72 : f x72 y72 = f y72 x72) (h73 : f x73 y73 = f y73 x73) (h74 : f x74 y74 = f y74 x74) (h75 : f x75 y75 = f y75 x75) (h76 : f x76 y76 = f y76 x76) (h77 : f x77 y77 = f y77 x77) (h78 : f x78 y78 = f y78 x78) (h79 : f x79 y79 = f y79 x79) (e : x0 = g35 c) : f x0 y0 = c + 35 :=
+begin [smt]
+  ematch_using [fg0, fg1, fg2, fg3, fg4, fg5, fg6, fg7, fg8, fg9, fg10, fg11, fg12, fg13, fg14, fg15, fg16, fg17, fg18, fg19, fg20, fg21, fg22, fg23, fg24, fg25, fg26, fg27, fg28, fg29, fg30, fg31, fg32, fg33, fg34, fg35, fg36, fg37, fg38, fg39, fg40, fg41, fg42, fg43, fg44, fg45, fg46, fg47, fg48, fg49, fg50, fg51, fg52, fg53, fg54, fg55, fg56, fg57, fg58, fg59, fg60, fg61, fg62, fg63, fg64, fg65, fg66, fg67, fg68, fg69, fg70, fg71, fg72, fg73, fg74, fg75, fg76, fg77, fg78, fg79, fg80, fg81, fg82, fg83, fg84, fg85, fg86, fg87, fg88, fg89, fg90, fg91, fg92, fg93, fg94, fg95, fg96, fg97, fg98, fg99, fg100, fg101, fg102, fg103, fg104, fg105, fg106, fg107, fg108, fg109, fg110, fg111, fg112, fg113, fg114, fg115, fg116, fg117, fg118, fg119]
+end
+example (x0 y0 x1 y1 x2 y2 x3 y3 x4 y4 x5 y5 x6 y6 x7 y7 x8 y8 x9 y9 x10 y10 x11 y11 x12 y12 x13 y13 x14 y14 x15 y15 x16 y16 x17 y17 x18 y18 x19 y19 x20 y20 x21 y21 x22 y22 x23 y23 x24 y24 x25 y25 x26 y26 x27 y27 x28 y28 x29 y29 x30 y30 x31 y31 x32 y32 x33 y33 x34 y34 x35 y35 x36 y36 x37 y37 x38 y38 x39 y39 x40 y40 x41 y41 x42 y42 x43 y43 x44 y44 x45 y45 x46 y46 x47 y47 x48 y48 x49 y49 x50 y50 x51 y51 x52 y52 x53 y53 x54 y54 x55 y55 x56 y56 x57 y57 x58 y58 x59 y59 x60 y60 x61 y61 x62 y62 x63 y63 x64 y64 x65 y65 x66 y66 x67 y67 x68 y68 x69 y69 x70 y70 x71 y71 x72 y72 x73 y73 x74 y74 x75 y75 x76 y76 x77 y77 x78 y78 x79 y79 c : ℕ) (h0 : f x0 y0 = f y0 x0) (h1 : f x1 y1 = f y1 x1) (h2 : f x2 y2 = f y2 x2) (h3 : f x3 y3 = f y3 x3) (h4 : f x4 y4 = f y4 x4) (h5 : f x5 y5 = f y5 x5) (h6 : f x6 y6 = f y6 x6) (h7 : f x7 y7 = f y7 x7) (h8 : f x8 y8 = f y8 x8) (h9 : f x9 y9 = f y9 x9) (h10 : f x10 y10 = f y10 x10) (h11 : f x11 y11 = f y11 x11) (h12 : f x12 y12 = f y12 x12) (h13 : f x13 y13 = f y13 x13) (h14 : f x14 y14 = f y14 x14) (h15 : f x15 y15 = f y15 x15) (h16 : f x16 y16 = f y16 x16) (h17 : f x17 y17 = f y17 x17) (h18 : f x18 y18 = f y18 x18) (h19 : f x19 y19 = f y19 x19) (h20 : f x20 y20 = f y20 x20) (h21 : f x21 y21 = f y21 x21) (h22 : f x22 y22 = f y22 x22) (h23 : f x23 y23 = f y23 x23) (h24 : f x24 y24 = f y24 x24) (h25 : f x25 y25 = f y25 x25) (h26 : f x26 y26 = f y26 x26) (h27 : f x27 y27 = f y27 x27) (h28 : f x28 y28 = f y28 x28) (h29 : f x29 y29 = f y29 x29) (h30 : f x30 y30 = f y30 x30) (h31 : f x31 y31 = f y31 x31) (h32 : f x32 y32 = f y32 x32) (h33 : f x33 y33 = f y33 x33) (h34 : f x34 y34 = f y34 x34) (h35 : f x35 y35 = f y35 x35) (h36 : f x36 y36 = f y36 x36) (h37 : f x37 y37 = f y37 x37) (h38 : f x38 y38 = f y38 x38) (h39 : f x39 y39 = f y39 x39) (h40 : f x40 y40 = f y40 x40) (h41 : f x41 y41 = f y41 x41) (h42 : f x42 y42 = f y42 x42) (h43 : f x43 y43 = f y43 x43) (h44 : f x44 y44 = f y44 x44) (h45 : f x45 y45 = f y45 x45) (h46 : f x46 y46 = f y46 x46) (h47 : f x47 y47 = f y47 x47) (h48 : f x48 y48 = f y48 x48) (h49 : f x49 y49 = f y49 x49) (h50 : f x50 y50 = f y50 x50) (h51 : f x51 y51 = f y51 x51) (h52 : f x52 y52 = f y52 x52) (h53 : f x53 y53 = f y53 x53) (h54 : f x54 y54 = f y54 x54) (h55 : f x55 y55 = f y55 x55) (h56 : f x56 y56 = f y56 x56) (h57 : f x57 y57 = f y57 x57) (h58 : f x58 y58 = f y58 x58) (h59 : f x59 y59 = f y59 x59) (h60 : f x60 y60 = f y60 x60) (h61 : f x61 y61 = f y61 x61) (h62 : f x62 y62 = f y62 x62) (h63 : f x63 y63 = f y63 x63) (h64 : f x64 y64 = f y64 x64) (h65 : f x65 y65 = f y65 x65) (h66 : f x66 y66 = f y66 x66) (h67 : f x67 y67 = f y67 x67) (h68 : f x68 y68 = f y68 x68) (h69 : f x69 y69 = f y69 x69) (h70 : f x70 y70 = f y70 x70) (h71 : f x71 y71 = f y71 x71) (h72 : f x72 y72 = f y72 x72) (h73 : f x73 y73 = f y73 x73) (h74 : f x74 y74 = f y74 x74) (h75 : f x75 y75 = f y75 x75) (h76 : f x76 y76 = f y76 x76) (h77 : f x77 y77 = f y77 x77) (h78 : f x78 y78 = f y78 x78) (h79 : f x79 y79 = f y79 x79) (e : x0 = g42 c) : f x0 y0 = c + 42 :=
+begin [smt]
+  ematch_using [fg0, fg1, fg2, fg3, fg4, fg5, fg6, fg7, fg8, fg9, fg10, fg11, fg12, fg13, fg14, fg15, fg16, fg17, fg18, fg19, fg20, fg21, fg22, fg23, fg24, fg25, fg26, fg27, fg28, fg29, fg30, fg31, fg32, fg33, fg34, fg35, fg36, fg37, fg38, fg39, fg40, fg41, fg42, fg43, fg44, fg45, fg46, fg47, fg48, fg49, fg50, fg51, fg52, fg53, fg54, fg55, fg56, fg57, fg58, fg59, fg60, fg61, fg62, fg63, fg64, fg65, fg66, fg67, fg68, fg69, fg70, fg71, fg72, fg73, fg74, fg75, fg76, fg77, fg78, fg79, fg80, fg81, fg82, fg83, fg84, fg85, fg86, fg87, fg88, fg89, fg90, fg91, fg92, fg93, fg94, fg95, fg96, fg97, fg98, fg99, fg100, fg101, fg102, fg103, fg104, fg105, fg106, fg107, fg108, fg109, fg110, fg111, fg112, fg113, fg114, fg115, fg116, fg117, fg118, fg119]
+end
+example (x0 y0 x1 y1 x2 y2 x3 y3 x4 y4 x5 y5 x6 y6 x7 y7 x8 y8 x9 y9 x10 y10 x11 y11 x12 y12 x13 y13 x14 y14 x15 y15 x16 y16 x17 y17 x18 y18 x19 y19 x20 y20 x21 y21 x22 y22 x23 y23 x24 y24 x25 y25 x26 y26 x27 y27 x28 y28 x29 y29 x30 y30 x31 y31 x32 y32 x33 y33 x34 y34 x35 y35 x36 y36 x37 y37 x38 y38 x39 y39 x40 y40 x41 y41 x42 y42 x43 y43 x44 y44 x45 y45 x46 y46 x47 y47 x48 y48 x49 y49 x50 y50 x51 y51 x52 y52 x53 y53 x54 y54 x55 y55 x56 y56 x57 y57 x58 y58 x59 y59 x60 y60 x61 y61 x62 y62 x63 y63 x64 y64 x65 y65 x66 y66 x67 y67 x68 y68 x69 y69 x70 y70 x71 y71 x72 y72 x73 y73 x74 y74 x75 y75 x76 y76 x77 y77 x78 y78 x79 y79 c : ℕ) (h0 : f x0 y0 = f y0 x0) (h1 : f x1 y1 = f y1 x1) (h2 : f x2 y2 = f y2 x2) (h3 : f x3 y3 = f y3 x3) (h4 : f x4 y4 = f y4 x4) (h5 : f x5 y5 = f y5 x5) (h6 : f x6 y6 = f y6 x6) (h7 : f x7 y7 = f y7 x7) (h8 : f x8 y8 = f y8 x8) (h9 : f x9 y9 = f y9 x9) (h10 : f x10 y10 = f y10 x10) (h11 : f x11 y11 = f y11 x11) (h12 : f x12 y12 = f y12 x12) (h13 : f x13 y13 = f y13 x13) (h14 : f x14 y14 = f y14 x14) (h15 : f x15 y15 = f y15 x15) (h16 : f x16 y16 = f y16 x16) (h17 : f x17 y17 = f y17 x17) (h18 : f x18 y18 = f y18 x18) (h19 : f x19 y19 = f y19 x19) (h20 : f x20 y20 = f y20 x20) (h21 : f x21 y21 = f y21 x21) (h22 : f x22 y22 = f y22 x22) (h23 : f x23 y23 = f y23 x23) (h24 : f x24 y24 = f y24 x24) (h25 : f x25 y25 = f y25 x25) (h26 : f x26 y26 = f y26 x26) (h27 : f x27 y27 = f y27 x27) (h28 : f x28 y28 = f y28 x28) (h29 : f x29 y29 = f y29 x29) (h30 : f x30 y30 = f y30 x30) (h31 : f x31 y31 = f y31 x31) (h32 : f x32 y32 = f y32 x32) (h33 : f x33 y33 = f y33 x33) (h34 : f x34 y34 = f y34 x34) (h35 : f x35 y35 = f y35 x35) (h36 : f x36 y36 = f y36 x36) (h37 : f x37 y37 = f y37 x37) (h38 : f x38 y38 = f y38 x38) (h39 : f x39 y39 = f y39 x39) (h40 : f x40 y40 = f y40 x40) (h41 : f x41 y41 = f y41 x41) (h42 : f x42 y42 = f y42 x42) (h43 : f x43 y43 = f y43 x43) (h44 : f x44 y44 = f y44 x44) (h45 : f x45 y45 = f y45 x45) (h46 : f x46 y46 = f y46 x46) (h47 : f x47 y47 = f y47 x47) (h48 : f x48 y48 = f y48 x48) (h49 : f x49 y49 = f y49 x49) (h50 : f x50 y50 = f y50 x50) (h51 : f x51 y51 = f y51 x51) (h52 : f x52 y52 = f y52 x52) (h53 : f x53 y53 = f y53 x53) (h54 : f x54 y54 = f y54 x54) (h55 : f x55 y55 = f y55 x55) (h56 : f x56 y56 = f y56 x56) (h57 : f x57 y57 = f y57 x57) (h58 : f x58 y58 = f y58 x58) (h59 : f x59 y59 = f y59 x59) (h60 : f x60 y60 = f y60 x60) (h61 : f x61 y61 = f y61 x61) (h62 : f x62 y62 = f y62 x62) (h63 : f x63 y63 = f y63 x63) (h64 : f x64 y64 = f y64 x64) (h65 : f x65 y65 = f y65 x65) (h66 : f x66 y66 = f y66 x66) (h67 : f x67 y67 = f y67 x67) (h68 : f x68 y68 = f y68 x68) (h69 : f x69 y69 = f y69 x69) (h70 : f x70 y70 = f y70 x70) (h71 : f x71 y71 = f y71 x71) (h72 : f x72 y72 = f y72 x72) (h73 : f x73 y73 = f y73 x73) (h74 : f x74 y74 = f y74 x74) (h75 : f x75 y75 = f y75 x75) (h76 : f x76 y76 = f y76 x76) (h77 : f x77 y77 = f y77 x77) (h78 : f x78 y78 = f y78 x78) (h79 : f x79 y79 = f y79 x79) (e : x0 = g49 c) : f x0 y0 = c + 49 :=
+begin [smt]
+  ematch_using [fg0, fg1, fg2, fg3, fg4, fg5, fg6, fg7, fg8, fg9, fg10, fg11, fg12, fg13, fg14, fg15, fg16, fg17, fg18, fg19, fg20, fg21, fg22, fg23, fg24, fg25, fg26, fg27, fg28, fg29, fg30, fg31, fg32, fg33, fg34, fg35, fg36, fg37, fg38, fg39, fg40, fg41, fg42, fg43, fg44, fg45, fg46, fg47, fg48, fg49, fg50, fg51, fg52, fg53, fg54, fg55, fg56, fg57, fg58, fg59, fg60, fg61, fg62, fg63, fg64, fg65, fg66, fg67, fg68, fg69, fg70, fg71, fg72, fg73, fg74, fg75, fg76, fg77, fg78, fg79, fg80, fg81, fg82, fg83, fg84, fg85, fg86, fg87, fg88, fg89, fg90, fg91, fg92, fg93, fg94, fg95, fg96, fg97, fg98, fg99, fg100, fg101, fg102, fg103, fg104, fg105, fg106, fg107, fg108, fg109, fg110, fg111, fg112, fg113, fg114, fg115, fg116, fg117, fg118, fg119]
+end
+example (x0 y0 x1 y1 x2 y2 x3 y3 x4 y4 x5 y5 x6 y6 x7 y7 x8 y8 x9 y9 x10 y10 x11 y11 x12 y12 x13 y13 x14 y14 x15 y15 x16 y16 x17 y17 x18 y18 x19 y19 x20 y20 x21 y21 x22 y22 x23 y23 x24 y24 x25 y25 x26 y26 x27 y27 x28 y28 x29 y29 x30 y30 x31 y31 x32 y32 x33 y33 x34 y34 x35 y35 x36 y36 x37 y37 x38 y38 x39 y39 x40 y40 x41 y41 x42 y42 x43 y43 x44 y44 x45 y45 x46 y46 x47 y47 x48 y48 x49 y49 x50 y50 x51 y51 x52 y52 x53 y53 x54 y54 x55 y55 x56 y56 x57 y57 x58 y58 x59 y59 x60 y60 x61 y61 x62 y62 x63 y63 x64 y64 x65 y65 x66 y66 x67 y67 x68 y68 x69 y69 x70 y70 x71 y71 x72 y72 x73 y73 x74 y74 x75 y75 x76 y76 x77 y77 x78 y78 x79 y79 c : ℕ) (h0 : f x0 y0 = f y0 x0) (h1 : f x1 y1 = f y1 x1) (h2 : f x2 y2 = f y2 x2) (h3 : f x3 y3 = f y3 x3) (h4 : f x4 y4 = f y4 x4) (h5 : f x5 y5 = f y5 x5) (h6 : f x6 y6 = f y6 x6) (h7 : f x7 y7 = f y7 x7) (h8 : f x8 y8 = f y8 x8) (h9 : f x9 y9 = f y9 x9) (h10 : f x10 y10 = f y10 x10) (h11 : f x11 y11 = f y11 x11) (h12 : f x12 y12 = f y12 x12) (h13 : f x13 y13 = f y13 x13) (h14 : f x14 y14 = f y14 x14) (h15 : f x15 y15 = f y15 x15) (h16 : f x16 y16 = f y16 x16) (h17 : f x17 y17 = f y17 x17) (h18 : f x18 y18 = f y18 x18) (h19 : f x19 y19 = f y19 x19) (h20 : f x20 y20 = f y20 x20) (h21 : f x21 y21 = f y21 x21) (h22 : f x22 y22 = f y22 x22) (h23 : f x23 y23 = f y23 x23) (h24 : f x24 y24 = f y24 x24) (h25 : f x25 y25 = f y25 x25) (h26 : f x26 y26 = f y26 x26) (h27 : f x27 y27 = f y27 x27) (h28 : f x28 y28 = f y28 x28) (h29 : f x29 y29 = f y29 x29) (h30 : f x30 y30 = f y30 x30) (h31 : f x31 y31 = f y31 x31) (h32 : f x32 y32 = f y32 x32) (h33 : f x33 y33 = f y33 x33) (h34 : f x34 y34 = f y34 x34) (h35 : f x35 y35 = f y35 x35) (h36 : f x36 y36 = f y36 x36) (h37 : f x37 y37 = f y37 x37) (h38 : f x38 y38 = f y38 x38) (h39 : f x39 y39 = f y39 x39) (h40 : f x40 y40 = f y40 x40) (h41 : f x41 y41 = f y41 x41) (h42 : f x42 y42 = f y42 x42) (h43 : f x43 y43 = f y43 x43) (h44 : f x44 y44 = f y44 x44) (h45 : f x45 y45 = f y45 x45) (h46 : f x46 y46 = f y46 x46) (h47 : f x47 y47 = f y47 x47) (h48 : f x48 y48 = f y48 x48) (h49 : f x49 y49 = f y49 x49) (h50 : f x50 y50 = f y50 x50) (h51 : f x51 y51 = f y51 x51) (h52 : f x52 y52 = f y52 x52) (h53 : f x53 y53 = f y53 x53) (h54 : f x54 y54 = f y54 x54) (h55 : f x55 y55 = f y55 x55) (h56 : f x56 y56 = f y56 x56) (h57 : f x57 y57 = f y57 x57) (h58 : f x58 y58 = f y58 x58) (h59 : f x59 y59 = f y59 x59) (h60 : f x60 y60 = f y60 x60) (h61 : f x61 y61 = f y61 x61) (h62 : f x62 y62 = f y62 x62) (h63 : f x63 y63 = f y63 x63) (h64 : f x64 y64 = f y64 x64) (h65 : f x65 y65 = f y65 x65) (h66 : f x66 y66 = f y66 x66) (h67 : f x67 y67 = f y67 x67) (h68 : f x68 y68 = f y68 x68) (h69 : f x69 y69 = f y69 x69) (h70 : f x70 y70 = f y70 x70) (h71 : f x71 y71 = f y71 x71) (h72 : f x72 y72 = f y72 x72) (h73 : f x73 y73 = f y73 x73) (h74 : f x74 y74 = f y74 x74) (h75 : f x75 y75 = f y75 x75) (h76 : f x76 y76 = f y76 x76) (h77 : f x77 y77 = f y77 x77) (h78 : f x78 y78 = f y78 x78) (h79 : f x79 y79 = f y79 x79) (e : x0 = g56 c) : f x0 y0 = c + 56 :=
+begin [smt]
+  ematch_using [fg0, fg1, fg2, fg3, fg4, fg5, fg6, fg7, fg8, fg9, fg10, fg11, fg12, fg13, fg14, fg15, fg16, fg17, fg18, fg19, fg20, fg21, fg22, fg23, fg24, fg25, fg26, fg27, fg28, fg29, fg30, fg31, fg32, fg33, fg34, fg35, fg36, fg37, fg38, fg39, fg40, fg41, fg42, fg43, fg44, fg45, fg46, fg47, fg48, fg49, fg50, fg51, fg52, fg53, fg54, fg55, fg56, fg57, fg58, fg59, fg60, fg61, fg62, fg63, fg64, fg65, fg66, fg67, fg68, fg69, fg70, fg71, fg72, fg73, fg74, fg75, fg76, fg77, fg78, fg79, fg80, fg81, fg82, fg83, fg84, fg85, fg86, fg87, fg88, fg89, fg90, fg91, fg92, fg93, fg94, fg95, fg96, fg97, fg98, fg99, fg100, fg101, fg102, fg103, fg104, fg105, fg106, fg107, fg108, fg109, fg110, fg111, fg112, fg113, fg114, fg115, fg116, fg117, fg118, fg119]
+end
+example (x0 y0 x1 y1 x2 y2 x3 y3 x4 y4 x5 y5 x6 y6 x7 y7 x8 y8 x9 y9 x10 y10 x11 y11 x12 y12 x13 y13 x14 y14 x15 y15 x16 y16 x17 y17 x18 y18 x19 y19 x20 y20 x21 y21 x22 y22 x23 y23 x24 y24 x25 y25 x26 y26 x27 y27 x28 y28 x29 y29 x30 y30 x31 y31 x32 y32 x33 y33 x34 y34 x35 y35 x36 y36 x37 y37 x38 y38 x39 y39 x40 y40 x41 y41 x42 y42 x43 y43 x44 y44 x45 y45 x46 y46 x47 y47 x48 y48 x49 y49 x50 y50 x51 y51 x52 y52 x53 y53 x54 y54 x55 y55 x56 y56 x57 y57 x58 y58 x59 y59 x60 y60 x61 y61 x62 y62 x63 y63 x64 y64 x65 y65 x66 y66 x67 y67 x68 y68 x69 y69 x70 y70 x71 y71 x72 y72 x73 y73 x74 y74 x75 y75 x76 y76 x77 y77 x78 y78 x79 y79 c : ℕ) (h0 : f x0 y0 = f y0 x0) (h1 : f x1 y1 = f y1 x1) (h2 : f x2 y2 = f y2 x2) (h3 : f x3 y3 = f y3 x3) (h4 : f x4 y4 = f y4 x4) (h5 : f x5 y5 = f y5 x5) (h6 : f x6 y6 = f y6 x6) (h7 : f x7 y7 = f y7 x7) (h8 : f x8 y8 = f y8 x8) (h9 : f x9 y9 = f y9 x9) (h10 : f x10 y10 = f y10 x10) (h11 : f x11 y11 = f y11 x11) (h12 : f x12 y12 = f y12 x12) (h13 : f x13 y13 = f y13 x13) (h14 : f x14 y14 = f y14 x14) (h15 : f x15 y15 = f y15 x15) (h16 : f x16 y16 = f y16 x16) (h17 : f x17 y17 = f y17 x17) (h18 : f x18 y18 = f y18 x18) (h19 : f x19 y19 = f y19 x19) (h20 : f x20 y20 = f y20 x20) (h21 : f x21 y21 = f y21 x21) (h22 : f x22 y22 = f y22 x22) (h23 : f x23 y23 = f y23 x23) (h24 : f x24 y24 = f y24 x24) (h25 : f x25 y25 = f y25 x25) (h26 : f x26 y26 = f y26 x26) (h27 : f x27 y27 = f y27 x27) (h28 : f x28 y28 = f y28 x28) (h29 : f x29 y29 = f y29 x29) (h30 : f x30 y30 = f y30 x30) (h31 : f x31 y31 = f y31 x31) (h32 : f x32 y32 = f y32 x32) (h33 : f x33 y33 = f y33 x33) (h34 : f x34 y34 = f y34 x34) (h35 : f x35 y35 = f y35 x35) (h36 : f x36 y36 = f y36 x36) (h37 : f x37 y37 = f y37 x37) (h38 : f x38 y38 = f y38 x38) (h39 : f x39 y39 = f y39 x39) (h40 : f x40 y40 = f y40 x40) (h41 : f x41 y41 = f y41 x41) (h42 : f x42 y42 = f y42 x42) (h43 : f x43 y43 = f y43 x43) (h44 : f x44 y44 = f y44 x44) (h45 : f x45 y45 = f y45 x45) (h46 : f x46 y46 = f y46 x46) (h47 : f x47 y47 = f y47 x47) (h48 : f x48 y48 = f y48 x48) (h49 : f x49 y49 = f y49 x49) (h50 : f x50 y50 = f y50 x50) (h51 : f x51 y51 = f y51 x51) (h52 : f x52 y52 = f y52 x52) (h53 : f x53 y53 = f y53 x53) (h54 : f x54 y54 = f y54 x54) (h55 : f x55 y55 = f y55 x55) (h56 : f x56 y56 = f y56 x56) (h57 : f x57 y57 = f y57 x57) (h58 : f x58 y58 = f y58 x58) (h59 : f x59 y59 = f y59 x59) (h60 : f x60 y60 = f y60 x60) (h61 : f x61 y61 = f y61 x61) (h62 : f x62 y62 = f y62 x62) (h63 : f x63 y63 = f y63 x63) (h64 : f x64 y64 = f y64 x64) (h65 : f x65 y65 = f y65 x65) (h66 : f x66 y66 = f y66 x66) (h67 : f x67 y67 = f y67 x67) (h68 : f x68 y68 = f y68 x68) (h69 : f x69 y69 = f y69 x69) (h70 : f x70 y70 = f y70 x70) (h71 : f x71 y71 = f y71 x71) (h72 : f x72 y72 = f y72 x72) (h73 : f x73 y73 = f y73 x73) (h74 : f x74 y74 = f y74 x74) (h75 : f x75 y75 = f y75 x75) (h76 : f x76 y76 = f y76 x76) (h77 : f x77 y77 = f y77 x77) (h78 : f x78 y78 = f y78 x78) (h79 : f x79 y79 = f y79 x79) (e : x0 = g63 c) : f x0 y0 = c + 63 :=
+begin [smt]
+  ematch_using [fg0, fg1, fg2, fg3, fg4, fg5, fg6, fg7, fg8, fg9, fg10, fg11, fg12, fg13, fg14, fg15, fg16, fg17, fg18, fg19, fg20, fg21, fg22, fg23, fg24, fg25, fg26, fg27, fg28, fg29, fg30, fg31, fg32, fg33, fg34, fg35, fg36, fg37, fg38, fg39, fg40, fg41, fg42, fg43, fg44, fg45, fg46, fg47, fg48, fg49, fg50, fg51, fg52, fg53, fg54, fg55, fg56, fg57, fg58, fg59, fg60, fg61, fg62, fg63, fg64, fg65, fg66, fg67, fg68, fg69, fg70, fg71, fg72, fg73, fg74, fg75, fg76, fg77, fg78, fg79, fg80, fg81, fg82, fg83, fg84, fg85, fg86, fg87, fg88, fg89, fg90, fg91, fg92, fg93, fg94, fg95, fg96, fg97, fg98, fg99, fg100, fg101, fg102, fg103, fg104, fg105, fg106, fg107, fg108, fg109, fg110, fg111, fg112, fg113, fg114, fg115, fg116, fg117, fg118, fg119]
+end
@@ -0,0 +1,92 @@
+-- Universe polymorphic structures in the style of category theory libraries.
+-- Elaboration and type checking produce many (max u v) and (imax u v) constraints.
+universes u₁ v₁ u₂ v₂ u₃ v₃ u₄ v₄
+
+structure category (obj : Type u₁) : Type (max u₁ (v₁+1)) :=
+(hom  : obj → obj → Type v₁)
+(id   : Π X : obj, hom X X)
+(comp : Π {X Y Z : obj}, hom X Y → hom Y Z → hom X Z)
+(id_comp : ∀ {X Y : obj} (f : hom X Y), comp (id X) f = f)
+(comp_id : ∀ {X Y : obj} (f : hom X Y), comp f (id Y) = f)
+(assoc   : ∀ {W X Y Z : obj} (f : hom W X) (g : hom X Y) (h : hom Y Z),
+  comp (comp f g) h = comp f (comp g h))
+
+structure cfunctor {C : Type u₁} (cC : category.{u₁ v₁} C) {D : Type u₂} (cD : category.{u₂ v₂} D) :
+  Type (max u₁ v₁ u₂ v₂) :=
+(obj  : C → D)
+(map  : Π {X Y : C}, cC.hom X Y → cD.hom (obj X) (obj Y))
+(map_id   : ∀ X : C, map (cC.id X) = cD.id (obj X))
+(map_comp : ∀ {X Y Z : C} (f : cC.hom X Y) (g : cC.hom Y Z), map (cC.comp f g) = cD.comp (map f) (map g))
+
+namespace cfunctor
+variables {A : Type u₁} {cA : category.{u₁ v₁} A} {B : Type u₂} {cB : category.{u₂ v₂} B}
+          {C : Type u₃} {cC : category.{u₃ v₃} C} {D : Type u₄} {cD : category.{u₄ v₄} D}
+
+def id (cA : category.{u₁ v₁} A) : cfunctor cA cA :=
+{ obj := λ X, X, map := λ X Y f, f, map_id := λ X, rfl, map_comp := λ X Y Z f g, rfl }
+
+def comp (F : cfunctor cA cB) (G : cfunctor cB cC) : cfunctor cA cC :=
+{ obj      := λ X, G.obj (F.obj X),
+  map      := λ X Y f, G.map (F.map f),
+  map_id   := λ X, by rw [F.map_id, G.map_id],
+  map_comp := λ X Y Z f g, by rw [F.map_comp, G.map_comp] }
+
+lemma comp_obj (F : cfunctor cA cB) (G : cfunctor cB cC) (X : A) : (comp F G).obj X = G.obj (F.obj X) :=
+rfl
+
+lemma comp_assoc (F : cfunctor cA cB) (G : cfunctor cB cC) (H : cfunctor cC cD) (X : A) :
+  (comp (comp F G) H).obj X = (comp F (comp G H)).obj X :=
+rfl
+end cfunctor
+
+structure nat_trans {C : Type u₁} {cC : category.{u₁ v₁} C} {D : Type u₂} {cD : category.{u₂ v₂} D}
+  (F G : cfunctor cC cD) : Type (max u₁ v₂) :=
+(app : Π X : C, cD.hom (F.obj X) (G.obj X))
+(naturality : ∀ {X Y : C} (f : cC.hom X Y), cD.comp (F.map f) (app Y) = cD.comp (app X) (G.map f))
+
+namespace nat_trans
+variables {C : Type u₁} {cC : category.{u₁ v₁} C} {D : Type u₂} {cD : category.{u₂ v₂} D}
+
+def id (F : cfunctor cC cD) : nat_trans F F :=
+{ app := λ X, cD.id (F.obj X),
+  naturality := λ X Y f, by rw [cD.comp_id, cD.id_comp] }
+
+def vcomp {F G H : cfunctor cC cD} (α : nat_trans F G) (β : nat_trans G H) : nat_trans F H :=
+{ app := λ X, cD.comp (α.app X) (β.app X),
+  naturality := λ X Y f,
+    by rw [-cD.assoc, α.naturality, cD.assoc, β.naturality, cD.assoc] }
+end nat_trans
+
+/- The category of types in universe u₁, and functor categories. -/
+def types : category.{u₁+1 u₁} (Type u₁) :=
+{ hom := λ α β, α → β, id := λ α a, a, comp := λ α β γ f g a, g (f a),
+  id_comp := λ α β f, rfl, comp_id := λ α β f, rfl, assoc := λ α β γ δ f g h, rfl }
+
+def product {C : Type u₁} (cC : category.{u₁ v₁} C) {D : Type u₂} (cD : category.{u₂ v₂} D) :
+  category.{(max u₁ u₂) (max v₁ v₂)} (C × D) :=
+{ hom  := λ X Y, cC.hom X.1 Y.1 × cD.hom X.2 Y.2,
+  id   := λ X, (cC.id X.1, cD.id X.2),
+  comp := λ X Y Z f g, (cC.comp f.1 g.1, cD.comp f.2 g.2),
+  id_comp := λ X Y f, by cases f; simp [cC.id_comp, cD.id_comp],
+  comp_id := λ X Y f, by cases f; simp [cC.comp_id, cD.comp_id],
+  assoc   := λ W X Y Z f g h, by simp [cC.assoc, cD.assoc] }
+
+def product_assoc_obj {A : Type u₁} (cA : category.{u₁ v₁} A) {B : Type u₂} (cB : category.{u₂ v₂} B)
+  {C : Type u₃} (cC : category.{u₃ v₃} C) :
+  cfunctor (product (product cA cB) cC) (product cA (product cB cC)) :=
+{ obj := λ X, (X.1.1, (X.1.2, X.2)),
+  map := λ X Y f, (f.1.1, (f.1.2, f.2)),
+  map_id := λ X, rfl,
+  map_comp := λ X Y Z f g, rfl }
+
+def const_functor {C : Type u₁} (cC : category.{u₁ v₁} C) {D : Type u₂} (cD : category.{u₂ v₂} D) (d : D) :
+  cfunctor cC cD :=
+{ obj := λ X, d, map := λ X Y f, cD.id d,
+  map_id := λ X, rfl, map_comp := λ X Y Z f g, by rw cD.id_comp }
+
+def diag {C : Type u₁} (cC : category.{u₁ v₁} C) : cfunctor cC (product cC cC) :=
+{ obj := λ X, (X, X), map := λ X Y f, (f, f), map_id := λ X, rfl, map_comp := λ X Y Z f g, rfl }
+
+lemma diag_assoc_obj {C : Type u₁} (cC : category.{u₁ v₁} C) (X Y : C) :
+  (cfunctor.comp (diag (product cC cC)) (product_assoc_obj cC cC (product cC cC))).obj (X, Y) = (X, (Y, (X, Y))) :=
+rfl
@@ -0,0 +1,45 @@
+-- Kernel universe level checks. Each theorem has a type of the form (Π (x₀ : Sort l₀) ... , Type),
+-- and a value (λ (x₀ : Sort l₀') ..., Prop) where the levels lᵢ and lᵢ' are equivalent but not
+-- syntactically equal, so the kernel has to normalize and compare composite levels (is_equivalent/is_geq).
+-- Different declarations perform the same comparisons on levels that are not shared.
+open tactic
+
+meta def succ_n (l : level) : ℕ → level
+| 0     := l
+| (n+1) := level.succ (succ_n n)
+
+meta def rotate {α : Type} : list α → ℕ → list α
+| []      _     := []
+| l       0     := l
+| (a::l)  (n+1) := rotate (l ++ [a]) n
+
+meta def mk_max_left : list level → level
+| []      := level.zero
+| (l::ls) := ls.foldl level.max l
+
+meta def mk_max_right : list level → level
+| []      := level.zero
+| [l]     := l
+| (l::ls) := level.max l (mk_max_right ls)
+
+meta def level_params : list name := [`u, `v, `w, `x, `y]
+
+meta def level_terms (i : ℕ) : ℕ → list name → list level
+| _ []      := []
+| j (n::ns) := succ_n (level.param n) ((i + j) % 4) :: level_terms (j+1) ns
+
+meta def num_binders : ℕ := 400
+
+meta def add_level_check (i : ℕ) : tactic unit :=
+let ts := level_terms (i % 7) 0 level_params,
+    ks := list.range num_binders,
+    type : expr := ks.foldr (λ k b, expr.pi `x binder_info.default
+              (expr.sort (level.imax (level.param `y) (mk_max_left (rotate ts ((i + k) % 5))))) b)
+              (expr.sort (level.succ level.zero)),
+    val  : expr := ks.foldr (λ k b, expr.lam `x binder_info.default
+              (expr.sort (level.imax (level.param `y) (mk_max_right (rotate ts.reverse ((i + k) % 3))))) b)
+              (expr.sort level.zero) in
+add_decl (declaration.thm (name.mk_string ("c" ++ to_string i) `level_check) level_params
+                          type (task.pure val))
+
+run_cmd (list.range 500).mmap' add_level_check
@@ -0,0 +1,14 @@
+/- Constructors, cases2 and projections on lists and pairs. -/
+def mk_list : nat → list nat → list nat
+| 0     l := l
+| (n+1) l := mk_list n (n :: l)
+
+def sum_pairs : list (nat × nat) → nat → nat
+| []       acc := acc
+| (p :: l) acc := sum_pairs l (acc + p.1 + p.2)
+
+def big_list := mk_list 200000 []
+
+#eval timeit "map/foldl" ((big_list.map (λ n, n + 1)).foldl (+) 0)
+#eval timeit "zip/pairs" (sum_pairs (big_list.zip big_list) 0)
+#eval timeit "reverse" (big_list.reverse.reverse.length)
@@ -0,0 +1,16 @@
+/- Meta code manipulating expressions, as in tactic-heavy files. -/
+open expr
+
+meta def mk_term : nat → expr
+| 0     := `(0 : nat)
+| (n+1) := `(nat.succ %%(mk_term n) + %%(mk_term 0))
+
+meta def count_apps : expr → nat
+| (app f a) := count_apps f + count_apps a + 1
+| _         := 0
+
+meta def term := mk_term 5000
+
+#eval timeit "count_apps" (count_apps term)
+#eval timeit "fold" (term.fold 0 (λ e _ n, n + 1))
+#eval timeit "instantiate" (count_apps ((term.abstract `(0 : nat)).instantiate_var `(1 : nat)))
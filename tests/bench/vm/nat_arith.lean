@@ -0,0 +1,11 @@
+/- Arithmetic on naturals that do not fit in a small nat, but fit in 64 bits. -/
+def big_loop : nat → nat → nat
+| 0     acc := acc
+| (n+1) acc := big_loop n ((acc * 3 + n) % 1000000000000000000)
+
+def big_cmp_loop : nat → nat → nat
+| 0     acc := acc
+| (n+1) acc := big_cmp_loop n (if 5000000000 + n < acc then acc - n else acc + 4294967296)
+
+#eval timeit "big_loop" (big_loop 1000000 4294967296)
+#eval timeit "big_cmp_loop" (big_cmp_loop 1000000 0)
@@ -0,0 +1,11 @@
+/- Tail-recursive loops over small naturals: natcases, push/move and ginvoke. -/
+def sum_loop : nat → nat → nat
+| 0     acc := acc
+| (n+1) acc := sum_loop n (acc + n)
+
+def nested_loop : nat → nat → nat
+| 0     acc := acc
+| (n+1) acc := nested_loop n (sum_loop 100 acc)
+
+#eval timeit "sum_loop" (sum_loop 2000000 0)
+#eval timeit "nested_loop" (nested_loop 20000 0)
@@ -0,0 +1,20 @@
+open tactic
+
+-- instance synthesis and simp run under arenas with --arena, their results are cached
+example (a b : ℕ) : a + b + 0 = b + a := by simp
+example (a b c : ℤ) : a * (b + c) = a * b + a * c := by simp [mul_add]
+example : decidable_eq (list (ℕ × bool)) := by apply_instance
+example (l : list ℕ) (h : l ≠ []) : list.length (1 :: l) = l.length + 1 := by simp
+example (s : string) : (s, (0 : ℕ)) = (s, 0) := by simp
+
+def f (n : ℕ) : ℕ := n + 1
+lemma f_def (n : ℕ) : f n = n + 1 := rfl
+example (a : ℕ) : f (f a) = a + 2 := by simp [f_def]
+
+run_cmd do
+  i ← mk_instance `(has_add ℕ),
+  i' ← mk_instance `(has_add ℕ),
+  trace (to_bool (i = i')),
+  t ← to_expr ``(decidable_eq (list (ℕ × bool))),
+  d ← mk_instance t,
+  infer_type d >>= trace
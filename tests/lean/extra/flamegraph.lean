@@ -0,0 +1,10 @@
+-- Input for test_flamegraph.sh, it should spend some time in the elaborator and the kernel.
+def fib : ℕ → ℕ
+| 0     := 1
+| 1     := 1
+| (n+2) := fib n + fib (n+1)
+
+example : fib 10 = 89 := rfl
+
+example (a b c d : ℕ) : (a + b) * (c + d) = a*c + a*d + b*c + b*d :=
+by simp [add_mul, mul_add]
@@ -0,0 +1,16 @@
+-- Input for test_intern.sh, the errors must be reported at the same positions with and without --intern.
+example : ℕ := tt
+
+example (a b : ℕ) : a + 0 = b := rfl
+
+example : 1 + 1 = 2 ∧ 2 + 2 = 5 := ⟨rfl, rfl⟩
+
+def f (n : ℕ) : ℕ := n + tt
+
+def g (n : ℕ) : ℕ := f (f (n + 0)) + f tt
+
+example (p q : Prop) (hp : p) : p ∧ q :=
+by split; assumption
+
+theorem foo (a : ℕ) : a + 0 = a + 0 ∧ a = a + 1 :=
+⟨rfl, rfl⟩
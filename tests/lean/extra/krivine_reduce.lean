@@ -0,0 +1,26 @@
+-- Input for test_krivine.sh, #reduce must produce the same output with and without --krivine.
+def fib : ℕ → ℕ
+| 0     := 0
+| 1     := 1
+| (n+2) := fib n + fib (n+1)
+
+def compose_n {α : Type} (f : α → α) : ℕ → α → α
+| 0     := id
+| (n+1) := f ∘ compose_n n
+
+#reduce fib 10
+#reduce list.map (λ x, x * 2) (list.range 6)
+#reduce (compose_n (λ l : list ℕ, 0 :: l) 5) []
+#reduce λ n : ℕ, compose_n nat.succ 4 n
+#reduce λ (f : ℕ → ℕ) (x : ℕ), let y := f x in f (f y)
+#reduce λ (α : Type) (a b : α), (a, b).2
+#reduce (⟨2, 3⟩ : ℕ × ℕ).1 + 1
+#reduce λ (p q : Prop) (hp : p) (hq : q), and.intro hp hq
+#reduce @quot.lift ℕ (λ a b, a = b) ℕ id (λ a b h, h) (quot.mk _ 3)
+#reduce (λ (x : ℕ) (y : bool), cond y x 0) 5 tt
+#reduce λ n : ℕ, (nat.rec_on n 0 (λ m ih, ih + 2) : ℕ)
+#reduce list.length [tt, ff, tt]
+#reduce (3 : ℕ) < 5
+#reduce λ x : ℕ, x + 0
+#reduce λ x : ℕ, 0 + x
+#reduce λ (a : ℕ) (h : a = a), (@eq.rec_on ℕ a (λ _, ℕ) a h (a + 1) : ℕ)
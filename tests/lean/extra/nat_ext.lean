@@ -0,0 +1,41 @@
+-- Input for test_nat_ext.sh, it is checked using --nat-ext, with and without --krivine.
+-- The declarations are added using add_decl, so they are only checked by the kernel.
+open tactic
+
+meta def add_and_report (n : name) (type val : expr) : tactic unit :=
+(add_decl (declaration.defn n [] type val reducibility_hints.opaque tt) >> trace ("accepted " ++ to_string n))
+<|> trace ("rejected " ++ to_string n)
+
+/- Check `@eq.refl ℕ v : lhs = v'`. -/
+meta def check_eq (n : name) (type val : pexpr) : tactic unit :=
+do t ← to_expr type, v ← to_expr val, add_and_report n t v
+
+/- Check `@of_as_true p d trivial : p`, it type checks iff the instance `d : decidable p` reduces to `is_true _`. -/
+meta def check_dec (n : name) (p d : pexpr) : tactic unit :=
+do p ← to_expr p, d ← to_expr d,
+   add_and_report n p (expr.app (expr.app (expr.app (expr.const `of_as_true []) p) d) (expr.const `trivial []))
+
+run_cmd check_eq `nat_ext.add_ok    ``((123:ℕ) + 456 = 579)       ``(@eq.refl ℕ 579)
+run_cmd check_eq `nat_ext.add_bad   ``((123:ℕ) + 456 = 580)       ``(@eq.refl ℕ 580)
+run_cmd check_eq `nat_ext.mul_ok    ``((123:ℕ) * 456 = 56088)     ``(@eq.refl ℕ 56088)
+run_cmd check_eq `nat_ext.mul_bad   ``((123:ℕ) * 456 = 56089)     ``(@eq.refl ℕ 56089)
+run_cmd check_eq `nat_ext.sub_ok    ``((2000:ℕ) - 1999 = 1)       ``(@eq.refl ℕ 1)
+run_cmd check_eq `nat_ext.sub_trunc ``((5:ℕ) - 7 = 0)             ``(@eq.refl ℕ 0)
+run_cmd check_eq `nat_ext.sub_bad   ``((2000:ℕ) - 1999 = 2)       ``(@eq.refl ℕ 2)
+run_cmd check_eq `nat_ext.div_ok    ``((100:ℕ) / 7 = 14)          ``(@eq.refl ℕ 14)
+run_cmd check_eq `nat_ext.div_zero  ``((7:ℕ) / 0 = 0)             ``(@eq.refl ℕ 0)
+run_cmd check_eq `nat_ext.div_bad   ``((100:ℕ) / 7 = 15)          ``(@eq.refl ℕ 15)
+run_cmd check_eq `nat_ext.mod_ok    ``((100:ℕ) % 7 = 2)           ``(@eq.refl ℕ 2)
+run_cmd check_eq `nat_ext.mod_zero  ``((5:ℕ) % 0 = 5)             ``(@eq.refl ℕ 5)
+run_cmd check_eq `nat_ext.mod_bad   ``((100:ℕ) % 7 = 3)           ``(@eq.refl ℕ 3)
+run_cmd check_eq `nat_ext.nested_ok ``((2:ℕ) * (10 + 5) - 3 = 27) ``(@eq.refl ℕ 27)
+run_cmd check_eq `nat_ext.succ_ok   ``(nat.succ 41 = 42)          ``(@eq.refl ℕ 42)
+run_cmd check_eq `nat_ext.big_ok    ``((123456789:ℕ) * 987654321 = 121932631112635269) ``(@eq.refl ℕ 121932631112635269)
+run_cmd check_eq `nat_ext.zero_bad  ``((0:ℕ) = 1)                 ``(@eq.refl ℕ 1)
+
+run_cmd check_dec `nat_ext.eq_ok  ``((1000:ℕ) = 1000)    ``(nat.decidable_eq 1000 1000)
+run_cmd check_dec `nat_ext.eq_bad ``((1000:ℕ) = 999)     ``(nat.decidable_eq 1000 999)
+run_cmd check_dec `nat_ext.le_ok  ``((12:ℕ) * 12 ≤ 144)  ``(nat.decidable_le (12 * 12) 144)
+run_cmd check_dec `nat_ext.le_bad ``((12:ℕ) * 13 ≤ 144)  ``(nat.decidable_le (12 * 13) 144)
+run_cmd check_dec `nat_ext.lt_ok  ``((999:ℕ) < 1000)     ``(nat.decidable_lt 999 1000)
+run_cmd check_dec `nat_ext.lt_bad ``((1000:ℕ) < 1000)    ``(nat.decidable_lt 1000 1000)
@@ -0,0 +1,2 @@
+import shared_cache_base
+theorem shared_cache_a : shared_cache_fib 12 = 233 := rfl
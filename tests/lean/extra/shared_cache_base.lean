@@ -0,0 +1,5 @@
+-- Imported by shared_cache_a.lean and shared_cache_b.lean, see test_shared_cache.sh.
+def shared_cache_fib : ℕ → ℕ
+| 0     := 1
+| 1     := 1
+| (n+2) := shared_cache_fib n + shared_cache_fib (n+1)
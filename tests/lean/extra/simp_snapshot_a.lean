@@ -0,0 +1,19 @@
+-- Imported by simp_snapshot_b.lean, see test_simp_snapshot.sh.
+constant f : ℕ → ℕ
+
+def my_eq (a b : ℕ) := a = b
+@[reducible] def my_eq2 (a b : ℕ) := a = b
+
+axiom f_zero : my_eq (f 0) 0
+axiom f_one : f 1 = 2
+axiom f_two : my_eq2 (f 2) 2
+attribute [simp] f_zero f_one f_two
+
+constant R : ℕ → ℕ → Prop
+axiom R_f : R (f 3) 3
+attribute [simp] R_f
+
+example : f 1 = 2 := by simp
+example : f 2 = 2 := by simp
+open tactic
+run_cmd do s ← simp_lemmas.mk_default, success_if_fail (s.rewrite skip `R `(f 3))
@@ -0,0 +1,23 @@
+import simp_snapshot_a
+-- The snapshots of the simp lemmas stored in simp_snapshot_a.olean depend on the reducibility of my_eq and my_eq2,
+-- and on the relation attributes of R.
+example : f 1 = 2 := by simp
+example : f 2 = 2 := by simp
+
+attribute [reducible] my_eq
+example : f 0 = 0 := by simp
+
+attribute [semireducible] my_eq2
+example (h : f 2 = 2) : f 2 = 2 := by success_if_fail {simp}; exact h
+example : f 1 = 2 := by simp
+
+-- R is not a simp relation in simp_snapshot_a, so R_f is used to rewrite `R (f 3) 3` into `true`,
+-- and not `f 3` into `3` modulo R.
+open tactic
+run_cmd do s ← simp_lemmas.mk_default, success_if_fail (s.rewrite skip `R `(f 3))
+
+axiom R_refl : ∀ a, R a a
+axiom R_trans : ∀ a b c, R a b → R b c → R a c
+attribute [refl] R_refl
+attribute [trans] R_trans
+run_cmd do s ← simp_lemmas.mk_default, s.rewrite skip `R `(f 3), skip
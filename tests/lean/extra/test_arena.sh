@@ -0,0 +1,28 @@
+#!/usr/bin/env bash
+# Check that allocating the temporary terms of instance synthesis and simp in arenas (--arena)
+# does not change the results.
+if [ $# -ne 1 ]; then
+    echo "Usage: test_arena.sh [lean-executable-path]"
+    exit 1
+fi
+ulimit -s 8192
+LEAN=$1
+export LEAN_PATH=../../../library:.
+f=arena.lean
+if ! "$LEAN" -j 0 $f > $f.produced.out 2>&1; then
+    cat $f.produced.out
+    echo "failed $f"
+    exit 1
+fi
+if ! "$LEAN" -j 0 --arena $f > $f.arena.produced.out 2>&1; then
+    cat $f.arena.produced.out
+    echo "failed $f with --arena"
+    exit 1
+fi
+if diff -u $f.produced.out $f.arena.produced.out; then
+    rm -f $f.produced.out $f.arena.produced.out
+    echo "-- checked"
+else
+    echo "ERROR: output differs with --arena"
+    exit 1
+fi
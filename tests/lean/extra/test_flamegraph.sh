@@ -0,0 +1,25 @@
+#!/usr/bin/env bash
+# Check that the sampling profiler records the phases of importing,
+# elaborating and type checking a file.
+if [ $# -ne 1 ]; then
+    echo "Usage: test_flamegraph.sh [lean-executable-path]"
+    exit 1
+fi
+ulimit -s 8192
+LEAN=$1
+export LEAN_PATH=../../../library:.
+out=flamegraph.out
+rm -f $out
+if ! "$LEAN" -D profiler.freq=1 --flamegraph=$out flamegraph.lean; then
+    echo "failed flamegraph.lean"
+    exit 1
+fi
+for phase in "olean_I/O" "elaboration" "kernel_check"; do
+    if ! grep -Eq "(^|;)$phase( |;)" $out; then
+        echo "phase $phase was not recorded"
+        cat $out
+        exit 1
+    fi
+done
+rm -f $out
+echo "-- checked"
@@ -0,0 +1,26 @@
+#!/usr/bin/env bash
+# Check that hash-consing terms does not change the positions of error messages.
+if [ $# -ne 1 ]; then
+    echo "Usage: test_intern.sh [lean-executable-path]"
+    exit 1
+fi
+ulimit -s 8192
+LEAN=$1
+export LEAN_PATH=../../../library:.
+f=intern_pos.lean
+"$LEAN" -j 0 $f > $f.produced.out
+"$LEAN" -j 0 --intern $f | grep -v "^interned " > $f.intern.produced.out
+# Messages of different declarations may be reported in any order when using several threads.
+sort $f.produced.out > $f.sorted.produced.out
+"$LEAN" -j 2 --intern $f | grep -v "^interned " | sort > $f.intern2.produced.out
+if ! grep -q "error" $f.produced.out; then
+    echo "expected error messages"
+    exit 1
+fi
+if diff -u $f.produced.out $f.intern.produced.out && diff -u $f.sorted.produced.out $f.intern2.produced.out; then
+    rm -f $f.produced.out $f.sorted.produced.out $f.intern.produced.out $f.intern2.produced.out
+    echo "-- checked"
+else
+    echo "ERROR: positions differ with --intern"
+    exit 1
+fi
@@ -0,0 +1,25 @@
+#!/usr/bin/env bash
+# Check that #reduce produces the same normal forms with the Krivine machine (--krivine).
+if [ $# -ne 1 ]; then
+    echo "Usage: test_krivine.sh [lean-executable-path]"
+    exit 1
+fi
+ulimit -s 8192
+LEAN=$1
+export LEAN_PATH=../../../library:.
+f=krivine_reduce.lean
+if ! "$LEAN" -j 0 $f > $f.produced.out; then
+    echo "failed $f"
+    exit 1
+fi
+if ! "$LEAN" -j 0 --krivine $f > $f.krivine.produced.out; then
+    echo "failed $f with --krivine"
+    exit 1
+fi
+if diff -u $f.produced.out $f.krivine.produced.out; then
+    rm -f $f.produced.out $f.krivine.produced.out
+    echo "-- checked"
+else
+    echo "ERROR: #reduce output differs with --krivine"
+    exit 1
+fi
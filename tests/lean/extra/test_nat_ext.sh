@@ -0,0 +1,20 @@
+#!/usr/bin/env bash
+# Check the kernel evaluation of nat numerals (--nat-ext): correct results must be accepted,
+# and wrong results rejected, also when the kernel uses the Krivine machine (--krivine).
+if [ $# -ne 1 ]; then
+    echo "Usage: test_nat_ext.sh [lean-executable-path]"
+    exit 1
+fi
+ulimit -s 8192
+LEAN=$1
+export LEAN_PATH=../../../library:.
+f=nat_ext.lean
+for flags in "--nat-ext" "--nat-ext --krivine"; do
+    "$LEAN" -j 0 $flags $f > $f.produced.out 2>&1
+    if ! diff -u $f.expected.out $f.produced.out; then
+        echo "ERROR: file $f.produced.out does not match $f.expected.out with $flags"
+        exit 1
+    fi
+done
+rm -f $f.produced.out
+echo "-- checked"
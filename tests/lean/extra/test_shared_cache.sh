@@ -0,0 +1,34 @@
+#!/usr/bin/env bash
+# Check that the kernel reuses results computed for another module:
+# shared_cache_a and shared_cache_b both import shared_cache_base, and check the same terms.
+if [ $# -ne 1 ]; then
+    echo "Usage: test_shared_cache.sh [lean-executable-path]"
+    exit 1
+fi
+ulimit -s 8192
+LEAN=$1
+export LEAN_PATH=../../../library:.
+rm -f shared_cache_*.olean
+out=shared_cache.produced.out
+if ! "$LEAN" -j 0 --profile --make shared_cache_a.lean shared_cache_b.lean > $out; then
+    echo "failed shared_cache_a.lean shared_cache_b.lean"
+    exit 1
+fi
+if ! grep -aq "^kernel shared (other environments) cache: [1-9]" $out; then
+    echo "ERROR: no results were reused across modules"
+    grep -a "cache:" $out
+    exit 1
+fi
+rm -f shared_cache_*.olean
+# The shared cache is disabled by --kernel-cache=0
+if ! "$LEAN" -j 0 --profile --kernel-cache=0 --make shared_cache_a.lean shared_cache_b.lean > $out; then
+    echo "failed shared_cache_a.lean shared_cache_b.lean with --kernel-cache=0"
+    exit 1
+fi
+if grep -aq "^kernel shared.* cache: [1-9]" $out; then
+    echo "ERROR: the shared cache was used with --kernel-cache=0"
+    grep -a "cache:" $out
+    exit 1
+fi
+rm -f shared_cache_*.olean $out
+echo "-- checked"
@@ -0,0 +1,20 @@
+#!/usr/bin/env bash
+# Check that the simp lemmas stored in an .olean file are analysed again when
+# the importing module changes the reducibility or the relation attributes of the constants they depend on.
+if [ $# -ne 1 ]; then
+    echo "Usage: test_simp_snapshot.sh [lean-executable-path]"
+    exit 1
+fi
+LEAN=$1
+export LEAN_PATH=../../../library:.
+rm -f simp_snapshot_*.olean
+if ! "$LEAN" --make simp_snapshot_a.lean; then
+    echo "failed simp_snapshot_a.lean"
+    exit 1
+fi
+if ! "$LEAN" simp_snapshot_b.lean; then
+    echo "failed simp_snapshot_b.lean"
+    exit 1
+fi
+rm -f simp_snapshot_*.olean
+echo "-- checked"
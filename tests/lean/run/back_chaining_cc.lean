@@ -0,0 +1,26 @@
+-- Backward chaining closing the equational goals by congruence closure
+constants (f : ℕ → ℕ) (g : ℕ → ℕ → ℕ) (p : ℕ → Prop) (q : ℕ → ℕ → Prop)
+constants (p_g : ∀ {a b : ℕ}, f a = b → p (g a b)) (p_q : ∀ {a b : ℕ}, q a b → p (g a b))
+attribute [intro] p_g p_q
+
+open tactic
+
+set_option back_chaining.cc true
+
+-- p_q is tried first, its premise (q a b) is not provable, and back_chaining backtracks and tries p_g
+example (a b c : ℕ) : a = c → f c = b → p (g a b) :=
+by (intros >> back_chaining)
+
+example (a b c : ℕ) (h : ¬ q a b) : a = c → f c = b → p (g a b) :=
+by (intros >> back_chaining)
+
+example (a b : ℕ) : a = b → a ≠ b → p a :=
+by (intros >> back_chaining)
+
+example (a b c : ℕ) (f : ℕ → ℕ) : a = b → b = c → f a = f c :=
+by (intros >> back_chaining_using_hs)
+
+set_option back_chaining.cc false
+
+example (a b c : ℕ) : a = c → f c = b → p (g a b) :=
+by (intros >> success_if_fail back_chaining >> admit)
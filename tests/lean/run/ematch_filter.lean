@@ -0,0 +1,33 @@
+constant f : nat → nat
+constant g : nat → nat
+constant h : nat → nat → nat
+axiom fg : ∀ x, (: f (g x) :) = x
+axiom fh : ∀ x y, (: f (h x y) :) = y
+axiom hg : ∀ x y, (: h (g x) (g y) :) = x
+
+/- The argument of f is an application of g only modulo the equalities. -/
+lemma ex1 (a b c : nat) : a = g c → f a = b → b = c :=
+begin [smt]
+  intros,
+  ematch_using [fg, fh]
+end
+
+/- Matching is performed again after new equalities are added. -/
+lemma ex2 (a b c d : nat) : f a = b → a = h c d → b = d :=
+begin [smt]
+  intros,
+  ematch_using [fg, fh, hg]
+end
+
+lemma ex3 (a b c d : nat) : a = g c → b = g d → h a b = c :=
+begin [smt]
+  intros,
+  ematch_using [fg, fh, hg]
+end
+
+set_option ematch.filter false
+lemma ex4 (a b c d : nat) : f a = b → a = h c d → b = d :=
+begin [smt]
+  intros,
+  ematch_using [fg, fh, hg]
+end
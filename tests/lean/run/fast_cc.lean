@@ -0,0 +1,24 @@
+open tactic
+
+example (a b c : nat) (f : nat → nat → nat) : a = b → b = c → f a b = f c c :=
+by do intros,
+      (lhs, rhs) ← target >>= match_eq,
+      tt ← fast_cc_is_eqv lhs rhs,
+      a ← to_expr ```(a),
+      ff ← fast_cc_is_eqv a rhs,
+      cc
+
+example (a b c : nat) (f : nat → nat) : a = b → f a ≠ f c → true :=
+by do intros,
+      a ← to_expr ```(a), c ← to_expr ```(c),
+      ff ← fast_cc_is_eqv a c,
+      fa ← to_expr ```(f a), fb ← to_expr ```(f b),
+      tt ← fast_cc_is_eqv fa fb,
+      ft ← to_expr ```(f a = f c),
+      tt ← fast_cc_is_eqv ft `(false),
+      triv
+
+example (p q : Prop) : p → ¬ q → (p ↔ q) → false :=
+by do intros,
+      tt ← fast_cc_is_eqv `(true) `(false),
+      cc
@@ -0,0 +1,30 @@
+class foo (α : Type) :=
+(val : nat)
+
+instance foo_nat : foo nat := ⟨_, 1⟩
+instance foo_bool : foo bool := ⟨_, 2⟩
+instance foo_list (α : Type) [foo α] : foo (list α) := ⟨_, foo.val α + 10⟩
+instance foo_prod (α β : Type) [foo α] [foo β] : foo (α × β) := ⟨_, foo.val α + foo.val β⟩
+instance foo_fn (α β : Type) [foo β] : foo (α → β) := ⟨_, foo.val β + 100⟩
+
+def my_nat := nat
+instance foo_my_nat : foo my_nat := ⟨_, 3⟩
+
+@[reducible] def my_bool := bool
+
+example : foo.val nat = 1 := rfl
+example : foo.val bool = 2 := rfl
+example : foo.val (list nat) = 11 := rfl
+example : foo.val (list (nat × bool)) = 13 := rfl
+example : foo.val (bool → nat) = 101 := rfl
+example : foo.val my_nat = 3 := rfl
+example : foo.val my_bool = 2 := rfl
+
+section
+variables (α : Type) [foo α]
+example : foo.val (list α) = foo.val α + 10 := rfl
+end
+
+set_option class.instance_index false
+example : foo.val (list (nat × bool)) = 13 := rfl
+example : foo.val my_nat = 3 := rfl
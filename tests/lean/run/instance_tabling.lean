@@ -0,0 +1,27 @@
+set_option class.instance_tabling true
+
+class A (α : Type) := (a : nat)
+class B (α : Type) := (b : nat)
+class C (α : Type) := (c : nat)
+class D (α : Type) := (d : nat)
+
+instance A_nat : A nat := ⟨_, 1⟩
+instance B_of_A (α : Type) [A α] : B α := ⟨_, A.a α + 1⟩
+instance C_of_A (α : Type) [A α] : C α := ⟨_, A.a α + 2⟩
+instance D_of_B_C (α : Type) [B α] [C α] : D α := ⟨_, B.b α + C.c α⟩
+instance A_prod (α β : Type) [D α] [D β] : A (α × β) := ⟨_, D.d α + D.d β⟩
+
+example : D.d nat = 5 := rfl
+example : D.d (nat × nat) = 23 := rfl
+example : D.d ((nat × nat) × (nat × nat)) = 95 := rfl
+
+/- loops are cut -/
+class E (α : Type) := (e : nat)
+instance E_nat : E nat := ⟨_, 7⟩
+instance E_of_E (α : Type) [E α] : E α := ⟨_, E.e α⟩
+
+example : E.e nat = 7 := rfl
+
+/- subgoals with metavariables -/
+example : inhabited (list nat) := by apply_instance
+example (α : Type) [inhabited α] : inhabited (α × list α) := by apply_instance
@@ -0,0 +1,29 @@
+constants (f g h : ℕ → ℕ) (k : ℕ → ℕ → ℕ)
+
+axiom f_succ (n : ℕ) : f (n + 1) = g n
+axiom k_zero (n : ℕ) : k n 0 = n
+axiom k_f (n m : ℕ) : k (f n) m = m
+axiom k_g (n m : ℕ) : k (g n) m = n
+
+@[reducible] def my_id (n : ℕ) := n
+axiom h_my_id (n : ℕ) : h (my_id n) = n
+
+attribute [simp] f_succ k_zero k_f k_g h_my_id
+
+example : f 3 = g 2 := by simp
+example (n : ℕ) : k (g n) 5 = n := by simp
+example (n m : ℕ) : k (f n) m = m := by simp
+example (n : ℕ) : k n 0 = n := by simp
+example : h 5 = 5 := by simp
+example (n : ℕ) : k (g n, f n).1 1 = n := by simp
+
+-- lemmas added to and erased from the default set
+example (n : ℕ) (H : g n = 0) : f (n + 1) = 0 := by simp [H]
+example (n : ℕ) (H₁ : g n = 1) (H₂ : k 1 0 = 2) : k (g n) 0 = 2 := by simp [H₁, H₂]
+example (n : ℕ) (H : k n 0 = 1) : k n 0 = 1 := by success_if_fail {simp without k_zero}; exact H
+example (n : ℕ) (H : g n = 2) : f (n + 1) = 2 := by success_if_fail {simp [H] without f_succ}; simp [H]
+
+set_option simp.index false
+example : f 3 = g 2 := by simp
+example (n : ℕ) : k (g n) 5 = n := by simp
+example : h 5 = 5 := by simp
@@ -0,0 +1,36 @@
+/- Boundary cases of the nat and int builtins: small nats, values that fit in 64 bits, and mpz. -/
+open tactic
+
+run_cmd guard (2147483647 + 1 = 2147483648)
+run_cmd guard (4294967295 + 1 = 4294967296)
+run_cmd guard (18446744073709551615 + 1 = 18446744073709551616)
+run_cmd guard (4294967296 * 4294967295 = 18446744069414584320)
+run_cmd guard (4294967296 * 4294967296 = 18446744073709551616)
+run_cmd guard (0 * 18446744073709551616 = 0)
+run_cmd guard (18446744073709551616 - 1 = 18446744073709551615)
+run_cmd guard (4294967296 - 8589934592 = 0)
+run_cmd guard (18446744073709551615 / 4294967296 = 4294967295)
+run_cmd guard (18446744073709551617 % 4294967296 = 1)
+run_cmd guard (4294967296 / 0 = 0)
+run_cmd guard (4294967296 % 0 = 4294967296)
+run_cmd guard (nat.shiftl 1 63 = 9223372036854775808)
+run_cmd guard (nat.shiftl 1 64 = 18446744073709551616)
+run_cmd guard (nat.shiftl 3 100 = 3 * 2^100)
+run_cmd guard (nat.shiftr 18446744073709551616 33 = 2147483648)
+run_cmd guard (nat.shiftr 4294967296 40 = 0)
+run_cmd guard (nat.shiftr 5 32 = 0)
+run_cmd guard (nat.test_bit 4294967296 32 = tt)
+run_cmd guard (nat.test_bit 1 40 = ff)
+run_cmd guard (nat.land 18446744073709551615 4294967296 = 4294967296)
+run_cmd guard (nat.lxor 18446744073709551616 18446744073709551616 = 0)
+run_cmd guard (4294967296 < 4294967297)
+run_cmd guard (4294967297 ≤ 4294967297)
+run_cmd guard (¬ 18446744073709551616 < 18446744073709551615)
+run_cmd guard (2147483648 ≠ 2147483647)
+
+run_cmd guard ((-4294967296 : int) * 4294967296 = -18446744073709551616)
+run_cmd guard ((9223372036854775807 : int) + 1 = 9223372036854775808)
+run_cmd guard (-(-9223372036854775808 : int) = 9223372036854775808)
+run_cmd guard ((-1073741824 : int) - 1 = -1073741825)
+run_cmd guard ((-9223372036854775808 : int) < -9223372036854775807)
+run_cmd guard ((4294967296 : int) * 0 = 0)
@@ -0,0 +1,31 @@
+set_option simplify.persistent_cache true
+set_option trace.simplify.stats true
+
+example (a b : nat) (f : nat → nat) (h : f (a + 0) = b) : f (0 + a) + 0 = b :=
+begin
+  simp at h,
+  simp,
+  exact h
+end
+
+example (a b c : nat) (h₁ : a + 0 = b) (h₂ : 0 + b = c) : a + 0 = c :=
+begin
+  simp at *,
+  simp [h₁, h₂]
+end
+
+-- `simp [h]` builds a new simp_lemmas object at each invocation, the results are reused
+example (a b : nat) (f : nat → nat) (h : f a = b) : f (a + 0) + 0 = b ∧ f (0 + a) + 0 = b :=
+begin
+  split,
+  simp [h],
+  simp [h]
+end
+
+-- The sets built by `simp [h₁]` and `simp [h₂]` are different, the results of the first one are not reused
+example (a b : nat) (f : nat → nat) (h₁ : f a = b) (h₂ : f a = a) : f (a + 0) = b ∧ f (a + 0) = a :=
+begin
+  split,
+  simp [h₁],
+  simp [h₂]
+end